@@ -0,0 +1,87 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// Main file for a sweep of DCA(+) calculations, e.g. a doping or temperature scan, in a single
+// process.
+// Usage: ./main_dca_sweep input_file_1.json [input_file_2.json ...]
+//
+// See dca/phys/dca_loop/dca_sweep.hpp for how the input files of the points are combined.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dca/config/cmake_options.hpp"
+// Defines Concurrency, Threading, ParametersType, DcaData, DcaLoop, and Profiler.
+#include "dca/config/dca.hpp"
+#include "dca/phys/dca_loop/dca_sweep.hpp"
+#include "dca/util/git_version.hpp"
+#include "dca/util/modules.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " input_file_1.json [input_file_2.json ...]" << std::endl;
+    return -1;
+  }
+
+  Concurrency concurrency(argc, argv);
+
+  try {
+    const std::vector<std::string> input_files(argv + 1, argv + argc);
+
+    Profiler::start();
+
+    // Print some info.
+    if (concurrency.id() == concurrency.first()) {
+      dca::util::GitVersion::print();
+      dca::util::Modules::print();
+      dca::config::CMakeOptions::print();
+
+#ifdef DCA_WITH_CUDA
+      dca::linalg::util::printInfoDevices();
+#endif  // DCA_WITH_CUDA
+
+      std::cout
+          << "\n"
+          << "********************************************************************************\n"
+          << "**********                  DCA(+) Calculation Sweep                  **********\n"
+          << "********************************************************************************\n"
+          << "\n"
+          << "Start time : " << dca::util::print_time() << "\n"
+          << "\n"
+          << "MPI-world set up: " << concurrency.number_of_processors() << " processes.\n"
+          << "\n"
+          << "Number of points: " << input_files.size() << "\n"
+          << std::endl;
+    }
+
+#ifdef DCA_WITH_CUDA
+    dca::linalg::util::initializeMagma();
+#endif  // DCA_WITH_CUDA
+
+    // Reads the first input file and initializes the domains and the DCA data shared by all points.
+    dca::phys::DcaSweep<ParametersType, DcaDataType, DcaLoopType> sweep(input_files, concurrency);
+
+    for (std::size_t point = 0; point < sweep.size(); ++point) {
+      sweep.readPoint(point);
+
+      Profiler profiler(__FUNCTION__, __FILE__, __LINE__);
+      sweep.runPoint();
+    }
+
+    Profiler::stop(concurrency, sweep.get_parameters().get_filename_profiling());
+
+    if (concurrency.id() == concurrency.first())
+      std::cout << "\nFinish time: " << dca::util::print_time() << "\n" << std::endl;
+  }
+  catch (const std::exception& err) {
+    std::cout << "Unhandled exception in main function:\n\t" << err.what();
+    concurrency.abort();
+  }
+
+  return 0;
+}
@@ -107,8 +107,9 @@ configure_file("${PROJECT_SOURCE_DIR}/include/dca/config/lattice_model.hpp.in"
 
 ################################################################################
 # Select the profiler type and enable auto-tuning.
-set(DCA_PROFILER "None" CACHE STRING "Profiler type, options are: None | Counting | PAPI.")
-set_property(CACHE DCA_PROFILER PROPERTY STRINGS None Counting PAPI)
+set(DCA_PROFILER "None" CACHE STRING
+  "Profiler type, options are: None | Counting | PAPI | Histogram.")
+set_property(CACHE DCA_PROFILER PROPERTY STRINGS None Counting PAPI Histogram)
 
 if (DCA_PROFILER STREQUAL "Counting")
   set(DCA_PROFILING_EVENT_TYPE dca::profiling::time_event<std::size_t>)
@@ -122,6 +123,13 @@ elseif (DCA_PROFILER STREQUAL "PAPI")
   set(DCA_PROFILER_TYPE dca::profiling::CountingProfiler<Event>)
   set(DCA_PROFILER_INCLUDE "dca/profiling/counting_profiler.hpp")
 
+elseif (DCA_PROFILER STREQUAL "Histogram")
+  # The HistogramProfiler only measures the wall time and doesn't have an event type.
+  set(DCA_PROFILING_EVENT_TYPE void)
+  set(DCA_PROFILING_EVENT_INCLUDE "dca/profiling/histogram_profiler.hpp")
+  set(DCA_PROFILER_TYPE dca::profiling::HistogramProfiler)
+  set(DCA_PROFILER_INCLUDE "dca/profiling/histogram_profiler.hpp")
+
 else()  # DCA_PROFILER = None
   # The NullProfiler doesn't have an event type.
   set(DCA_PROFILING_EVENT_TYPE void)
@@ -14,6 +14,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dca {
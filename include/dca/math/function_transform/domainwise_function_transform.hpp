@@ -12,7 +12,11 @@
 #ifndef DCA_MATH_FUNCTION_TRANSFORM_DOMAINWISE_FUNCTION_TRANSFORM_HPP
 #define DCA_MATH_FUNCTION_TRANSFORM_DOMAINWISE_FUNCTION_TRANSFORM_HPP
 
+#include <cassert>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "dca/function/domains/domain_type_operations.hpp"
 #include "dca/function/function.hpp"
@@ -70,6 +74,21 @@ struct DomainwiseFunctionTransform {
     TRANSFORM_DOMAIN_PROCEDURE<CURR_DMN_INDEX>::transform(f_input, f_output, T);
   }
 
+  template <typename scalartype_input, typename scalartype_output, typename scalartype_T,
+            class Threading>
+  static void execute_on_first(const func::function<scalartype_input, domain_input>& f_input,
+                               func::function<scalartype_output, domain_output>& f_output,
+                               const linalg::Matrix<scalartype_T, linalg::CPU>& T,
+                               Threading& threading, const int n_threads) {
+    assert(CURR_DMN_INDEX > -1 and CURR_DMN_INDEX < f_input.signature());
+
+    TRANSFORM_DOMAIN_PROCEDURE<CURR_DMN_INDEX>::transform(f_input, f_output, T, threading,
+                                                          n_threads);
+  }
+
+  // Transforms all the domains of type type_input. The intermediate functions are released as soon
+  // as the next domain has been transformed, and the last transformation writes directly into
+  // f_output.
   template <typename scalartype_input, typename scalartype_output>
   static void execute_on_all(const func::function<scalartype_input, domain_input>& f_input,
                              func::function<scalartype_output, domain_output>& f_output) {
@@ -80,36 +99,8 @@ struct DomainwiseFunctionTransform {
       f_input.print_fingerprint();
     }
 
-    func::function<scalartype_output, TRANSFORMED_DOMAIN> f_output_new("f_output_new");
-
-    TRANSFORM_DOMAIN<type_input, DMN_REP_LHS, type_output, DMN_REP_RHS, CURR_DMN_INDEX>::execute(
-        f_input, f_output_new);
-
-    if (NEXT_DMN_INDEX == -1) {
-      if (VERBOSE)
-        std::cout << "\n\n\tSTOP\t  start the copy " << std::endl;
-
-      assert(f_output_new.size() == f_output.size());
-
-      for (int l = 0; l < f_output.size(); l++)
-        f_output(l) = f_output_new(l);
-
-      if (VERBOSE) {
-        f_output.print_fingerprint();
-
-        std::cout << "\n\n\tSTOP\t finished the copy\n\n\n" << std::endl;
-      }
-    }
-    else {
-      if (VERBOSE) {
-        std::cout << "\n\n\tSTART\t" << __FUNCTION__ << std::endl;
-
-        f_output_new.print_fingerprint();
-      }
-
-      DomainwiseFunctionTransform<TRANSFORMED_DOMAIN, domain_output, type_input, type_output>::execute_on_all(
-          f_output_new, f_output);
-    }
+    executeOnAll(IsLastTransform(), f_input,
+                 std::unique_ptr<func::function<scalartype_input, domain_input>>(), f_output);
   }
 
   template <typename scalartype_input, typename scalartype_output, typename scalartype_T>
@@ -123,35 +114,93 @@ struct DomainwiseFunctionTransform {
       f_input.print_fingerprint();
     }
 
-    func::function<scalartype_output, TRANSFORMED_DOMAIN> f_output_new("f_output_new");
+    executeOnAll(IsLastTransform(), f_input,
+                 std::unique_ptr<func::function<scalartype_input, domain_input>>(), f_output, T);
+  }
 
-    TRANSFORM_DOMAIN_PROCEDURE<CURR_DMN_INDEX>::transform(f_input, f_output_new, T);
+  // Same as above, with the matrix products of each transformation distributed among n_threads
+  // threads.
+  template <typename scalartype_input, typename scalartype_output, typename scalartype_T,
+            class Threading>
+  static void execute_on_all(const func::function<scalartype_input, domain_input>& f_input,
+                             func::function<scalartype_output, domain_output>& f_output,
+                             const linalg::Matrix<scalartype_T, linalg::CPU>& T,
+                             Threading& threading, const int n_threads) {
+    executeOnAll(IsLastTransform(), f_input,
+                 std::unique_ptr<func::function<scalartype_input, domain_input>>(), f_output, T,
+                 threading, n_threads);
+  }
 
-    if (NEXT_DMN_INDEX == -1) {
-      if (VERBOSE)
-        std::cout << "\n\n\tSTOP\t  start the copy " << std::endl;
+private:
+  template <typename, typename, typename, typename>
+  friend struct DomainwiseFunctionTransform;
+
+  using IsLastTransform = std::integral_constant<bool, NEXT_DMN_INDEX == -1>;
+
+  // Transforms the last remaining domain directly into f_output.
+  // The unique_ptr owns f_input, if f_input is an intermediate result.
+  template <typename scalartype_input, typename scalartype_output, typename... Args>
+  static void executeOnAll(std::true_type,
+                           const func::function<scalartype_input, domain_input>& f_input,
+                           std::unique_ptr<func::function<scalartype_input, domain_input>>,
+                           func::function<scalartype_output, domain_output>& f_output,
+                           Args&... args) {
+    assert(f_input.size() / f_input[CURR_DMN_INDEX] * f_output[CURR_DMN_INDEX] == f_output.size());
+    transformCurrent(f_input, f_output, args...);
+  }
 
-      assert(f_output_new.size() == f_output.size());
+  // Transforms the current domain into a new intermediate function, releases the input of this
+  // step and continues with the next domain.
+  template <typename scalartype_input, typename scalartype_output, typename... Args>
+  static void executeOnAll(std::false_type,
+                           const func::function<scalartype_input, domain_input>& f_input,
+                           std::unique_ptr<func::function<scalartype_input, domain_input>> storage,
+                           func::function<scalartype_output, domain_output>& f_output,
+                           Args&... args) {
+    using NextTransform =
+        DomainwiseFunctionTransform<TRANSFORMED_DOMAIN, domain_output, type_input, type_output>;
+
+    std::unique_ptr<func::function<scalartype_output, TRANSFORMED_DOMAIN>> f_next(
+        new func::function<scalartype_output, TRANSFORMED_DOMAIN>("f_output_new"));
+
+    transformCurrent(f_input, *f_next, args...);
+    storage.reset();
+
+    const auto& f_next_ref = *f_next;
+    NextTransform::executeOnAll(typename NextTransform::IsLastTransform(), f_next_ref,
+                                std::move(f_next), f_output, args...);
+  }
 
-      for (int l = 0; l < f_output.size(); l++)
-        f_output(l) = f_output_new(l);
+  template <typename scalartype_input, class dmn_input, typename scalartype_output,
+            class dmn_output>
+  static void transformCurrent(const func::function<scalartype_input, dmn_input>& f_input,
+                               func::function<scalartype_output, dmn_output>& f_output) {
+    assert(CURR_DMN_INDEX > -1 and CURR_DMN_INDEX < f_input.signature());
 
-      if (VERBOSE) {
-        f_output.print_fingerprint();
+    TRANSFORM_DOMAIN<type_input, DMN_REP_LHS, type_output, DMN_REP_RHS, CURR_DMN_INDEX>::execute(
+        f_input, f_output);
+  }
 
-        std::cout << "\n\n\tSTOP\t finished the copy\n\n\n" << std::endl;
-      }
-    }
-    else {
-      if (VERBOSE) {
-        std::cout << "\n\n\tSTART\t" << __FUNCTION__ << std::endl;
+  template <typename scalartype_input, class dmn_input, typename scalartype_output,
+            class dmn_output, typename scalartype_T>
+  static void transformCurrent(const func::function<scalartype_input, dmn_input>& f_input,
+                               func::function<scalartype_output, dmn_output>& f_output,
+                               const linalg::Matrix<scalartype_T, linalg::CPU>& T) {
+    assert(CURR_DMN_INDEX > -1 and CURR_DMN_INDEX < f_input.signature());
+
+    TRANSFORM_DOMAIN_PROCEDURE<CURR_DMN_INDEX>::transform(f_input, f_output, T);
+  }
 
-        f_output_new.print_fingerprint();
-      }
+  template <typename scalartype_input, class dmn_input, typename scalartype_output,
+            class dmn_output, typename scalartype_T, class Threading>
+  static void transformCurrent(const func::function<scalartype_input, dmn_input>& f_input,
+                               func::function<scalartype_output, dmn_output>& f_output,
+                               const linalg::Matrix<scalartype_T, linalg::CPU>& T,
+                               Threading& threading, const int n_threads) {
+    assert(CURR_DMN_INDEX > -1 and CURR_DMN_INDEX < f_input.signature());
 
-      DomainwiseFunctionTransform<TRANSFORMED_DOMAIN, domain_output, type_input, type_output>::execute_on_all(
-          f_output_new, f_output, T);
-    }
+    TRANSFORM_DOMAIN_PROCEDURE<CURR_DMN_INDEX>::transform(f_input, f_output, T, threading,
+                                                          n_threads);
   }
 };
 
@@ -65,6 +65,24 @@ public:
         f_input, f_output, T);
   }
 
+  // Same as above, with the matrix products distributed among n_threads threads of type Threading.
+  template <typename scalartype_input, class domain_input, typename scalartype_output,
+            class domain_output, typename scalartype_T, class Threading>
+  static void execute(const func::function<scalartype_input, domain_input>& f_input,
+                      func::function<scalartype_output, domain_output>& f_output,
+                      const linalg::Matrix<scalartype_T, linalg::CPU>& T, Threading threading,
+                      const int n_threads) {
+    if (VERBOSE)
+      print_types(f_input, f_output);
+
+    using TRANSFORMED_DOMAIN =
+        typename dca::func::SWAP_FIRST<domain_input, type_input, type_output>::Result;
+    dca::util::assert_same<TRANSFORMED_DOMAIN, domain_output>();
+
+    DomainwiseFunctionTransform<domain_input, domain_output, type_input, type_output>::execute_on_first(
+        f_input, f_output, T, threading, n_threads);
+  }
+
   template <typename scalartype_input, class domain_input, typename scalartype_output, class domain_output>
   static void execute_on_all(const func::function<scalartype_input, domain_input>& f_input,
                              func::function<scalartype_output, domain_output>& f_output) {
@@ -97,6 +115,26 @@ public:
         f_input, f_output, T);
   }
 
+  // Same as above, with the matrix products of each transformation distributed among n_threads
+  // threads of type Threading.
+  template <typename scalartype_input, class domain_input, typename scalartype_output,
+            class domain_output, typename scalartype_T, class Threading>
+  static void execute_on_all(const func::function<scalartype_input, domain_input>& f_input,
+                             func::function<scalartype_output, domain_output>& f_output,
+                             const linalg::Matrix<scalartype_T, linalg::CPU>& T,
+                             Threading threading, const int n_threads) {
+    if (VERBOSE)
+      print_types(f_input, f_output);
+
+    using TRANSFORMED_DOMAIN =
+        typename dca::func::SWAP_ALL<domain_input, type_input, type_output>::Result;
+
+    dca::util::assert_same<TRANSFORMED_DOMAIN, domain_output>();
+
+    DomainwiseFunctionTransform<domain_input, domain_output, type_input, type_output>::execute_on_all(
+        f_input, f_output, T, threading, n_threads);
+  }
+
 private:
   template <typename scalartype_input, class domain_input, typename scalartype_output, class domain_output>
   static void print_types(const func::function<scalartype_input, domain_input>& f_input,
@@ -0,0 +1,246 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class transforms functions between the Legendre basis and the Matsubara frequency and
+// imaginary time domains. The transformation matrices are computed once; each transform is a
+// single matrix-matrix multiplication over the last domain of the function.
+// Matsubara frequency <- Legendre:
+//     G(i w) = \sum_l T(w, l) G_l,   T(w, l) = \sqrt(2l+1) e^{iz} i^l j_l(z),   z = w beta / 2,
+// where j_l is the spherical Bessel function of the first kind.
+// Legendre <- Matsubara frequency: least-squares fit on the frequencies of WDmn, which are used as
+// sampling points.
+//
+// Template parameters:
+// LegendreDmn: func::dmn_0<phys::domains::LegendreDomain>.
+// WDmn: func::dmn_0 of a fermionic Matsubara frequency domain.
+
+#ifndef DCA_MATH_FUNCTION_TRANSFORM_LEGENDRE_TRANSFORM_HPP
+#define DCA_MATH_FUNCTION_TRANSFORM_LEGENDRE_TRANSFORM_HPP
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "dca/function/function.hpp"
+#include "dca/linalg/blas/blas3.hpp"
+#include "dca/linalg/lapack/lapack.hpp"
+
+namespace dca {
+namespace math {
+namespace transform {
+// dca::math::transform::
+
+template <typename LegendreDmn, typename WDmn>
+class LegendreTransform {
+public:
+  using Complex = std::complex<double>;
+
+  // Transforms the last domain of f_l, LegendreDmn, to WDmn, the last domain of f_w. The leading
+  // domains of f_l and f_w must agree.
+  template <typename Scalar, typename DmnL, typename DmnW>
+  static void legendreToMatsubara(const func::function<Scalar, DmnL>& f_l,
+                                  func::function<Complex, DmnW>& f_w);
+
+  // Fits the Legendre coefficients f_l to the values of f_w on the Matsubara frequencies of WDmn.
+  template <typename DmnW, typename DmnL>
+  static void matsubaraToLegendre(const func::function<Complex, DmnW>& f_w,
+                                  func::function<Complex, DmnL>& f_l);
+
+  // Evaluates f_l on the imaginary times of TDmn, the last domain of f_t.
+  template <typename TDmn, typename Scalar, typename DmnL, typename DmnT>
+  static void legendreToTime(const func::function<Scalar, DmnL>& f_l,
+                             func::function<Scalar, DmnT>& f_t);
+
+  // Returns the column major matrix T(w, l).
+  static const std::vector<Complex>& get_matsubara_matrix();
+
+  // Returns the column major matrix F(l, w) of the least-squares fit.
+  static const std::vector<Complex>& get_fit_matrix();
+
+  // Stores in j the spherical Bessel functions j_0(z), ..., j_l_max(z).
+  static void sphericalBessel(int l_max, double z, std::vector<double>& j);
+
+private:
+  // Computes out(i, b) = \sum_a in(i, a) m(b, a), where m is an (size_b x size_a) matrix.
+  template <typename Scalar>
+  static void multiplyLastIndex(const Scalar* in, int size_a, const Scalar* m, int size_b,
+                                Scalar* out, int leading_size);
+};
+
+template <typename LegendreDmn, typename WDmn>
+template <typename Scalar, typename DmnL, typename DmnW>
+void LegendreTransform<LegendreDmn, WDmn>::legendreToMatsubara(
+    const func::function<Scalar, DmnL>& f_l, func::function<Complex, DmnW>& f_w) {
+  const int n_l = LegendreDmn::dmn_size();
+  const int n_w = WDmn::dmn_size();
+  const int leading_size = f_l.size() / n_l;
+  if (leading_size * n_l != f_l.size() || leading_size * n_w != f_w.size())
+    throw(std::logic_error("The leading domains do not match."));
+
+  std::vector<Complex> f_l_complex(f_l.values(), f_l.values() + f_l.size());
+  multiplyLastIndex(f_l_complex.data(), n_l, get_matsubara_matrix().data(), n_w, f_w.values(),
+                    leading_size);
+}
+
+template <typename LegendreDmn, typename WDmn>
+template <typename DmnW, typename DmnL>
+void LegendreTransform<LegendreDmn, WDmn>::matsubaraToLegendre(
+    const func::function<Complex, DmnW>& f_w, func::function<Complex, DmnL>& f_l) {
+  const int n_l = LegendreDmn::dmn_size();
+  const int n_w = WDmn::dmn_size();
+  const int leading_size = f_l.size() / n_l;
+  if (leading_size * n_l != f_l.size() || leading_size * n_w != f_w.size())
+    throw(std::logic_error("The leading domains do not match."));
+
+  multiplyLastIndex(f_w.values(), n_w, get_fit_matrix().data(), n_l, f_l.values(), leading_size);
+}
+
+template <typename LegendreDmn, typename WDmn>
+template <typename TDmn, typename Scalar, typename DmnL, typename DmnT>
+void LegendreTransform<LegendreDmn, WDmn>::legendreToTime(const func::function<Scalar, DmnL>& f_l,
+                                                          func::function<Scalar, DmnT>& f_t) {
+  using LegendreDomain = typename LegendreDmn::parameter_type;
+  const int n_l = LegendreDmn::dmn_size();
+  const int n_t = TDmn::dmn_size();
+  const int leading_size = f_l.size() / n_l;
+  if (leading_size * n_l != f_l.size() || leading_size * n_t != f_t.size())
+    throw(std::logic_error("The leading domains do not match."));
+
+  const double beta = LegendreDomain::get_beta();
+  std::vector<Scalar> matrix(n_t * n_l);
+  std::vector<double> values;
+  for (int t = 0; t < n_t; ++t) {
+    LegendreDomain::evaluate(TDmn::get_elements()[t], values);
+    for (int l = 0; l < n_l; ++l)
+      matrix[t + n_t * l] = values[l] / beta;
+  }
+
+  multiplyLastIndex(f_l.values(), n_l, matrix.data(), n_t, f_t.values(), leading_size);
+}
+
+template <typename LegendreDmn, typename WDmn>
+const std::vector<std::complex<double>>& LegendreTransform<LegendreDmn, WDmn>::get_matsubara_matrix() {
+  static const std::vector<Complex> matrix = [] {
+    const int n_l = LegendreDmn::dmn_size();
+    const int n_w = WDmn::dmn_size();
+    const double beta = LegendreDmn::parameter_type::get_beta();
+
+    std::vector<Complex> t(n_w * n_l);
+    std::vector<double> j;
+    for (int w = 0; w < n_w; ++w) {
+      const double z = WDmn::get_elements()[w] * beta / 2.;
+      sphericalBessel(n_l - 1, z, j);
+
+      Complex phase = std::exp(Complex(0., z));  // e^{iz} i^l
+      for (int l = 0; l < n_l; ++l) {
+        t[w + n_w * l] = std::sqrt(2. * l + 1.) * phase * j[l];
+        phase *= Complex(0., 1.);
+      }
+    }
+    return t;
+  }();
+
+  return matrix;
+}
+
+template <typename LegendreDmn, typename WDmn>
+const std::vector<std::complex<double>>& LegendreTransform<LegendreDmn, WDmn>::get_fit_matrix() {
+  static const std::vector<Complex> matrix = [] {
+    const int n_l = LegendreDmn::dmn_size();
+    const int n_w = WDmn::dmn_size();
+    if (n_w < n_l)
+      throw(std::logic_error("Not enough Matsubara frequencies to fit the Legendre coefficients."));
+
+    const std::vector<Complex>& t = get_matsubara_matrix();
+
+    // F = (T^H T)^{-1} T^H.
+    std::vector<Complex> normal(n_l * n_l);
+    linalg::blas::gemm("C", "N", n_l, n_l, n_w, Complex(1.), t.data(), n_w, t.data(), n_w,
+                       Complex(0.), normal.data(), n_l);
+
+    std::vector<Complex> fit(n_l * n_w);
+    for (int w = 0; w < n_w; ++w)
+      for (int l = 0; l < n_l; ++l)
+        fit[l + n_l * w] = std::conj(t[w + n_w * l]);
+
+    std::vector<int> ipiv(n_l);
+    linalg::lapack::gesv(n_l, n_w, normal.data(), n_l, ipiv.data(), fit.data(), n_l);
+    return fit;
+  }();
+
+  return matrix;
+}
+
+template <typename LegendreDmn, typename WDmn>
+void LegendreTransform<LegendreDmn, WDmn>::sphericalBessel(const int l_max, double z,
+                                                         std::vector<double>& j) {
+  j.assign(l_max + 1, 0.);
+
+  // j_l(-z) = (-1)^l j_l(z).
+  const double parity = z < 0 ? -1. : 1.;
+  z = std::abs(z);
+
+  if (z == 0.) {
+    j[0] = 1.;
+    return;
+  }
+
+  const double j0 = std::sin(z) / z;
+  const double j1 = std::sin(z) / (z * z) - std::cos(z) / z;
+
+  if (z > l_max) {
+    // The upward recurrence is stable for l < z.
+    j[0] = j0;
+    if (l_max > 0)
+      j[1] = j1;
+    for (int l = 1; l < l_max; ++l)
+      j[l + 1] = (2 * l + 1) / z * j[l] - j[l - 1];
+  }
+  else {
+    // Miller's downward recurrence, normalized with j_0 or j_1.
+    const int l_start = l_max + 16 + static_cast<int>(std::sqrt(40. * (l_max + 1)));
+    double j_next = 0.;
+    double j_curr = 1.e-30;
+    for (int l = l_start; l > 0; --l) {
+      const double j_prev = (2 * l + 1) / z * j_curr - j_next;
+      j_next = j_curr;
+      j_curr = j_prev;
+      if (l - 1 <= l_max)
+        j[l - 1] = j_curr;
+      if (std::abs(j_curr) > 1.e200) {
+        j_curr *= 1.e-200;
+        j_next *= 1.e-200;
+        for (int l2 = l - 1; l2 <= l_max; ++l2)
+          j[l2] *= 1.e-200;
+      }
+    }
+
+    const double norm = std::abs(j0) > std::abs(j1) ? j0 / j[0] : j1 / j[1];
+    for (double& val : j)
+      val *= norm;
+  }
+
+  if (parity < 0)
+    for (int l = 1; l <= l_max; l += 2)
+      j[l] = -j[l];
+}
+
+template <typename LegendreDmn, typename WDmn>
+template <typename Scalar>
+void LegendreTransform<LegendreDmn, WDmn>::multiplyLastIndex(const Scalar* in, const int size_a,
+                                                             const Scalar* m, const int size_b,
+                                                             Scalar* out, const int leading_size) {
+  linalg::blas::gemm("N", "T", leading_size, size_b, size_a, Scalar(1.), in, leading_size, m,
+                     size_b, Scalar(0.), out, leading_size);
+}
+
+}  // transform
+}  // math
+}  // dca
+
+#endif  // DCA_MATH_FUNCTION_TRANSFORM_LEGENDRE_TRANSFORM_HPP
@@ -12,6 +12,8 @@
 #ifndef DCA_MATH_FUNCTION_TRANSFORM_TRANSFORM_DOMAIN_PROCEDURE_HPP
 #define DCA_MATH_FUNCTION_TRANSFORM_TRANSFORM_DOMAIN_PROCEDURE_HPP
 
+#include <algorithm>
+
 #include "dca/function/function.hpp"
 #include "dca/linalg/linalg.hpp"
 
@@ -67,6 +69,24 @@ public:
   static void transform(const func::function<std::complex<scalartype>, domain_input>& f_input,
                         func::function<scalartype, domain_output>& f_output,
                         const linalg::Matrix<std::complex<scalartype>, linalg::CPU>& T);
+
+  // Threaded versions: the independent matrix products over the domains following DMN_INDEX are
+  // distributed among n_threads threads, using threading.execute.
+  template <typename scalartype, class domain_input, class domain_output, class Threading>
+  static void transform(const func::function<scalartype, domain_input>& f_input,
+                        func::function<scalartype, domain_output>& f_output,
+                        const linalg::Matrix<scalartype, linalg::CPU>& T, Threading& threading,
+                        int n_threads);
+
+  // Mixed scalar types are transformed serially.
+  template <typename scalartype_1, class domain_input, typename scalartype_2, class domain_output,
+            typename scalartype_3, class Threading>
+  static void transform(const func::function<scalartype_1, domain_input>& f_input,
+                        func::function<scalartype_2, domain_output>& f_output,
+                        const linalg::Matrix<scalartype_3, linalg::CPU>& T,
+                        Threading& /*threading*/, int /*n_threads*/) {
+    transform(f_input, f_output, T);
+  }
 };
 
 template <int DMN_INDEX>
@@ -115,6 +135,41 @@ void TRANSFORM_DOMAIN_PROCEDURE<DMN_INDEX>::transform(
   }
 }
 
+template <int DMN_INDEX>
+template <typename scalartype, class domain_input, class domain_output, class Threading>
+void TRANSFORM_DOMAIN_PROCEDURE<DMN_INDEX>::transform(
+    const func::function<scalartype, domain_input>& f_input,
+    func::function<scalartype, domain_output>& f_output,
+    const linalg::Matrix<scalartype, linalg::CPU>& T, Threading& threading, int n_threads) {
+  int M, K, N, P;
+  characterize_transformation(f_input, f_output, M, K, N, P);
+
+  n_threads = std::min(n_threads, P);
+  if (n_threads <= 1) {
+    transform(f_input, f_output, T);
+    return;
+  }
+
+  threading.execute(n_threads, [&](int id, int n_threads) {
+    const int l_start = (static_cast<long>(P) * id) / n_threads;
+    const int l_end = (static_cast<long>(P) * (id + 1)) / n_threads;
+
+    const scalartype alpha(1);
+    const scalartype beta(0);
+
+    if (M == 1) {
+      linalg::blas::gemm("N", "N", T.size().first, l_end - l_start, T.size().second, alpha,
+                         &T(0, 0), T.leadingDimension(), &f_input(K * l_start), K, beta,
+                         &f_output(N * l_start), N);
+    }
+    else {
+      for (int l = l_start; l < l_end; l++)
+        linalg::blas::gemm("N", "T", M, N, K, alpha, &f_input(M * K * l), M, &T(0, 0),
+                           T.leadingDimension(), beta, &f_output(M * N * l), M);
+    }
+  });
+}
+
 template <int DMN_INDEX>
 template <typename scalartype, class domain_input, class domain_output>
 void TRANSFORM_DOMAIN_PROCEDURE<DMN_INDEX>::transform(
@@ -16,11 +16,13 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
+#include "dca/linalg/blas/blas3.hpp"
 #include "dca/linalg/matrix.hpp"
 #include "dca/linalg/matrixop.hpp"
 
@@ -55,9 +57,46 @@ public:
   void findShift(const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& source_interpolated,
                  func::function<double, OtherDmn>& shift);
 
+  // Restricts the deconvolution to the OtherDmn indices in [bounds.first, bounds.second), e.g. to
+  // distribute the independent columns amongst processes. The target function is not written
+  // outside of this range.
+  void setColumnBounds(const std::pair<int, int>& bounds) {
+    assert(bounds.first >= 0 && bounds.first <= bounds.second &&
+           bounds.second <= OtherDmn::dmn_size());
+    column_bounds_ = bounds;
+  }
+
+  // If true, findTargetFunction starts the iteration from the target function passed to it instead
+  // of a flat function, e.g. from the result of the previous DCA iteration. Columns of the target
+  // function that cannot be used as initial guess, because after the shift they are not strictly
+  // of the sign of the source, still start from the flat function.
+  void setWarmStart(const bool warm_start) {
+    warm_start_ = warm_start;
+  }
+
+  // Additionally stops the iteration of a column when the relative change of its L2 error between
+  // two iterations drops below 'tolerance'. Zero (default) disables this stopping rule.
+  void setStagnationTolerance(const double tolerance) {
+    assert(tolerance >= 0.);
+    stagnation_tolerance_ = tolerance;
+  }
+
 private:
+  // Computes c[:, begin:end) = op(a) * b[:, begin:end).
+  void multiplyColumns(char transa, const linalg::Matrix<double, linalg::CPU>& a,
+                       const linalg::Matrix<double, linalg::CPU>& b,
+                       linalg::Matrix<double, linalg::CPU>& c) const;
+
+  int columnsBegin() const {
+    return column_bounds_.first;
+  }
+  int columnsEnd() const {
+    return column_bounds_.second < 0 ? OtherDmn::dmn_size() : column_bounds_.second;
+  }
+
   void initializeMatrices(
-      const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& source_interpolated);
+      const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& source_interpolated,
+      const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& initial_guess);
 
   bool finished(const func::function<double, func::dmn_variadic<ClusterDmn, OtherDmn>>& source,
                 func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& target);
@@ -80,6 +119,13 @@ private:
   func::function<double, OtherDmn> shift_;
   func::function<bool, OtherDmn> is_finished_;
   func::function<double, OtherDmn> error_;
+  func::function<double, OtherDmn> previous_error_;
+
+  // Default: all columns.
+  std::pair<int, int> column_bounds_ = std::make_pair(0, -1);
+
+  bool warm_start_ = false;
+  double stagnation_tolerance_ = 0.;
 };
 
 template <typename ClusterDmn, typename HostDmn, typename OtherDmn>
@@ -107,7 +153,8 @@ RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::RichardsonLucyDeconv
 
       shift_("shift"),
       is_finished_("is_finished"),
-      error_("error") {
+      error_("error"),
+      previous_error_("previous-error") {
   if (p_host_.size().first != HostDmn::dmn_size() || p_host_.size().second != HostDmn::dmn_size() ||
       p_cluster_.size().first != ClusterDmn::dmn_size() ||
       p_cluster_.size().second != HostDmn::dmn_size())
@@ -121,24 +168,28 @@ std::pair<int, double> RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn
     func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& target, bool verbose) {
   is_finished_.reset();
   error_.reset();
+  previous_error_ = std::numeric_limits<double>::max();
 
   findShift(source_interpolated, shift_);
-  initializeMatrices(source_interpolated);
+  initializeMatrices(source_interpolated, target);
+
+  const int begin = columnsBegin();
+  const int end = columnsEnd();
 
   int iterations = 0;
   while (!finished(source, target) && iterations < max_iterations_) {
     // Compute c.
-    linalg::matrixop::gemm(p_host_, u_t_, c_);
+    multiplyColumns('N', p_host_, u_t_, c_);
 
     // Compute d_over_c.
-    for (int j = 0; j < OtherDmn::dmn_size(); ++j)
+    for (int j = begin; j < end; ++j)
       for (int i = 0; i < HostDmn::dmn_size(); ++i)
         d_over_c_(i, j) = d_(i, j) / c_(i, j);
 
     // Compute u_{t+1}.
-    linalg::matrixop::gemm('T', 'N', p_host_, d_over_c_, u_t_plus_1_);
+    multiplyColumns('T', p_host_, d_over_c_, u_t_plus_1_);
 
-    for (int j = 0; j < OtherDmn::dmn_size(); ++j)
+    for (int j = begin; j < end; ++j)
       for (int i = 0; i < HostDmn::dmn_size(); ++i)
         u_t_(i, j) = u_t_plus_1_(i, j) * u_t_(i, j);
 
@@ -147,11 +198,12 @@ std::pair<int, double> RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn
 
   // Copy iterative solution into returned target function for all OtherDmn indices that have not
   // finished.
-  for (int j = 0; j < OtherDmn::dmn_size(); ++j)
+  for (int j = begin; j < end; ++j)
     if (!is_finished_(j))
       for (int i = 0; i < HostDmn::dmn_size(); ++i)
         target(i, j) = u_t_(i, j) - shift_(j);
 
+  // error_ vanishes outside of the column bounds.
   double max_error = error_(0);
   for (int j = 1; j < OtherDmn::dmn_size(); ++j)
     max_error = std::max(max_error, error_(j));
@@ -176,13 +228,13 @@ std::pair<int, double> RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn
 
   // Compute the convolution of the target function, which should resemble the interpolated source
   // function.
-  for (int j = 0; j < OtherDmn::dmn_size(); j++)
+  for (int j = columnsBegin(); j < columnsEnd(); j++)
     for (int i = 0; i < HostDmn::dmn_size(); i++)
       u_t_(i, j) = target(i, j);
 
-  linalg::matrixop::gemm(p_host_, u_t_, c_);
+  multiplyColumns('N', p_host_, u_t_, c_);
 
-  for (int j = 0; j < OtherDmn::dmn_size(); j++)
+  for (int j = columnsBegin(); j < columnsEnd(); j++)
     for (int i = 0; i < HostDmn::dmn_size(); i++)
       target_convoluted(i, j) = c_(i, j);
 
@@ -229,7 +281,8 @@ void RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::findShift(
 
 template <typename ClusterDmn, typename HostDmn, typename OtherDmn>
 void RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::initializeMatrices(
-    const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& source_interpolated) {
+    const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& source_interpolated,
+    const func::function<double, func::dmn_variadic<HostDmn, OtherDmn>>& initial_guess) {
   const int num_rows_host = HostDmn::dmn_size();
   const int num_rows_cluster = ClusterDmn::dmn_size();
   const int num_cols = OtherDmn::dmn_size();
@@ -256,8 +309,14 @@ void RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::initializeMatri
       mean += d_(i, j);
     mean /= num_rows_host;
 
+    // The multiplicative updates preserve the sign of u_t, which has to be the sign of d.
+    bool use_initial_guess = warm_start_;
+    for (int i = 0; i < num_rows_host && use_initial_guess; ++i)
+      use_initial_guess = (initial_guess(i, j) + shift_(j)) * mean > 0.;
+
     for (int i = 0; i < num_rows_host; ++i)
-      u_t_(i, j) = mean / std::abs(mean);  // Used to be: u_t_(i,j) = mean.
+      u_t_(i, j) = use_initial_guess ? initial_guess(i, j) + shift_(j)
+                                     : mean / std::abs(mean);  // Used to be: u_t_(i,j) = mean.
   }
 
   // Initialize the other matrices with zero.
@@ -270,6 +329,22 @@ void RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::initializeMatri
       c_cluster_(i, j) = 0.;
 }
 
+template <typename ClusterDmn, typename HostDmn, typename OtherDmn>
+void RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::multiplyColumns(
+    const char transa, const linalg::Matrix<double, linalg::CPU>& a,
+    const linalg::Matrix<double, linalg::CPU>& b, linalg::Matrix<double, linalg::CPU>& c) const {
+  const int n_cols = columnsEnd() - columnsBegin();
+  if (n_cols == 0)
+    return;
+
+  const int k = transa == 'N' ? a.nrCols() : a.nrRows();
+  assert(k == b.nrRows() && c.nrRows() == (transa == 'N' ? a.nrRows() : a.nrCols()));
+
+  linalg::blas::gemm(&transa, "N", c.nrRows(), n_cols, k, 1., a.ptr(), a.leadingDimension(),
+                     b.ptr(0, columnsBegin()), b.leadingDimension(), 0., c.ptr(0, columnsBegin()),
+                     c.leadingDimension());
+}
+
 template <typename ClusterDmn, typename HostDmn, typename OtherDmn>
 bool RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::finished(
     const func::function<double, func::dmn_variadic<ClusterDmn, OtherDmn>>& source,
@@ -278,15 +353,15 @@ bool RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::finished(
 
   // Convolute iterative solution (without shift) to cluster domain and compare with original
   // source.
-  for (int j = 0; j < OtherDmn::dmn_size(); ++j) {
+  for (int j = columnsBegin(); j < columnsEnd(); ++j) {
     for (int i = 0; i < HostDmn::dmn_size(); ++i) {
       u_t_no_shift_(i, j) = u_t_(i, j) - shift_(j);
     }
   }
 
-  linalg::matrixop::gemm(p_cluster_, u_t_no_shift_, c_cluster_);
+  multiplyColumns('N', p_cluster_, u_t_no_shift_, c_cluster_);
 
-  for (int j = 0; j < OtherDmn::dmn_size(); ++j) {
+  for (int j = columnsBegin(); j < columnsEnd(); ++j) {
     if (!is_finished_(j)) {
       // Compute relative L2 error.
       double diff_squared = 0.;
@@ -299,7 +374,11 @@ bool RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>::finished(
 
       error_(j) = std::sqrt(diff_squared / norm_source_squared);
 
-      if (error_(j) < tolerance_) {
+      const bool stagnated =
+          std::abs(previous_error_(j) - error_(j)) < stagnation_tolerance_ * error_(j);
+      previous_error_(j) = error_(j);
+
+      if (error_(j) < tolerance_ || stagnated) {
         // Copy iterative solution into returned target function.
         for (int i = 0; i < HostDmn::dmn_size(); ++i)
           target(i, j) = u_t_(i, j) - shift_(j);
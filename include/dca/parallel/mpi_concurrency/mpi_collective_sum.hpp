@@ -12,10 +12,17 @@
 //
 // This class provides an interface to do collective sums and averages with MPI.
 // In addition, it can compute the covariance for func::function.
+// Large sums can optionally be performed hierarchically, first within each shared memory node and
+// then across the nodes (see MPINodeGrouping).
+// The operations on func::function are streamed: the reductions are performed in chunks of bounded
+// size, such that no temporary copy of the whole function is needed.
 
 #ifndef DCA_PARALLEL_MPI_CONCURRENCY_MPI_COLLECTIVE_SUM_HPP
 #define DCA_PARALLEL_MPI_CONCURRENCY_MPI_COLLECTIVE_SUM_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <map>
 #include <string>
 #include <utility>  // std::move, std::swap
@@ -27,6 +34,7 @@
 #include "dca/function/function.hpp"
 #include "dca/linalg/matrix.hpp"
 #include "dca/linalg/vector.hpp"
+#include "dca/parallel/mpi_concurrency/mpi_node_grouping.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_processor_grouping.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_type_map.hpp"
 
@@ -34,10 +42,24 @@ namespace dca {
 namespace parallel {
 // dca::parallel::
 
-class MPICollectiveSum : public virtual MPIProcessorGrouping {
+class MPICollectiveSum : public virtual MPIProcessorGrouping, public MPINodeGrouping {
 public:
   MPICollectiveSum() = default;
 
+  // Collective. Enables or disables the hierarchical summation of buffers of at least 'min_size'
+  // bytes. 'buffer_size' is the amount of shared memory, per node, used to stage the partial sums.
+  // See MPINodeGrouping::initializeNodeGrouping for 'max_node_size'.
+  void setHierarchicalSum(bool enable, std::size_t min_size = 1 << 20,
+                          std::size_t buffer_size = 1 << 25, int max_node_size = 0);
+  bool hierarchicalSumEnabled() const {
+    return hierarchical_sum_;
+  }
+
+  // Sets the maximum size in bytes of the chunks in which functions are reduced.
+  void setStreamingChunkSize(std::size_t chunk_size) {
+    streaming_chunk_size_ = std::max<std::size_t>(1, chunk_size);
+  }
+
   template <typename scalar_type>
   void sum(scalar_type& value) const;
   template <typename scalar_type>
@@ -61,12 +83,11 @@ public:
   template <typename some_type>
   void sum_and_average(const some_type& in, some_type& out, int nr_meas_rank = 1) const;
 
+  // Averages f_mean over all ranks and stores in f_stddev the standard deviation of the mean.
+  // For std::complex, real and imaginary parts are treated independently.
   template <typename scalar_type, class domain>
   void average_and_compute_stddev(func::function<scalar_type, domain>& f_mean,
                                   func::function<scalar_type, domain>& f_stddev) const;
-  template <typename scalar_type, class domain>
-  void average_and_compute_stddev(func::function<std::complex<scalar_type>, domain>& f_mean,
-                                  func::function<std::complex<scalar_type>, domain>& f_stddev) const;
 
   // Computes the sum of s over all ranks excluding the local value and stores the result back
   // in s.
@@ -96,14 +117,10 @@ public:
   // Preconditions: Each rank holds a unique precomputed jackknife estimate f_i.
   // Postconditions: If overwrite == true, the jackknife estimate f_i is overwritten with the
   //                 average f_avg; else f_i stays unchanged.
+  // For std::complex, real and imaginary parts are treated independently.
   template <typename Scalar, class Domain>
   func::function<Scalar, Domain> jackknifeError(func::function<Scalar, Domain>& f_i,
                                                 bool overwrite = true) const;
-  // Implementation for std::complex.
-  // Real and imaginary parts are treated independently.
-  template <typename Scalar, class Domain>
-  func::function<std::complex<Scalar>, Domain> jackknifeError(
-      func::function<std::complex<Scalar>, Domain>& f_i, bool overwrite = true) const;
 
   // Computes the covariance matrix of the measurements of the different mpi ranks.
   // In: f, f_estimated
@@ -138,8 +155,77 @@ public:
   template <typename Scalar, class Domain>
   std::vector<Scalar> avgNormalizedMomenta(const func::function<Scalar, Domain>& f,
                                            const std::vector<int>& orders) const;
+
+private:
+  // Sums the n elements of 'in' over all ranks and stores the result in 'out'.
+  template <typename Scalar>
+  void allreduceSum(const Scalar* in, Scalar* out, std::size_t n) const;
+
+  // Sums a buffer of n elements over all ranks, one chunk at a time.
+  // For each chunk, compute(start, size, local) must write the local values of the elements
+  // [start, start + size) into 'local'. Then store(start, size, local, sum) is called with their
+  // local and summed values. 'local' can be used as scratch space by 'store'.
+  template <typename Scalar, class Compute, class Store>
+  void chunkedSum(std::size_t n, Compute&& compute, Store&& store) const;
+
+  template <typename Scalar>
+  static Scalar squareComponents(Scalar x) {
+    return x * x;
+  }
+  template <typename Scalar>
+  static std::complex<Scalar> squareComponents(std::complex<Scalar> x) {
+    return std::complex<Scalar>(x.real() * x.real(), x.imag() * x.imag());
+  }
+  template <typename Scalar>
+  static Scalar sqrtComponents(Scalar x) {
+    return std::sqrt(x);
+  }
+  template <typename Scalar>
+  static std::complex<Scalar> sqrtComponents(std::complex<Scalar> x) {
+    return std::complex<Scalar>(std::sqrt(x.real()), std::sqrt(x.imag()));
+  }
+
+  bool hierarchical_sum_ = false;
+  std::size_t hierarchical_sum_min_size_ = 0;
+  std::size_t streaming_chunk_size_ = 1 << 23;
 };
 
+inline void MPICollectiveSum::setHierarchicalSum(const bool enable, const std::size_t min_size,
+                                                 const std::size_t buffer_size,
+                                                 const int max_node_size) {
+  if (enable)
+    initializeNodeGrouping(buffer_size, max_node_size);
+  else
+    finalizeNodeGrouping();
+
+  // Nothing can be gained if every process runs on a separate node.
+  hierarchical_sum_ = enable && hasSharedMemoryNodes();
+  hierarchical_sum_min_size_ = min_size;
+}
+
+template <typename Scalar>
+void MPICollectiveSum::allreduceSum(const Scalar* in, Scalar* out, const std::size_t n) const {
+  if (hierarchical_sum_ && n * sizeof(Scalar) >= hierarchical_sum_min_size_)
+    hierarchicalSum(in, out, n);
+  else
+    MPI_Allreduce(in, out, MPITypeMap<Scalar>::factor() * n, MPITypeMap<Scalar>::value(), MPI_SUM,
+                  MPIProcessorGrouping::get());
+}
+
+template <typename Scalar, class Compute, class Store>
+void MPICollectiveSum::chunkedSum(const std::size_t n, Compute&& compute, Store&& store) const {
+  const std::size_t chunk = std::max<std::size_t>(1, streaming_chunk_size_ / sizeof(Scalar));
+  std::vector<Scalar> local(std::min(chunk, n));
+  std::vector<Scalar> sum(local.size());
+
+  for (std::size_t start = 0; start < n; start += chunk) {
+    const std::size_t size = std::min(chunk, n - start);
+    compute(start, size, local.data());
+    allreduceSum(local.data(), sum.data(), size);
+    store(start, size, local.data(), sum.data());
+  }
+}
+
 template <typename scalar_type>
 void MPICollectiveSum::sum(scalar_type& value) const {
   scalar_type result;
@@ -154,8 +240,7 @@ template <typename scalar_type>
 void MPICollectiveSum::sum(std::vector<scalar_type>& m) const {
   std::vector<scalar_type> result(m.size(), scalar_type(0));
 
-  MPI_Allreduce(&(m[0]), &(result[0]), MPITypeMap<scalar_type>::factor() * m.size(),
-                MPITypeMap<scalar_type>::value(), MPI_SUM, MPIProcessorGrouping::get());
+  allreduceSum(m.data(), result.data(), m.size());
 
   m = std::move(result);
 }
@@ -181,12 +266,15 @@ void MPICollectiveSum::sum(std::map<std::string, std::vector<scalar_type>>& m) c
 
 template <typename scalar_type, class domain>
 void MPICollectiveSum::sum(func::function<scalar_type, domain>& f) const {
-  func::function<scalar_type, domain> f_sum;
-
-  MPI_Allreduce(f.values(), f_sum.values(), MPITypeMap<scalar_type>::factor() * f.size(),
-                MPITypeMap<scalar_type>::value(), MPI_SUM, MPIProcessorGrouping::get());
-
-  f = std::move(f_sum);
+  scalar_type* const values = f.values();
+  chunkedSum<scalar_type>(
+      f.size(),
+      [&](std::size_t start, std::size_t size, scalar_type* local) {
+        std::copy_n(values + start, size, local);
+      },
+      [&](std::size_t start, std::size_t size, scalar_type*, const scalar_type* sum) {
+        std::copy_n(sum, size, values + start);
+      });
 
 #ifndef NDEBUG
   for (int i = 0; i < f.size(); ++i) {
@@ -200,8 +288,7 @@ void MPICollectiveSum::sum(func::function<scalar_type, domain>& f) const {
 template <typename scalar_type, class domain>
 void MPICollectiveSum::sum(const func::function<scalar_type, domain>& f_in,
                            func::function<scalar_type, domain>& f_out) const {
-  MPI_Allreduce(f_in.values(), f_out.values(), MPITypeMap<scalar_type>::factor() * f_in.size(),
-                MPITypeMap<scalar_type>::value(), MPI_SUM, MPIProcessorGrouping::get());
+  allreduceSum(f_in.values(), f_out.values(), f_in.size());
 }
 
 template <typename scalar_type, class domain>
@@ -226,8 +313,7 @@ template <typename scalar_type>
 void MPICollectiveSum::sum(linalg::Vector<scalar_type, linalg::CPU>& vec) const {
   linalg::Vector<scalar_type, linalg::CPU> vec_sum("vec_sum", vec.size());
 
-  MPI_Allreduce(&vec[0], &vec_sum[0], MPITypeMap<scalar_type>::factor() * vec.size(),
-                MPITypeMap<scalar_type>::value(), MPI_SUM, MPIProcessorGrouping::get());
+  allreduceSum(vec.ptr(), vec_sum.ptr(), vec.size());
 
   vec = vec_sum;
 
@@ -248,8 +334,7 @@ void MPICollectiveSum::sum(linalg::Matrix<scalar_type, linalg::CPU>& f) const {
   int Nr = f.capacity().first;
   int Nc = f.capacity().second;
 
-  MPI_Allreduce(&f(0, 0), &F(0, 0), MPITypeMap<scalar_type>::factor() * Nr * Nc,
-                MPITypeMap<scalar_type>::value(), MPI_SUM, MPIProcessorGrouping::get());
+  allreduceSum(f.ptr(), F.ptr(), std::size_t(Nr) * Nc);
 
   for (int j = 0; j < F.size().second; j++)
     for (int i = 0; i < F.size().first; i++)
@@ -290,11 +375,16 @@ void MPICollectiveSum::leaveOneOutSum(func::function<Scalar, Domain>& f) const {
   if (MPIProcessorGrouping::get_size() == 1)
     return;
 
-  const func::function<Scalar, Domain> f_local(f);
-  sum(f_local, f);
-
-  for (int i = 0; i < f.size(); ++i)
-    f(i) = f(i) - f_local(i);
+  Scalar* const values = f.values();
+  chunkedSum<Scalar>(
+      f.size(),
+      [&](std::size_t start, std::size_t size, Scalar* local) {
+        std::copy_n(values + start, size, local);
+      },
+      [&](std::size_t start, std::size_t size, const Scalar* local, const Scalar* sum) {
+        for (std::size_t i = 0; i < size; ++i)
+          values[start + i] = sum[i] - local[i];
+      });
 }
 
 template <typename T>
@@ -307,7 +397,7 @@ void MPICollectiveSum::leaveOneOutAvg(T& x) const {
 }
 
 template <typename Scalar, class Domain>
-func::function<Scalar, Domain> MPICollectiveSum::jackknifeError(func::function<Scalar, Domain> &f_i,
+func::function<Scalar, Domain> MPICollectiveSum::jackknifeError(func::function<Scalar, Domain>& f_i,
                                                                 const bool overwrite) const {
   func::function<Scalar, Domain> err("jackknife-error");
 
@@ -316,53 +406,30 @@ func::function<Scalar, Domain> MPICollectiveSum::jackknifeError(func::function<S
   if (n == 1)  // No jackknife procedure possible.
     return err;
 
-  func::function<Scalar, Domain> f_avg("f_avg");
-  sum_and_average(f_i, f_avg);
-
-  for (int k = 0; k < f_avg.size(); ++k)
-    err(k) = (f_i(k) - f_avg(k)) * (f_i(k) - f_avg(k));
-
-  sum(err);
-
-  const double scale = double(n - 1) / double(n);
-  for (int k = 0; k < err.size(); ++k)
-    err(k) = std::sqrt(scale * err(k));
-
-  if (overwrite)
-    f_i = std::move(f_avg);
-
-  return err;
-}
-
-template <typename Scalar, class Domain>
-func::function<std::complex<Scalar>, Domain> MPICollectiveSum::jackknifeError(
-    func::function<std::complex<Scalar>, Domain>& f_i, const bool overwrite) const {
-  func::function<std::complex<Scalar>, Domain> err("jackknife-error");
-
-  const int n = MPIProcessorGrouping::get_size();
-
-  if (n == 1)  // No jackknife procedure possible.
-    return err;
-
-  func::function<std::complex<Scalar>, Domain> f_avg("f_avg");
-  sum_and_average(f_i, f_avg);
-
-  for (int k = 0; k < f_avg.size(); ++k) {
-    const auto diff = f_i(k) - f_avg(k);
-    err(k).real(diff.real() * diff.real());
-    err(k).imag(diff.imag() * diff.imag());
-  }
-
-  sum(err);
-
-  const double scale = double(n - 1) / double(n);
-  for (int k = 0; k < err.size(); ++k) {
-    err(k).real(std::sqrt(scale * err(k).real()));
-    err(k).imag(std::sqrt(scale * err(k).imag()));
-  }
-
-  if (overwrite)
-    f_i = std::move(f_avg);
+  using Real = decltype(std::real(Scalar()));
+  const Real scale = Real(n - 1) / Real(n);
+  Scalar* const values = f_i.values();
+  Scalar* const err_values = err.values();
+
+  chunkedSum<Scalar>(
+      f_i.size(),
+      [&](std::size_t start, std::size_t size, Scalar* local) {
+        std::copy_n(values + start, size, local);
+      },
+      [&](std::size_t start, std::size_t size, Scalar* local, const Scalar* sum) {
+        // Reuse the local chunk to store the squared deviations from the average.
+        for (std::size_t i = 0; i < size; ++i) {
+          const Scalar avg = sum[i] / Real(n);
+          local[i] = squareComponents(local[i] - avg);
+          if (overwrite)
+            values[start + i] = avg;
+        }
+
+        allreduceSum(local, err_values + start, size);
+
+        for (std::size_t i = 0; i < size; ++i)
+          err_values[start + i] = sqrtComponents(scale * err_values[start + i]);
+      });
 
   return err;
 }
@@ -370,73 +437,51 @@ func::function<std::complex<Scalar>, Domain> MPICollectiveSum::jackknifeError(
 template <typename scalar_type, class domain>
 void MPICollectiveSum::average_and_compute_stddev(func::function<scalar_type, domain>& f_mean,
                                                   func::function<scalar_type, domain>& f_stddev) const {
-  scalar_type factor = 1. / MPIProcessorGrouping::get_size();
-
-  func::function<scalar_type, domain> f_sum("f-sum");
-  func::function<scalar_type, domain> f_diff("f-diff");
-
-  sum(f_mean, f_sum);
-
-  f_sum *= factor;
-
-  for (int i = 0; i < f_sum.size(); i++)
-    f_diff(i) = (f_mean(i) - f_sum(i)) * (f_mean(i) - f_sum(i));
-
-  for (int i = 0; i < f_sum.size(); i++)
-    f_mean(i) = f_sum(i);
-
-  sum(f_diff, f_stddev);
-
-  f_stddev *= factor;
-
-  for (int i = 0; i < f_sum.size(); i++)
-    f_stddev(i) = std::sqrt(f_stddev(i));
-
-  f_stddev /= std::sqrt(MPIProcessorGrouping::get_size());
-}
-
-template <typename scalar_type, class domain>
-void MPICollectiveSum::average_and_compute_stddev(
-    func::function<std::complex<scalar_type>, domain>& f_mean,
-    func::function<std::complex<scalar_type>, domain>& f_stddev) const {
-  scalar_type factor = 1. / MPIProcessorGrouping::get_size();
-
-  func::function<std::complex<scalar_type>, domain> f_sum("f-sum");
-  func::function<std::complex<scalar_type>, domain> f_diff("f-diff");
-
-  sum(f_mean, f_sum);
-
-  f_sum *= factor;
-
-  for (int i = 0; i < f_sum.size(); i++) {
-    f_diff(i).real(real(f_mean(i) - f_sum(i)) * real(f_mean(i) - f_sum(i)));
-    f_diff(i).imag(imag(f_mean(i) - f_sum(i)) * imag(f_mean(i) - f_sum(i)));
-  }
-
-  for (int i = 0; i < f_sum.size(); i++)
-    f_mean(i) = f_sum(i);
-
-  sum(f_diff, f_stddev);
-
-  f_stddev *= factor;
-
-  for (int i = 0; i < f_sum.size(); i++) {
-    f_stddev(i).real(std::sqrt(real(f_stddev(i))));
-    f_stddev(i).imag(std::sqrt(imag(f_stddev(i))));
-  }
-
-  f_stddev /= std::sqrt(MPIProcessorGrouping::get_size());
+  using Real = decltype(std::real(scalar_type()));
+  const Real n = MPIProcessorGrouping::get_size();
+  scalar_type* const mean_values = f_mean.values();
+  scalar_type* const stddev_values = f_stddev.values();
+
+  // Each rank holds a single sample, hence the mean and the variance are computed chunk by chunk
+  // with the two-pass formula.
+  chunkedSum<scalar_type>(
+      f_mean.size(),
+      [&](std::size_t start, std::size_t size, scalar_type* local) {
+        std::copy_n(mean_values + start, size, local);
+      },
+      [&](std::size_t start, std::size_t size, scalar_type* local, const scalar_type* sum) {
+        for (std::size_t i = 0; i < size; ++i) {
+          mean_values[start + i] = sum[i] / n;
+          local[i] = squareComponents(local[i] - mean_values[start + i]);
+        }
+
+        allreduceSum(local, stddev_values + start, size);
+
+        for (std::size_t i = 0; i < size; ++i)
+          stddev_values[start + i] = sqrtComponents(stddev_values[start + i] / n) / std::sqrt(n);
+      });
 }
 
 template <typename Scalar, class Domain>
 void MPICollectiveSum::computeCovariance(
     const func::function<Scalar, Domain>& f, const func::function<Scalar, Domain>& f_estimated,
     func::function<Scalar, func::dmn_variadic<Domain, Domain>>& cov) const {
-  for (int i = 0; i < f.size(); i++)
-    for (int j = 0; j < f.size(); j++)
-      cov(i, j) = (f(i) - f_estimated(i)) * (f(j) - f_estimated(j));
-
-  sum_and_average(cov, 1);
+  const std::size_t n = f.size();
+  const double n_ranks = MPIProcessorGrouping::get_size();
+
+  chunkedSum<Scalar>(
+      cov.size(),
+      [&](std::size_t start, std::size_t size, Scalar* local) {
+        for (std::size_t l = start; l < start + size; ++l) {
+          const std::size_t i = l % n;
+          const std::size_t j = l / n;
+          local[l - start] = (f(i) - f_estimated(i)) * (f(j) - f_estimated(j));
+        }
+      },
+      [&](std::size_t start, std::size_t size, Scalar*, const Scalar* sum) {
+        for (std::size_t i = 0; i < size; ++i)
+          cov(start + i) = sum[i] / n_ranks;
+      });
 }
 
 template <typename Scalar, class Domain, class CovDomain>
@@ -445,25 +490,24 @@ void MPICollectiveSum::computeCovariance(const func::function<std::complex<Scala
                                          func::function<Scalar, CovDomain>& cov) const {
   assert(4 * f.size() * f.size() == cov.size());
 
-  // Treat real and imaginary parts as independent entries
-  for (int i = 0; i < f.size(); i++)
-    for (int j = 0; j < f.size(); j++) {
-      // Real - Real
-      cov(i, j) = (f(i).real() - f_estimated(i).real()) * (f(j).real() - f_estimated(j).real());
-
-      // Imaginary - Imaginary
-      cov(i + f.size(), j + f.size()) =
-          (f(i).imag() - f_estimated(i).imag()) * (f(j).imag() - f_estimated(j).imag());
-
-      // Real - Imaginary
-      cov(i, j + f.size()) =
-          (f(i).real() - f_estimated(i).real()) * (f(j).imag() - f_estimated(j).imag());
-
-      // Imaginary - Real
-      cov(i + f.size(), j) =
-          (f(i).imag() - f_estimated(i).imag()) * (f(j).real() - f_estimated(j).imag());
-    }
-  sum_and_average(cov, 1);
+  const std::size_t n = f.size();
+  const double n_ranks = MPIProcessorGrouping::get_size();
+
+  // Treat real and imaginary parts as independent entries.
+  auto deviation = [&](const std::size_t i) {
+    return i < n ? f(i).real() - f_estimated(i).real() : f(i - n).imag() - f_estimated(i - n).imag();
+  };
+
+  chunkedSum<Scalar>(
+      cov.size(),
+      [&](std::size_t start, std::size_t size, Scalar* local) {
+        for (std::size_t l = start; l < start + size; ++l)
+          local[l - start] = deviation(l % (2 * n)) * deviation(l / (2 * n));
+      },
+      [&](std::size_t start, std::size_t size, Scalar*, const Scalar* sum) {
+        for (std::size_t i = 0; i < size; ++i)
+          cov(start + i) = sum[i] / n_ranks;
+      });
 }
 
 template <typename ScalarOrComplex, typename Scalar, class Domain, class CovDomain>
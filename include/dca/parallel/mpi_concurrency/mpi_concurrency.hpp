@@ -24,6 +24,7 @@
 #include "dca/parallel/mpi_concurrency/mpi_collective_max.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_collective_min.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_collective_sum.hpp"
+#include "dca/parallel/mpi_concurrency/mpi_global_counter.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_initializer.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_packing.hpp"
 #include "dca/parallel/mpi_concurrency/mpi_processor_grouping.hpp"
@@ -38,7 +39,8 @@ class MPIConcurrency final : public virtual MPIInitializer,
                              public MPIPacking,
                              public MPICollectiveMax,
                              public MPICollectiveMin,
-                             public MPICollectiveSum {
+                             public MPICollectiveSum,
+                             public MPIGlobalCounter {
 public:
   MPIConcurrency(int argc, char** argv);
 
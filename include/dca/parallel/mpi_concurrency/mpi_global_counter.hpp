@@ -0,0 +1,50 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class provides a counter shared by all the processes of the grouping. It is stored in an
+// MPI-3 window on the first rank and incremented with one-sided atomics (MPI_Fetch_and_op), so that
+// the processes can claim work without any synchronization with each other.
+
+#ifndef DCA_PARALLEL_MPI_CONCURRENCY_MPI_GLOBAL_COUNTER_HPP
+#define DCA_PARALLEL_MPI_CONCURRENCY_MPI_GLOBAL_COUNTER_HPP
+
+#include <mpi.h>
+
+#include "dca/parallel/mpi_concurrency/mpi_processor_grouping.hpp"
+
+namespace dca {
+namespace parallel {
+// dca::parallel::
+
+class MPIGlobalCounter : public virtual MPIProcessorGrouping {
+public:
+  // Collectively allocates the window holding the counter and sets the counter to zero.
+  MPIGlobalCounter();
+  // Collectively frees the window.
+  ~MPIGlobalCounter();
+
+  MPIGlobalCounter(const MPIGlobalCounter&) = delete;
+  MPIGlobalCounter& operator=(const MPIGlobalCounter&) = delete;
+
+  // Collectively sets the counter to zero. No process must access the counter concurrently.
+  void resetGlobalCounter() const;
+
+  // Atomically adds 'increment' to the counter and returns its previous value.
+  // Not collective.
+  long long globalCounterFetchAdd(long long increment) const;
+
+private:
+  static constexpr int root_ = 0;
+
+  MPI_Win window_ = MPI_WIN_NULL;
+  long long* counter_ = nullptr;
+};
+
+}  // parallel
+}  // dca
+
+#endif  // DCA_PARALLEL_MPI_CONCURRENCY_MPI_GLOBAL_COUNTER_HPP
@@ -0,0 +1,150 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class groups the processes that share memory (i.e. run on the same node) and provides a
+// two-level all-reduce: the buffers are first reduced within each node through an MPI-3 shared
+// memory window, then only the node leaders take part in the inter-node all-reduce, which is
+// pipelined over fixed-size chunks. Finally the result is read back from shared memory by all the
+// processes of the node.
+
+#ifndef DCA_PARALLEL_MPI_CONCURRENCY_MPI_NODE_GROUPING_HPP
+#define DCA_PARALLEL_MPI_CONCURRENCY_MPI_NODE_GROUPING_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include <mpi.h>
+
+#include "dca/parallel/mpi_concurrency/mpi_processor_grouping.hpp"
+#include "dca/parallel/mpi_concurrency/mpi_type_map.hpp"
+
+namespace dca {
+namespace parallel {
+// dca::parallel::
+
+class MPINodeGrouping : public virtual MPIProcessorGrouping {
+public:
+  MPINodeGrouping() = default;
+  ~MPINodeGrouping();
+
+  MPINodeGrouping(const MPINodeGrouping&) = delete;
+  MPINodeGrouping& operator=(const MPINodeGrouping&) = delete;
+
+  // Collectively creates the node and the leader communicators, and the shared window of
+  // 'buffer_size' bytes per node used by hierarchicalSum.
+  // If max_node_size > 0, the processes sharing memory are further split into groups of at most
+  // max_node_size processes, e.g. to match the NUMA domains.
+  void initializeNodeGrouping(std::size_t buffer_size, int max_node_size = 0);
+  // Collectively frees the resources allocated by initializeNodeGrouping.
+  void finalizeNodeGrouping();
+
+  bool nodeGroupingInitialized() const {
+    return node_comm_ != MPI_COMM_NULL;
+  }
+  // Returns true if at least one node contains more than one process.
+  bool hasSharedMemoryNodes() const {
+    return max_node_size_ > 1;
+  }
+
+  int get_node_id() const {
+    return node_id_;
+  }
+  int get_node_size() const {
+    return node_size_;
+  }
+  int get_number_of_nodes() const {
+    return number_of_nodes_;
+  }
+
+  // Sums the n elements of 'in' over all the processes and stores the result in 'out'.
+  // 'in' and 'out' can alias.
+  // Precondition: initializeNodeGrouping has been called.
+  template <typename Scalar>
+  void hierarchicalSum(const Scalar* in, Scalar* out, std::size_t n) const;
+
+private:
+  bool isNodeLeader() const {
+    return node_id_ == 0;
+  }
+  void nodeBarrier() const;
+
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+  MPI_Comm leaders_comm_ = MPI_COMM_NULL;
+  MPI_Win window_ = MPI_WIN_NULL;
+  char* shared_buffer_ = nullptr;
+  std::size_t buffer_size_ = 0;
+
+  int node_id_ = -1;
+  int node_size_ = -1;
+  int max_node_size_ = -1;
+  int number_of_nodes_ = -1;
+};
+
+template <typename Scalar>
+void MPINodeGrouping::hierarchicalSum(const Scalar* in, Scalar* out, const std::size_t n) const {
+  assert(nodeGroupingInitialized());
+
+  // The shared buffer is split in two halves, such that the reduction of the next chunk within the
+  // node can overlap with the inter-node reduction of the current one. Each half contains one
+  // slot per process of the node. The chunk size must agree between all the nodes, hence it is
+  // determined by the largest one.
+  const std::size_t chunk =
+      std::max<std::size_t>(1, buffer_size_ / (2 * max_node_size_ * sizeof(Scalar)));
+  assert(2 * max_node_size_ * chunk * sizeof(Scalar) <= buffer_size_);
+  Scalar* const buffer = reinterpret_cast<Scalar*>(shared_buffer_);
+  auto slot = [&](const int half, const int id) { return buffer + (half * node_size_ + id) * chunk; };
+
+  const std::size_t n_chunks = (n + chunk - 1) / chunk;
+  auto chunk_size = [&](const std::size_t c) { return std::min(chunk, n - c * chunk); };
+
+  MPI_Request requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+
+  auto finish_chunk = [&](const std::size_t c) {
+    const int half = c % 2;
+    if (isNodeLeader())
+      MPI_Wait(&requests[half], MPI_STATUS_IGNORE);
+    nodeBarrier();
+    std::copy_n(slot(half, 0), chunk_size(c), out + c * chunk);
+    // Do not overwrite the result until everyone has read it.
+    nodeBarrier();
+  };
+
+  for (std::size_t c = 0; c < n_chunks; ++c) {
+    const int half = c % 2;
+    const std::size_t size = chunk_size(c);
+
+    std::copy_n(in + c * chunk, size, slot(half, node_id_));
+    nodeBarrier();
+
+    // Each process reduces its own slice of the chunk into the slot of the leader.
+    const std::size_t start = size * node_id_ / node_size_;
+    const std::size_t end = size * (node_id_ + 1) / node_size_;
+    Scalar* const result = slot(half, 0);
+    for (int id = 1; id < node_size_; ++id) {
+      const Scalar* const contribution = slot(half, id);
+      for (std::size_t i = start; i < end; ++i)
+        result[i] += contribution[i];
+    }
+    nodeBarrier();
+
+    if (isNodeLeader() && number_of_nodes_ > 1)
+      MPI_Iallreduce(MPI_IN_PLACE, result, MPITypeMap<Scalar>::factor() * size,
+                     MPITypeMap<Scalar>::value(), MPI_SUM, leaders_comm_, &requests[half]);
+
+    if (c > 0)
+      finish_chunk(c - 1);
+  }
+
+  if (n_chunks > 0)
+    finish_chunk(n_chunks - 1);
+}
+
+}  // parallel
+}  // dca
+
+#endif  // DCA_PARALLEL_MPI_CONCURRENCY_MPI_NODE_GROUPING_HPP
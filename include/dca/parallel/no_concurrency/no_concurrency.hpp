@@ -15,12 +15,13 @@
 
 #include <utility>
 #include "dca/parallel/no_concurrency/serial_collective_sum.hpp"
+#include "dca/parallel/no_concurrency/serial_global_counter.hpp"
 
 namespace dca {
 namespace parallel {
 // dca::parallel::
 
-class NoConcurrency : public SerialCollectiveSum {
+class NoConcurrency : public SerialCollectiveSum, public SerialGlobalCounter {
 public:
   NoConcurrency(int /*argc*/, char** /*argv*/){};
 
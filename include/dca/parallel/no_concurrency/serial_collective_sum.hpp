@@ -31,6 +31,8 @@ namespace parallel {
 
 class SerialCollectiveSum {
 public:
+  void setHierarchicalSum(bool /*enable*/) {}
+
   template <typename Scalar>
   void sum(Scalar&) const {}
   template <typename Scalar>
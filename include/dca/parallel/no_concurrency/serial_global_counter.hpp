@@ -0,0 +1,36 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class is the equivalent of MPIGlobalCounter for serial execution.
+
+#ifndef DCA_PARALLEL_NO_CONCURRENCY_SERIAL_GLOBAL_COUNTER_HPP
+#define DCA_PARALLEL_NO_CONCURRENCY_SERIAL_GLOBAL_COUNTER_HPP
+
+namespace dca {
+namespace parallel {
+// dca::parallel::
+
+class SerialGlobalCounter {
+public:
+  void resetGlobalCounter() const {
+    counter_ = 0;
+  }
+
+  long long globalCounterFetchAdd(const long long increment) const {
+    const long long previous = counter_;
+    counter_ += increment;
+    return previous;
+  }
+
+private:
+  mutable long long counter_ = 0;
+};
+
+}  // parallel
+}  // dca
+
+#endif  // DCA_PARALLEL_NO_CONCURRENCY_SERIAL_GLOBAL_COUNTER_HPP
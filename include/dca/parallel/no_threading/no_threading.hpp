@@ -38,7 +38,7 @@ public:
     ReturnType result = 0;
 
     for (int id = 0; id < num_threads; ++id)
-      result += f(id, 1, args...);
+      result += f(id, num_threads, args...);
 
     return result;
   }
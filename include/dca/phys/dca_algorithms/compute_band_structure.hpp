@@ -85,22 +85,29 @@ void compute_band_structure::execute(const ParametersType& parameters,
       "H_k");
   ParametersType::lattice_type::initialize_H_0(parameters, H_k);
 
-  // Compute the bands.
-  dca::linalg::Vector<double, dca::linalg::CPU> L_vec(nu::dmn_size());
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> H_mat(nu::dmn_size());
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> V_mat(nu::dmn_size());
-
-  for (int l = 0; l < int(collection_k_vecs.size()); l++) {
-    for (int i = 0; i < nu::dmn_size(); i++)
-      for (int j = 0; j < nu::dmn_size(); j++)
-        H_mat(i, j) = H_k(i, j, l);
-
-    dca::linalg::matrixop::eigensolverHermitian('N', 'U', H_mat, L_vec, V_mat);
-
-    for (int i = 0; i < b::dmn_size(); i++)
-      for (int j = 0; j < s::dmn_size(); j++)
-        band_structure(i, j, l) = L_vec[2 * i + j];
-  }
+  // Compute the bands. The k-points are distributed amongst the threads.
+  const int n_k = collection_k_vecs.size();
+  typename ParametersType::ThreadingType().execute(
+      parameters.get_coarsegraining_threads(), [&](const int id, const int n_threads) {
+        dca::linalg::Vector<double, dca::linalg::CPU> L_vec(nu::dmn_size());
+        dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> H_mat(nu::dmn_size());
+        dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> V_mat(nu::dmn_size());
+
+        const int start = (long(n_k) * id) / n_threads;
+        const int end = (long(n_k) * (id + 1)) / n_threads;
+
+        for (int l = start; l < end; l++) {
+          for (int i = 0; i < nu::dmn_size(); i++)
+            for (int j = 0; j < nu::dmn_size(); j++)
+              H_mat(i, j) = H_k(i, j, l);
+
+          dca::linalg::matrixop::eigensolverHermitian('N', 'U', H_mat, L_vec, V_mat);
+
+          for (int i = 0; i < b::dmn_size(); i++)
+            for (int j = 0; j < s::dmn_size(); j++)
+              band_structure(i, j, l) = L_vec[2 * i + j];
+        }
+      });
 }
 
 template <int lattice_dimension>
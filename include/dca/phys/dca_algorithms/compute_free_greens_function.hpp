@@ -12,12 +12,19 @@
 #ifndef DCA_PHYS_DCA_ALGORITHMS_COMPUTE_FREE_GREENS_FUNCTION_HPP
 #define DCA_PHYS_DCA_ALGORITHMS_COMPUTE_FREE_GREENS_FUNCTION_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/phys/dca_algorithms/compute_greens_function.hpp"
-#include "dca/phys/dca_step/cluster_mapping/coarsegraining/quadrature_integration.hpp"
+#include "dca/linalg/linalg.hpp"
+#include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 
 namespace dca {
 namespace phys {
@@ -25,65 +32,182 @@ namespace phys {
 
 // Computes the free Matsubara Green's function G_0(\vec{k}, i\omega_n) from the non-interacting
 // Hamiltonian H_0(\vec{k}).
+// The (k, w) points are distributed amongst the processes and n_threads threads of 'threading'.
 template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename MatsubaraFreqDmn,
-          typename ConcurrencyType>
+          typename ConcurrencyType, typename Threading>
 void compute_G0_k_w(
     const func::function<std::complex<Scalar>,
                          func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
     const Scalar mu, const ConcurrencyType& concurrency,
     func::function<std::complex<Scalar>,
-                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn, MatsubaraFreqDmn>>& G0_k_w) {
+                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                      MatsubaraFreqDmn>>& G0_k_w,
+    Threading threading, const int n_threads) {
   // Call compute_G_k_w with vanishing self-energy.
   const func::function<std::complex<Scalar>,
                        func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn, MatsubaraFreqDmn>>
       zero;
-  compute_G_k_w(H0_k, zero, mu, concurrency, G0_k_w);
+  compute_G_k_w(H0_k, zero, mu, concurrency, G0_k_w, threading, n_threads);
+}
+
+// Serial version.
+template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename MatsubaraFreqDmn,
+          typename ConcurrencyType>
+void compute_G0_k_w(
+    const func::function<std::complex<Scalar>,
+                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
+    const Scalar mu, const ConcurrencyType& concurrency,
+    func::function<std::complex<Scalar>,
+                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                      MatsubaraFreqDmn>>& G0_k_w) {
+  compute_G0_k_w(H0_k, mu, concurrency, G0_k_w, parallel::NoThreading(), 1);
 }
 
 // Computes the free imaginary time Green's function G_0(\vec{k}, \tau) from the non-interacting
 // Hamiltonian H_0(\vec{k}).
-template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename ImagTimeDmn>
+// H_0(\vec{k}) - \mu is diagonalized only once per k-point. The (k, tau) points are distributed
+// amongst the processes and, within each process, amongst n_threads threads of 'threading'.
+template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename ImagTimeDmn,
+          typename ConcurrencyType, typename Threading>
 void compute_G0_k_t(
     const func::function<std::complex<Scalar>,
                          func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
-    const Scalar mu, const Scalar beta,
-    func::function<Scalar, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn, ImagTimeDmn>>& G0_k_t) {
-  // Diagonal \mu function.
-  func::function<std::complex<Scalar>, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>> mu_function;
-  for (int k = 0; k < KDmn::dmn_size(); ++k) {
-    for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m) {
-      mu_function(m, m, k) = mu;
-    }
+    const Scalar mu, const Scalar beta, const ConcurrencyType& concurrency,
+    func::function<Scalar, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                              ImagTimeDmn>>& G0_k_t,
+    Threading threading, const int n_threads) {
+  const int n = OrbitalSpinDmn::dmn_size();
+  const int n_k = KDmn::dmn_size();
+
+  // Distribute the work amongst the processes.
+  const func::dmn_variadic<KDmn, ImagTimeDmn> k_t_dmn_obj;
+  const std::pair<int, int> bounds = concurrency.get_bounds(k_t_dmn_obj);
+
+  // Only the k-points of this process need to be diagonalized.
+  std::vector<int> k_indices;
+  if (bounds.second - bounds.first >= n_k) {
+    for (int k = 0; k < n_k; ++k)
+      k_indices.push_back(k);
+  }
+  else {
+    for (int l = bounds.first; l < bounds.second; ++l)
+      k_indices.push_back(l % n_k);
+    std::sort(k_indices.begin(), k_indices.end());
   }
 
-  // Helper function to store the result for fixed time.
-  func::function<std::complex<Scalar>, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>> g;
+  // Eigenvalues and eigenvectors of H_0(\vec{k}) - \mu, and the \tau-independent denominators
+  // 1 + exp(-|\epsilon| \beta).
+  func::function<Scalar, func::dmn_variadic<OrbitalSpinDmn, KDmn>> eigenvalues;
+  func::function<Scalar, func::dmn_variadic<OrbitalSpinDmn, KDmn>> denominators;
+  func::function<std::complex<Scalar>, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>
+      eigenvectors;
 
-  for (int t = 0; t < ImagTimeDmn::dmn_size(); ++t) {
-    Scalar tau = ImagTimeDmn::get_elements()[t];
-    Scalar sign = -1;  // quadrature_integration_G_q_t_st requires Scalar.
+  auto split = [](const int size, const int id, const int n_threads) {
+    return std::make_pair(int((long(size) * id) / n_threads),
+                          int((long(size) * (id + 1)) / n_threads));
+  };
 
-    // G_0(\tau) = -G_0(\tau+\beta)
-    if (tau < 0) {
-      tau += beta;
-      sign = 1;
+  threading.execute(n_threads, [&](const int id, const int n_threads) {
+    linalg::Matrix<std::complex<Scalar>, linalg::CPU> H_m("H_m", n);
+    linalg::Vector<Scalar, linalg::CPU> L("L", n);
+    linalg::Matrix<std::complex<Scalar>, linalg::CPU> V("V", n);
+
+    const auto k_bounds = split(k_indices.size(), id, n_threads);
+    for (int ind = k_bounds.first; ind < k_bounds.second; ++ind) {
+      const int k = k_indices[ind];
+
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+          H_m(i, j) = H0_k(i, j, k) - (i == j ? mu : Scalar(0));
+
+      linalg::matrixop::eigensolverGreensFunctionMatrix('V', 'U', H_m, L, V);
+
+      for (int l = 0; l < n; ++l) {
+        eigenvalues(l, k) = L[l];
+        denominators(l, k) = L[l] < 0 ? std::exp(L[l] * beta) + 1. : std::exp(-L[l] * beta) + 1.;
+        for (int i = 0; i < n; ++i)
+          eigenvectors(i, l, k) = V(i, l);
+      }
     }
+  });
 
-    g = 0.;
+  G0_k_t = 0.;
 
-    clustermapping::quadrature_integration<Scalar, KDmn, OrbitalSpinDmn>::quadrature_integration_G_q_t_st(
-        beta, sign, tau, mu_function, H0_k, g);
+  std::vector<char> is_complex(n_threads, false);
 
-    for (int k = 0; k < KDmn::dmn_size(); ++k) {
-      for (int n = 0; n < OrbitalSpinDmn::dmn_size(); ++n) {
-        for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m) {
-          if (g(m, n, k).imag() > 1.e-6)
-            throw std::logic_error("G_0(\vec{k}, \tau) is real!");
-          G0_k_t(m, n, k, t) = g(m, n, k).real();
+  threading.execute(n_threads, [&](const int id, const int n_threads) {
+    std::vector<Scalar> exponents(n);
+    std::vector<Scalar> G_t(n);
+
+    const auto l_bounds = split(bounds.second - bounds.first, id, n_threads);
+    int coor[2];
+
+    for (int l_ind = bounds.first + l_bounds.first; l_ind < bounds.first + l_bounds.second;
+         ++l_ind) {
+      k_t_dmn_obj.linind_2_subind(l_ind, coor);
+      const int k = coor[0];
+      const int t = coor[1];
+
+      Scalar tau = ImagTimeDmn::get_elements()[t];
+      Scalar sign = -1;
+
+      // G_0(\tau) = -G_0(\tau+\beta)
+      if (tau < 0) {
+        tau += beta;
+        sign = 1;
+      }
+
+      // Branch-free exponents, followed by a contiguous loop over the exponentials.
+      for (int l = 0; l < n; ++l) {
+        const Scalar e = eigenvalues(l, k);
+        exponents[l] = e < 0 ? e * (beta - tau) : -e * tau;
+      }
+      for (int l = 0; l < n; ++l)
+        G_t[l] = sign * std::exp(exponents[l]) / denominators(l, k);
+
+      for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+          std::complex<Scalar> g = 0.;
+          for (int l = 0; l < n; ++l)
+            g += eigenvectors(i, l, k) * G_t[l] * std::conj(eigenvectors(j, l, k));
+
+          if (g.imag() > 1.e-6)
+            is_complex[id] = true;
+          G0_k_t(i, j, k, t) = g.real();
         }
       }
     }
-  }
+  });
+
+  // Every process only checks its own part of G0_k_t. Reduce the error flags, such that either all
+  // processes throw or none, before any of them enters the sum of G0_k_t.
+  int complex_error = std::find(is_complex.begin(), is_complex.end(), true) != is_complex.end();
+  int nan_error = 0;
+  for (int l = 0; l < G0_k_t.size(); ++l)
+    if (std::isnan(G0_k_t(l)))
+      nan_error = 1;
+
+  concurrency.sum(complex_error);
+  concurrency.sum(nan_error);
+
+  if (complex_error)
+    throw std::logic_error("G_0(\vec{k}, \tau) is real!");
+  if (nan_error)
+    throw std::logic_error(__FUNCTION__);
+
+  concurrency.sum(G0_k_t);
+}
+
+// Serial version.
+template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename ImagTimeDmn>
+void compute_G0_k_t(
+    const func::function<std::complex<Scalar>,
+                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
+    const Scalar mu, const Scalar beta,
+    func::function<Scalar, func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                              ImagTimeDmn>>& G0_k_t) {
+  compute_G0_k_t(H0_k, mu, beta, parallel::NoConcurrency(0, nullptr), G0_k_t,
+                 parallel::NoThreading(), 1);
 }
 
 }  // phys
@@ -19,6 +19,7 @@
 #include "dca/function/function.hpp"
 #include "dca/linalg/matrix.hpp"
 #include "dca/linalg/matrixop.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 
 namespace dca {
 namespace phys {
@@ -28,55 +29,83 @@ namespace phys {
 // function G_0(\vec{k}, i\omega_n) = [i\omega_n + \mu - H_0(\vec{k})]^{-1} and the self-energy
 // \Sigma(\vec{k}, i\omega_n) via the Dyson equation,
 // G = [G_0^{-1} - \Sigma]^{-1}.
+// The (k, w) points are distributed amongst the processes and, within each process, amongst
+// n_threads threads of 'threading', each with its own work space.
 template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename MatsubaraFreqDmn,
-          typename ConcurrencyType>
+          typename ConcurrencyType, typename Threading>
 void compute_G_k_w(
     const func::function<std::complex<Scalar>,
                          func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
     const func::function<std::complex<Scalar>,
-                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn, MatsubaraFreqDmn>>& S_k_w,
+                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                            MatsubaraFreqDmn>>& S_k_w,
     const Scalar mu, const ConcurrencyType& concurrency,
     func::function<std::complex<Scalar>,
-                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn, MatsubaraFreqDmn>>& G_k_w) {
-  // Work space for inverse.
-  linalg::Matrix<std::complex<Scalar>, linalg::CPU> G_inv("G_inv", OrbitalSpinDmn::dmn_size());
-  linalg::Vector<int, linalg::CPU> ipiv;
-  linalg::Vector<std::complex<Scalar>, linalg::CPU> work;
-
-  const std::complex<Scalar> i(0., 1.);
-
+                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                      MatsubaraFreqDmn>>& G_k_w,
+    Threading threading, const int n_threads) {
   // Distribute the work amongst the processes.
   const func::dmn_variadic<KDmn, MatsubaraFreqDmn> k_w_dmn_obj;
   const std::pair<int, int> bounds = concurrency.get_bounds(k_w_dmn_obj);
-  int coor[2];
 
   G_k_w = 0.;
 
-  for (int l = bounds.first; l < bounds.second; ++l) {
-    k_w_dmn_obj.linind_2_subind(l, coor);
-    const auto k_ind = coor[0];
-    const auto w_ind = coor[1];
-    const auto w_val = MatsubaraFreqDmn::get_elements()[w_ind];
-
-    // Compute G^{-1} for fixed k-vector and Matsubara frequency.
-    for (int n = 0; n < OrbitalSpinDmn::dmn_size(); ++n) {
-      for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m) {
-        G_inv(m, n) = -H0_k(m, n, k_ind) - S_k_w(m, n, k_ind, w_ind);
-        if (m == n)
-          G_inv(m, n) += i * w_val + mu;
+  threading.execute(n_threads, [&](const int id, const int n_threads) {
+    // Distribute the work of the process amongst the threads.
+    const long n_points = bounds.second - bounds.first;
+    const int start = bounds.first + (n_points * id) / n_threads;
+    const int end = bounds.first + (n_points * (id + 1)) / n_threads;
+
+    // Work space for inverse.
+    linalg::Matrix<std::complex<Scalar>, linalg::CPU> G_inv("G_inv", OrbitalSpinDmn::dmn_size());
+    linalg::Vector<int, linalg::CPU> ipiv;
+    linalg::Vector<std::complex<Scalar>, linalg::CPU> work;
+
+    const std::complex<Scalar> i(0., 1.);
+    int coor[2];
+
+    for (int l = start; l < end; ++l) {
+      k_w_dmn_obj.linind_2_subind(l, coor);
+      const auto k_ind = coor[0];
+      const auto w_ind = coor[1];
+      const auto w_val = MatsubaraFreqDmn::get_elements()[w_ind];
+
+      // Compute G^{-1} for fixed k-vector and Matsubara frequency.
+      for (int n = 0; n < OrbitalSpinDmn::dmn_size(); ++n) {
+        for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m) {
+          G_inv(m, n) = -H0_k(m, n, k_ind) - S_k_w(m, n, k_ind, w_ind);
+          if (m == n)
+            G_inv(m, n) += i * w_val + mu;
+        }
       }
-    }
 
-    linalg::matrixop::inverse(G_inv, ipiv, work);
+      linalg::matrixop::inverse(G_inv, ipiv, work);
 
-    for (int n = 0; n < OrbitalSpinDmn::dmn_size(); ++n)
-      for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m)
-        G_k_w(m, n, k_ind, w_ind) = G_inv(m, n);
-  }
+      for (int n = 0; n < OrbitalSpinDmn::dmn_size(); ++n)
+        for (int m = 0; m < OrbitalSpinDmn::dmn_size(); ++m)
+          G_k_w(m, n, k_ind, w_ind) = G_inv(m, n);
+    }
+  });
 
   concurrency.sum(G_k_w);
 }
 
+// Serial version.
+template <typename Scalar, typename OrbitalSpinDmn, typename KDmn, typename MatsubaraFreqDmn,
+          typename ConcurrencyType>
+void compute_G_k_w(
+    const func::function<std::complex<Scalar>,
+                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>& H0_k,
+    const func::function<std::complex<Scalar>,
+                         func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                            MatsubaraFreqDmn>>& S_k_w,
+    const Scalar mu, const ConcurrencyType& concurrency,
+    func::function<std::complex<Scalar>,
+                   func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                      MatsubaraFreqDmn>>& G_k_w) {
+  compute_G_k_w(H0_k, S_k_w, mu, concurrency, G_k_w, parallel::NoThreading(), 1);
+}
+
 }  // phys
 }  // dca
 
@@ -18,6 +18,7 @@
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
+#include "dca/phys/dca_analysis/bse_solver/compute_gamma_cluster.hpp"
 #include "dca/phys/dca_step/symmetrization/diagrammatic_symmetries.hpp"
 #include "dca/phys/dca_step/symmetrization/symmetrize.hpp"
 #include "dca/phys/domains/cluster/cluster_domain.hpp"
@@ -37,6 +38,7 @@ class BseClusterSolver {
 public:
   using profiler_t = typename ParametersType::profiler_type;
   using concurrency_t = typename ParametersType::concurrency_type;
+  using Threading = typename ParametersType::ThreadingType;
 
   using w = func::dmn_0<domains::frequency_domain>;
   using w_VERTEX = func::dmn_0<domains::vertex_frequency_domain<domains::COMPACT>>;
@@ -307,24 +309,13 @@ void BseClusterSolver<ParametersType, DcaDataType, ScalarType>::solve_BSE_on_clu
   if (concurrency.id() == concurrency.first())
     std::cout << "\t" << __FUNCTION__ << std::endl << std::endl;
 
-  ScalarType renorm = 1. / (parameters.get_beta() * k_DCA::dmn_size());
+  const ScalarType renorm = 1. / (parameters.get_beta() * k_DCA::dmn_size());
 
-  int N = cluster_eigenvector_dmn.get_size();
+  // G_II_0 is diagonal in (k, w), i.e. block diagonal with blocks of size b^2 x b^2.
+  const int block_size = b::dmn_size() * b::dmn_size();
 
-  dca::linalg::Matrix<std::complex<ScalarType>, dca::linalg::CPU> G4_inv(N);
-  dca::linalg::Matrix<std::complex<ScalarType>, dca::linalg::CPU> G4_0_inv(N);
-
-  G_II *= renorm;
-  dca::linalg::matrixop::copyArrayToMatrix(N, N, &G_II(0), N, G4_inv);
-  dca::linalg::matrixop::inverse(G4_inv);
-
-  G_II_0 *= renorm;
-  dca::linalg::matrixop::copyArrayToMatrix(N, N, &G_II_0(0), N, G4_0_inv);
-  dca::linalg::matrixop::inverse(G4_0_inv);
-
-  for (int j = 0; j < N; j++)
-    for (int i = 0; i < N; i++)
-      Gamma_cluster(i, j) = G4_0_inv(i, j) - G4_inv(i, j);
+  computeGammaCluster(G_II, G_II_0, renorm, block_size, Gamma_cluster, Threading(),
+                      parameters.get_coarsegraining_threads());
 }
 
 }  // analysis
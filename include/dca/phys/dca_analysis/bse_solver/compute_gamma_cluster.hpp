@@ -0,0 +1,91 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file provides the solution of the Bethe-Salpeter equation on the cluster,
+//     \Gamma = (c G_II_0)^{-1} - (c G_II)^{-1},
+// where the two-particle Green's functions G_II and G_II_0 are N x N matrices and c is a
+// normalization factor.
+
+#ifndef DCA_PHYS_DCA_ANALYSIS_BSE_SOLVER_COMPUTE_GAMMA_CLUSTER_HPP
+#define DCA_PHYS_DCA_ANALYSIS_BSE_SOLVER_COMPUTE_GAMMA_CLUSTER_HPP
+
+#include <algorithm>
+#include <complex>
+#include <utility>
+#include <vector>
+
+#include "dca/function/function.hpp"
+#include "dca/linalg/lapack/inverse.hpp"
+#include "dca/parallel/util/get_bounds.hpp"
+
+namespace dca {
+namespace phys {
+namespace analysis {
+// dca::phys::analysis::
+
+// Computes Gamma = (renorm G_II_0)^{-1} - (renorm G_II)^{-1}.
+// G_II_0 is usually block diagonal with blocks of size block_size x block_size, in which case it is
+// inverted block by block with n_threads threads of 'threading'. Otherwise it is inverted densely.
+// Out: G_II_0 is overwritten.
+template <typename Scalar, typename MatrixDmn, typename Threading>
+void computeGammaCluster(const func::function<std::complex<Scalar>, MatrixDmn>& G_II,
+                         func::function<std::complex<Scalar>, MatrixDmn>& G_II_0,
+                         const Scalar renorm, const int block_size,
+                         func::function<std::complex<Scalar>, MatrixDmn>& Gamma,
+                         Threading threading, const int n_threads) {
+  const int N = G_II.get_domain().get_branch_size(0);
+  const int n_blocks = N / block_size;
+
+  bool block_diagonal = N % block_size == 0;
+  for (int j = 0; j < N && block_diagonal; ++j)
+    for (int i = 0; i < N; ++i)
+      if (i / block_size != j / block_size && G_II_0(i, j) != std::complex<Scalar>(0)) {
+        block_diagonal = false;
+        break;
+      }
+
+  // The dense inversion of G_II is done in place in Gamma, using the blocked LU factorization of
+  // LAPACK.
+  Gamma = G_II;
+  Gamma *= renorm;
+  linalg::lapack::inverse(N, &Gamma(0), N);
+  for (int i = 0; i < Gamma.size(); ++i)
+    Gamma(i) = -Gamma(i);
+
+  G_II_0 *= renorm;
+
+  if (!block_diagonal) {
+    linalg::lapack::inverse(N, &G_II_0(0), N);
+    for (int i = 0; i < Gamma.size(); ++i)
+      Gamma(i) += G_II_0(i);
+    return;
+  }
+
+  threading.execute(std::min(n_threads, n_blocks), [&](int id, int n_threads) {
+    const auto bounds = parallel::util::getBounds(id, n_threads, std::make_pair(0, n_blocks));
+    std::vector<std::complex<Scalar>> block(block_size * block_size);
+
+    for (int l = bounds.first; l < bounds.second; ++l) {
+      const int offset = l * block_size;
+      for (int j = 0; j < block_size; ++j)
+        for (int i = 0; i < block_size; ++i)
+          block[i + block_size * j] = G_II_0(offset + i, offset + j);
+
+      linalg::lapack::inverse(block_size, block.data(), block_size);
+
+      for (int j = 0; j < block_size; ++j)
+        for (int i = 0; i < block_size; ++i)
+          Gamma(offset + i, offset + j) += block[i + block_size * j];
+    }
+  });
+}
+
+}  // analysis
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_ANALYSIS_BSE_SOLVER_COMPUTE_GAMMA_CLUSTER_HPP
@@ -61,6 +61,7 @@ public:
   using profiler_type = typename Parameters::profiler_type;
 
   using Concurrency = typename Parameters::concurrency_type;
+  using Threading = typename Parameters::ThreadingType;
   using Lattice = typename Parameters::lattice_type;
   constexpr static int DIMENSION = Lattice::DIMENSION;
   using TpAccumulatorScalar = typename Parameters::MC_measurement_scalar_type;
@@ -200,6 +201,12 @@ public:  // Optional members getters.
       Sigma_err_.reset(new SpGreensFunction("Self_Energy-error"));
     return *Sigma_err_;
   }
+  bool has_Sigma_error() const {
+    return (bool)Sigma_err_;
+  }
+  void clear_Sigma_error() {
+    Sigma_err_.reset();
+  }
   auto& get_G4() {
     if (not G4_)
       G4_.reset(new TpGreensFunction("G4"));
@@ -493,12 +500,17 @@ void DcaData<Parameters>::initialize_G0() {
 
   util::Timer("G_0 initialization", concurrency_.id() == concurrency_.first());
 
+  // The (k, w) and (k, t) points are distributed amongst the processes and threads.
+  const int n_threads = parameters_.get_coarsegraining_threads();
+
   // Compute G0_k_w.
-  compute_G0_k_w(H_DCA, parameters_.get_chemical_potential(), concurrency_, G0_k_w);
+  compute_G0_k_w(H_DCA, parameters_.get_chemical_potential(), concurrency_, G0_k_w, Threading(),
+                 n_threads);
   symmetrize::execute(G0_k_w, H_symmetry, true);
 
   // Compute G0_k_t.
-  compute_G0_k_t(H_DCA, parameters_.get_chemical_potential(), parameters_.get_beta(), G0_k_t);
+  compute_G0_k_t(H_DCA, parameters_.get_chemical_potential(), parameters_.get_beta(), concurrency_,
+                 G0_k_t, Threading(), n_threads);
   symmetrize::execute(G0_k_t, H_symmetry, true);
 
   // Compute G0_r_w.
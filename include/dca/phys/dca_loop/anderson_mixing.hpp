@@ -0,0 +1,216 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class accelerates the fixed point iteration x_{n+1} = g(x_n) of the DCA loop with Anderson
+// mixing (equivalent to DIIS / Pulay mixing).
+// Given the history of inputs x_i and outputs g_i with residuals f_i = g_i - x_i, the next input
+// is
+//     x_{n+1} = g_n - \sum_j gamma_j (g_{j+1} - g_j),
+// where gamma minimizes the weighted norm |f_n - \sum_j gamma_j (f_{j+1} - f_j)|_W.
+// The weights are the inverse variances of the outputs, if their statistical errors are provided.
+// Safeguards against the Monte Carlo noise:
+// - the least squares problem is Tikhonov regularized,
+// - no extrapolation is performed if the residual is compatible with the error bars,
+// - the history is restarted if the residual grows.
+
+#ifndef DCA_PHYS_DCA_LOOP_ANDERSON_MIXING_HPP
+#define DCA_PHYS_DCA_LOOP_ANDERSON_MIXING_HPP
+
+#include <cassert>
+#include <complex>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "dca/linalg/lapack/lapack.hpp"
+
+namespace dca {
+namespace phys {
+// dca::phys::
+
+template <typename Function>
+class AndersonMixing {
+public:
+  // history_size: maximum number of previous iterations used by the extrapolation. A value of zero
+  //               disables the acceleration.
+  // regularization: Tikhonov parameter relative to the mean diagonal of the normal equations.
+  // noise_threshold: the extrapolation is skipped if the mean squared residual in units of the
+  //                  error bars is smaller than this value.
+  AndersonMixing(int history_size, double regularization = 1.e-3, double noise_threshold = 1.);
+
+  // Replaces 'output', the result of the iteration with input 'input', with the next input of the
+  // accelerated iteration.
+  // In (optional): error, element-wise statistical error of 'output'. Real and imaginary parts are
+  //                treated independently.
+  // Returns true if an extrapolation was performed.
+  bool execute(const Function& input, Function& output, const Function* error = nullptr);
+
+  void reset() {
+    outputs_.clear();
+    residuals_.clear();
+  }
+
+  int get_history_size() const {
+    return residuals_.size();
+  }
+  const std::vector<double>& get_coefficients() const {
+    return coefficients_;
+  }
+  // Returns true if the last call to execute weighted the residuals with the error bars.
+  bool is_weighted() const {
+    return weighted_;
+  }
+
+private:
+  void computeWeights(const Function* error);
+  double product(const Function& a, const Function& b) const;
+
+  // Growth of the residual norm that triggers a restart of the history.
+  constexpr static double restart_factor_ = 2.;
+
+  const int history_size_;
+  const double regularization_;
+  const double noise_threshold_;
+
+  std::deque<Function> outputs_;
+  std::deque<Function> residuals_;
+
+  std::vector<double> weights_re_;
+  std::vector<double> weights_im_;
+  bool weighted_ = false;
+
+  std::vector<double> coefficients_;
+};
+
+template <typename Function>
+AndersonMixing<Function>::AndersonMixing(const int history_size, const double regularization,
+                                         const double noise_threshold)
+    : history_size_(history_size),
+      regularization_(regularization),
+      noise_threshold_(noise_threshold) {
+  if (history_size < 0 || regularization < 0)
+    throw(std::invalid_argument("Invalid Anderson mixing parameters."));
+}
+
+template <typename Function>
+bool AndersonMixing<Function>::execute(const Function& input, Function& output,
+                                       const Function* error) {
+  coefficients_.clear();
+  if (history_size_ == 0)
+    return false;
+
+  assert(input.size() == output.size());
+
+  Function residual(output);
+  for (int i = 0; i < residual.size(); ++i)
+    residual(i) -= input(i);
+
+  computeWeights(error);
+  const double residual_norm = product(residual, residual);
+
+  if (residuals_.size() &&
+      residual_norm > restart_factor_ * product(residuals_.back(), residuals_.back()))
+    reset();
+
+  outputs_.push_back(output);
+  residuals_.push_back(std::move(residual));
+  if (residuals_.size() > history_size_ + 1) {
+    outputs_.pop_front();
+    residuals_.pop_front();
+  }
+
+  const int m = residuals_.size() - 1;
+  if (m == 0)
+    return false;
+  // The residual is compatible with zero: the differences would only extrapolate noise.
+  if (weighted_ && residual_norm < noise_threshold_ * 2 * output.size())
+    return false;
+
+  // Differences of residuals and outputs between consecutive iterations.
+  std::vector<Function> delta_f(m), delta_g(m);
+  for (int j = 0; j < m; ++j) {
+    delta_f[j] = residuals_[j + 1];
+    delta_g[j] = outputs_[j + 1];
+    for (int i = 0; i < output.size(); ++i) {
+      delta_f[j](i) -= residuals_[j](i);
+      delta_g[j](i) -= outputs_[j](i);
+    }
+  }
+
+  // Solve the regularized normal equations (A + lambda) gamma = b.
+  std::vector<double> a(m * m);
+  coefficients_.resize(m);
+  double trace = 0;
+  for (int j = 0; j < m; ++j) {
+    for (int i = 0; i <= j; ++i)
+      a[i + m * j] = a[j + m * i] = product(delta_f[i], delta_f[j]);
+    coefficients_[j] = product(delta_f[j], residuals_.back());
+    trace += a[j + m * j];
+  }
+  if (trace == 0) {
+    coefficients_.clear();
+    return false;
+  }
+  for (int j = 0; j < m; ++j)
+    a[j + m * j] += regularization_ * trace / m;
+
+  std::vector<int> ipiv(m);
+  linalg::lapack::gesv(m, 1, a.data(), m, ipiv.data(), coefficients_.data(), m);
+
+  for (int j = 0; j < m; ++j)
+    for (int i = 0; i < output.size(); ++i)
+      output(i) -= coefficients_[j] * delta_g[j](i);
+
+  return true;
+}
+
+template <typename Function>
+void AndersonMixing<Function>::computeWeights(const Function* error) {
+  weighted_ = error != nullptr;
+  if (!weighted_)
+    return;
+
+  const int n = error->size();
+  weights_re_.resize(n);
+  weights_im_.resize(n);
+
+  // Regularize the inverse variance of elements with a vanishing error.
+  double mean_variance = 0;
+  for (int i = 0; i < n; ++i)
+    mean_variance += std::norm((*error)(i));
+  mean_variance /= 2 * n;
+  if (mean_variance == 0) {
+    weighted_ = false;
+    return;
+  }
+  const double floor = 1.e-2 * mean_variance;
+
+  for (int i = 0; i < n; ++i) {
+    weights_re_[i] = 1. / (std::real((*error)(i)) * std::real((*error)(i)) + floor);
+    weights_im_[i] = 1. / (std::imag((*error)(i)) * std::imag((*error)(i)) + floor);
+  }
+}
+
+template <typename Function>
+double AndersonMixing<Function>::product(const Function& a, const Function& b) const {
+  double result = 0;
+  if (weighted_) {
+    for (int i = 0; i < a.size(); ++i)
+      result += weights_re_[i] * std::real(a(i)) * std::real(b(i)) +
+                weights_im_[i] * std::imag(a(i)) * std::imag(b(i));
+  }
+  else {
+    for (int i = 0; i < a.size(); ++i)
+      result += std::real(a(i)) * std::real(b(i)) + std::imag(a(i)) * std::imag(b(i));
+  }
+  return result;
+}
+
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_LOOP_ANDERSON_MIXING_HPP
@@ -22,6 +22,7 @@
 #include "dca/io/hdf5/hdf5_writer.hpp"
 #include "dca/io/json/json_writer.hpp"
 #include "dca/phys/dca_algorithms/compute_greens_function.hpp"
+#include "dca/phys/dca_loop/anderson_mixing.hpp"
 #include "dca/phys/dca_loop/dca_loop_data.hpp"
 #include "dca/phys/dca_step/cluster_mapping/cluster_exclusion.hpp"
 #include "dca/phys/dca_step/cluster_mapping/coarsegraining/coarsegraining_sp.hpp"
@@ -73,6 +74,10 @@ public:
   void execute();
   void finalize();
 
+  const auto& get_anderson_mixing() const {
+    return anderson_mixing_;
+  }
+
 protected:
   void adjust_chemical_potential();
 
@@ -87,6 +92,10 @@ protected:
 
   double solve_cluster_problem(int DCA_iteration);
 
+  // Replaces the self-energy computed by the cluster solver with the Anderson extrapolation from
+  // the previous iterations.
+  void accelerate_self_energy();
+
   void perform_lattice_mapping();
 
   void update_DCA_loop_data_functions(int DCA_iteration);
@@ -96,8 +105,13 @@ protected:
   concurrency_type& concurrency;
 
 private:
+  using SelfEnergyType = decltype(DcaDataType::Sigma);
+
   DcaLoopData<ParametersType> DCA_info_struct;
 
+  AndersonMixing<SelfEnergyType> anderson_mixing_;
+  SelfEnergyType Sigma_input_;
+
   cluster_exclusion_type cluster_exclusion_obj;
   double_counting_correction_type double_counting_correction_obj;
 
@@ -120,6 +134,11 @@ DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::DcaLoop(ParametersType&
 
       DCA_info_struct(),
 
+      anderson_mixing_(parameters.get_anderson_history_size(),
+                       parameters.get_anderson_regularization(),
+                       parameters.get_anderson_noise_threshold()),
+      Sigma_input_("Self-Energy-input"),
+
       cluster_exclusion_obj(parameters, MOMS),
       double_counting_correction_obj(parameters, MOMS),
 
@@ -129,6 +148,8 @@ DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::DcaLoop(ParametersType&
       update_chemical_potential_obj(parameters, MOMS, cluster_mapping_obj),
 
       monte_carlo_integrator_(parameters_ref, MOMS_ref) {
+  concurrency.setHierarchicalSum(parameters.hierarchical_sum());
+
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\n\t" << __FUNCTION__ << " has started \t" << dca::util::print_time() << "\n\n";
 }
@@ -193,9 +214,17 @@ void DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::execute() {
 
     perform_cluster_exclusion_step();
 
+    if (parameters.get_anderson_history_size() > 0)
+      Sigma_input_ = MOMS.Sigma_cluster;
+
     double L2_Sigma_difference =
         solve_cluster_problem(i);  // returned from cluster_solver::finalize
 
+    // Keep the measured self-energy of the last iteration.
+    if (i < parameters.get_dca_iterations() - 1 &&
+        L2_Sigma_difference >= parameters.get_dca_accuracy())
+      accelerate_self_energy();
+
     adjust_impurity_self_energy();  // double-counting-correction
 
     perform_lattice_mapping();
@@ -255,7 +284,8 @@ void DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::perform_cluster_map
   // Finite-size QMC
   if (parameters.do_finite_size_qmc())
     compute_G_k_w(MOMS.H_DCA, MOMS.Sigma, parameters.get_chemical_potential(), concurrency,
-                  MOMS.G_k_w);
+                  MOMS.G_k_w, typename ParametersType::ThreadingType(),
+                  parameters.get_coarsegraining_threads());
   // DCA+
   else if (parameters.do_dca_plus())
     cluster_mapping_obj.compute_G_K_w(MOMS.Sigma_lattice, MOMS.G_k_w);
@@ -288,6 +318,10 @@ void DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::perform_cluster_exc
 
 template <typename ParametersType, typename DcaDataType, typename MCIntegratorType>
 double DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::solve_cluster_problem(int DCA_iteration) {
+  // The error bars of the self-energy, if any, are computed by the cluster solver for the current
+  // iteration only.
+  MOMS.clear_Sigma_error();
+
   {
     profiler_type profiler("initialize cluster-solver", "DCA", __LINE__);
     monte_carlo_integrator_.initialize(DCA_iteration);
@@ -306,6 +340,35 @@ double DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::solve_cluster_pro
   }
 }
 
+template <typename ParametersType, typename DcaDataType, typename MCIntegratorType>
+void DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::accelerate_self_energy() {
+  if (parameters.get_anderson_history_size() == 0)
+    return;
+
+  profiler_type profiler("Anderson-acceleration", "DCA", __LINE__);
+
+  // The input of the cluster solver is the coarsegrained self-energy, its output the new cluster
+  // self-energy.
+  const bool extrapolated = anderson_mixing_.execute(
+      Sigma_input_, MOMS.Sigma, MOMS.has_Sigma_error() ? &MOMS.get_Sigma_error() : nullptr);
+
+  if (extrapolated)
+    symmetrize::execute(MOMS.Sigma, MOMS.H_symmetry);
+
+  if (concurrency.id() == concurrency.first()) {
+    std::cout << "\n\t\t Anderson-acceleration " << dca::util::print_time();
+    if (extrapolated) {
+      std::cout << "\n\t\t\t coefficients :";
+      for (const double c : anderson_mixing_.get_coefficients())
+        std::cout << " " << c;
+    }
+    else
+      std::cout << "\n\t\t\t no extrapolation (history : " << anderson_mixing_.get_history_size()
+                << ")";
+    std::cout << "\n";
+  }
+}
+
 template <typename ParametersType, typename DcaDataType, typename MCIntegratorType>
 void DcaLoop<ParametersType, DcaDataType, MCIntegratorType>::perform_lattice_mapping() {
   profiler_type profiler("lattice-mapping", "DCA", __LINE__);
@@ -0,0 +1,240 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class executes a sweep of DCA(+) calculations, e.g. a doping or temperature scan, in a single
+// process.
+//
+// The input files are read in order into the same parameters object, i.e. every file only needs to
+// contain the parameters that change with respect to the previous point. The cluster domains are
+// initialized only once, the time and frequency domains again whenever the inverse temperature
+// changes. Each point starts from the self-energy of the previous point and, if the chemical
+// potential is adjusted, from its chemical potential. The self-energy is kept index-wise, i.e. after
+// a change of the inverse temperature it is only a starting guess on the new Matsubara frequencies.
+// Points that would write to the same output file as a previous point get the suffix "_point<n>"
+// added to the name of their output file.
+
+#ifndef DCA_PHYS_DCA_LOOP_DCA_SWEEP_HPP
+#define DCA_PHYS_DCA_LOOP_DCA_SWEEP_HPP
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dca/io/json/json_reader.hpp"
+#include "dca/util/git_version.hpp"
+
+namespace dca {
+namespace phys {
+// dca::phys::
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+class DcaSweep {
+public:
+  using concurrency_type = typename ParametersType::concurrency_type;
+
+  // Reads the first input file and initializes the domains.
+  DcaSweep(const std::vector<std::string>& input_files, concurrency_type& concurrency);
+
+  std::size_t size() const {
+    return input_files_.size();
+  }
+
+  // Reads the input file of the given point and initializes the data that depends on its
+  // parameters. The self-energy of the previous point is kept.
+  // Precondition: the points are read in order.
+  void readPoint(std::size_t point);
+  // Runs the DCA(+) loop for the point read last and writes its results.
+  void runPoint();
+
+  // Reads and runs all points.
+  void execute();
+
+  ParametersType& get_parameters() {
+    return parameters_;
+  }
+  DcaDataType& get_dca_data() {
+    return dca_data_;
+  }
+  // Returns the output file of the point read last.
+  std::string get_output_file() const {
+    return parameters_.get_directory() + parameters_.get_filename_dca();
+  }
+
+private:
+  // Reads the input file of the first point into the parameters and initializes the model and the
+  // domains. Called before the DCA data is constructed.
+  ParametersType& readFirstPoint();
+
+  // Returns a string of all parameters that enter the initialization of the domains, except for
+  // the inverse temperature.
+  static std::string domainsSignature(const ParametersType& parameters);
+
+  void makeOutputFileUnique();
+
+  const std::vector<std::string> input_files_;
+  concurrency_type& concurrency_;
+
+  ParametersType parameters_;
+  DcaDataType dca_data_;
+
+  std::string domains_signature_;
+  std::set<std::string> output_files_;
+  // Name of the output file as given by the input, before a suffix was added.
+  std::string filename_dca_;
+
+  std::size_t current_point_ = 0;
+  bool first_run_ = true;
+};
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+DcaSweep<ParametersType, DcaDataType, DcaLoopType>::DcaSweep(
+    const std::vector<std::string>& input_files, concurrency_type& concurrency)
+    : input_files_(input_files),
+      concurrency_(concurrency),
+      parameters_(dca::util::GitVersion::string(), concurrency_),
+      dca_data_(readFirstPoint()),
+      domains_signature_(domainsSignature(parameters_)),
+      filename_dca_(parameters_.get_filename_dca()) {}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+ParametersType& DcaSweep<ParametersType, DcaDataType, DcaLoopType>::readFirstPoint() {
+  parameters_.template read_input_and_broadcast<dca::io::JSONReader>(input_files_.at(0));
+  parameters_.update_model();
+  parameters_.update_domains();
+
+  return parameters_;
+}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+void DcaSweep<ParametersType, DcaDataType, DcaLoopType>::readPoint(const std::size_t point) {
+  if (point > 0) {
+    const double beta = parameters_.get_beta();
+    const double mu = parameters_.get_chemical_potential();
+
+    // Parameters missing in the input of this point keep the value of the previous point. For the
+    // name of the output file this is the name given by the input, without the suffix.
+    parameters_.set_filename_dca(filename_dca_);
+
+    parameters_.template read_input_and_broadcast<dca::io::JSONReader>(input_files_.at(point));
+    parameters_.update_model();
+
+    filename_dca_ = parameters_.get_filename_dca();
+
+    if (domainsSignature(parameters_) != domains_signature_)
+      throw std::logic_error("The parameters of the domains in " + input_files_[point] +
+                             " differ from the ones of the first point.");
+
+    if (parameters_.get_beta() != beta)
+      parameters_.update_time_and_frequency_domains();
+
+    // The chemical potential of the input is only a starting value, if it is adjusted.
+    if (parameters_.adjust_chemical_potential())
+      parameters_.get_chemical_potential() = mu;
+  }
+
+  current_point_ = point;
+  makeOutputFileUnique();
+
+  if (concurrency_.id() == concurrency_.first())
+    std::cout << "\n"
+              << "Point " << point + 1 << " of " << size() << ": " << input_files_[point] << "\n"
+              << "Output: " << get_output_file() << "\n"
+              << std::endl;
+
+  // H_0, the interaction and G_0 depend on the parameters of the point. The self-energy is kept.
+  dca_data_.initialize();
+}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+void DcaSweep<ParametersType, DcaDataType, DcaLoopType>::runPoint() {
+  DcaLoopType dca_loop(parameters_, dca_data_, concurrency_);
+
+  // Only the first point reads the initial self-energy and maps it to the lattice. Later points
+  // start from the self-energy of the previous point, whose lattice self-energy is still in memory.
+  if (first_run_)
+    dca_loop.initialize();
+  first_run_ = false;
+
+  dca_loop.execute();
+  dca_loop.finalize();
+
+  if (concurrency_.id() == concurrency_.first()) {
+    std::cout << "\nProcessor " << concurrency_.id() << " is writing data." << std::endl;
+    dca_loop.write();
+  }
+}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+void DcaSweep<ParametersType, DcaDataType, DcaLoopType>::execute() {
+  for (std::size_t point = 0; point < size(); ++point) {
+    readPoint(point);
+    runPoint();
+  }
+}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+void DcaSweep<ParametersType, DcaDataType, DcaLoopType>::makeOutputFileUnique() {
+  if (output_files_.count(get_output_file())) {
+    const std::string& filename = parameters_.get_filename_dca();
+    const std::size_t dot = filename.rfind('.');
+    const std::string stem = dot == std::string::npos ? filename : filename.substr(0, dot);
+    const std::string extension = dot == std::string::npos ? "" : filename.substr(dot);
+
+    parameters_.set_filename_dca(stem + "_point" + std::to_string(current_point_ + 1) + extension);
+
+    if (output_files_.count(get_output_file()))
+      throw std::logic_error("The output file " + get_output_file() + " of point " +
+                             std::to_string(current_point_ + 1) + " is already in use.");
+  }
+
+  output_files_.insert(get_output_file());
+}
+
+template <typename ParametersType, typename DcaDataType, typename DcaLoopType>
+std::string DcaSweep<ParametersType, DcaDataType, DcaLoopType>::domainsSignature(
+    const ParametersType& parameters) {
+  std::ostringstream signature;
+  signature.precision(17);
+
+  auto write_vectors = [&](const auto& vecs) {
+    for (const auto& vec : vecs) {
+      for (const auto& elem : vec)
+        signature << elem << " ";
+      signature << "; ";
+    }
+    signature << "\n";
+  };
+
+  signature << parameters.get_dca_iterations() << "\n"
+            << parameters.do_dca_plus() << "\n"
+            << parameters.get_sp_time_intervals() << "\n"
+            << parameters.get_time_intervals_for_time_measurements() << "\n"
+            << parameters.get_legendre_coefficients() << "\n"
+            << parameters.get_sp_fermionic_frequencies() << "\n"
+            << parameters.get_hts_bosonic_frequencies() << "\n"
+            << parameters.get_four_point_fermionic_frequencies() << "\n"
+            << parameters.get_four_point_frequency_transfer() << "\n"
+            << parameters.get_min_real_frequency() << "\n"
+            << parameters.get_max_real_frequency() << "\n"
+            << parameters.get_real_frequencies() << "\n"
+            << parameters.get_imaginary_damping() << "\n";
+  write_vectors(parameters.get_cluster());
+  write_vectors(parameters.get_sp_host());
+  write_vectors(parameters.get_tp_host());
+  write_vectors(
+      std::vector<std::vector<double>>{parameters.get_four_point_momentum_transfer_input()});
+
+  return signature.str();
+}
+
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_LOOP_DCA_SWEEP_HPP
@@ -12,12 +12,14 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_MAPPING_CLUSTER_EXCLUSION_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_MAPPING_CLUSTER_EXCLUSION_HPP
 
+#include <algorithm>
 #include <complex>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/linalg/linalg.hpp"
 #include "dca/math/function_transform/function_transform.hpp"
+#include "dca/parallel/util/get_bounds.hpp"
 #include "dca/phys/domains/cluster/cluster_domain.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
 #include "dca/phys/domains/quantum/electron_spin_domain.hpp"
@@ -36,6 +38,7 @@ class cluster_exclusion {
 public:
   using profiler_type = typename parameters_type::profiler_type;
   using concurrency_type = typename parameters_type::concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   using t = func::dmn_0<domains::time_domain>;
   using w = func::dmn_0<domains::frequency_domain>;
@@ -85,54 +88,48 @@ template <typename parameters_type, typename MOMS_type>
 void cluster_exclusion<parameters_type, MOMS_type>::compute_G0_K_w_cluster_excluded() {
   profiler_type profiler(__FUNCTION__, "cluster_exclusion", __LINE__);
 
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> G_matrix("G_matrix", nu::dmn_size());
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> S_matrix("S_matrix", nu::dmn_size());
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> one_plus_S_G("one_plus_S_G",
-                                                                           nu::dmn_size());
-  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> G0_matrix("G0_matrix", nu::dmn_size());
+  const int n = nu::dmn_size();
+  const std::complex<double> one(1.);
+  const std::complex<double> zero(0.);
 
-  // Allocate the work space for inverse only once.
-  dca::linalg::Vector<int, dca::linalg::CPU> ipiv;
-  dca::linalg::Vector<std::complex<double>, dca::linalg::CPU> work;
+  // The (K, w) points are independent and distributed amongst the threads.
+  const func::dmn_variadic<KClusterDmn, w> K_w_dmn;
+  const int n_threads =
+      std::max(1, std::min(parameters.get_coarsegraining_threads(), K_w_dmn.get_size()));
 
-  for (int w_ind = 0; w_ind < w::dmn_size(); w_ind++) {
-    for (int K_ind = 0; K_ind < KClusterDmn::dmn_size(); K_ind++) {
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          G_matrix(i, j) = MOMS.G_k_w(i, j, K_ind, w_ind);
+  Threading().execute(n_threads, [&](int id, int n_threads) {
+    const auto bounds = parallel::util::getBounds(id, n_threads, K_w_dmn);
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          S_matrix(i, j) = MOMS.Sigma_cluster(i, j, K_ind, w_ind);
+    dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> one_plus_S_G("one_plus_S_G", n);
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          one_plus_S_G(i, j) = 0;
+    // Allocate the work space for inverse only once per thread.
+    dca::linalg::Vector<int, dca::linalg::CPU> ipiv;
+    dca::linalg::Vector<std::complex<double>, dca::linalg::CPU> work;
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          for (int l = 0; l < nu::dmn_size(); l++)
-            one_plus_S_G(i, j) += S_matrix(i, l) * G_matrix(l, j);
+    int coor[2];
 
-      for (int i = 0; i < nu::dmn_size(); i++)
-        one_plus_S_G(i, i) += 1.;
+    for (int l = bounds.first; l < bounds.second; ++l) {
+      K_w_dmn.linind_2_subind(l, coor);
+      const int K_ind = coor[0];
+      const int w_ind = coor[1];
 
-      dca::linalg::matrixop::inverse(one_plus_S_G, ipiv, work);
+      // The (nu, nu) matrices at fixed (K, w) are stored contiguously.
+      const std::complex<double>* G_matrix = &MOMS.G_k_w(0, 0, K_ind, w_ind);
+      const std::complex<double>* S_matrix = &MOMS.Sigma_cluster(0, 0, K_ind, w_ind);
+      std::complex<double>* G0_matrix = &MOMS.G0_k_w_cluster_excluded(0, 0, K_ind, w_ind);
+
+      dca::linalg::blas::gemm("N", "N", n, n, n, one, S_matrix, n, G_matrix, n, zero,
+                              one_plus_S_G.ptr(), one_plus_S_G.leadingDimension());
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          G0_matrix(i, j) = 0;
+      for (int i = 0; i < n; i++)
+        one_plus_S_G(i, i) += 1.;
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          for (int l = 0; l < nu::dmn_size(); l++)
-            G0_matrix(i, j) += G_matrix(i, l) * one_plus_S_G(l, j);
+      dca::linalg::matrixop::inverse(one_plus_S_G, ipiv, work);
 
-      for (int j = 0; j < nu::dmn_size(); j++)
-        for (int i = 0; i < nu::dmn_size(); i++)
-          MOMS.G0_k_w_cluster_excluded(i, j, K_ind, w_ind) = G0_matrix(i, j);
+      dca::linalg::blas::gemm("N", "N", n, n, n, one, G_matrix, n, one_plus_S_G.ptr(),
+                              one_plus_S_G.leadingDimension(), zero, G0_matrix, n);
     }
-  }
+  });
 }
 
 template <typename parameters_type, typename MOMS_type>
@@ -225,7 +225,8 @@ template <typename parameters_type, typename MOMS_type, typename coarsegraining_
 double update_chemical_potential<parameters_type, MOMS_type, coarsegraining_type>::compute_density() {
   if (parameters.do_finite_size_qmc())
     compute_G_k_w(MOMS.H_DCA, MOMS.Sigma, parameters.get_chemical_potential(), concurrency,
-                  MOMS.G_k_w);
+                  MOMS.G_k_w, typename parameters_type::ThreadingType(),
+                  parameters.get_coarsegraining_threads());
   else if (parameters.do_dca_plus())
     coarsegraining.compute_G_K_w(MOMS.Sigma_lattice, MOMS.G_k_w);
   else
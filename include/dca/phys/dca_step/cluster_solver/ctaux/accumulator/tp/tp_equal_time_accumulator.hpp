@@ -869,8 +869,9 @@ void TpEqualTimeAccumulator<parameters_type, MOMS_type>::compute_G0_matrix_right
 template <class parameters_type, class MOMS_type>
 inline double TpEqualTimeAccumulator<parameters_type, MOMS_type>::interpolate_akima(
     int b_i, int s_i, int b_j, int s_j, int delta_r, double tau) {
-  const static double beta = parameters.get_beta();
-  const static double N_div_beta = parameters.get_sp_time_intervals() / beta;
+  // Not static: beta can change between the points of a sweep.
+  const double beta = parameters.get_beta();
+  const double N_div_beta = parameters.get_sp_time_intervals() / beta;
 
   // make sure that new_tau is positive !!
   double new_tau = tau + beta;
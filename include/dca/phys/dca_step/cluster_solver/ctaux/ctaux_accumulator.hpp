@@ -25,6 +25,7 @@
 #include "dca/linalg/util/cuda_event.hpp"
 #include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/tp/tp_accumulator.hpp"
 #include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/sp/sp_accumulator.hpp"
+#include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/sp/sp_legendre_accumulator.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/accumulator/tp/tp_equal_time_accumulator.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/domains/feynman_expansion_order_domain.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/ct_aux_hs_configuration.hpp"
@@ -129,11 +130,13 @@ public:
 
   // sp-measurements
   const auto& get_sign_times_M_r_w() const {
-    return single_particle_accumulator_obj.get_sign_times_M_r_w();
+    return legendre_measurement_ ? legendre_accumulator_.get_sign_times_M_r_w()
+                                 : single_particle_accumulator_obj.get_sign_times_M_r_w();
   }
 
   const auto& get_sign_times_M_r_w_sqr() const {
-    return single_particle_accumulator_obj.get_sign_times_M_r_w_sqr();
+    return legendre_measurement_ ? legendre_accumulator_.get_sign_times_M_r_w_sqr()
+                                 : single_particle_accumulator_obj.get_sign_times_M_r_w_sqr();
   }
 
   // tp-measurements
@@ -162,10 +165,13 @@ public:
   }
 
 private:
+  using AccumType = typename Parameters::MC_measurement_scalar_type;
+
   void accumulate_single_particle_quantities();
+  void accumulate_legendre_quantities(const std::array<linalg::Matrix<AccumType, linalg::GPU>, 2>& M);
+  void accumulate_legendre_quantities(const std::array<linalg::Matrix<AccumType, linalg::CPU>, 2>& M);
 
   void accumulate_equal_time_quantities();
-  using AccumType = typename Parameters::MC_measurement_scalar_type;
   void accumulate_equal_time_quantities(const std::array<linalg::Matrix<AccumType, linalg::GPU>, 2>& M);
   void accumulate_equal_time_quantities(const std::array<linalg::Matrix<AccumType, linalg::CPU>, 2>& M);
 
@@ -185,8 +191,11 @@ protected:
 
   using MC_accumulator_data::current_sign;
   using MC_accumulator_data::accumulated_sign;
+  using MC_accumulator_data::accumulated_tp_sign;
 
   const bool compute_std_deviation_;
+  // Measure M_r_w in the Legendre basis instead of with the NFFT.
+  const bool legendre_measurement_;
 
   std::array<std::vector<vertex_singleton_type>, 2> hs_configuration_;
 
@@ -206,6 +215,7 @@ protected:
   func::function<std::complex<double>, func::dmn_variadic<nu, nu, r_dmn_t, w>> M_r_w_stddev;
 
   accumulator::SpAccumulator<Parameters, device_t> single_particle_accumulator_obj;
+  accumulator::SpLegendreAccumulator<Parameters> legendre_accumulator_;
 
   ctaux::TpEqualTimeAccumulator<Parameters, Data> MC_two_particle_equal_time_accumulator_obj;
 
@@ -227,6 +237,7 @@ CtauxAccumulator<device_t, Parameters, Data>::CtauxAccumulator(Parameters& param
 
       compute_std_deviation_(parameters_.get_error_computation_type() ==
                              ErrorComputationType::STANDARD_DEVIATION),
+      legendre_measurement_(parameters_.get_legendre_coefficients() > 0),
 
       error("numerical-error-distribution-of-N-matrices"),
       visited_expansion_order_k("<k>"),
@@ -241,6 +252,7 @@ CtauxAccumulator<device_t, Parameters, Data>::CtauxAccumulator(Parameters& param
       M_r_w_stddev("M_r_w_stddev"),
 
       single_particle_accumulator_obj(parameters_, compute_std_deviation_),
+      legendre_accumulator_(parameters_, compute_std_deviation_),
 
       MC_two_particle_equal_time_accumulator_obj(parameters_, data_, id),
 
@@ -262,7 +274,10 @@ void CtauxAccumulator<device_t, Parameters, Data>::initialize(int dca_iteration)
   for (int i = 0; i < visited_expansion_order_k.size(); i++)
     visited_expansion_order_k(i) = 0;
 
-  single_particle_accumulator_obj.resetAccumulation();
+  if (legendre_measurement_)
+    legendre_accumulator_.resetAccumulation();
+  else
+    single_particle_accumulator_obj.resetAccumulation();
 
   if (perform_tp_accumulation_)
     two_particle_accumulator_.resetAccumulation(dca_iteration);
@@ -284,11 +299,14 @@ void CtauxAccumulator<device_t, Parameters, Data>::finalize() {
   // Note: only one thread calls this function.
   profiler_type profiler(__FUNCTION__, "CT-AUX accumulator", __LINE__);
 
-  single_particle_accumulator_obj.finalize();
+  if (legendre_measurement_)
+    legendre_accumulator_.finalize();
+  else
+    single_particle_accumulator_obj.finalize();
 
   if (compute_std_deviation_) {
-    const auto& M_r_w = single_particle_accumulator_obj.get_sign_times_M_r_w();
-    const auto& M_r_w_squared = single_particle_accumulator_obj.get_sign_times_M_r_w_sqr();
+    const auto& M_r_w = get_sign_times_M_r_w();
+    const auto& M_r_w_squared = get_sign_times_M_r_w_sqr();
     for (int l = 0; l < M_r_w_stddev.size(); l++)
       M_r_w_stddev(l) = std::sqrt(abs(M_r_w_squared(l)) - std::pow(abs(M_r_w(l)), 2));
 
@@ -391,8 +409,12 @@ void CtauxAccumulator<device_t, Parameters, Data>::measure() {
   number_of_measurements += 1;
   accumulated_sign += current_sign;
 
-  if (perform_tp_accumulation_)
+  // The first measurement of every interval contributes to G4.
+  if (perform_tp_accumulation_ &&
+      (number_of_measurements - 1) % parameters_.get_four_point_measurement_interval() == 0) {
+    accumulated_tp_sign += current_sign;
     accumulate_two_particle_quantities();
+  }
 
   accumulate_single_particle_quantities();
 
@@ -439,12 +461,32 @@ template <dca::linalg::DeviceType device_t, class Parameters, class Data>
 void CtauxAccumulator<device_t, Parameters, Data>::accumulate_single_particle_quantities() {
   profiler_type profiler("sp-accumulation", "CT-AUX accumulator", __LINE__, thread_id);
 
-  single_particle_accumulator_obj.accumulate(M_, hs_configuration_, current_sign);
+  if (legendre_measurement_)
+    accumulate_legendre_quantities(M_);
+  else
+    single_particle_accumulator_obj.accumulate(M_, hs_configuration_, current_sign);
 
   GFLOP += 2. * 8. * M_[1].size().first * M_[1].size().first * (1.e-9);
   GFLOP += 2. * 8. * M_[0].size().first * M_[0].size().first * (1.e-9);
 }
 
+template <dca::linalg::DeviceType device_t, class Parameters, class Data>
+void CtauxAccumulator<device_t, Parameters, Data>::accumulate_legendre_quantities(
+    const std::array<linalg::Matrix<AccumType, linalg::GPU>, 2>& M) {
+  for (int s = 0; s < 2; ++s)
+    M_host_[s].setAsync(M[s], thread_id, s);
+  for (int s = 0; s < 2; ++s)
+    linalg::util::syncStream(thread_id, s);
+
+  accumulate_legendre_quantities(M_host_);
+}
+
+template <dca::linalg::DeviceType device_t, class Parameters, class Data>
+void CtauxAccumulator<device_t, Parameters, Data>::accumulate_legendre_quantities(
+    const std::array<linalg::Matrix<AccumType, linalg::CPU>, 2>& M) {
+  legendre_accumulator_.accumulate(M, hs_configuration_, current_sign);
+}
+
 /*************************************************************
  **                                                         **
  **                 equal-time - MEASUREMENTS               **
@@ -502,6 +544,7 @@ void CtauxAccumulator<device_t, Parameters, Data>::sumTo(this_type& other) {
 
   other.accumulated_sign += accumulated_sign;
   other.number_of_measurements += number_of_measurements;
+  other.accumulated_tp_sign += accumulated_tp_sign;
 
   other.get_visited_expansion_order_k() += visited_expansion_order_k;
   other.get_error_distribution() += error;
@@ -514,7 +557,10 @@ void CtauxAccumulator<device_t, Parameters, Data>::sumTo(this_type& other) {
   other.get_dwave_pp_correlator() += dwave_pp_correlator;
 
   // sp-measurements
-  single_particle_accumulator_obj.sumTo(other.single_particle_accumulator_obj);
+  if (legendre_measurement_)
+    legendre_accumulator_.sumTo(other.legendre_accumulator_);
+  else
+    single_particle_accumulator_obj.sumTo(other.single_particle_accumulator_obj);
 
   // tp-measurements
   if (perform_tp_accumulation_)
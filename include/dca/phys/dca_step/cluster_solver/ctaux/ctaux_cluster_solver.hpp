@@ -15,6 +15,7 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_CTAUX_CLUSTER_SOLVER_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_CTAUX_CLUSTER_SOLVER_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <complex>
@@ -101,6 +102,12 @@ protected:
   void computeErrorBars();
 
 private:
+  // Estimates the error of the self-energy from the spread of the self-energies of the individual
+  // ranks and stores it in data_.get_Sigma_error(). It is used to weight the Anderson acceleration
+  // of the DCA loop in the iterations without error bars.
+  // Precondition: the accumulator_ data has not been averaged.
+  void estimateSigmaError();
+
   void symmetrize_measurements();
 
   // Sums/averages the quantities measured by the individual MPI ranks.
@@ -145,6 +152,8 @@ private:
   func::function<std::complex<double>, NuNuKClusterWDmn> Sigma_new_;
 
   int accumulated_sign_;
+  // Number of measurements of all ranks, collected in the same way as accumulated_sign_.
+  int accumulated_measurements_;
   func::function<std::complex<double>, NuNuRClusterWDmn> M_r_w_;
   func::function<std::complex<double>, NuNuRClusterWDmn> M_r_w_squared_;
 
@@ -177,6 +186,9 @@ CtauxClusterSolver<device_t, Parameters, Data>::CtauxClusterSolver(Parameters& p
       M_r_w_squared_("M_r_w_squared"),
 
       averaged_(false) {
+  if (parameters_.dynamic_measurement_distribution() && parameters_.get_measurement_batch_size() < 1)
+    throw std::logic_error("The measurement batch size must be at least 1.");
+
   if (concurrency_.id() == concurrency_.first())
     std::cout << "\n\n\t CT-AUX Integrator is born \n" << std::endl;
 }
@@ -207,6 +219,9 @@ void CtauxClusterSolver<device_t, Parameters, Data>::initialize(int dca_iteratio
       (dca_iteration == parameters_.get_dca_iterations() - 1) &&
       (parameters_.get_error_computation_type() == ErrorComputationType::JACK_KNIFE);
 
+  if (parameters_.dynamic_measurement_distribution())
+    concurrency_.resetGlobalCounter();
+
   if (concurrency_.id() == concurrency_.first())
     std::cout << "\n\n\t CT-AUX Integrator has initialized (DCA-iteration : " << dca_iteration
               << ")\n\n";
@@ -256,6 +271,10 @@ void CtauxClusterSolver<device_t, Parameters, Data>::integrate() {
 template <dca::linalg::DeviceType device_t, class Parameters, class Data>
 template <typename dca_info_struct_t>
 double CtauxClusterSolver<device_t, Parameters, Data>::finalize(dca_info_struct_t& dca_info_struct) {
+  if (parameters_.get_anderson_history_size() > 0 &&
+      dca_iteration_ < parameters_.get_dca_iterations() - 1)
+    estimateSigmaError();
+
   collect_measurements();
   symmetrize_measurements();
 
@@ -296,8 +315,7 @@ double CtauxClusterSolver<device_t, Parameters, Data>::finalize(dca_info_struct_
 
   dca_info_struct.average_expansion_order(dca_iteration_) = integral / total;
 
-  dca_info_struct.sign(dca_iteration_) =
-      double(accumulator_.get_accumulated_sign()) / accumulator_.get_number_of_measurements();
+  dca_info_struct.sign(dca_iteration_) = double(accumulated_sign_) / accumulated_measurements_;
 
   dca_info_struct.thermalization_per_mpi_task(dca_iteration_) =
       thermalization_time_ / double(concurrency_.number_of_processors());
@@ -344,7 +362,7 @@ void CtauxClusterSolver<device_t, Parameters, Data>::measure(Walker& walker) {
 
   const int n_meas = parallel::util::getWorkload(parameters_.get_measurements(), concurrency_);
 
-  for (int i = 0; i < n_meas; i++) {
+  auto measure_once = [&](const int meas_id) {
     {
       Profiler profiler("updating", "QMCI", __LINE__);
       walker.doSweep();
@@ -356,7 +374,26 @@ void CtauxClusterSolver<device_t, Parameters, Data>::measure(Walker& walker) {
       accumulator_.measure();
     }
 
-    walker.updateShell(i, n_meas);
+    walker.updateShell(meas_id, n_meas);
+  };
+
+  if (parameters_.dynamic_measurement_distribution()) {
+    // Claim batches of measurements from the counter shared by all ranks, until all measurements
+    // are done. The static workload is only an estimate for the progress report.
+    const long long total_meas = parameters_.get_measurements();
+    const int batch_size = parameters_.get_measurement_batch_size();
+
+    int meas_id = 0;
+    for (long long first_meas = concurrency_.globalCounterFetchAdd(batch_size);
+         first_meas < total_meas; first_meas = concurrency_.globalCounterFetchAdd(batch_size)) {
+      const int batch_end = meas_id + std::min<long long>(batch_size, total_meas - first_meas);
+      for (; meas_id < batch_end; ++meas_id)
+        measure_once(meas_id);
+    }
+  }
+  else {
+    for (int i = 0; i < n_meas; i++)
+      measure_once(i);
   }
 
   accumulator_.finalize();
@@ -400,12 +437,40 @@ void CtauxClusterSolver<device_t, Parameters, Data>::computeErrorBars() {
       std::cout << "\n\t\t compute-error-bars on G4\t" << dca::util::print_time() << "\n\n";
 
     auto G4 = accumulator_.get_sign_times_G4();
-    G4 /= parameters_.get_beta() * parameters_.get_beta() * accumulator_.get_accumulated_sign();
+    G4 /= parameters_.get_beta() * parameters_.get_beta() * accumulator_.get_accumulated_tp_sign();
 
     concurrency_.average_and_compute_stddev(G4, data_.get_G4_stdv());
   }
 }
 
+template <dca::linalg::DeviceType device_t, class Parameters, class Data>
+void CtauxClusterSolver<device_t, Parameters, Data>::estimateSigmaError() {
+  // The spread is not defined for a single rank, nor if a rank has no measurement to estimate its
+  // self-energy from.
+  int ranks_without_sign = accumulator_.get_accumulated_sign() == 0;
+  concurrency_.sum(ranks_without_sign);
+  if (concurrency_.number_of_processors() < 2 || ranks_without_sign)
+    return;
+
+  func::function<std::complex<double>, NuNuRClusterWDmn> M_r_w_local(
+      accumulator_.get_sign_times_M_r_w(), "M_r_w_local");
+  M_r_w_local /= accumulator_.get_accumulated_sign();
+
+  func::function<std::complex<double>, NuNuKClusterWDmn> M_k_w_local("M_k_w_local");
+  func::function<std::complex<double>, NuNuKClusterWDmn> G_k_w_local("G_k_w_local");
+  func::function<std::complex<double>, NuNuKClusterWDmn> Sigma_local("Sigma_local");
+
+  math::transform::FunctionTransform<RClusterDmn, KClusterDmn>::execute(M_r_w_local, M_k_w_local);
+  compute_G_k_w_new(M_k_w_local, G_k_w_local);
+  compute_S_k_w_new(G_k_w_local, Sigma_local);
+
+  auto& Sigma_error = data_.get_Sigma_error();
+  concurrency_.average_and_compute_stddev(Sigma_local, Sigma_error);
+
+  // The self-energy returned to the DCA loop is mixed with the input one.
+  Sigma_error *= parameters_.get_self_energy_mixing_factor();
+}
+
 template <dca::linalg::DeviceType device_t, class Parameters, class Data>
 void CtauxClusterSolver<device_t, Parameters, Data>::collect_measurements() {
   auto collect = [&](auto& f) {
@@ -421,13 +486,16 @@ void CtauxClusterSolver<device_t, Parameters, Data>::collect_measurements() {
     concurrency_.sum(accumulator_.get_Gflop());
     accumulated_sign_ = accumulator_.get_accumulated_sign();
     collect(accumulated_sign_);
+    // Ranks might have performed a different number of measurements.
+    accumulated_measurements_ = accumulator_.get_number_of_measurements();
+    collect(accumulated_measurements_);
   }
 
   if (concurrency_.id() == concurrency_.first())
     std::cout << "\n\t\t Collect measurements \t" << dca::util::print_time() << "\n"
               << "\n\t\t\t QMC-time : " << total_time_ << " [sec]"
               << "\n\t\t\t Gflops   : " << accumulator_.get_Gflop() / total_time_ << " [Gf]"
-              << "\n\t\t\t sign     : " << accumulated_sign_ / parameters_.get_measurements()
+              << "\n\t\t\t sign     : " << double(accumulated_sign_) / accumulated_measurements_
               << " \n";
 
   // sum M_r_w
@@ -452,16 +520,24 @@ void CtauxClusterSolver<device_t, Parameters, Data>::collect_measurements() {
     concurrency_.sum(accumulator_.get_G_r_t());
     concurrency_.sum(accumulator_.get_G_r_t_stddev());
 
-    accumulator_.get_G_r_t() /= accumulated_sign_;
-    accumulator_.get_G_r_t_stddev() /= accumulated_sign_ * std::sqrt(parameters_.get_measurements());
+    // These quantities are summed over all ranks, also in jackknife mode. Hence they are
+    // normalized by the sign and the number of measurements of all ranks instead of the
+    // leave-one-out ones.
+    int total_sign = accumulator_.get_accumulated_sign();
+    int total_measurements = accumulator_.get_number_of_measurements();
+    concurrency_.sum(total_sign);
+    concurrency_.sum(total_measurements);
+
+    accumulator_.get_G_r_t() /= total_sign;
+    accumulator_.get_G_r_t_stddev() /= total_sign * std::sqrt(total_measurements);
 
     concurrency_.sum(accumulator_.get_charge_cluster_moment());
     concurrency_.sum(accumulator_.get_magnetic_cluster_moment());
     concurrency_.sum(accumulator_.get_dwave_pp_correlator());
 
-    accumulator_.get_charge_cluster_moment() /= accumulated_sign_;
-    accumulator_.get_magnetic_cluster_moment() /= accumulated_sign_;
-    accumulator_.get_dwave_pp_correlator() /= accumulated_sign_;
+    accumulator_.get_charge_cluster_moment() /= total_sign;
+    accumulator_.get_magnetic_cluster_moment() /= total_sign;
+    accumulator_.get_dwave_pp_correlator() /= total_sign;
 
     data_.G_r_t = accumulator_.get_G_r_t();
   }
@@ -470,10 +546,14 @@ void CtauxClusterSolver<device_t, Parameters, Data>::collect_measurements() {
   if (parameters_.get_four_point_type() != NONE &&
       dca_iteration_ == parameters_.get_dca_iterations() - 1) {
     Profiler profiler("QMC-two-particle-Greens-function", "QMC-collectives", __LINE__);
+    // G4 is normalized by the sign of the measurements that contributed to it.
+    int accumulated_tp_sign = accumulator_.get_accumulated_tp_sign();
+    collect(accumulated_tp_sign);
+
     auto& G4 = data_.get_G4();
     G4 = accumulator_.get_sign_times_G4();
     collect(G4);
-    G4 /= accumulated_sign_;
+    G4 /= accumulated_tp_sign;
   }
 
   concurrency_.sum(accumulator_.get_visited_expansion_order_k());
@@ -545,7 +625,7 @@ void CtauxClusterSolver<device_t, Parameters, Data>::compute_G_k_w_from_M_r_w()
 
 template <dca::linalg::DeviceType device_t, class Parameters, class Data>
 double CtauxClusterSolver<device_t, Parameters, Data>::compute_S_k_w_from_G_k_w() {
-  static double alpha = parameters_.get_self_energy_mixing_factor();
+  const double alpha = parameters_.get_self_energy_mixing_factor();
   //     double L2_difference_norm = 0;
   //     double L2_Sigma_norm      = 0;
 
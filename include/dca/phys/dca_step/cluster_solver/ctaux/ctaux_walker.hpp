@@ -12,12 +12,16 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_CTAUX_WALKER_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_CTAUX_WALKER_HPP
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>  // uint64_t
 #include <cstdlib>  // std::size_t
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -35,6 +39,7 @@
 #include "dca/phys/dca_step/cluster_solver/ctaux/walker/tools/shrink_tools.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/walker/walker_bit.hpp"
 #include "dca/phys/dca_step/cluster_solver/shared_tools/util/accumulator.hpp"
+#include "dca/phys/dca_step/cluster_solver/shared_tools/util/autocorrelation_estimator.hpp"
 #include "dca/util/print_time.hpp"
 
 namespace dca {
@@ -64,9 +69,20 @@ public:
   bool& is_thermalized();
 
   // Does one sweep, if the walker is not yet thermalized (warm-up).
-  // Otherwise, does multiple sweeps according to the input parameter "sweeps-per-measurement".
+  // Otherwise, does multiple sweeps according to the input parameter "sweeps-per-measurement", or
+  // to the estimated autocorrelation time if "adaptive-sweeps-per-measurement" is set.
   void doSweep();
 
+  // Returns the number of sweeps between two measurements.
+  double get_sweeps_per_measurement() const {
+    return sweeps_per_measurement_;
+  }
+  // Returns the integrated autocorrelation time in sweeps used to set the number of sweeps per
+  // measurement, or zero if it has not been estimated (yet).
+  double get_autocorrelation_time() const {
+    return autocorrelation_time_;
+  }
+
   // Does one submatrix step of at most single_spin_updates_todo single spin updates.
   // Precondition: single_spin_updates_todo > 0
   // Postcondition: single_spin_updates_todo has been updated according to the executed submatrix
@@ -85,8 +101,36 @@ public:
   int get_sign();
   int get_thread_id();
 
+  // Returns the fraction of accepted single spin updates since the last call to initialize.
+  double get_acceptance_ratio() const {
+    const int proposed = number_of_creations + number_of_annihilations;
+    return proposed ? static_cast<double>(number_of_accepted_moves_) / proposed : 0.;
+  }
+  // Returns the current perturbation expansion order.
+  int get_expansion_order() {
+    return configuration.get_number_of_interacting_HS_spins();
+  }
+
   double get_Gflop();
 
+  // Sets the expansion parameter K used from the next call to initialize on. By default, the
+  // expansion parameter of the input is used.
+  void setExpansionParameter(const double K) {
+    expansion_parameter_K_ = K;
+  }
+  double get_expansion_parameter() const {
+    return expansion_parameter_K_;
+  }
+
+  // Replica exchange.
+  // Returns the logarithm of |W(c, K) / W(c, K_0)|, where W is the weight of the current
+  // configuration c, K_0 the current expansion parameter, and stores the sign of the ratio in
+  // 'ratio_sign'.
+  double logWeightRatio(double K, int& ratio_sign);
+  // Changes the expansion parameter to K, keeping the current configuration, and recomputes the N
+  // and G matrices. 'ratio_sign' is the sign of the weight ratio returned by logWeightRatio(K).
+  void changeExpansionParameter(double K, int ratio_sign);
+
   template <class stream_type>
   void to_JSON(stream_type& /*ss*/) {}
 
@@ -114,6 +158,21 @@ public:
 private:
   void add_non_interacting_spins_to_configuration();
 
+  // Returns the logarithm of |det(N^{-1})| for the spin e_spin of the current configuration,
+  // computed from scratch with the interaction 'cv', and stores the sign of the determinant in
+  // 'det_sign'.
+  double logDeterminantNInverse(CV<parameters_type>& cv, e_spin_states e_spin, int& det_sign);
+
+  // Adds the current expansion order, sign and total Hubbard-Stratonovich field to the
+  // autocorrelation estimators.
+  void sampleAutocorrelation();
+  // Sets the number of sweeps per measurement to the largest autocorrelation time, once it is
+  // estimated with enough samples.
+  void adaptSweepsPerMeasurement();
+  int max_autocorrelation_lag() const {
+    return 8 * std::max(1, static_cast<int>(parameters.get_max_sweeps_per_measurement()));
+  }
+
   void generate_delayed_spins(int& single_spin_updates_todo);
 
   // Generates delayed single spin updates.
@@ -211,7 +270,10 @@ private:
   int thread_id;
   int stream_id;
 
+  double expansion_parameter_K_;
   CV<parameters_type> CV_obj;
+  // Interaction at the expansion parameter of a proposed replica exchange.
+  std::unique_ptr<CV<parameters_type>> CV_exchange_;
   CT_AUX_WALKER_TOOLS<dca::linalg::CPU> ctaux_tools;
 
   rng_type& rng;
@@ -265,6 +327,7 @@ private:
 
   int number_of_creations;
   int number_of_annihilations;
+  int number_of_accepted_moves_;
 
   bool annihilation_proposal_aborted_;
   uint64_t aborted_vertex_id_;
@@ -278,6 +341,15 @@ private:
   util::Accumulator<std::size_t> warm_up_expansion_order_;
   util::Accumulator<std::size_t> num_delayed_spins_;
 
+  double sweeps_per_measurement_;
+  bool adapt_sweeps_per_measurement_;
+  double autocorrelation_time_;
+  std::array<util::AutocorrelationEstimator, 3> autocorrelation_estimators_;
+  // Minimum and maximum number of sweeps used to estimate the autocorrelation time. Within these
+  // bounds, the estimate is accepted once it is based on at least 50 autocorrelation times.
+  constexpr static int min_autocorrelation_samples_ = 200;
+  constexpr static int max_autocorrelation_samples_ = 2000;
+
   //  std::array<linalg::Matrix<double, device_t>, 2> M_;
   std::array<linalg::Vector<double, linalg::CPU>, 2> exp_v_minus_one_;
   std::array<linalg::Vector<double, device_t>, 2> exp_v_minus_one_dev_;
@@ -300,6 +372,7 @@ CtauxWalker<device_t, parameters_type, MOMS_type>::CtauxWalker(parameters_type&
       thread_id(id),
       stream_id(0),
 
+      expansion_parameter_K_(parameters.get_expansion_parameter_K()),
       CV_obj(parameters),
       ctaux_tools(CtauxWalkerData<device_t, parameters_type>::MAX_VERTEX_SINGLETS *
                   parameters.get_max_submatrix_size()),
@@ -340,6 +413,14 @@ CtauxWalker<device_t, parameters_type, MOMS_type>::CtauxWalker(parameters_type&
       warm_up_expansion_order_(),
       num_delayed_spins_(),
 
+      sweeps_per_measurement_(parameters.get_sweeps_per_measurement()),
+      adapt_sweeps_per_measurement_(parameters.adaptive_sweeps_per_measurement()),
+      autocorrelation_time_(0),
+      // Resolve lags up to the automatic window of the largest accepted autocorrelation time.
+      autocorrelation_estimators_{{util::AutocorrelationEstimator(max_autocorrelation_lag()),
+                                   util::AutocorrelationEstimator(max_autocorrelation_lag()),
+                                   util::AutocorrelationEstimator(max_autocorrelation_lag())}},
+
       config_initialized_(false) {
   if (concurrency.id() == 0 and thread_id == 0) {
     std::cout << "\n\n"
@@ -361,6 +442,9 @@ void CtauxWalker<device_t, parameters_type, MOMS_type>::printSummary() const {
     std::cout << "estimate for sweep size: " << warm_up_expansion_order_.mean() << "\n";
   if (num_delayed_spins_.count())
     std::cout << "average number of delayed spins: " << num_delayed_spins_.mean() << "\n";
+  if (autocorrelation_time_ > 0)
+    std::cout << "autocorrelation time [sweeps]: " << autocorrelation_time_
+              << ", sweeps per measurement: " << sweeps_per_measurement_ << "\n";
 
   std::cout << "# creations / # annihilations: "
             << static_cast<double>(number_of_creations) / static_cast<double>(number_of_annihilations)
@@ -396,6 +480,89 @@ double CtauxWalker<device_t, parameters_type, MOMS_type>::get_Gflop() {
   return Gflop;
 }
 
+template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
+double CtauxWalker<device_t, parameters_type, MOMS_type>::logWeightRatio(const double K,
+                                                                         int& ratio_sign) {
+  if (!CV_exchange_)
+    CV_exchange_ = std::make_unique<CV<parameters_type>>(parameters);
+  CV_exchange_->initialize(MOMS, K);
+
+  // W(c, K) is proportional to K^k det(N_up^{-1}) det(N_dn^{-1}), where k is the number of
+  // interacting spins. The remaining factors do not depend on K.
+  double log_ratio =
+      configuration.get_number_of_interacting_HS_spins() * std::log(K / expansion_parameter_K_);
+  ratio_sign = 1;
+
+  try {
+    for (const e_spin_states e_spin : {e_UP, e_DN}) {
+      int sign_new = 1;
+      int sign_old = 1;
+      log_ratio += logDeterminantNInverse(*CV_exchange_, e_spin, sign_new) -
+                   logDeterminantNInverse(CV_obj, e_spin, sign_old);
+      ratio_sign *= sign_new * sign_old;
+    }
+  }
+  catch (const linalg::lapack::util::LapackException&) {
+    // A singular N^{-1} at K has vanishing weight.
+    return -std::numeric_limits<double>::infinity();
+  }
+
+  return log_ratio;
+}
+
+template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
+void CtauxWalker<device_t, parameters_type, MOMS_type>::changeExpansionParameter(
+    const double K, const int ratio_sign) {
+  expansion_parameter_K_ = K;
+  CV_obj.initialize(MOMS, expansion_parameter_K_);
+
+  sign *= ratio_sign;
+
+  G0_tools_obj.build_G0_matrix(configuration, G0_up, e_UP);
+  G0_tools_obj.build_G0_matrix(configuration, G0_dn, e_DN);
+
+  N_tools_obj.build_N_matrix(configuration, N_up, G0_up, e_UP);
+  N_tools_obj.build_N_matrix(configuration, N_dn, G0_dn, e_DN);
+
+  G_tools_obj.build_G_matrix(configuration, N_up, G0_up, G_up, e_UP);
+  G_tools_obj.build_G_matrix(configuration, N_dn, G0_dn, G_dn, e_DN);
+}
+
+template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
+double CtauxWalker<device_t, parameters_type, MOMS_type>::logDeterminantNInverse(
+    CV<parameters_type>& cv, const e_spin_states e_spin, int& det_sign) {
+  std::vector<vertex_singleton_type>& configuration_e_spin = configuration.get(e_spin);
+  const int n = configuration_e_spin.size();
+
+  det_sign = 1;
+  if (n == 0)
+    return 0.;
+
+  dca::linalg::Matrix<double, device_t> G0;
+  G0_tools_obj.build_G0_matrix(configuration, G0, e_spin);
+
+  // N^{-1} = e^V - G0 (e^V - 1).
+  dca::linalg::Matrix<double, dca::linalg::CPU> N_inv(G0);
+  for (int j = 0; j < n; ++j) {
+    const double exp_V = cv.exp_V(configuration_e_spin[j]);
+    for (int i = 0; i < n; ++i)
+      N_inv(i, j) *= 1. - exp_V;
+    N_inv(j, j) += exp_V;
+  }
+
+  std::vector<int> ipiv(n);
+  dca::linalg::lapack::getrf(n, n, N_inv.ptr(), N_inv.leadingDimension(), ipiv.data());
+
+  double log_det = 0.;
+  for (int i = 0; i < n; ++i) {
+    log_det += std::log(std::abs(N_inv(i, i)));
+    if ((N_inv(i, i) < 0) != (ipiv[i] != i + 1))
+      det_sign *= -1;
+  }
+
+  return log_det;
+}
+
 template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
 bool& CtauxWalker<device_t, parameters_type, MOMS_type>::is_thermalized() {
   return thermalized;
@@ -407,13 +574,14 @@ void CtauxWalker<device_t, parameters_type, MOMS_type>::initialize() {
 
   number_of_creations = 0;
   number_of_annihilations = 0;
+  number_of_accepted_moves_ = 0;
 
   annihilation_proposal_aborted_ = false;
   // aborted_vertex_id_ = 0;
 
   sign = 1;
 
-  CV_obj.initialize(MOMS);
+  CV_obj.initialize(MOMS, expansion_parameter_K_);
 
   if (!config_initialized_)
     configuration.initialize();
@@ -462,7 +630,7 @@ void CtauxWalker<device_t, parameters_type, MOMS_type>::initialize() {
 template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
 void CtauxWalker<device_t, parameters_type, MOMS_type>::doSweep() {
   profiler_type profiler("do_sweep", "CT-AUX walker", __LINE__, thread_id);
-  const double sweeps_per_measurement{thermalized ? parameters.get_sweeps_per_measurement() : 1.};
+  const double sweeps_per_measurement{thermalized ? sweeps_per_measurement_ : 1.};
 
   // Do at least one single spin update per sweep.
   const int single_spin_updates_per_sweep{warm_up_expansion_order_.count() > 0 &&
@@ -475,21 +643,69 @@ void CtauxWalker<device_t, parameters_type, MOMS_type>::doSweep() {
   if (warm_up_sweeps_done_ == parameters.get_warm_up_sweeps() / 2)
     warm_up_expansion_order_.reset();
 
-  int single_spin_updates_todo{single_spin_updates_per_sweep *
-                               static_cast<int>(sweeps_per_measurement)};
+  // Sample the autocorrelation after every sweep during the second half of the warm-up and the
+  // first measurements.
+  if (adapt_sweeps_per_measurement_ && warm_up_sweeps_done_ >= parameters.get_warm_up_sweeps() / 2) {
+    for (int sweep = 0; sweep < static_cast<int>(sweeps_per_measurement); ++sweep) {
+      int single_spin_updates_todo{single_spin_updates_per_sweep};
+      while (single_spin_updates_todo > 0)
+        do_step(single_spin_updates_todo);
+      sampleAutocorrelation();
+    }
 
-  while (single_spin_updates_todo > 0) {
-    do_step(single_spin_updates_todo);
+    if (thermalized)
+      adaptSweepsPerMeasurement();
   }
 
-  assert(single_spin_updates_todo == 0);
+  else {
+    int single_spin_updates_todo{single_spin_updates_per_sweep *
+                                 static_cast<int>(sweeps_per_measurement)};
+
+    while (single_spin_updates_todo > 0) {
+      do_step(single_spin_updates_todo);
+    }
+
+    assert(single_spin_updates_todo == 0);
+  }
 
   if (!thermalized)
     ++warm_up_sweeps_done_;
 }
 
+template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
+void CtauxWalker<device_t, parameters_type, MOMS_type>::sampleAutocorrelation() {
+  int hs_field = 0;
+  for (int i = 0; i < configuration.size(); ++i)
+    hs_field += configuration[i].get_HS_spin();
+
+  autocorrelation_estimators_[0].addSample(configuration.get_number_of_interacting_HS_spins());
+  autocorrelation_estimators_[1].addSample(sign);
+  autocorrelation_estimators_[2].addSample(hs_field);
+}
+
+template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
+void CtauxWalker<device_t, parameters_type, MOMS_type>::adaptSweepsPerMeasurement() {
+  const int samples = autocorrelation_estimators_[0].count();
+  if (samples < min_autocorrelation_samples_)
+    return;
+
+  double tau = 0.5;
+  for (const auto& estimator : autocorrelation_estimators_)
+    tau = std::max(tau, estimator.integratedTime());
+
+  if (samples < 50 * tau && samples < max_autocorrelation_samples_)
+    return;
+
+  autocorrelation_time_ = tau;
+  sweeps_per_measurement_ =
+      std::min(std::max(1., std::round(tau)), parameters.get_max_sweeps_per_measurement());
+  adapt_sweeps_per_measurement_ = false;
+}
+
 template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_type>
 void CtauxWalker<device_t, parameters_type, MOMS_type>::do_step(int& single_spin_updates_todo) {
+  profiler_type profiler("submatrix update", "CT-AUX walker", __LINE__, thread_id);
+
   add_non_interacting_spins_to_configuration();
 
   {
@@ -1216,6 +1432,7 @@ void CtauxWalker<device_t, parameters_type, MOMS_type>::add_delayed_spin(int& de
 
   if (std::fabs(acceptance_ratio) >= rng()) {
     delayed_spins[delayed_index].is_accepted_move = true;
+    ++number_of_accepted_moves_;
 
     if (acceptance_ratio < 0)
       sign *= -1;
@@ -1489,7 +1706,7 @@ template <dca::linalg::DeviceType device_t, class parameters_type, class MOMS_ty
 double CtauxWalker<device_t, parameters_type, MOMS_type>::calculate_acceptace_ratio(
     double determinant_ratio, HS_vertex_move_type HS_current_move, double QMC_factor) {
   double N = number_of_interacting_spins;
-  double K = parameters.get_expansion_parameter_K();
+  double K = expansion_parameter_K_;
 
   double acceptance_ratio;
 
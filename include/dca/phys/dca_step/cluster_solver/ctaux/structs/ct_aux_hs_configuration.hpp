@@ -17,11 +17,13 @@
 #include <cstdlib>  // std::size_t
 #include <iostream>
 #include <stdexcept>
+#include <utility>  // std::swap
 #include <vector>
 
 #include "dca/io/buffer.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/domains/hs_field_sign_domain.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/domains/hs_spin_domain.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_pair.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_singleton.hpp"
 
@@ -47,7 +49,18 @@ public:
   int size();
   vertex_pair_type& operator[](int index);
 
+  // Returns the vertices of spin e_spin_type. The vertices must only be erased, swapped or have their
+  // HS spin changed through the methods of this class, which keep the vertex arrays in sync.
   std::vector<vertex_singleton_type>& get(e_spin_states_type e_spin_type);
+  // Returns the vertices of spin e_spin_type as a structure of arrays, with the indices of get.
+  const VertexArrays& get_vertex_arrays(e_spin_states_type e_spin_type) const {
+    return e_spin_type == e_UP ? vertex_arrays_e_UP : vertex_arrays_e_DN;
+  }
+
+  // Swaps the vertices i and j of spin e_spin_type.
+  void swap_vertices(e_spin_states_type e_spin_type, int i, int j);
+  // Erases the vertex i of spin e_spin_type.
+  void erase_vertex(e_spin_states_type e_spin_type, int i);
 
   void reset();
 
@@ -121,6 +134,9 @@ private:
   std::vector<vertex_singleton_type> configuration_e_UP;  // = { configuration | e_spin == e_UP}
   std::vector<vertex_singleton_type> configuration_e_DN;  // = { configuration | e_spin == e_DN}
 
+  VertexArrays vertex_arrays_e_UP;  // = configuration_e_UP as structure of arrays
+  VertexArrays vertex_arrays_e_DN;  // = configuration_e_DN as structure of arrays
+
   int current_Nb_of_creatable_spins;
   int current_Nb_of_annihilatable_spins;
 
@@ -196,6 +212,9 @@ void CT_AUX_HS_configuration<parameters_type>::remove_HS_spin(int index) {
   for (size_t i = 0; i < configuration_e_DN.size(); i++)
     if (configuration_e_DN[i].get_configuration_index() > index)
       configuration_e_DN[i].get_configuration_index() -= 1;
+
+  vertex_arrays_e_UP.removeConfigurationIndex(index);
+  vertex_arrays_e_DN.removeConfigurationIndex(index);
 }
 
 template <class parameters_type>
@@ -206,6 +225,23 @@ std::vector<vertex_singleton>& CT_AUX_HS_configuration<parameters_type>::get(e_s
     return configuration_e_DN;
 }
 
+template <class parameters_type>
+void CT_AUX_HS_configuration<parameters_type>::swap_vertices(e_spin_states_type e_spin, int i,
+                                                             int j) {
+  std::vector<vertex_singleton_type>& configuration_e_spin = get(e_spin);
+  std::swap(configuration_e_spin[i], configuration_e_spin[j]);
+
+  (e_spin == e_UP ? vertex_arrays_e_UP : vertex_arrays_e_DN).swap(i, j);
+}
+
+template <class parameters_type>
+void CT_AUX_HS_configuration<parameters_type>::erase_vertex(e_spin_states_type e_spin, int i) {
+  std::vector<vertex_singleton_type>& configuration_e_spin = get(e_spin);
+  configuration_e_spin.erase(configuration_e_spin.begin() + i);
+
+  (e_spin == e_UP ? vertex_arrays_e_UP : vertex_arrays_e_DN).erase(i);
+}
+
 template <class parameters_type>
 void CT_AUX_HS_configuration<parameters_type>::reset() {
   configuration.clear();
@@ -213,6 +249,9 @@ void CT_AUX_HS_configuration<parameters_type>::reset() {
   configuration_e_UP.clear();
   configuration_e_DN.clear();
 
+  vertex_arrays_e_UP.clear();
+  vertex_arrays_e_DN.clear();
+
   current_Nb_of_creatable_spins = 0;
   current_Nb_of_annihilatable_spins = 0;
 
@@ -278,19 +317,23 @@ void CT_AUX_HS_configuration<parameters_type>::update_configuration_e_spin(
   if (vertex_pair.get_e_spins().first == e_UP) {
     vertex_pair.get_configuration_e_spin_indices().first = configuration_e_UP.size();
     configuration_e_UP.push_back(vertex_pair.first());
+    vertex_arrays_e_UP.push_back(configuration_e_UP.back());
   }
   else {
     vertex_pair.get_configuration_e_spin_indices().first = configuration_e_DN.size();
     configuration_e_DN.push_back(vertex_pair.first());
+    vertex_arrays_e_DN.push_back(configuration_e_DN.back());
   }
 
   if (vertex_pair.get_e_spins().second == e_UP) {
     vertex_pair.get_configuration_e_spin_indices().second = configuration_e_UP.size();
     configuration_e_UP.push_back(vertex_pair.second());
+    vertex_arrays_e_UP.push_back(configuration_e_UP.back());
   }
   else {
     vertex_pair.get_configuration_e_spin_indices().second = configuration_e_DN.size();
     configuration_e_DN.push_back(vertex_pair.second());
+    vertex_arrays_e_DN.push_back(configuration_e_DN.back());
   }
 }
 
@@ -367,14 +410,18 @@ void CT_AUX_HS_configuration<parameters_type>::commit_accepted_spins() {
   changed_spin_indices.clear();
   changed_spin_values.clear();
 
-  for (size_t i = 0; i < changed_spin_indices_e_UP.size(); i++)
+  for (size_t i = 0; i < changed_spin_indices_e_UP.size(); i++) {
     configuration_e_UP[changed_spin_indices_e_UP[i]].get_HS_spin() = changed_spin_values_e_UP[i];
+    vertex_arrays_e_UP.setHSSpin(changed_spin_indices_e_UP[i], changed_spin_values_e_UP[i]);
+  }
 
   changed_spin_indices_e_UP.clear();
   changed_spin_values_e_UP.clear();
 
-  for (size_t i = 0; i < changed_spin_indices_e_DN.size(); i++)
+  for (size_t i = 0; i < changed_spin_indices_e_DN.size(); i++) {
     configuration_e_DN[changed_spin_indices_e_DN[i]].get_HS_spin() = changed_spin_values_e_DN[i];
+    vertex_arrays_e_DN.setHSSpin(changed_spin_indices_e_DN[i], changed_spin_values_e_DN[i]);
+  }
 
   changed_spin_indices_e_DN.clear();
   changed_spin_values_e_DN.clear();
@@ -595,6 +642,10 @@ bool CT_AUX_HS_configuration<parameters_type>::assert_consistency() {
   assert(2 * configuration.size() == (configuration_e_UP.size() + configuration_e_DN.size()));
   assert_counters();
 
+  if (!vertex_arrays_e_UP.isConsistent(configuration_e_UP) ||
+      !vertex_arrays_e_DN.isConsistent(configuration_e_DN))
+    throw std::logic_error("The vertex arrays are out of sync with the configuration.");
+
   // assert configuration-index
   for (int i = 0; i < (int)configuration.size(); i++)
     assert(configuration[i].get_configuration_index() == i);
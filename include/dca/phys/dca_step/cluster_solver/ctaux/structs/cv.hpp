@@ -17,6 +17,7 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_STRUCTS_CV_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_STRUCTS_CV_HPP
 
+#include <cassert>
 #include <cmath>
 #include <utility>
 
@@ -24,6 +25,7 @@
 #include "dca/function/function.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/domains/hs_field_sign_domain.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/domains/hs_spin_domain.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
 #include "dca/phys/domains/cluster/cluster_domain.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
 #include "dca/phys/domains/quantum/electron_spin_domain.hpp"
@@ -98,6 +100,9 @@ public:
   double exp_V(int spin_orbital_1, int spin_orbital_2, HS_spin_states_type HS_spin,
                HS_field_sign_type HS_field_sign, int site);
 
+  // Stores exp_V of the first n vertices of 'vertices' in exp_V_values[0, n).
+  void exp_V(const VertexArrays& vertices, int n, double* exp_V_values);
+
   double exp_delta_V(int linind);
 
   template <typename vertex_singleton_t>
@@ -114,6 +119,9 @@ public:
 
   template <typename MOMS_type>
   void initialize(MOMS_type& MOMS);
+  // Initializes the interaction with the expansion parameter K instead of the input parameter.
+  template <typename MOMS_type>
+  void initialize(MOMS_type& MOMS, double K);
 
 private:
   void initialize_gamma();
@@ -234,6 +242,26 @@ inline double CV<parameters_type>::exp_V(int spin_orbital_1, int spin_orbital_2,
   return exp_V_function(spin_orbital_1, spin_orbital_2, HS_spin_ind, HS_field_ind, site);
 }
 
+template <typename parameters_type>
+void CV<parameters_type>::exp_V(const VertexArrays& vertices, const int n, double* exp_V_values) {
+  assert(n <= vertices.size());
+  // The HS spin and field values are mapped to the coordinates of HS_spin_domain and
+  // HS_field_sign_domain arithmetically.
+  assert(HS_spin_domain::to_coordinate(HS_DN) == 0 && HS_spin_domain::to_coordinate(HS_UP) == 2);
+  assert(HS_field_sign_domain::to_coordinate(HS_FIELD_DN) == 0 &&
+         HS_field_sign_domain::to_coordinate(HS_FIELD_UP) == 1);
+
+  const int* spin_orbital = vertices.spin_orbital();
+  const int* paired_spin_orbital = vertices.paired_spin_orbital();
+  const int* HS_spin = vertices.HS_spin();
+  const int* HS_field = vertices.HS_field();
+  const int* delta_r = vertices.delta_r();
+
+  for (int i = 0; i < n; ++i)
+    exp_V_values[i] = exp_V_function(spin_orbital[i], paired_spin_orbital[i], HS_spin[i] + 1,
+                                     (HS_field[i] + 1) / 2, delta_r[i]);
+}
+
 template <typename parameters_type>
 inline double CV<parameters_type>::exp_delta_V(int linind) {
   return exp_delta_V_function(linind);
@@ -300,8 +328,14 @@ inline double CV<parameters_type>::exp_minus_delta_V(int spin_orbital_1, int spi
 template <class parameters_type>
 template <typename MOMS_type>
 void CV<parameters_type>::initialize(MOMS_type& MOMS) {
+  initialize(MOMS, parameters.get_expansion_parameter_K());
+}
+
+template <class parameters_type>
+template <typename MOMS_type>
+void CV<parameters_type>::initialize(MOMS_type& MOMS, const double K) {
   BETA = parameters.get_beta();
-  K_CT_AUX = parameters.get_expansion_parameter_K();
+  K_CT_AUX = K;
   BANDS = domains::electron_band_domain::get_size();
   FULL_CLUSTER_SIZE = r_dmn_t::dmn_size();
 
@@ -0,0 +1,173 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class stores the vertex singletons of one spin sector of the CT-AUX configuration as a
+// structure of arrays, i.e. one contiguous array per field, so that the kernels looping over the
+// vertices (G0 interpolation, exp(V), shrinking) read unit-stride memory.
+// Element i of every array belongs to vertex i of the spin sector. CT_AUX_HS_configuration owns
+// one instance per spin sector and keeps it in sync with its std::vector<vertex_singleton> view at
+// every insertion, erasure, swap and HS spin change.
+// The HS spins and fields are stored as their integer values (-1, 0, 1).
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_STRUCTS_VERTEX_ARRAYS_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_STRUCTS_VERTEX_ARRAYS_HPP
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_singleton.hpp"
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace ctaux {
+// dca::phys::solver::ctaux::
+
+class VertexArrays {
+public:
+  int size() const {
+    return tau_.size();
+  }
+
+  void clear();
+  void push_back(const vertex_singleton& v);
+  void erase(int i);
+  void swap(int i, int j);
+
+  void setHSSpin(int i, HS_spin_states_type HS_spin) {
+    HS_spin_[i] = HS_spin;
+  }
+  // Decrements the configuration indices larger than 'index', after the vertex pair at 'index' has
+  // been removed from the configuration.
+  void removeConfigurationIndex(int index);
+
+  // Returns true if the arrays hold the fields of 'vertices'.
+  bool isConsistent(const std::vector<vertex_singleton>& vertices) const;
+
+  const double* tau() const {
+    return tau_.data();
+  }
+  const int* band() const {
+    return band_.data();
+  }
+  const int* r_site() const {
+    return r_site_.data();
+  }
+  const int* delta_r() const {
+    return delta_r_.data();
+  }
+  const int* spin_orbital() const {
+    return spin_orbital_.data();
+  }
+  const int* paired_spin_orbital() const {
+    return paired_spin_orbital_.data();
+  }
+  const int* HS_spin() const {
+    return HS_spin_.data();
+  }
+  const int* HS_field() const {
+    return HS_field_.data();
+  }
+  const int* configuration_index() const {
+    return configuration_index_.data();
+  }
+
+private:
+  std::vector<double> tau_;
+  std::vector<int> band_;
+  std::vector<int> r_site_;
+  std::vector<int> delta_r_;
+  std::vector<int> spin_orbital_;
+  std::vector<int> paired_spin_orbital_;
+  std::vector<int> HS_spin_;
+  std::vector<int> HS_field_;
+  std::vector<int> configuration_index_;
+};
+
+inline void VertexArrays::clear() {
+  tau_.clear();
+  band_.clear();
+  r_site_.clear();
+  delta_r_.clear();
+  spin_orbital_.clear();
+  paired_spin_orbital_.clear();
+  HS_spin_.clear();
+  HS_field_.clear();
+  configuration_index_.clear();
+}
+
+inline void VertexArrays::push_back(const vertex_singleton& v) {
+  tau_.push_back(v.get_tau());
+  band_.push_back(v.get_band());
+  r_site_.push_back(v.get_r_site());
+  delta_r_.push_back(v.get_delta_r());
+  spin_orbital_.push_back(v.get_spin_orbital());
+  paired_spin_orbital_.push_back(v.get_paired_spin_orbital());
+  HS_spin_.push_back(v.get_HS_spin());
+  HS_field_.push_back(v.get_HS_field());
+  configuration_index_.push_back(v.get_configuration_index());
+}
+
+inline void VertexArrays::erase(const int i) {
+  assert(i >= 0 && i < size());
+
+  tau_.erase(tau_.begin() + i);
+  band_.erase(band_.begin() + i);
+  r_site_.erase(r_site_.begin() + i);
+  delta_r_.erase(delta_r_.begin() + i);
+  spin_orbital_.erase(spin_orbital_.begin() + i);
+  paired_spin_orbital_.erase(paired_spin_orbital_.begin() + i);
+  HS_spin_.erase(HS_spin_.begin() + i);
+  HS_field_.erase(HS_field_.begin() + i);
+  configuration_index_.erase(configuration_index_.begin() + i);
+}
+
+inline void VertexArrays::swap(const int i, const int j) {
+  assert(i >= 0 && i < size() && j >= 0 && j < size());
+
+  std::swap(tau_[i], tau_[j]);
+  std::swap(band_[i], band_[j]);
+  std::swap(r_site_[i], r_site_[j]);
+  std::swap(delta_r_[i], delta_r_[j]);
+  std::swap(spin_orbital_[i], spin_orbital_[j]);
+  std::swap(paired_spin_orbital_[i], paired_spin_orbital_[j]);
+  std::swap(HS_spin_[i], HS_spin_[j]);
+  std::swap(HS_field_[i], HS_field_[j]);
+  std::swap(configuration_index_[i], configuration_index_[j]);
+}
+
+inline void VertexArrays::removeConfigurationIndex(const int index) {
+  for (int& configuration_index : configuration_index_)
+    if (configuration_index > index)
+      --configuration_index;
+}
+
+inline bool VertexArrays::isConsistent(const std::vector<vertex_singleton>& vertices) const {
+  if (static_cast<int>(vertices.size()) != size())
+    return false;
+
+  for (int i = 0; i < size(); ++i) {
+    const vertex_singleton& v = vertices[i];
+
+    if (tau_[i] != v.get_tau() || band_[i] != v.get_band() || r_site_[i] != v.get_r_site() ||
+        delta_r_[i] != v.get_delta_r() || spin_orbital_[i] != v.get_spin_orbital() ||
+        paired_spin_orbital_[i] != v.get_paired_spin_orbital() ||
+        HS_spin_[i] != v.get_HS_spin() || HS_field_[i] != v.get_HS_field() ||
+        configuration_index_[i] != v.get_configuration_index())
+      return false;
+  }
+
+  return true;
+}
+
+}  // ctaux
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_STRUCTS_VERTEX_ARRAYS_HPP
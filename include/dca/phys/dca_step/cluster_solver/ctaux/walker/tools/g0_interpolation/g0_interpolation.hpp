@@ -13,6 +13,7 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_WALKER_TOOLS_G0_INTERPOLATION_G0_INTERPOLATION_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_CTAUX_WALKER_TOOLS_G0_INTERPOLATION_G0_INTERPOLATION_HPP
 
+#include <algorithm>  // std::copy_n
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -20,6 +21,7 @@
 #include "dca/function/domains/dmn_0.hpp"
 #include "dca/linalg/device_type.hpp"
 #include "dca/linalg/matrix.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_singleton.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/walker/tools/g0_interpolation/g0_interpolation_template.hpp"
 #include "dca/phys/domains/cluster/cluster_domain.hpp"
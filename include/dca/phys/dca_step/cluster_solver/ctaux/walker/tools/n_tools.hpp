@@ -37,6 +37,7 @@
 
 #include "dca/linalg/linalg.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/cv.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_singleton.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/walker/tools/n_matrix_tools/n_matrix_tools.hpp"
 
@@ -190,8 +191,8 @@ void N_TOOLS<device_t, parameters_type>::build_N_matrix(configuration_type& conf
                                                         dca::linalg::Matrix<double, device_t>& N,
                                                         const dca::linalg::Matrix<double, device_t>& G0,
                                                         e_spin_states_type e_spin) {
-  std::vector<vertex_singleton_type>& configuration_e_spin = configuration.get(e_spin);
-  int configuration_size(configuration_e_spin.size());
+  const VertexArrays& vertices = configuration.get_vertex_arrays(e_spin);
+  int configuration_size = vertices.size();
 
   // All interaction pairs are of the same spin type, which leads to a zero configuration size for
   // one of the spin types.
@@ -204,8 +205,7 @@ void N_TOOLS<device_t, parameters_type>::build_N_matrix(configuration_type& conf
 
   N.resizeNoCopy(configuration_size);
 
-  for (int i = 0; i < configuration_size; ++i)
-    exp_gamma_s[i] = CV_obj.exp_V(configuration_e_spin[i]);
+  CV_obj.exp_V(vertices, configuration_size, exp_gamma_s.ptr());
 
   for (int i = 0; i < configuration_size; ++i)
     one_min_exp_gamma_s[i] = (1. - exp_gamma_s[i]);
@@ -239,8 +239,8 @@ void N_TOOLS<device_t, parameters_type>::update_N_matrix(configuration_type& con
                                                          e_spin_states_type e_spin) {
   // profiler_t profiler(concurrency, "update_N_matrix", "CT-AUX", __LINE__, true);
 
-  std::vector<vertex_singleton_type>& configuration_e_spin = configuration.get(e_spin);
-  int configuration_size = configuration_e_spin.size();
+  const VertexArrays& vertices = configuration.get_vertex_arrays(e_spin);
+  int configuration_size = vertices.size();
 
   // All interaction pairs are of the same spin type, which leads to a zero configuration size for
   // one of the spin types.
@@ -301,8 +301,9 @@ void N_TOOLS<device_t, parameters_type>::update_N_matrix(configuration_type& con
     auto& exp_V_minus_one = exp_V_minus_one_val[spin_index];
 
     exp_V_minus_one.resize(first_non_interacting_vertex_index);
+    CV_obj.exp_V(vertices, first_non_interacting_vertex_index, exp_V_minus_one.ptr());
     for (int j = 0; j < first_non_interacting_vertex_index; ++j)
-      exp_V_minus_one[j] = CV_obj.exp_V(configuration_e_spin[j]) - 1.;
+      exp_V_minus_one[j] -= 1.;
 
     double* diagonal_matrix_ptr =
         N_MATRIX_TOOLS<device_t, parameters_type>::get_device_ptr(exp_V_minus_one);
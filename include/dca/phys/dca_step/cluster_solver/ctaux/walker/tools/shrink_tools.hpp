@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "dca/linalg/linalg.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_singleton.hpp"
 #include "dca/phys/dca_step/cluster_solver/ctaux/walker/tools/shrink_tools_algorithms/shrink_tools_algorithms.hpp"
 
@@ -169,16 +170,15 @@ void SHRINK_TOOLS<device_t>::shrink_Gamma_matrix(configuration_type& full_config
                                                  e_spin_states_type e_spin) {
   std::vector<int> configuration_spin_indices_to_be_erased(0);
 
-  std::vector<vertex_singleton_type>& configuration_e_spin = full_configuration.get(e_spin);
+  const int* configuration_index_e_spin =
+      full_configuration.get_vertex_arrays(e_spin).configuration_index();
   std::vector<int>& changed_spin_indices_e_spin =
       full_configuration.get_changed_spin_indices_e_spin(e_spin);
   std::vector<HS_spin_states_type>& changed_spin_values_e_spin =
       full_configuration.get_changed_spin_values_e_spin(e_spin);
 
   for (int i = 0; i < Gamma.size();) {
-    int configuration_index_e_spin = changed_spin_indices_e_spin[i];
-    int configuration_index =
-        configuration_e_spin[configuration_index_e_spin].get_configuration_index();
+    int configuration_index = configuration_index_e_spin[changed_spin_indices_e_spin[i]];
 
     if (full_configuration[configuration_index].is_Bennett()) {
       changed_spin_indices_e_spin.erase(changed_spin_indices_e_spin.begin() + i);
@@ -198,7 +198,8 @@ void SHRINK_TOOLS<device_t>::shrink_Gamma_matrix(configuration_type& full_config
                                                  e_spin_states_type e_spin) {
   std::vector<int> configuration_spin_indices_to_be_erased(0);
 
-  std::vector<vertex_singleton_type>& configuration_e_spin = full_configuration.get(e_spin);
+  const int* configuration_index_e_spin =
+      full_configuration.get_vertex_arrays(e_spin).configuration_index();
   std::vector<int>& changed_spin_indices_e_spin =
       full_configuration.get_changed_spin_indices_e_spin(e_spin);
   std::vector<HS_spin_states_type>& changed_spin_values_e_spin =
@@ -207,9 +208,7 @@ void SHRINK_TOOLS<device_t>::shrink_Gamma_matrix(configuration_type& full_config
   assert(Gamma.is_square());
 
   for (int i = 0; i < Gamma.size().first;) {
-    int configuration_index_e_spin = changed_spin_indices_e_spin[i];
-    int configuration_index =
-        configuration_e_spin[configuration_index_e_spin].get_configuration_index();
+    int configuration_index = configuration_index_e_spin[changed_spin_indices_e_spin[i]];
 
     if (full_configuration[configuration_index].is_Bennett()) {
       changed_spin_indices_e_spin.erase(changed_spin_indices_e_spin.begin() + i);
@@ -378,38 +377,40 @@ void SHRINK_TOOLS<device_t>::swap_interacting_vertices_to_left(configuration_typ
                                                                e_spin_states_type e_spin) {
   // cout << __FUNCTION__ << endl;
 
-  std::vector<vertex_singleton_type>& configuration_e_spin = full_configuration.get(e_spin);
-  int configuration_size = configuration_e_spin.size();
+  const VertexArrays& vertices = full_configuration.get_vertex_arrays(e_spin);
+  const int* configuration_index = vertices.configuration_index();
+  const int* HS_field = vertices.HS_field();
+  int configuration_size = vertices.size();
 
   if (configuration_size == 0) {
     return;
   }
 
   int dead_spin = 0;
-  int configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
+  int configuration_index_dead_spin = configuration_index[dead_spin];
 
   int living_spin = configuration_size - 1;
-  int configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+  int configuration_index_living_spin = configuration_index[living_spin];
 
   while (true) {
     while (dead_spin < configuration_size - 1 &&
            full_configuration[configuration_index_dead_spin].is_annihilatable()) {
       dead_spin++;
-      configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
+      configuration_index_dead_spin = configuration_index[dead_spin];
     }
 
     while (living_spin > 0 &&
            !full_configuration[configuration_index_living_spin].is_annihilatable()) {
       living_spin--;
-      configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+      configuration_index_living_spin = configuration_index[living_spin];
     }
 
     // if(dead_spin > living_spin)
     if (dead_spin >= living_spin)
       break;
     else {
-      HS_field_sign_type HS_field_dead_spin = configuration_e_spin[dead_spin].get_HS_field();
-      HS_field_sign_type HS_field_living_spin = configuration_e_spin[living_spin].get_HS_field();
+      const int HS_field_dead_spin = HS_field[dead_spin];
+      const int HS_field_living_spin = HS_field[living_spin];
 
       std::pair<int, int>& pair_dead_spin =
           full_configuration[configuration_index_dead_spin].get_configuration_e_spin_indices();
@@ -422,7 +423,7 @@ void SHRINK_TOOLS<device_t>::swap_interacting_vertices_to_left(configuration_typ
       // dca::linalg::matrixop::swapRowAndCol(N , dead_spin, living_spin);
       // dca::linalg::matrixop::swapRowAndCol(G0, dead_spin, living_spin);
 
-      std::swap(configuration_e_spin[dead_spin], configuration_e_spin[living_spin]);
+      full_configuration.swap_vertices(e_spin, dead_spin, living_spin);
 
       if (HS_field_dead_spin == HS_FIELD_DN)
         pair_dead_spin.first = living_spin;
@@ -438,11 +439,11 @@ void SHRINK_TOOLS<device_t>::swap_interacting_vertices_to_left(configuration_typ
     dead_spin++;
     living_spin--;
 
-    if (dead_spin == int(configuration_e_spin.size()) || living_spin == -1)
+    if (dead_spin == configuration_size || living_spin == -1)
       break;
     else {
-      configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
-      configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+      configuration_index_dead_spin = configuration_index[dead_spin];
+      configuration_index_living_spin = configuration_index[living_spin];
     }
   }
 }
@@ -533,38 +534,40 @@ void SHRINK_TOOLS<device_t>::swap_non_changed_vertices_to_left(configuration_typ
                                                                std::vector<int>& source_index,
                                                                std::vector<int>& target_index,
                                                                e_spin_states_type e_spin) {
-  std::vector<vertex_singleton_type>& configuration_e_spin = full_configuration.get(e_spin);
-  int configuration_size = configuration_e_spin.size();
+  const VertexArrays& vertices = full_configuration.get_vertex_arrays(e_spin);
+  const int* configuration_index = vertices.configuration_index();
+  const int* HS_field = vertices.HS_field();
+  int configuration_size = vertices.size();
 
   if (configuration_size == 0) {
     return;
   }
 
   int dead_spin = 0;
-  int configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
+  int configuration_index_dead_spin = configuration_index[dead_spin];
 
   int living_spin = configuration_size - 1;
-  int configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+  int configuration_index_living_spin = configuration_index[living_spin];
 
   while (true) {
     while (dead_spin < configuration_size - 1 &&
            !(!full_configuration[configuration_index_dead_spin].is_annihilatable() &&
              !full_configuration[configuration_index_dead_spin].is_creatable())) {
       dead_spin++;
-      configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
+      configuration_index_dead_spin = configuration_index[dead_spin];
     }
 
     while (living_spin > 0 && !full_configuration[configuration_index_living_spin].is_creatable()) {
       living_spin--;
-      configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+      configuration_index_living_spin = configuration_index[living_spin];
     }
 
     // if(dead_spin > living_spin)
     if (dead_spin >= living_spin)
       break;
     else {
-      HS_field_sign_type HS_field_dead_spin = configuration_e_spin[dead_spin].get_HS_field();
-      HS_field_sign_type HS_field_living_spin = configuration_e_spin[living_spin].get_HS_field();
+      const int HS_field_dead_spin = HS_field[dead_spin];
+      const int HS_field_living_spin = HS_field[living_spin];
 
       std::pair<int, int>& pair_dead_spin =
           full_configuration[configuration_index_dead_spin].get_configuration_e_spin_indices();
@@ -577,7 +580,7 @@ void SHRINK_TOOLS<device_t>::swap_non_changed_vertices_to_left(configuration_typ
       // dca::linalg::matrixop::swapRowAndCol(N , dead_spin, living_spin);
       // dca::linalg::matrixop::swapRowAndCol(G0, dead_spin, living_spin);
 
-      std::swap(configuration_e_spin[dead_spin], configuration_e_spin[living_spin]);
+      full_configuration.swap_vertices(e_spin, dead_spin, living_spin);
 
       if (HS_field_dead_spin == HS_FIELD_DN)
         pair_dead_spin.first = living_spin;
@@ -593,11 +596,11 @@ void SHRINK_TOOLS<device_t>::swap_non_changed_vertices_to_left(configuration_typ
     dead_spin++;
     living_spin--;
 
-    if (dead_spin == int(configuration_e_spin.size()) || living_spin == -1)
+    if (dead_spin == configuration_size || living_spin == -1)
       break;
     else {
-      configuration_index_dead_spin = configuration_e_spin[dead_spin].get_configuration_index();
-      configuration_index_living_spin = configuration_e_spin[living_spin].get_configuration_index();
+      configuration_index_dead_spin = configuration_index[dead_spin];
+      configuration_index_living_spin = configuration_index[living_spin];
     }
   }
 }
@@ -624,20 +627,20 @@ template <class configuration_type>
 void SHRINK_TOOLS<device_t>::erase_non_creatable_and_non_annihilatable_spins(
     configuration_type& full_configuration, dca::linalg::Matrix<double, device_t>& N,
     dca::linalg::Matrix<double, device_t>& G0, e_spin_states_type e_spin) {
-  std::vector<vertex_singleton_type>& configuration_e_spin = full_configuration.get(e_spin);
+  const VertexArrays& vertices = full_configuration.get_vertex_arrays(e_spin);
 
-  for (size_t i = 0; i < configuration_e_spin.size();) {
-    int configuration_index = configuration_e_spin[i].get_configuration_index();
+  for (int i = 0; i < vertices.size();) {
+    int configuration_index = vertices.configuration_index()[i];
     if (!full_configuration[configuration_index].is_annihilatable() &&
         !full_configuration[configuration_index].is_creatable())
-      configuration_e_spin.erase(configuration_e_spin.begin() + i);
+      full_configuration.erase_vertex(e_spin, i);
     else
       i++;
   }
 
   //     N .size() = configuration_e_spin.size();
   //     G0.size() = configuration_e_spin.size();
-  int SIZE = configuration_e_spin.size();
+  int SIZE = vertices.size();
 
   N.resize(SIZE);
   G0.resize(SIZE);
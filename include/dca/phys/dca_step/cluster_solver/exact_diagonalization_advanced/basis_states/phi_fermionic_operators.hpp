@@ -56,14 +56,12 @@ bool PhiFermionicOperators<parameter_type, ed_options>::create_at(int_type l, ph
 
     // Determine whether there is a sign change in the elegant (fast) way.
     if (l != 0) {
-      int_type tmp = (1 << l) - 1;
-      phi_type mask(tmp);  // = 00...0011...11,
-                           // where the first 0 (from the right) is at l-th position.
-
+      // Shifting phi to the left by N - l keeps the bits before the l-th position. The count of
+      // the bitset is a popcount.
       // Determines the parity of the number of 1's in phi before the l-th position:
       // odd --> change_sign = true
       // even --> change_sign = false.
-      bool change_sign = ((phi & mask).count()) & 1;
+      bool change_sign = ((phi << (phi.size() - l)).count()) & 1;
 
       if (change_sign)
         sign *= -1;
@@ -95,14 +93,12 @@ bool PhiFermionicOperators<parameter_type, ed_options>::annihilate_at(int_type l
 
     // Determine whether there is a sign change in the elegant (fast) way.
     if (l != 0) {
-      int_type tmp = (1 << l) - 1;
-      phi_type mask(tmp);  // = 00...0011...11,
-                           // where the first 0 (from the right) is at l-th position.
-
+      // Shifting phi to the left by N - l keeps the bits before the l-th position. The count of
+      // the bitset is a popcount.
       // Determines the parity of the number of 1's in phi before the l-th position:
       // odd --> change_sign = true
       // even --> change_sign = false.
-      bool change_sign = ((phi & mask).count()) & 1;
+      bool change_sign = ((phi << (phi.size() - l)).count()) & 1;
 
       if (change_sign)
         sign *= -1;
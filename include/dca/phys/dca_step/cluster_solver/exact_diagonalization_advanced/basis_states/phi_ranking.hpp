@@ -0,0 +1,112 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class ranks the occupation number states phi with a fixed number of electrons n using the
+// combinatorial number system. The occupied orbitals c_1 < c_2 < ... < c_m of one spin species
+// have the rank \sum_i C(c_i, i), which numbers the configurations of m electrons in M orbitals
+// from 0 to C(M, m) - 1. The states with n electrons are ordered by their number of spin up
+// electrons and then by the ranks of the spin up and spin down configurations, which maps them
+// one-to-one to [0, C(N, n)).
+// The spin-orbitals are ordered as (b, s, r), i.e. orbital l has spin (l / n_bands) % 2.
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_EXACT_DIAGONALIZATION_ADVANCED_BASIS_STATES_PHI_RANKING_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_EXACT_DIAGONALIZATION_ADVANCED_BASIS_STATES_PHI_RANKING_HPP
+
+#include <cassert>
+#include <vector>
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace ed {
+// dca::phys::solver::ed::
+
+template <typename ed_options>
+class PhiRanking {
+public:
+  typedef typename ed_options::phi_type phi_type;
+
+  PhiRanking(int num_bands, int num_sites);
+
+  int get_num_orbitals() const {
+    return num_orbitals_;
+  }
+
+  // Returns the rank of 'phi' among the states with the same number of electrons.
+  long long rank(const phi_type& phi) const;
+
+  // Returns C(n, k), or zero if k > n.
+  long long binomial(const int n, const int k) const {
+    assert(n >= 0 && n <= num_orbitals_ && k >= 0);
+    return k <= n ? binomial_[n][k] : 0;
+  }
+
+private:
+  int num_orbitals_;
+  int num_orbitals_per_spin_;
+
+  // Spin and position among the orbitals of the same spin of each spin-orbital.
+  std::vector<int> spin_;
+  std::vector<int> position_;
+
+  std::vector<std::vector<long long>> binomial_;
+  // offset_[n][n_up] = number of states with n electrons and less than n_up spin up electrons.
+  std::vector<std::vector<long long>> offset_;
+};
+
+template <typename ed_options>
+PhiRanking<ed_options>::PhiRanking(const int num_bands, const int num_sites)
+    : num_orbitals_(2 * num_bands * num_sites),
+      num_orbitals_per_spin_(num_bands * num_sites),
+      spin_(num_orbitals_),
+      position_(num_orbitals_) {
+  assert(num_orbitals_ <= phi_type().size());
+
+  int count[2] = {0, 0};
+  for (int l = 0; l < num_orbitals_; ++l) {
+    spin_[l] = (l / num_bands) % 2;
+    position_[l] = count[spin_[l]]++;
+  }
+
+  binomial_.resize(num_orbitals_ + 1);
+  for (int n = 0; n <= num_orbitals_; ++n) {
+    binomial_[n].resize(n + 1);
+    binomial_[n][0] = binomial_[n][n] = 1;
+    for (int k = 1; k < n; ++k)
+      binomial_[n][k] = binomial_[n - 1][k - 1] + binomial_[n - 1][k];
+  }
+
+  const int M = num_orbitals_per_spin_;
+  offset_.resize(num_orbitals_ + 1, std::vector<long long>(M + 2, 0));
+  for (int n = 0; n <= num_orbitals_; ++n)
+    for (int n_up = 0; n_up <= M && n_up <= n; ++n_up)
+      offset_[n][n_up + 1] =
+          offset_[n][n_up] + (n - n_up <= M ? binomial(M, n_up) * binomial(M, n - n_up) : 0);
+}
+
+template <typename ed_options>
+long long PhiRanking<ed_options>::rank(const phi_type& phi) const {
+  int n[2] = {0, 0};
+  long long rank[2] = {0, 0};
+
+  for (int l = 0; l < num_orbitals_; ++l) {
+    if (phi[l]) {
+      const int s = spin_[l];
+      ++n[s];
+      rank[s] += binomial(position_[l], n[s]);
+    }
+  }
+
+  return offset_[n[0] + n[1]][n[0]] + rank[0] * binomial(num_orbitals_per_spin_, n[1]) + rank[1];
+}
+
+}  // ed
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_EXACT_DIAGONALIZATION_ADVANCED_BASIS_STATES_PHI_RANKING_HPP
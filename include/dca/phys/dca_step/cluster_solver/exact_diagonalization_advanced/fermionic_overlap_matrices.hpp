@@ -23,6 +23,7 @@
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/linalg/matrixop.hpp"
+#include "dca/parallel/util/get_bounds.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/hamiltonian.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/overlap_matrix_element.hpp"
 #include "dca/phys/domains/cluster/cluster_domain_aliases.hpp"
@@ -45,6 +46,7 @@ public:
     
   typedef typename ed_options::profiler_t profiler_t;
   typedef typename ed_options::concurrency_type concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   typedef typename ed_options::scalar_type scalar_type;
   typedef typename ed_options::complex_type complex_type;
@@ -105,12 +107,23 @@ public:
   }
 
 private:
+  using set_all_type =
+      func::function<int, func::dmn_variadic<fermionic_Fock_dmn_type, fermionic_Fock_dmn_type, b_s_r_dmn_type>>;
+  using set_nonzero_sparse_type =
+      func::function<std::vector<sparse_element_type>,
+                     func::dmn_variadic<fermionic_Fock_dmn_type, fermionic_Fock_dmn_type, b_s_r_dmn_type>>;
+
+  // Computes the sparse matrices of c^\dagger ('create' = true) or c of all the sets for which
+  // 'set_all' is not -1 and returns the number of non-zero matrices.
+  unsigned long construct_set_nonzero_sparse(bool create, const set_all_type& set_all,
+                                             set_nonzero_sparse_type& set_nonzero_sparse);
+
   void compute_sparse_creation(int HS_i, int HS_j, int b_s_r);
   void compute_sparse_annihilation(int HS_i, int HS_j, int b_s_r);
 
-  void sort(std::vector<sparse_element_type>& sparse_matrix);
+  static void sort(std::vector<sparse_element_type>& sparse_matrix);
 
-  void merge(std::vector<sparse_element_type>& sparse_matrix);
+  static void merge(std::vector<sparse_element_type>& sparse_matrix);
 
 private:
   parameters_type& parameters;
@@ -249,61 +262,8 @@ void fermionic_overlap_matrices<parameters_type, ed_options>::construct_creation
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\t" << __FUNCTION__ << std::endl;
 
-  std::vector<Hilbert_space_type>& Hilbert_spaces = fermionic_Fock_dmn_type::get_elements();
-
-  unsigned long non_zero = 0;
-
-  creation_set_nonzero_sparse.reset();
-
-  for (int r_idx = 0; r_idx < Hilbert_spaces.size(); ++r_idx) {
-    for (int l_idx = 0; l_idx < Hilbert_spaces.size(); ++l_idx) {
-      for (int k = 0; k < b_s_r_dmn_type::dmn_size(); ++k) {
-        if (creation_set_all(l_idx, r_idx, k) != -1) {
-          creation_set_nonzero_sparse(l_idx, r_idx, k).reserve(1024);
-          creation_set_nonzero_sparse(l_idx, r_idx, k).resize(0);
-
-          Hilbert_space_phi_representation_type& rep_r = Hilbert_spaces[r_idx].get_rep();
-          Hilbert_space_phi_representation_type& rep_l = Hilbert_spaces[l_idx].get_rep();
-
-          for (int j = 0; j < rep_r.size(); ++j) {
-            int sign = 1;
-            phi_type phi = rep_r.get_phi(j);
-
-            if (fermionic_operators_type::create_at(k, phi, sign)) {
-              std::vector<int>& column_index = rep_r.get_indices(j);
-              std::vector<complex_type>& column_alpha = rep_r.get_alphas(j);
-
-              int i = rep_l.find(phi);
-
-              if (i < rep_l.size()) {
-                std::vector<int>& row_index = rep_l.get_indices(i);
-                std::vector<complex_type>& row_alpha = rep_l.get_alphas(i);
-
-                for (int c = 0; c < column_index.size(); ++c) {
-                  for (int r = 0; r < row_index.size(); ++r) {
-                    sparse_element_type tmp;
-                    tmp.i = row_index[r];
-                    tmp.j = column_index[c];
-                    tmp.value = conj(row_alpha[r]) * column_alpha[c] * scalar_type(sign);
-
-                    creation_set_nonzero_sparse(l_idx, r_idx, k).push_back(tmp);
-                  }
-                }
-              }
-            }
-          }
-        }
-
-        if (creation_set_nonzero_sparse(l_idx, r_idx, k).size() != 0) {
-          ++non_zero;
-
-          sort(creation_set_nonzero_sparse(l_idx, r_idx, k));
-
-          merge(creation_set_nonzero_sparse(l_idx, r_idx, k));
-        }
-      }
-    }
-  }
+  const unsigned long non_zero =
+      construct_set_nonzero_sparse(true, creation_set_all, creation_set_nonzero_sparse);
 
   if (concurrency.id() == concurrency.first()) {
     std::cout << "\tnumber of non-zero matrices : " << non_zero << std::endl;
@@ -315,65 +275,92 @@ void fermionic_overlap_matrices<parameters_type, ed_options>::construct_annihila
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\t" << __FUNCTION__ << std::endl;
 
+  const unsigned long non_zero =
+      construct_set_nonzero_sparse(false, annihilation_set_all, annihilation_set_nonzero_sparse);
+
+  if (concurrency.id() == concurrency.first()) {
+    std::cout << "\tnumber of non-zero matrices : " << non_zero << std::endl;
+  }
+}
+
+// The matrices of the different (l_idx, r_idx, k) are independent and distributed over the
+// threads. Each thread only writes to the elements of 'set_nonzero_sparse' it owns.
+template <typename parameters_type, typename ed_options>
+unsigned long fermionic_overlap_matrices<parameters_type, ed_options>::construct_set_nonzero_sparse(
+    const bool create, const set_all_type& set_all, set_nonzero_sparse_type& set_nonzero_sparse) {
   std::vector<Hilbert_space_type>& Hilbert_spaces = fermionic_Fock_dmn_type::get_elements();
 
-  unsigned long non_zero = 0;
+  set_nonzero_sparse.reset();
 
-  annihilation_set_nonzero_sparse.reset();
+  // Linear indices of the (l_idx, r_idx, k) with a matrix.
+  std::vector<int> matrices;
+  for (int l = 0; l < set_all.size(); ++l)
+    if (set_all(l) != -1)
+      matrices.push_back(l);
 
-  for (int r_idx = 0; r_idx < Hilbert_spaces.size(); ++r_idx) {
-    for (int l_idx = 0; l_idx < Hilbert_spaces.size(); ++l_idx) {
-      for (int k = 0; k < b_s_r_dmn_type::dmn_size(); ++k) {
-        //         std::vector<int> x, y;
+  const int num_HS = Hilbert_spaces.size();
 
-        if (annihilation_set_all(l_idx, r_idx, k) != -1) {
-          annihilation_set_nonzero_sparse(l_idx, r_idx, k).reserve(1024);
+  auto construct = [&](const int id, const int num_threads) {
+    const std::pair<int, int> bounds =
+        parallel::util::getBounds(id, num_threads, std::make_pair(0, int(matrices.size())));
 
-          Hilbert_space_phi_representation_type& rep_r = Hilbert_spaces[r_idx].get_rep();
-          Hilbert_space_phi_representation_type& rep_l = Hilbert_spaces[l_idx].get_rep();
+    unsigned long non_zero = 0;
 
-          for (int j = 0; j < rep_r.size(); ++j) {
-            int sign = 1;
-            phi_type phi = rep_r.get_phi(j);
+    for (int m = bounds.first; m < bounds.second; ++m) {
+      const int l_idx = matrices[m] % num_HS;
+      const int r_idx = (matrices[m] / num_HS) % num_HS;
+      const int k = matrices[m] / (num_HS * num_HS);
 
-            if (fermionic_operators_type::annihilate_at(k, phi, sign)) {
-              std::vector<int>& column_index = rep_r.get_indices(j);
-              std::vector<complex_type>& column_alpha = rep_r.get_alphas(j);
+      std::vector<sparse_element_type>& sparse_matrix = set_nonzero_sparse(l_idx, r_idx, k);
+      sparse_matrix.reserve(1024);
 
-              int i = rep_l.find(phi);
+      const Hilbert_space_phi_representation_type& rep_r = Hilbert_spaces[r_idx].get_rep();
+      const Hilbert_space_phi_representation_type& rep_l = Hilbert_spaces[l_idx].get_rep();
 
-              if (i < rep_l.size()) {
-                std::vector<int>& row_index = rep_l.get_indices(i);
-                std::vector<complex_type>& row_alpha = rep_l.get_alphas(i);
+      for (int j = 0; j < rep_r.size(); ++j) {
+        int sign = 1;
+        phi_type phi = rep_r.get_phi(j);
 
-                for (int c = 0; c < column_index.size(); ++c) {
-                  for (int r = 0; r < row_index.size(); ++r) {
-                    sparse_element_type tmp;
-                    tmp.i = row_index[r];
-                    tmp.j = column_index[c];
-                    tmp.value = conj(row_alpha[r]) * column_alpha[c] * scalar_type(sign);
+        const bool nonzero = create ? fermionic_operators_type::create_at(k, phi, sign)
+                                    : fermionic_operators_type::annihilate_at(k, phi, sign);
 
-                    annihilation_set_nonzero_sparse(l_idx, r_idx, k).push_back(tmp);
-                  }
-                }
+        if (nonzero) {
+          const int i = rep_l.find(phi);
+
+          if (i < rep_l.size()) {
+            const int* column_index = rep_r.get_indices(j);
+            const complex_type* column_alpha = rep_r.get_alphas(j);
+            const int* row_index = rep_l.get_indices(i);
+            const complex_type* row_alpha = rep_l.get_alphas(i);
+
+            for (int c = 0; c < rep_r.get_multiplicity(j); ++c) {
+              for (int r = 0; r < rep_l.get_multiplicity(i); ++r) {
+                sparse_element_type tmp;
+                tmp.i = row_index[r];
+                tmp.j = column_index[c];
+                tmp.value = conj(row_alpha[r]) * column_alpha[c] * scalar_type(sign);
+
+                sparse_matrix.push_back(tmp);
               }
             }
           }
         }
+      }
 
-        if (annihilation_set_nonzero_sparse(l_idx, r_idx, k).size() != 0) {
-          ++non_zero;
+      if (sparse_matrix.size() != 0) {
+        ++non_zero;
 
-          sort(annihilation_set_nonzero_sparse(l_idx, r_idx, k));
+        sort(sparse_matrix);
 
-          merge(annihilation_set_nonzero_sparse(l_idx, r_idx, k));
-        }
+        merge(sparse_matrix);
       }
     }
-  }
-  if (concurrency.id() == concurrency.first()) {
-    std::cout << "\tnumber of non-zero matrices : " << non_zero << std::endl;
-  }
+
+    return non_zero;
+  };
+
+  Threading threads;
+  return threads.sumReduction(parameters.get_ed_threads(), construct);
 }
 
 template <typename parameters_type, typename ed_options>
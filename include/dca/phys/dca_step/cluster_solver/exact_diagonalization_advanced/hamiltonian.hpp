@@ -339,14 +339,14 @@ void Hamiltonian<parameters_type, ed_options>::add_V_to_Hamiltonian(int /*N*/, m
       phi_type phi = rep.get_phi(j);
 
       if (fermionic_operators_type::annihilate_at(V_i[l].index, phi, sign)) {
-        std::vector<int>& column_index = rep.get_indices(j);
-        std::vector<complex_type>& column_alpha = rep.get_alphas(j);
+        const int* column_index = rep.get_indices(j);
+        const complex_type* column_alpha = rep.get_alphas(j);
 
-        std::vector<int>& row_index = column_index;
-        std::vector<complex_type>& row_alpha = column_alpha;
+        const int* row_index = column_index;
+        const complex_type* row_alpha = column_alpha;
 
-        for (int c = 0; c < column_index.size(); ++c) {
-          for (int r = 0; r < row_index.size(); ++r) {
+        for (int c = 0; c < rep.get_multiplicity(j); ++c) {
+          for (int r = 0; r < rep.get_multiplicity(j); ++r) {
             H(row_index[r], column_index[c]) += conj(row_alpha[r]) * column_alpha[c] * V_i[l].value;
           }
         }
@@ -367,17 +367,17 @@ void Hamiltonian<parameters_type, ed_options>::add_T_to_Hamiltonian(int /*N*/, m
 
       if (fermionic_operators_type::annihilate_at(t_ij[l].rhs, phi, sign) &&
           fermionic_operators_type::create_at(t_ij[l].lhs, phi, sign)) {
-        std::vector<int>& column_index = rep.get_indices(j);
-        std::vector<complex_type>& column_alpha = rep.get_alphas(j);
+        const int* column_index = rep.get_indices(j);
+        const complex_type* column_alpha = rep.get_alphas(j);
 
         int i = rep.find(phi);
 
         if (i < rep.size()) {
-          std::vector<int>& row_index = rep.get_indices(i);
-          std::vector<complex_type>& row_alpha = rep.get_alphas(i);
+          const int* row_index = rep.get_indices(i);
+          const complex_type* row_alpha = rep.get_alphas(i);
 
-          for (int c = 0; c < column_index.size(); ++c) {
-            for (int r = 0; r < row_index.size(); ++r) {
+          for (int c = 0; c < rep.get_multiplicity(j); ++c) {
+            for (int r = 0; r < rep.get_multiplicity(i); ++r) {
               H(row_index[r], column_index[c]) +=
                   conj(row_alpha[r]) * column_alpha[c] * scalar_type(sign) * t_ij[l].value;
             }
@@ -403,16 +403,16 @@ void Hamiltonian<parameters_type, ed_options>::add_U_to_Hamiltonian(int N, matri
           fermionic_operators_type::create_at(U_ij[l].rhs, phi, sign) &&
           fermionic_operators_type::annihilate_at(U_ij[l].lhs, phi, sign) &&
           fermionic_operators_type::create_at(U_ij[l].lhs, phi, sign)) {
-        std::vector<int>& column_index = rep.get_indices(j);
-        std::vector<complex_type>& column_alpha = rep.get_alphas(j);
+        const int* column_index = rep.get_indices(j);
+        const complex_type* column_alpha = rep.get_alphas(j);
 
         int i = rep.find(phi);
         if (i < rep.size()) {
-          std::vector<int>& row_index = rep.get_indices(i);
-          std::vector<complex_type>& row_alpha = rep.get_alphas(i);
+          const int* row_index = rep.get_indices(i);
+          const complex_type* row_alpha = rep.get_alphas(i);
 
-          for (int c = 0; c < column_index.size(); ++c) {
-            for (int r = 0; r < row_index.size(); ++r) {
+          for (int c = 0; c < rep.get_multiplicity(j); ++c) {
+            for (int r = 0; r < rep.get_multiplicity(i); ++r) {
               H(row_index[r], column_index[c]) +=
                   conj(row_alpha[r]) * column_alpha[c] * U_ij[l].value;
             }
@@ -428,16 +428,16 @@ void Hamiltonian<parameters_type, ed_options>::add_U_to_Hamiltonian(int N, matri
 
       if (fermionic_operators_type::annihilate_at(U_ij[l].rhs, phi, sign) &&
           fermionic_operators_type::create_at(U_ij[l].rhs, phi, sign)) {
-        std::vector<int>& column_index = rep.get_indices(j);
-        std::vector<complex_type>& column_alpha = rep.get_alphas(j);
+        const int* column_index = rep.get_indices(j);
+        const complex_type* column_alpha = rep.get_alphas(j);
 
         int i = rep.find(phi);
         if (i < rep.size()) {
-          std::vector<int>& row_index = rep.get_indices(i);
-          std::vector<complex_type>& row_alpha = rep.get_alphas(i);
+          const int* row_index = rep.get_indices(i);
+          const complex_type* row_alpha = rep.get_alphas(i);
 
-          for (int c = 0; c < column_index.size(); ++c) {
-            for (int r = 0; r < row_index.size(); ++r) {
+          for (int c = 0; c < rep.get_multiplicity(j); ++c) {
+            for (int r = 0; r < rep.get_multiplicity(i); ++r) {
               H(row_index[r], column_index[c]) -=
                   conj(row_alpha[r]) * column_alpha[c] * U_ij[l].value / scalar_type(2.);
             }
@@ -453,16 +453,16 @@ void Hamiltonian<parameters_type, ed_options>::add_U_to_Hamiltonian(int N, matri
 
       if (fermionic_operators_type::annihilate_at(U_ij[l].lhs, phi, sign) &&
           fermionic_operators_type::create_at(U_ij[l].lhs, phi, sign)) {
-        std::vector<int>& column_index = rep.get_indices(j);
-        std::vector<complex_type>& column_alpha = rep.get_alphas(j);
+        const int* column_index = rep.get_indices(j);
+        const complex_type* column_alpha = rep.get_alphas(j);
 
         int i = rep.find(phi);
         if (i < rep.size()) {
-          std::vector<int>& row_index = rep.get_indices(i);
-          std::vector<complex_type>& row_alpha = rep.get_alphas(i);
+          const int* row_index = rep.get_indices(i);
+          const complex_type* row_alpha = rep.get_alphas(i);
 
-          for (int c = 0; c < column_index.size(); ++c) {
-            for (int r = 0; r < row_index.size(); ++r) {
+          for (int c = 0; c < rep.get_multiplicity(j); ++c) {
+            for (int r = 0; r < rep.get_multiplicity(i); ++r) {
               H(row_index[r], column_index[c]) -=
                   conj(row_alpha[r]) * column_alpha[c] * U_ij[l].value / scalar_type(2.);
             }
@@ -9,16 +9,24 @@
 //         Urs R. Haehner (haehneru@itp.phys.ethz.ch)
 //
 // This file provides a compact representation of the Hilbert space.
+// The occupation number states phi of the psi states are stored in increasing order, together with
+// the indices of the psi states containing them and their coefficients, in flat arrays.
+// If all phis have the same number of electrons and their combinatorial ranks (see
+// phi_ranking.hpp) are dense enough, a table from the rank to the index of phi makes find O(1).
+// Otherwise find uses a binary search.
 
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_EXACT_DIAGONALIZATION_ADVANCED_HILBERT_SPACES_HILBERT_SPACE_PHI_REPRESENTATION_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_EXACT_DIAGONALIZATION_ADVANCED_HILBERT_SPACES_HILBERT_SPACE_PHI_REPRESENTATION_HPP
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
 #include <vector>
 
+#include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/basis_states/phi_ranking.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/basis_states/phi_state.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/basis_states/psi_state.hpp"
+#include "dca/phys/domains/cluster/cluster_domain_aliases.hpp"
 
 namespace dca {
 namespace phys {
@@ -34,50 +42,75 @@ public:
 
   typedef typename ed_options::phi_type phi_type;
 
+  using CDA = ClusterDomainAliases<parameter_type::lattice_type::DIMENSION>;
+  using RClusterDmn = typename CDA::RClusterDmn;
+
 public:
   Hilbert_space_phi_representation();
 
   template <typename Hilbert_space_type>
   void initialize(Hilbert_space_type& HS);
 
-  int size() {
-    return rep.size();
+  int size() const {
+    return phis.size();
   }
 
-  phi_type& get_phi(int i) {
+  const phi_type& get_phi(int i) const {
+    assert(i >= 0 && i < size());
+    return phis[i];
+  }
+  // Returns the number of psi states containing the i-th phi.
+  int get_multiplicity(int i) const {
     assert(i >= 0 && i < size());
-    return rep[i].phi;
+    return offsets[i + 1] - offsets[i];
   }
-  std::vector<int>& get_indices(int i) {
+  // Return the indices of the psi states containing the i-th phi and the coefficients of phi in
+  // these states. The arrays have get_multiplicity(i) elements, sorted by the index.
+  const int* get_indices(int i) const {
     assert(i >= 0 && i < size());
-    return rep[i].index;
+    return &indices[offsets[i]];
   }
-  std::vector<complex_type>& get_alphas(int i) {
+  const complex_type* get_alphas(int i) const {
     assert(i >= 0 && i < size());
-    return rep[i].alpha;
+    return &alphas[offsets[i]];
   }
 
-  int find(const phi_type& phi_);
+  // Returns the index of phi_, or size() if phi_ is not in the representation.
+  int find(const phi_type& phi_) const;
 
 private:
-  void sort();
+  void sort(std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep);
+
+  void merge(std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep);
 
-  void merge();
+  void sort_phis(std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep);
 
-  void sort_phis();
+  void initialize_rank_table();
 
 private:
-  std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>> rep;
+  std::vector<phi_type> phis;
+  std::vector<int> offsets;
+  std::vector<int> indices;
+  std::vector<complex_type> alphas;
+
+  // rank_table[ranking->rank(phi) - rank_offset] is the index of phi, or -1.
+  std::shared_ptr<const PhiRanking<ed_options>> ranking;
+  int occupation;
+  long long rank_offset;
+  std::vector<int> rank_table;
 };
 
 template <typename parameter_type, typename ed_options>
-Hilbert_space_phi_representation<parameter_type, ed_options>::Hilbert_space_phi_representation() {}
+Hilbert_space_phi_representation<parameter_type, ed_options>::Hilbert_space_phi_representation()
+    : occupation(-1), rank_offset(0) {}
 
 template <typename parameter_type, typename ed_options>
 template <typename Hilbert_space_type>
 void Hilbert_space_phi_representation<parameter_type, ed_options>::initialize(
     Hilbert_space_type& HS)  // Hilbert_space<parameter_type, ed_options>& HS)
 {
+  std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>> rep;
+
   for (int i = 0; i < HS.size(); ++i) {
     psi_state<parameter_type, ed_options>& Psi = HS.get_element(i);
 
@@ -92,25 +125,44 @@ void Hilbert_space_phi_representation<parameter_type, ed_options>::initialize(
     }
   }
 
-  sort();
+  sort(rep);
 
-  merge();
+  merge(rep);
 
-  sort_phis();
+  sort_phis(rep);
+
+  phis.resize(rep.size());
+  offsets.assign(1, 0);
+  indices.clear();
+  alphas.clear();
+
+  for (int i = 0; i < rep.size(); ++i) {
+    phis[i] = rep[i].phi;
+    indices.insert(indices.end(), rep[i].index.begin(), rep[i].index.end());
+    alphas.insert(alphas.end(), rep[i].alpha.begin(), rep[i].alpha.end());
+    offsets.push_back(indices.size());
+  }
+
+  initialize_rank_table();
 }
 
 template <typename parameter_type, typename ed_options>
-void Hilbert_space_phi_representation<parameter_type, ed_options>::sort() {
+void Hilbert_space_phi_representation<parameter_type, ed_options>::sort(
+    std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep) {
   std::sort(rep.begin(), rep.end());
 }
 
 template <typename parameter_type, typename ed_options>
-void Hilbert_space_phi_representation<parameter_type, ed_options>::merge() {
+void Hilbert_space_phi_representation<parameter_type, ed_options>::merge(
+    std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep) {
+  if (rep.empty())
+    return;
+
   std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>> merged_rep;
 
   merged_rep.push_back(rep[0]);
 
-  for (int i = 1; i < size(); ++i) {
+  for (int i = 1; i < rep.size(); ++i) {
     if (rep[i].phi == merged_rep.back().phi) {
       merged_rep.back().index.insert(merged_rep.back().index.end(), rep[i].index.begin(),
                                      rep[i].index.end());
@@ -126,23 +178,68 @@ void Hilbert_space_phi_representation<parameter_type, ed_options>::merge() {
 }
 
 template <typename parameter_type, typename ed_options>
-void Hilbert_space_phi_representation<parameter_type, ed_options>::sort_phis() {
-  for (int i = 0; i < size(); ++i)
+void Hilbert_space_phi_representation<parameter_type, ed_options>::sort_phis(
+    std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>& rep) {
+  for (int i = 0; i < rep.size(); ++i)
     rep[i].sort();
 }
 
 template <typename parameter_type, typename ed_options>
-int Hilbert_space_phi_representation<parameter_type, ed_options>::find(const phi_type& phi_) {
-  phi_state<parameter_type, ed_options, PHI_MULTIPLET> tmp;
-  tmp.phi = phi_;
+void Hilbert_space_phi_representation<parameter_type, ed_options>::initialize_rank_table() {
+  rank_table.clear();
+  occupation = -1;
+
+  if (phis.empty())
+    return;
+
+  occupation = phis[0].count();
+  for (int i = 1; i < size(); ++i)
+    if (phis[i].count() != occupation)
+      return;
+
+  if (!ranking)
+    ranking = std::make_shared<const PhiRanking<ed_options>>(ed_options::b_dmn::dmn_size(),
+                                                             RClusterDmn::dmn_size());
+
+  std::vector<long long> ranks(size());
+  for (int i = 0; i < size(); ++i)
+    ranks[i] = ranking->rank(phis[i]);
+
+  const auto minmax = std::minmax_element(ranks.begin(), ranks.end());
+  const long long table_size = *minmax.second - *minmax.first + 1;
+
+  // Fall back to the binary search if the table would be sparse.
+  if (table_size > 4 * static_cast<long long>(size()) + 64)
+    return;
+
+  rank_offset = *minmax.first;
+  rank_table.assign(table_size, -1);
+  for (int i = 0; i < size(); ++i)
+    rank_table[ranks[i] - rank_offset] = i;
+}
+
+template <typename parameter_type, typename ed_options>
+int Hilbert_space_phi_representation<parameter_type, ed_options>::find(const phi_type& phi_) const {
+  if (!rank_table.empty()) {
+    if (phi_.count() != occupation)
+      return size();
+
+    const long long l = ranking->rank(phi_) - rank_offset;
+    if (l < 0 || l >= static_cast<long long>(rank_table.size()) || rank_table[l] == -1)
+      return size();
+
+    assert(phis[rank_table[l]] == phi_);
+    return rank_table[l];
+  }
 
-  typename std::vector<phi_state<parameter_type, ed_options, PHI_MULTIPLET>>::iterator it =
-      std::lower_bound(rep.begin(), rep.end(), tmp);
+  const auto it = std::lower_bound(
+      phis.begin(), phis.end(), phi_,
+      [](const phi_type& phi1, const phi_type& phi2) { return phi1.to_ulong() < phi2.to_ulong(); });
 
-  if (it != rep.end() && !(tmp < *it))
-    return it - rep.begin();
+  if (it != phis.end() && *it == phi_)
+    return it - phis.begin();
   else
-    return rep.size();
+    return size();
 }
 
 }  // ed
@@ -0,0 +1,95 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class transforms the columns of a matrix between the momentum space cluster k_dmn_t and its
+// dual real space cluster by matrix products with the phases e^{ik.r}:
+//     f(r) = 1/N \sum_k e^{ik.r} f(k),    f(k) = \sum_r e^{-ik.r} f(r).
+// On the finite cluster the momentum convolutions of the series expansion become products in real
+// space, e.g. \sum_q A(k-q) B(q) = N \sum_r e^{-ik.r} A(r) B(r).
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_HIGH_TEMPERATURE_SERIES_EXPANSION_CLUSTER_FOURIER_TRANSFORM_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_HIGH_TEMPERATURE_SERIES_EXPANSION_CLUSTER_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+
+#include "dca/function/domains/dmn_0.hpp"
+#include "dca/linalg/matrix.hpp"
+#include "dca/linalg/matrixop.hpp"
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace htseries {
+// dca::phys::solver::htseries::
+
+template <class k_dmn_t>
+class ClusterFourierTransform {
+public:
+  using r_dmn_t = func::dmn_0<typename k_dmn_t::parameter_type::dual_type>;
+  using Matrix = linalg::Matrix<std::complex<double>, linalg::CPU>;
+
+  ClusterFourierTransform();
+
+  // f_r(:, r) = 1/N \sum_k e^{ik.r} f_k(:, k).
+  // Out: f_r
+  void toRealSpace(const Matrix& f_k, Matrix& f_r) const;
+  // f_k(:, k) = \sum_r e^{-ik.r} f_r(:, r).
+  // Out: f_k
+  void toMomentumSpace(const Matrix& f_r, Matrix& f_k) const;
+
+  // Returns the index of -r.
+  int minusR(const int r_ind) const {
+    return minus_r_[r_ind];
+  }
+
+private:
+  // phases_(k, r) = e^{ik.r}.
+  Matrix phases_;
+  std::vector<int> minus_r_;
+};
+
+template <class k_dmn_t>
+ClusterFourierTransform<k_dmn_t>::ClusterFourierTransform()
+    : phases_("phases", std::make_pair(k_dmn_t::dmn_size(), r_dmn_t::dmn_size())),
+      minus_r_(r_dmn_t::dmn_size()) {
+  const auto& k_elements = k_dmn_t::get_elements();
+  const auto& r_elements = r_dmn_t::get_elements();
+
+  for (int r_ind = 0; r_ind < r_dmn_t::dmn_size(); ++r_ind) {
+    for (int k_ind = 0; k_ind < k_dmn_t::dmn_size(); ++k_ind) {
+      double k_dot_r = 0;
+      for (int d = 0; d < k_elements[k_ind].size(); ++d)
+        k_dot_r += k_elements[k_ind][d] * r_elements[r_ind][d];
+      phases_(k_ind, r_ind) = std::polar(1., k_dot_r);
+    }
+
+    minus_r_[r_ind] =
+        r_dmn_t::parameter_type::subtract(r_ind, r_dmn_t::parameter_type::origin_index());
+  }
+}
+
+template <class k_dmn_t>
+void ClusterFourierTransform<k_dmn_t>::toRealSpace(const Matrix& f_k, Matrix& f_r) const {
+  f_r.resizeNoCopy(std::make_pair(f_k.nrRows(), r_dmn_t::dmn_size()));
+  const std::complex<double> norm(1. / k_dmn_t::dmn_size());
+  linalg::matrixop::gemm('N', 'N', norm, f_k, phases_, std::complex<double>(0), f_r);
+}
+
+template <class k_dmn_t>
+void ClusterFourierTransform<k_dmn_t>::toMomentumSpace(const Matrix& f_r, Matrix& f_k) const {
+  f_k.resizeNoCopy(std::make_pair(f_r.nrRows(), k_dmn_t::dmn_size()));
+  linalg::matrixop::gemm('N', 'C', std::complex<double>(1), f_r, phases_, std::complex<double>(0),
+                         f_k);
+}
+
+}  // htseries
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_HIGH_TEMPERATURE_SERIES_EXPANSION_CLUSTER_FOURIER_TRANSFORM_HPP
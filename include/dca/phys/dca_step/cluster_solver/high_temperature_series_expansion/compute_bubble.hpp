@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include <complex>
+#include <cstdlib>
 #include <iostream>
 #include <functional>
 #include <stdexcept>
@@ -22,11 +23,11 @@
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/parallel/util/get_bounds.hpp"
+#include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/cluster_fourier_transform.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
 #include "dca/phys/domains/quantum/electron_spin_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/vertex_frequency_domain.hpp"
-#include "dca/util/print_time.hpp"
 
 namespace dca {
 namespace phys {
@@ -75,12 +76,17 @@ private:
   void execute_on_lattice_ph(G_function_type& S);
   void execute_on_cluster_ph(G_function_type& G);
 
-  void threaded_execute_on_cluster_ph(int id, int nr_threads, const G_function_type& G);
 
   void execute_on_lattice_pp(G_function_type& S);
   void execute_on_cluster_pp(G_function_type& G);
 
-  void threaded_execute_on_cluster_pp(int id, int nr_threads, G_function_type& G);
+  // Computes the products of the real space Green's functions of the channel for the sites in
+  // 'r_bounds' and accumulates them over the frequencies.
+  // Out: C (the columns in 'r_bounds')
+  void threaded_convolution(int id, int nr_threads, std::pair<int, int> r_bounds,
+                            const ClusterFourierTransform<k_dmn_t>& transform,
+                            const typename ClusterFourierTransform<k_dmn_t>::Matrix& G_r,
+                            typename ClusterFourierTransform<k_dmn_t>::Matrix& C) const;
 
 private:
   parameters_type& parameters;
@@ -132,6 +138,11 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_o
   }
 }
 
+// The momentum sum is evaluated in real space,
+//     ph: \sum_k G(k, w) G(k+q, w+nu) = N \sum_r e^{-iq.r} G(-r, w) G(r, w+nu),
+//     pp: \sum_k G(k, w) G(q-k, nu-w) = N \sum_r e^{-iq.r} G(r, w) G(r, nu-w),
+// which reduces the cost from O(N_k^2 N_w N_nu) to O(N_k^2 (N_w + N_nu) + N_k N_w N_nu). The sites
+// are distributed over the processes and threads, and the partial bubbles are summed at the end.
 template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
 void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::threaded_execute_on_cluster(
     G_function_type& G) {
@@ -142,30 +153,104 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::threaded_
 
   profiler_type profiler("threaded_execute_on_cluster compute-bubble", "HTS", __LINE__);
 
-  const int nr_threads = parameters.get_hts_threads();
-  Threading threads;
-
   switch (channel_value) {
     case ph:
-      threads.execute(nr_threads,
-                      std::bind(&ThisType::threaded_execute_on_cluster_ph, this,
-                                std::placeholders::_1, std::placeholders::_2, std::ref(G)));
+      chi.set_name("ph-bubble");
       break;
     case pp:
-      threads.execute(nr_threads,
-                      std::bind(&ThisType::threaded_execute_on_cluster_pp, this,
-                                std::placeholders::_1, std::placeholders::_2, std::ref(G)));
+      chi.set_name("pp-bubble");
       break;
 
     default:
       throw std::logic_error(__FUNCTION__);
   }
 
-  concurrency.sum(chi);
+  using Transform = ClusterFourierTransform<k_dmn_t>;
+  using Matrix = typename Transform::Matrix;
+  const Transform transform;
 
-  double factor = -1. / (parameters.get_beta() * k_dmn_t::dmn_size());
+  const int n_b = b::dmn_size();
 
-  chi *= factor;
+  // G_k(i + n_b j + n_b^2 w, k) = G(i, j, k, w) for the spin up orbitals.
+  Matrix G_k("G_k", std::make_pair(n_b * n_b * w_dmn_t::dmn_size(), k_dmn_t::dmn_size()));
+  for (int k_ind = 0; k_ind < k_dmn_t::dmn_size(); ++k_ind)
+    for (int w_ind = 0; w_ind < w_dmn_t::dmn_size(); ++w_ind)
+      for (int j = 0; j < n_b; ++j)
+        for (int i = 0; i < n_b; ++i)
+          G_k(i + n_b * (j + n_b * w_ind), k_ind) = G(i, j, k_ind, w_ind);
+
+  Matrix G_r("G_r");
+  transform.toRealSpace(G_k, G_r);
+
+  // C(i0 + n_b i1 + n_b^2 j0 + n_b^3 j1 + n_b^4 nu, r) has the layout of chi. The matrix is
+  // initialized to zero.
+  Matrix C("C", std::make_pair(n_b * n_b * n_b * n_b * w_VERTEX_BOSONIC::dmn_size(),
+                               Transform::r_dmn_t::dmn_size()));
+
+  typename Transform::r_dmn_t r_dmn;
+  const std::pair<int, int> r_bounds = concurrency.get_bounds(r_dmn);
+
+  Threading threads;
+  threads.execute(parameters.get_hts_threads(),
+                  std::bind(&ThisType::threaded_convolution, this, std::placeholders::_1,
+                            std::placeholders::_2, r_bounds, std::cref(transform), std::cref(G_r),
+                            std::ref(C)));
+
+  Matrix chi_k("chi_k");
+  transform.toMomentumSpace(C, chi_k);
+
+  // The factor N of the real space sum cancels the 1/N of the bubble.
+  const double factor = -1. / parameters.get_beta();
+
+  for (int nu_ind = 0; nu_ind < w_VERTEX_BOSONIC::dmn_size(); ++nu_ind)
+    for (int q_ind = 0; q_ind < k_dmn_t::dmn_size(); ++q_ind)
+      for (int l = 0; l < n_b * n_b * n_b * n_b; ++l)
+        chi(l + n_b * n_b * n_b * n_b * (q_ind + k_dmn_t::dmn_size() * nu_ind)) =
+            factor * chi_k(l + n_b * n_b * n_b * n_b * nu_ind, q_ind);
+
+  concurrency.sum(chi);
+}
+
+template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
+void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::threaded_convolution(
+    const int id, const int nr_threads, const std::pair<int, int> r_bounds,
+    const ClusterFourierTransform<k_dmn_t>& transform,
+    const typename ClusterFourierTransform<k_dmn_t>::Matrix& G_r,
+    typename ClusterFourierTransform<k_dmn_t>::Matrix& C) const {
+  const std::pair<int, int> bounds = dca::parallel::util::getBounds(id, nr_threads, r_bounds);
+
+  const int n_b = b::dmn_size();
+  const int n_w = w_dmn_t::dmn_size();
+
+  for (int r_ind = bounds.first; r_ind < bounds.second; ++r_ind) {
+    // The ph channel pairs G(-r) with G(r), the pp channel G(r) with G(r).
+    const int r_left = channel_value == ph ? transform.minusR(r_ind) : r_ind;
+    const std::complex<double>* G_left = &G_r(0, r_left);
+    const std::complex<double>* G_right = &G_r(0, r_ind);
+    std::complex<double>* C_r = &C(0, r_ind);
+
+    for (int nu_ind = 0; nu_ind < w_VERTEX_BOSONIC::dmn_size(); ++nu_ind) {
+      const int nu_c = (nu_ind - w_VERTEX_BOSONIC::dmn_size() / 2);
+      std::complex<double>* C_nu = C_r + n_b * n_b * n_b * n_b * nu_ind;
+
+      for (int w_ind = std::abs(nu_c); w_ind < n_w - std::abs(nu_c); ++w_ind) {
+        const int w_right = channel_value == ph ? w_ind + nu_c : nu_c + (n_w - 1 - w_ind);
+        const std::complex<double>* G_w = G_left + n_b * n_b * w_ind;
+        const std::complex<double>* G_w_right = G_right + n_b * n_b * w_right;
+
+        for (int j1 = 0; j1 < n_b; ++j1)
+          for (int j0 = 0; j0 < n_b; ++j0)
+            for (int i1 = 0; i1 < n_b; ++i1)
+              for (int i0 = 0; i0 < n_b; ++i0) {
+                // ph: G(i0, j1) G(i1, j0), pp: G(i0, j0) G(i1, j1).
+                const std::complex<double> product =
+                    channel_value == ph ? G_w[i0 + n_b * j1] * G_w_right[i1 + n_b * j0]
+                                        : G_w[i0 + n_b * j0] * G_w_right[i1 + n_b * j1];
+                C_nu[i0 + n_b * (i1 + n_b * (j0 + n_b * j1))] += product;
+              }
+      }
+    }
+  }
 }
 
 template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
@@ -175,7 +260,7 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_o
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\n\t\t ph-buble \n\n" << std::endl;
 
-  chi.get_name() = "ph-bubble";
+  chi.set_name("ph-bubble");
 
   chi = 0.;
 
@@ -206,43 +291,6 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_o
   chi *= factor;
 }
 
-template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
-void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::threaded_execute_on_cluster_ph(
-    const int id, const int nr_threads, const G_function_type& G) {
-  k_dmn_t k_dmn;
-  std::pair<int, int> k_bounds = concurrency.get_bounds(k_dmn);
-
-  k_dmn_t q_dmn;
-  std::pair<int, int> q_bounds = dca::parallel::util::getBounds(id, nr_threads, q_dmn);
-
-  for (int q_ind = q_bounds.first; q_ind < q_bounds.second; ++q_ind) {
-    double percentage = double(q_ind - q_bounds.first) / double(q_bounds.second - q_bounds.first);
-
-    if (concurrency.id() == concurrency.first() and id == 0 and (int(100 * percentage) % 10 == 0))
-      std::cout << "\t" << int(100 * percentage) << " % finished\t" << dca::util::print_time()
-                << "\n";
-
-    for (int k_ind = k_bounds.first; k_ind < k_bounds.second; ++k_ind) {
-      int k_plus_q = k_dmn_t::parameter_type::add(q_ind, k_ind);
-
-      for (int nu_ind = 0; nu_ind < w_VERTEX_BOSONIC::dmn_size(); ++nu_ind) {
-        int nu_c = (nu_ind - w_VERTEX_BOSONIC::dmn_size() / 2);
-
-        for (int w_ind = std::fabs(nu_c); w_ind < w_dmn_t::dmn_size() - std::fabs(nu_c); ++w_ind) {
-          int w_plus_nu = w_ind + nu_c;
-
-          for (int j1 = 0; j1 < b::dmn_size(); ++j1)
-            for (int j0 = 0; j0 < b::dmn_size(); ++j0)
-              for (int i1 = 0; i1 < b::dmn_size(); ++i1)
-                for (int i0 = 0; i0 < b::dmn_size(); ++i0)
-                  chi(i0, i1, j0, j1, q_ind, nu_ind) +=
-                      G(i0, j1, k_ind, w_ind) * G(i1, j0, k_plus_q, w_plus_nu);
-        }
-      }
-    }
-  }
-}
-
 template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
 void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_on_cluster_pp(
     G_function_type& G) {
@@ -250,7 +298,7 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_o
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\n\t\t pp-buble \n\n" << std::endl;
 
-  chi.get_name() = "pp-bubble";
+  chi.set_name("pp-bubble");
 
   chi = 0.;
 
@@ -281,43 +329,6 @@ void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::execute_o
   chi *= factor;
 }
 
-template <channel_type channel_value, class parameters_type, class k_dmn_t, class w_dmn_t>
-void compute_bubble<channel_value, parameters_type, k_dmn_t, w_dmn_t>::threaded_execute_on_cluster_pp(
-    int id, const int nr_threads, G_function_type& G) {
-  k_dmn_t k_dmn;
-  std::pair<int, int> k_bounds = concurrency.get_bounds(k_dmn);
-
-  k_dmn_t q_dmn;
-  std::pair<int, int> q_bounds = dca::parallel::util::getBounds(id, nr_threads, q_dmn);
-
-  for (int q_ind = q_bounds.first; q_ind < q_bounds.second; ++q_ind) {
-    double percentage = double(q_ind - q_bounds.first) / double(q_bounds.second - q_bounds.first);
-
-    if (concurrency.id() == concurrency.first() and id == 0 and (int(100 * percentage) % 10 == 0))
-      std::cout << "\t" << int(100 * percentage) << " % finished\t" << dca::util::print_time()
-                << "\n";
-
-    for (int k_ind = k_bounds.first; k_ind < k_bounds.second; ++k_ind) {
-      int q_minus_k = k_dmn_t::parameter_type::subtract(k_ind, q_ind);
-
-      for (int nu_ind = 0; nu_ind < w_VERTEX_BOSONIC::dmn_size(); ++nu_ind) {
-        int nu_c = (nu_ind - w_VERTEX_BOSONIC::dmn_size() / 2);
-
-        for (int w_ind = std::fabs(nu_c); w_ind < w_dmn_t::dmn_size() - std::fabs(nu_c); ++w_ind) {
-          int nu_minus_w = nu_c + (w::dmn_size() - 1 - w_ind);
-
-          for (int j1 = 0; j1 < b::dmn_size(); ++j1)
-            for (int j0 = 0; j0 < b::dmn_size(); ++j0)
-              for (int i1 = 0; i1 < b::dmn_size(); ++i1)
-                for (int i0 = 0; i0 < b::dmn_size(); ++i0)
-                  chi(i0, i1, j0, j1, q_ind, nu_ind) +=
-                      G(i0, j0, k_ind, w_ind) * G(i1, j1, q_minus_k, nu_minus_w);
-        }
-      }
-    }
-  }
-}
-
 }  // htseries
 }  // solver
 }  // phys
@@ -13,6 +13,7 @@
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_HIGH_TEMPERATURE_SERIES_EXPANSION_SIGMA_PERTURBATION_HPP
 
 #include <complex>
+#include <cstdlib>
 #include <iostream>
 #include <utility>
 
@@ -20,6 +21,7 @@
 #include "dca/function/function.hpp"
 #include "dca/parallel/util/get_bounds.hpp"
 #include "dca/parallel/thread_manager_sum.hpp"
+#include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/cluster_fourier_transform.hpp"
 #include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/compute_bubble.hpp"
 #include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/compute_interaction.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
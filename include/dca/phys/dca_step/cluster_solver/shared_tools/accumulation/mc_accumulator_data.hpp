@@ -31,6 +31,13 @@ public:
     return number_of_measurements;
   }
 
+  // Sum of the signs of the measurements that contributed to the two-particle quantities, which
+  // might be measured less often than the single-particle ones. The two-particle quantities are
+  // normalized by it.
+  int get_accumulated_tp_sign() const {
+    return accumulated_tp_sign;
+  }
+
   double get_average_sign() const {
     return static_cast<double>(accumulated_sign) / static_cast<double>(number_of_measurements);
   }
@@ -44,6 +51,8 @@ public:
     accumulated_sign = 0;
 
     number_of_measurements = 0;
+
+    accumulated_tp_sign = 0;
   }
 
 protected:
@@ -55,6 +64,8 @@ protected:
   int accumulated_sign;
 
   int number_of_measurements;
+
+  int accumulated_tp_sign;
 };
 
 }  // solver
@@ -0,0 +1,367 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class measures the single-particle function M_r_w by projecting the contribution of each
+// pair of vertices on the Legendre basis of phys::domains::LegendreDomain.
+// In finalize the coefficients are transformed to the Matsubara frequencies that the basis
+// resolves. The remaining high frequencies are computed from the first moments of the expansion,
+//     M(i w) = c_0 + c_1 / (i w) + c_2 / (i w)^2,
+// which are less noisy than the direct measurement. The equal time contributions (i == j) form
+// the constant c_0 and are accumulated separately, c_1 and c_2 are fitted to the highest resolved
+// frequencies.
+// It provides the same interface as SpAccumulator<Parameters, linalg::CPU>.
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_SP_SP_LEGENDRE_ACCUMULATOR_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_SP_SP_LEGENDRE_ACCUMULATOR_HPP
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/linalg/matrix.hpp"
+#include "dca/math/function_transform/legendre_transform.hpp"
+#include "dca/phys/domains/quantum/electron_band_domain.hpp"
+#include "dca/phys/domains/quantum/electron_spin_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/legendre_domain.hpp"
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace accumulator {
+// dca::phys::solver::accumulator::
+
+template <class Parameters>
+class SpLegendreAccumulator {
+protected:
+  using WDmn = func::dmn_0<domains::frequency_domain>;
+  using LDmn = func::dmn_0<domains::LegendreDomain>;
+  using BDmn = func::dmn_0<domains::electron_band_domain>;
+  using SDmn = func::dmn_0<domains::electron_spin_domain>;
+  using RDmn = typename Parameters::RClusterDmn;
+
+  using NuDmn = func::dmn_variadic<BDmn, SDmn>;  // orbital-spin index
+  using PDmn = func::dmn_variadic<BDmn, BDmn, RDmn>;
+
+  using Transform = math::transform::LegendreTransform<LDmn, WDmn>;
+
+public:
+  using ScalarType = typename Parameters::MC_measurement_scalar_type;
+
+  SpLegendreAccumulator(/*const*/ Parameters& parameters_ref, bool accumulate_m_squared = false);
+
+  void resetAccumulation();
+
+  template <class Configuration>
+  void accumulate(const std::array<linalg::Matrix<ScalarType, linalg::CPU>, 2>& Ms,
+                  const std::array<Configuration, 2>& configs, const int sign);
+
+  void finalize();
+
+  void sumTo(SpLegendreAccumulator<Parameters>& other) const;
+
+  void synchronizeCopy() {}
+
+  const auto& get_sign_times_M_r_w() const;
+
+  const auto& get_sign_times_M_r_w_sqr() const;
+
+  template <class T>
+  void syncStreams(const T&) {}
+
+  int deviceFingerprint() const {
+    return 0;
+  }
+
+  // Returns the number of Matsubara frequencies, starting from the smallest positive one, that
+  // are computed from the Legendre coefficients.
+  static int get_resolved_frequencies();
+
+protected:
+  /*const*/ Parameters& parameters_;
+
+  bool initialized_ = false;
+  bool finalized_ = false;
+
+  const bool accumulate_m_sqr_ = true;
+
+  using MFunction =
+      func::function<std::complex<double>, func::dmn_variadic<NuDmn, NuDmn, RDmn, WDmn>>;
+  std::unique_ptr<MFunction> M_r_w_, M_r_w_sqr_;
+
+private:
+  // Legendre coefficients and equal time contributions.
+  using CoefficientsFunction = func::function<double, func::dmn_variadic<PDmn, SDmn, LDmn>>;
+  using ConstantFunction = func::function<double, func::dmn_variadic<PDmn, SDmn>>;
+
+  struct Coefficients {
+    CoefficientsFunction legendre{"M_r_l"};
+    ConstantFunction equal_time{"M_r_equal_time"};
+
+    Coefficients& operator+=(const Coefficients& other) {
+      legendre += other.legendre;
+      equal_time += other.equal_time;
+      return *this;
+    }
+  };
+
+  void finalizeFunction(const Coefficients& coefficients, MFunction& function) const;
+
+  std::unique_ptr<Coefficients> coefficients_;
+  std::unique_ptr<Coefficients> coefficients_sqr_;
+
+  // Work space of the vectorized recurrence.
+  std::vector<int> index_;
+  std::vector<double> x_;
+  std::vector<double> f_;
+  std::vector<double> f_sqr_;
+  std::vector<double> p_;
+  std::vector<double> p_prev_;
+};
+
+template <class Parameters>
+SpLegendreAccumulator<Parameters>::SpLegendreAccumulator(/*const*/ Parameters& parameters_ref,
+                                                         const bool accumulate_m_sqr)
+    : parameters_(parameters_ref), accumulate_m_sqr_(accumulate_m_sqr) {}
+
+template <class Parameters>
+void SpLegendreAccumulator<Parameters>::resetAccumulation() {
+  coefficients_ = std::make_unique<Coefficients>();
+  if (accumulate_m_sqr_)
+    coefficients_sqr_ = std::make_unique<Coefficients>();
+
+  M_r_w_.reset();
+  M_r_w_sqr_.reset();
+  finalized_ = false;
+  initialized_ = true;
+}
+
+template <class Parameters>
+template <class Configuration>
+void SpLegendreAccumulator<Parameters>::accumulate(
+    const std::array<linalg::Matrix<ScalarType, linalg::CPU>, 2>& Ms,
+    const std::array<Configuration, 2>& configs, const int sign) {
+  if (!initialized_)
+    throw(std::logic_error("The accumulator was not initialized."));
+
+  const func::dmn_variadic<PDmn> bbr_dmn;
+  const int n_l = LDmn::dmn_size();
+  const double beta = parameters_.get_beta();
+  const int stride_l = PDmn::dmn_size() * SDmn::dmn_size();
+
+  auto accumulate_column = [&](const int n, const int offset, const std::vector<double>& f,
+                               Coefficients& coefficients) {
+    double* const m_l = coefficients.legendre.values() + offset;
+
+    for (int i = 0; i < n; ++i) {
+      p_[i] = 1.;
+      p_prev_[i] = 0.;
+    }
+
+    // Recurrence (l + 1) P_{l+1} = (2l + 1) x P_l - l P_{l-1}, vectorized over the pairs.
+    for (int l = 0; l < n_l; ++l) {
+      const double norm = std::sqrt(2. * l + 1.);
+      double* const m = m_l + stride_l * l;
+      for (int i = 0; i < n; ++i)
+        m[index_[i]] += norm * f[i] * p_[i];
+
+      const double a = (2. * l + 1.) / (l + 1.);
+      const double b = l / (l + 1.);
+      for (int i = 0; i < n; ++i) {
+        const double p_next = a * x_[i] * p_[i] - b * p_prev_[i];
+        p_prev_[i] = p_[i];
+        p_[i] = p_next;
+      }
+    }
+  };
+
+  for (int s = 0; s < 2; ++s) {
+    const auto& config = configs[s];
+    const int n = config.size();
+    index_.resize(n);
+    x_.resize(n);
+    f_.resize(n);
+    f_sqr_.resize(n);
+    p_.resize(n);
+    p_prev_.resize(n);
+
+    const int offset = PDmn::dmn_size() * s;
+
+    for (int j = 0; j < n; j++) {
+      const int b_j = config[j].get_left_band();
+      const int r_j = config[j].get_left_site();
+      const double t_j = config[j].get_tau();
+
+      // Pairs with i != j are compacted in the work space.
+      int n_pairs = 0;
+      for (int i = 0; i < n; i++) {
+        const int b_i = config[i].get_right_band();
+        const int r_i = config[i].get_right_site();
+        const int delta_r = RDmn::parameter_type::subtract(r_j, r_i);
+        const int index = bbr_dmn(b_i, b_j, delta_r);
+        const double f_val = sign * Ms[s](i, j);
+
+        if (i == j) {
+          coefficients_->equal_time(index, s) += f_val;
+          if (accumulate_m_sqr_)
+            coefficients_sqr_->equal_time(index, s) += f_val * f_val * sign;
+          continue;
+        }
+
+        // Map tau in (-beta, beta) to [0, beta) using the antiperiodicity.
+        double tau = config[i].get_tau() - t_j;
+        double f_antiperiodic = f_val;
+        if (tau < 0) {
+          tau += beta;
+          f_antiperiodic = -f_val;
+        }
+
+        index_[n_pairs] = index;
+        x_[n_pairs] = 2. * tau / beta - 1.;
+        f_[n_pairs] = f_antiperiodic;
+        f_sqr_[n_pairs] = f_antiperiodic * f_val * sign;
+        ++n_pairs;
+      }
+
+      accumulate_column(n_pairs, offset, f_, *coefficients_);
+      if (accumulate_m_sqr_)
+        accumulate_column(n_pairs, offset, f_sqr_, *coefficients_sqr_);
+    }
+  }
+}
+
+template <class Parameters>
+void SpLegendreAccumulator<Parameters>::finalize() {
+  if (finalized_)
+    return;
+
+  M_r_w_.reset(new MFunction("M_r_w"));
+  finalizeFunction(*coefficients_, *M_r_w_);
+
+  if (accumulate_m_sqr_) {
+    M_r_w_sqr_.reset(new MFunction("M_r_w_sqr"));
+    finalizeFunction(*coefficients_sqr_, *M_r_w_sqr_);
+  }
+
+  finalized_ = true;
+  initialized_ = false;
+}
+
+template <class Parameters>
+void SpLegendreAccumulator<Parameters>::finalizeFunction(const Coefficients& coefficients,
+                                                         MFunction& function) const {
+  func::function<std::complex<double>, func::dmn_variadic<PDmn, SDmn, WDmn>> tmp("tmp");
+  Transform::legendreToMatsubara(coefficients.legendre, tmp);
+
+  const int n_w = WDmn::dmn_size();
+  const int n_resolved = get_resolved_frequencies();
+  const double normalization = 1. / RDmn::dmn_size();
+  const auto& freqs = WDmn::get_elements();
+
+  // Distance from the center, 0 for the smallest positive and negative frequency.
+  auto distance = [n_w](const int w) { return w < n_w / 2 ? n_w / 2 - 1 - w : w - n_w / 2; };
+
+  for (int s = 0; s < SDmn::dmn_size(); ++s)
+    for (int p = 0; p < PDmn::dmn_size(); ++p) {
+      const double c0 = coefficients.equal_time(p, s);
+
+      // Least squares fit of the real moments c_1 and c_2 on the upper half of the resolved
+      // frequencies. The imaginary part determines c_1, the real part c_2.
+      double c1 = 0, c2 = 0, norm1 = 0, norm2 = 0;
+      for (int w = 0; w < n_w; ++w) {
+        if (distance(w) < n_resolved)
+          tmp(p, s, w) += c0;
+        if (distance(w) < n_resolved / 2 || distance(w) >= n_resolved)
+          continue;
+        const double a = -1. / freqs[w];
+        const double b = -a * a;
+        c1 += a * (tmp(p, s, w) - c0).imag();
+        c2 += b * (tmp(p, s, w) - c0).real();
+        norm1 += a * a;
+        norm2 += b * b;
+      }
+      if (norm1 > 0) {
+        c1 /= norm1;
+        c2 /= norm2;
+      }
+
+      for (int w = 0; w < n_w; ++w) {
+        if (distance(w) >= n_resolved) {
+          const std::complex<double> iw(0., freqs[w]);
+          tmp(p, s, w) = c0 + c1 / iw + c2 / (iw * iw);
+        }
+      }
+    }
+
+  const func::dmn_variadic<PDmn> bbr_dmn;
+  for (int w = 0; w < n_w; ++w)
+    for (int r = 0; r < RDmn::dmn_size(); ++r)
+      for (int b2 = 0; b2 < BDmn::dmn_size(); ++b2)
+        for (int b1 = 0; b1 < BDmn::dmn_size(); ++b1)
+          for (int s = 0; s < SDmn::dmn_size(); ++s)
+            function(b1, s, b2, s, r, w) = tmp(bbr_dmn(b1, b2, r), s, w) * normalization;
+}
+
+template <class Parameters>
+int SpLegendreAccumulator<Parameters>::get_resolved_frequencies() {
+  // A frequency is resolved if the basis represents e^{i w tau}: \sum_l |T(w, l)|^2 ~ 1.
+  static const int n_resolved = [] {
+    const auto& t = Transform::get_matsubara_matrix();
+    const int n_w = WDmn::dmn_size();
+    int n = 0;
+    for (int w = n_w / 2; w < n_w; ++w, ++n) {
+      double norm = 0;
+      for (int l = 0; l < LDmn::dmn_size(); ++l)
+        norm += std::norm(t[w + n_w * l]);
+      if (norm < 1. - 1.e-12)
+        break;
+    }
+    return n;
+  }();
+
+  return n_resolved;
+}
+
+template <class Parameters>
+void SpLegendreAccumulator<Parameters>::sumTo(SpLegendreAccumulator<Parameters>& other) const {
+  if (!other.coefficients_)
+    other.coefficients_ = std::make_unique<Coefficients>();
+  if (!other.coefficients_sqr_ && accumulate_m_sqr_)
+    other.coefficients_sqr_ = std::make_unique<Coefficients>();
+
+  *other.coefficients_ += *coefficients_;
+  if (accumulate_m_sqr_)
+    *other.coefficients_sqr_ += *coefficients_sqr_;
+}
+
+template <class Parameters>
+const auto& SpLegendreAccumulator<Parameters>::get_sign_times_M_r_w() const {
+  if (!finalized_)
+    throw(std::logic_error("The accumulator was not finalized."));
+  return *M_r_w_;
+}
+
+template <class Parameters>
+const auto& SpLegendreAccumulator<Parameters>::get_sign_times_M_r_w_sqr() const {
+  if (!finalized_)
+    throw(std::logic_error("The accumulator was not finalized."));
+  if (!accumulate_m_sqr_)
+    throw(std::logic_error("M squared was not accumulated."));
+  return *M_r_w_sqr_;
+}
+
+}  // accumulator
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_SP_SP_LEGENDRE_ACCUMULATOR_HPP
@@ -0,0 +1,129 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class partitions, for each momentum exchange, the (b1, b2, b3, b4, k1, k2) indices of the
+// two particle Green's function into orbits of the cluster symmetry operations that leave the
+// momentum exchange invariant. Each orbit is labeled by an irreducible index.
+// The operations act on the indices as in symmetrize_two_particle_function, hence the sum of G4
+// over an orbit divided by the orbit size equals the symmetrized G4 on every element of the orbit.
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_TP_G4_SYMMETRY_ORBITS_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_TP_G4_SYMMETRY_ORBITS_HPP
+
+#include <vector>
+
+#include "dca/phys/domains/cluster/cluster_symmetry.hpp"
+#include "dca/phys/domains/cluster/momentum_exchange_domain.hpp"
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace accumulator {
+// dca::phys::solver::accumulator::
+
+template <class KDmn, class BDmn>
+class G4SymmetryOrbits {
+public:
+  G4SymmetryOrbits();
+
+  // Returns the number of irreducible indices, summed over all the momentum exchanges.
+  int size() const {
+    return orbit_size_.size();
+  }
+
+  // Returns the irreducible index of the element (b1, b2, b3, b4, k1, k2) of the momentum exchange
+  // k_ex_idx, where 'tuple' is the linear index of (b1, b2, b3, b4, k1, k2).
+  int irreducibleIndex(const int tuple, const int k_ex_idx) const {
+    return irreducible_index_[tuple + n_tuples_ * k_ex_idx];
+  }
+
+  // Returns the number of elements in the orbit with irreducible index 'index'.
+  int orbitSize(const int index) const {
+    return orbit_size_[index];
+  }
+
+private:
+  const int n_bands_;
+  const int n_k_;
+  const int n_tuples_;
+
+  std::vector<int> irreducible_index_;
+  std::vector<int> orbit_size_;
+};
+
+template <class KDmn, class BDmn>
+G4SymmetryOrbits<KDmn, BDmn>::G4SymmetryOrbits()
+    : n_bands_(BDmn::dmn_size()),
+      n_k_(KDmn::dmn_size()),
+      n_tuples_(n_bands_ * n_bands_ * n_bands_ * n_bands_ * n_k_ * n_k_) {
+  using KCluster = typename KDmn::parameter_type;
+  using SymmetryDmn = typename domains::cluster_symmetry<KCluster>::sym_super_cell_dmn_t;
+  const auto& symmetry_matrix = domains::cluster_symmetry<KCluster>::get_symmetry_matrix();
+
+  const auto& exchange_mom = domains::MomentumExchangeDomain::get_elements();
+  irreducible_index_.resize(n_tuples_ * exchange_mom.size(), -1);
+
+  std::vector<int> tuple(6);
+  auto decode = [&](int index) {
+    for (int i = 0; i < 4; ++i, index /= n_bands_)
+      tuple[i] = index % n_bands_;
+    tuple[4] = index % n_k_;
+    tuple[5] = index / n_k_;
+  };
+  auto encode = [&](const int b1, const int b2, const int b3, const int b4, const int k1,
+                    const int k2) {
+    return b1 + n_bands_ * (b2 + n_bands_ * (b3 + n_bands_ * (b4 + n_bands_ * (k1 + n_k_ * k2))));
+  };
+
+  std::vector<int> stack;
+  for (int k_ex_idx = 0; k_ex_idx < exchange_mom.size(); ++k_ex_idx) {
+    const int k_ex = exchange_mom[k_ex_idx];
+    int* const index = irreducible_index_.data() + n_tuples_ * k_ex_idx;
+
+    // Operations leaving the momentum exchange invariant.
+    std::vector<int> little_group;
+    for (int s = 0; s < SymmetryDmn::dmn_size(); ++s)
+      if (symmetry_matrix(k_ex, 0, s).first == k_ex)
+        little_group.push_back(s);
+
+    for (int start = 0; start < n_tuples_; ++start) {
+      if (index[start] != -1)
+        continue;
+
+      const int label = orbit_size_.size();
+      orbit_size_.push_back(0);
+      index[start] = label;
+      stack.push_back(start);
+
+      while (!stack.empty()) {
+        decode(stack.back());
+        stack.pop_back();
+        ++orbit_size_[label];
+
+        const int b1 = tuple[0], b2 = tuple[1], b3 = tuple[2], b4 = tuple[3];
+        const int k1 = tuple[4], k2 = tuple[5];
+        for (const int s : little_group) {
+          const int image = encode(
+              symmetry_matrix(0, b1, s).second, symmetry_matrix(k1, b2, s).second,
+              symmetry_matrix(0, b3, s).second, symmetry_matrix(k2, b4, s).second,
+              symmetry_matrix(k1, b2, s).first, symmetry_matrix(k2, b4, s).first);
+          if (index[image] == -1) {
+            index[image] = label;
+            stack.push_back(image);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // accumulator
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_TP_G4_SYMMETRY_ORBITS_HPP
@@ -7,6 +7,13 @@
 // Author: Giovanni Balduzzi (gbalduzz@itp.phys.ethz.ch)
 //
 // This class computes the two particle Green's function from the walker's M matrix.
+// The single-particle Green's functions of up to get_four_point_batch_size() measurements are
+// buffered and added to G4 together, such that G4 is streamed through memory once per batch
+// rather than once per measurement.
+// If irreducible_storage() is set, only one entry per orbit of the cluster symmetries is stored
+// during the accumulation (see G4SymmetryOrbits), and the full, symmetrized, G4 is expanded by
+// finalize(). This reduces the memory of the accumulator, but not the cost of the update, since
+// every element of an orbit contributes to its irreducible entry.
 
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_TP_TP_ACCUMULATOR_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_ACCUMULATION_TP_TP_ACCUMULATOR_HPP
@@ -16,12 +23,14 @@
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <vector>
 
 #include "dca/config/config_defines.hpp"
 #include "dca/linalg/matrix.hpp"
 #include "dca/linalg/matrix_view.hpp"
 #include "dca/linalg/matrixop.hpp"
 #include "dca/math/function_transform/special_transforms/space_transform_2D.hpp"
+#include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/tp/g4_symmetry_orbits.hpp"
 #include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/tp/ndft/cached_ndft_cpu.hpp"
 #include "dca/phys/domains/cluster/momentum_exchange_domain.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
@@ -77,13 +86,16 @@ public:
   double accumulate(const std::array<linalg::Matrix<Real, linalg::CPU>, 2>& M_pair,
                     const std::array<Configuration, 2>& configs, int sign);
 
-  // Empty method for compatibility with GPU version.
-  void finalize() {}
+  // Adds the measurements still buffered to G4, and expands the irreducible entries of G4 if
+  // irreducible_storage() is set. G4 vanishes if no measurement has been accumulated.
+  void finalize();
 
   // Returns the accumulated Green's function.
+  // Precondition: finalize() has been called after the last measurement.
   const auto& get_sign_times_G4() const;
 
   // Sums the accumulated Green's function to the accumulated Green's function of other_acc.
+  // Does nothing if no measurement has been accumulated.
   void sumTo(this_type& other_acc);
 
   void synchronizeCopy() {}
@@ -120,13 +132,14 @@ protected:
 
   double computeG();
 
-  void computeGMultiband(int s, int k1, int k2, int w1, int w2);
+  void computeGMultiband(SpGreenFunction& G, int s, int k1, int k2, int w1, int w2);
 
-  void computeGSingleband(int s, int k1, int k2, int w1, int w2);
+  void computeGSingleband(SpGreenFunction& G, int s, int k1, int k2, int w1, int w2);
 
-  void getGMultiband(int s, int k1, int k2, int w1, int w2, Matrix& G, Complex beta = 0) const;
+  void getGMultiband(const SpGreenFunction& G, int s, int k1, int k2, int w1, int w2,
+                     Matrix& G_out, Complex beta = 0) const;
 
-  Complex getGSingleband(int s, int k1, int k2, int w1, int w2) const;
+  Complex getGSingleband(const SpGreenFunction& G, int s, int k1, int k2, int w1, int w2) const;
 
   template <class Configuration>
   double computeM(const std::array<linalg::Matrix<Real, linalg::CPU>, 2>& M_pair,
@@ -134,6 +147,11 @@ protected:
 
   double updateG4();
 
+  // Adds to G4, with a few matrix-matrix multiplications over the batch of buffered measurements,
+  // the term alpha * (G_up + sign * G_down)(k1, k1 + k_ex) (G_up + sign * G_down)(k2 + k_ex, k2)
+  // of the particle-hole channels.
+  void updateG4SpinDifferenceBatched(int sign, Real alpha);
+
   void inline updateG4Atomic(Complex* G4_ptr, int s_a, int k1_a, int k2_a, int w1_a, int w2_a,
                              int s_b, int k1_b, int k2_b, int w1_b, int w2_b, Real alpha,
                              bool cross_legs);
@@ -142,6 +160,17 @@ protected:
                                      int w2_a, int k1_b, int k2_b, int w1_b, int w2_b, Real alpha,
                                      bool cross_legs);
 
+  // Adds alpha times the product of G_a_ and G_b_ to the band indices of a G4 element.
+  void inline updateG4Bands(Complex* G4_ptr, Real alpha, bool cross_legs);
+
+  // Returns a pointer to the band indices of the G4 element (k1, k2, k_ex, w1, w2, w_ex) to update.
+  // With irreducible storage this is a zeroed work space, which commitG4Block adds to the
+  // irreducible entries.
+  Complex* getG4Block(int k1, int k2, int k_ex, int w1, int w2, int w_ex);
+  void commitG4Block(int k1, int k2, int k_ex, int w1, int w2, int w_ex);
+
+  void expandG4();
+
 protected:
   const func::function<std::complex<double>, func::dmn_variadic<NuDmn, NuDmn, KDmn, WDmn>>* const G0_ptr_ =
       nullptr;
@@ -156,10 +185,21 @@ protected:
       models::has_non_density_interaction<typename Parameters::lattice_type>::value;
   CachedNdft<Real, RDmn, WTpExtDmn, WTpExtPosDmn, linalg::CPU, non_density_density_> ndft_obj_;
 
-  SpGreenFunction G_;
+  // Single-particle Green's functions and signs of the measurements not yet added to G4.
+  std::vector<SpGreenFunction> G_;
+  std::vector<int> signs_;
+  int n_batched_ = 0;
+  const int batch_size_ = 1;
 
   std::unique_ptr<TpGreenFunction> G4_;
 
+  const bool irreducible_storage_ = false;
+  // Shared with the accumulators this one is summed to.
+  std::shared_ptr<const G4SymmetryOrbits<KDmn, BDmn>> orbits_;
+  // Irreducible entries of G4, stored as [irreducible index, w1, w2, w_ex].
+  std::vector<Complex> G4_irreducible_;
+  std::vector<Complex> G4_block_;
+
   func::function<Complex, func::dmn_variadic<BDmn, BDmn, SDmn, KDmn, WTpExtDmn>> G0_;
 
   int sign_;
@@ -170,6 +210,8 @@ protected:
 private:
   // work spaces for computeGMultiband.
   Matrix G0_M_, G_a_, G_b_;
+  // work spaces for updateG4SpinDifferenceBatched.
+  Matrix G4_a_, G4_b_, G4_ab_;
 };
 
 template <class Parameters>
@@ -180,6 +222,10 @@ TpAccumulator<Parameters, linalg::CPU>::TpAccumulator(
       thread_id_(thread_id),
       mode_(pars.get_four_point_type()),
       beta_(pars.get_beta()),
+      G_(1),
+      signs_(1),
+      batch_size_(pars.get_four_point_batch_size()),
+      irreducible_storage_(pars.irreducible_storage()),
       extension_index_offset_((WTpExtDmn::dmn_size() - WTpDmn::dmn_size()) / 2),
       n_pos_frqs_(WTpExtPosDmn::dmn_size()),
       G0_M_(n_bands_),
@@ -187,12 +233,20 @@ TpAccumulator<Parameters, linalg::CPU>::TpAccumulator(
       G_b_(n_bands_) {
   if (WDmn::dmn_size() < WTpExtDmn::dmn_size())
     throw(std::logic_error("The number of single particle frequencies is too small."));
+  if (batch_size_ < 1)
+    throw(std::logic_error("The four-point batch size must be positive."));
   initializeG0();
 }
 
 template <class Parameters>
 void TpAccumulator<Parameters, linalg::CPU>::resetAccumulation(unsigned int /*dca_loop*/) {
-  G4_.reset(new TpGreenFunction("G4"));
+  if (irreducible_storage_) {
+    G4_.reset();
+    G4_irreducible_.clear();
+  }
+  else
+    G4_.reset(new TpGreenFunction("G4"));
+  n_batched_ = 0;
   initializeG0();
 }
 
@@ -220,13 +274,32 @@ double TpAccumulator<Parameters, linalg::CPU>::accumulate(
   if (!(configs[0].size() + configs[1].size()))  // empty config
     return gflops;
 
+  if (G_.size() < batch_size_) {
+    G_.resize(batch_size_);
+    signs_.resize(batch_size_);
+  }
+
   sign_ = sign;
+  signs_[n_batched_] = sign;
   gflops += computeM(M_pair, configs);
   gflops += computeG();
-  gflops += updateG4();
+  ++n_batched_;
+
+  if (n_batched_ == batch_size_)
+    gflops += updateG4();
   return gflops;
 }
 
+template <class Parameters>
+void TpAccumulator<Parameters, linalg::CPU>::finalize() {
+  if (n_batched_)
+    updateG4();
+  if (irreducible_storage_ && G4_irreducible_.size())
+    expandG4();
+  else if (!G4_)
+    G4_.reset(new TpGreenFunction("G4"));
+}
+
 template <class Parameters>
 template <class Configuration>
 double TpAccumulator<Parameters, linalg::CPU>::computeM(
@@ -245,7 +318,7 @@ double TpAccumulator<Parameters, linalg::CPU>::computeM(
 
   Profiler prf_b("Space FT", "tp-accumulation", __LINE__, thread_id_);
   // TODO: add the gflops here.
-  math::transform::SpaceTransform2D<RDmn, KDmn, Real>::execute(M_r_r_w_w, G_);
+  math::transform::SpaceTransform2D<RDmn, KDmn, Real>::execute(M_r_r_w_w, G_[n_batched_]);
 
   return gflops;
 }
@@ -253,6 +326,7 @@ double TpAccumulator<Parameters, linalg::CPU>::computeM(
 template <class Parameters>
 double TpAccumulator<Parameters, linalg::CPU>::computeG() {
   Profiler prf("ComputeG", "tp-accumulation", __LINE__, thread_id_);
+  SpGreenFunction& G = G_[n_batched_];
   for (int w2 = 0; w2 < WTpExtDmn::dmn_size(); ++w2)
     for (int w1 = 0; w1 < WTpExtPosDmn::dmn_size(); ++w1)
       for (int k2 = 0; k2 < KDmn::dmn_size(); ++k2)
@@ -260,10 +334,10 @@ double TpAccumulator<Parameters, linalg::CPU>::computeG() {
           for (int s = 0; s < 2; ++s)
             switch (n_bands_) {
               case 1:
-                computeGSingleband(s, k1, k2, w1, w2);
+                computeGSingleband(G, s, k1, k2, w1, w2);
                 break;
               default:
-                computeGMultiband(s, k1, k2, w1, w2);
+                computeGMultiband(G, s, k1, k2, w1, w2);
             }
   //  INTERNAL: the additional flops for w1==w2 are ignored.
   const Real flops = 8 * std::pow(n_bands_, 3) * WTpExtPosDmn::dmn_size() * WTpExtDmn::dmn_size() *
@@ -272,33 +346,33 @@ double TpAccumulator<Parameters, linalg::CPU>::computeG() {
 }
 
 template <class Parameters>
-void TpAccumulator<Parameters, linalg::CPU>::computeGSingleband(const int s, const int k1,
-                                                                const int k2, const int w1,
-                                                                const int w2) {
+void TpAccumulator<Parameters, linalg::CPU>::computeGSingleband(SpGreenFunction& G, const int s,
+                                                                const int k1, const int k2,
+                                                                const int w1, const int w2) {
   assert(w1 < WTpExtPosDmn::dmn_size());
   assert(w2 < WTpExtDmn::dmn_size());
 
   const Complex G0_w1 = G0_(0, 0, s, k1, w1 + n_pos_frqs_);
   const Complex G0_w2 = G0_(0, 0, s, k2, w2);
-  const Complex M_val = G_(0, 0, s, k1, k2, w1, w2);
+  const Complex M_val = G(0, 0, s, k1, k2, w1, w2);
 
   if (k2 == k1 && w2 == w1 + n_pos_frqs_)
-    G_(0, 0, s, k1, k2, w1, w2) = -G0_w1 * M_val * G0_w2 + G0_w1 * beta_;
+    G(0, 0, s, k1, k2, w1, w2) = -G0_w1 * M_val * G0_w2 + G0_w1 * beta_;
   else
-    G_(0, 0, s, k1, k2, w1, w2) = -G0_w1 * M_val * G0_w2;
+    G(0, 0, s, k1, k2, w1, w2) = -G0_w1 * M_val * G0_w2;
 }
 
 template <class Parameters>
-void TpAccumulator<Parameters, linalg::CPU>::computeGMultiband(const int s, const int k1,
-                                                               const int k2, const int w1,
-                                                               const int w2) {
+void TpAccumulator<Parameters, linalg::CPU>::computeGMultiband(SpGreenFunction& G, const int s,
+                                                               const int k1, const int k2,
+                                                               const int w1, const int w2) {
   assert(w1 < WTpExtPosDmn::dmn_size());
   assert(w2 < WTpExtDmn::dmn_size());
 
   const linalg::MatrixView<Complex, linalg::CPU> G0_w1(&G0_(0, 0, s, k1, w1 + n_pos_frqs_),
                                                        n_bands_, n_bands_);
   const linalg::MatrixView<Complex, linalg::CPU> G0_w2(&G0_(0, 0, s, k2, w2), n_bands_, n_bands_);
-  linalg::MatrixView<Complex, linalg::CPU> M_matrix(&G_(0, 0, s, k1, k2, w1, w2), n_bands_);
+  linalg::MatrixView<Complex, linalg::CPU> M_matrix(&G(0, 0, s, k1, k2, w1, w2), n_bands_);
 
   // G(w1, w2) <- -G0(w1) M(w1, w2) G0(w2)
   linalg::matrixop::gemm(G0_w1, M_matrix, G0_M_);
@@ -314,8 +388,8 @@ void TpAccumulator<Parameters, linalg::CPU>::computeGMultiband(const int s, cons
 
 template <class Parameters>
 std::complex<typename TpAccumulator<Parameters, linalg::CPU>::Real> TpAccumulator<
-    Parameters, linalg::CPU>::getGSingleband(const int s, const int k1, const int k2, const int w1,
-                                             const int w2) const {
+    Parameters, linalg::CPU>::getGSingleband(const SpGreenFunction& G, const int s, const int k1,
+                                             const int k2, const int w1, const int w2) const {
   const int w2_ext = w2 + extension_index_offset_;
   const int w1_ext = w1 + extension_index_offset_;
   auto minus_w1 = [=](const int w) { return n_pos_frqs_ - 1 - w; };
@@ -328,14 +402,15 @@ std::complex<typename TpAccumulator<Parameters, linalg::CPU>::Real> TpAccumulato
   };
 
   if (w1_ext >= n_pos_frqs_)
-    return G_(0, 0, s, k1, k2, plus_w1(w1_ext), w2_ext);
+    return G(0, 0, s, k1, k2, plus_w1(w1_ext), w2_ext);
   else
-    return std::conj(G_(0, 0, s, minus_k(k1), minus_k(k2), minus_w1(w1_ext), minus_w2(w2_ext)));
+    return std::conj(G(0, 0, s, minus_k(k1), minus_k(k2), minus_w1(w1_ext), minus_w2(w2_ext)));
 }
 
 template <class Parameters>
-void TpAccumulator<Parameters, linalg::CPU>::getGMultiband(int s, int k1, int k2, int w1, int w2,
-                                                           Matrix& G, const Complex beta) const {
+void TpAccumulator<Parameters, linalg::CPU>::getGMultiband(const SpGreenFunction& G, int s, int k1,
+                                                           int k2, int w1, int w2, Matrix& G_out,
+                                                           const Complex beta) const {
   const int w2_ext = w2 + extension_index_offset_;
   const int w1_ext = w1 + extension_index_offset_;
   auto minus_w1 = [=](const int w) { return n_pos_frqs_ - 1 - w; };
@@ -349,16 +424,17 @@ void TpAccumulator<Parameters, linalg::CPU>::getGMultiband(int s, int k1, int k2
   };
 
   if (w1_ext >= n_pos_frqs_) {
-    const Complex* const G_ptr = &G_(0, 0, s, k1, k2, plus_w1(w1_ext), w2_ext);
+    const Complex* const G_ptr = &G(0, 0, s, k1, k2, plus_w1(w1_ext), w2_ext);
     for (int b2 = 0; b2 < n_bands_; ++b2)
       for (int b1 = 0; b1 < n_bands_; ++b1)
-        G(b1, b2) = beta * G(b1, b2) + G_ptr[b1 + b2 * n_bands_];
+        G_out(b1, b2) = beta * G_out(b1, b2) + G_ptr[b1 + b2 * n_bands_];
   }
   else {
-    const Complex* const G_ptr = &G_(0, 0, s, minus_k(k1), minus_k(k2), minus_w1(w1_ext), minus_w2(w2_ext));
+    const Complex* const G_ptr =
+        &G(0, 0, s, minus_k(k1), minus_k(k2), minus_w1(w1_ext), minus_w2(w2_ext));
     for (int b2 = 0; b2 < n_bands_; ++b2)
       for (int b1 = 0; b1 < n_bands_; ++b1)
-        G(b1, b2) = beta * G(b1, b2) + std::conj(G_ptr[b1 + b2 * n_bands_]);
+        G_out(b1, b2) = beta * G_out(b1, b2) + std::conj(G_ptr[b1 + b2 * n_bands_]);
   }
 }
 
@@ -371,7 +447,15 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
   //        |           |
   // b2 ------------------------ b4
   Profiler profiler("updateG4", "tp-accumulation", __LINE__, thread_id_);
-  if (!G4_)
+  if (irreducible_storage_) {
+    if (!orbits_)
+      orbits_ = std::make_shared<const G4SymmetryOrbits<KDmn, BDmn>>();
+    if (G4_irreducible_.empty())
+      G4_irreducible_.resize(orbits_->size() * WTpDmn::dmn_size() * WTpDmn::dmn_size() *
+                             WExchangeDmn::dmn_size());
+    G4_block_.resize(std::pow(n_bands_, 4));
+  }
+  else if (!G4_)
     G4_.reset(new TpGreenFunction("G4"));
   double flops(0);
 
@@ -382,7 +466,11 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
   // Returns the index of the exchange frequency w_ex minus the Matsubara frequency with index w.
   auto w_ex_minus_w = [](const int w, const int w_ex) { return w_ex + WTpDmn::dmn_size() - 1 - w; };
 
-  const Real sign_over_2 = 0.5 * sign_;
+  // The sign of each measurement is applied by the update functions.
+  const Real one_half = 0.5;
+  // The term that factorizes in (k1, w1) and (k2, w2) is added with matrix-matrix multiplications
+  // when more than one measurement is buffered.
+  const bool batched_spin_difference = n_batched_ > 1;
 
   const double flops_update_atomic = 3 * std::pow(n_bands_, 4);
   const double flops_update_spin_diff = flops_update_atomic + 2 * std::pow(n_bands_, 2);
@@ -399,6 +487,8 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
       //                    c^+(k2, s2) c(k2 + k_ex, s2)>
       //                  = 1/2 (s1 * s2) <G(k1, k1 + k_ex, s1) G(k2 + k_ex, k2, s2) -
       //                    (s1 == s2) G(k2 + k_ex, k1 + k_ex, s1) G(k1, k2, s1)>.
+      if (batched_spin_difference)
+        updateG4SpinDifferenceBatched(-1, one_half);
       for (int w_ex_idx = 0; w_ex_idx < exchange_frq.size(); ++w_ex_idx) {
         const int w_ex = exchange_frq[w_ex_idx];
         for (int w2 = 0; w2 < WTpDmn::dmn_size(); ++w2)
@@ -407,14 +497,16 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
               const int k_ex = exchange_mom[k_ex_idx];
               for (int k2 = 0; k2 < KDmn::dmn_size(); ++k2)
                 for (int k1 = 0; k1 < KDmn::dmn_size(); ++k1) {
-                  Complex* const G4_ptr = &(*G4_)(0, 0, 0, 0, k1, k2, k_ex_idx, w1, w2, w_ex_idx);
-                  updateG4SpinDifference(G4_ptr, -1, k1, momentum_sum(k1, k_ex), w1,
-                                         w_plus_w_ex(w1, w_ex), momentum_sum(k2, k_ex), k2,
-                                         w_plus_w_ex(w2, w_ex), w2, sign_over_2, false);
+                  Complex* const G4_ptr = getG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+                  if (!batched_spin_difference)
+                    updateG4SpinDifference(G4_ptr, -1, k1, momentum_sum(k1, k_ex), w1,
+                                           w_plus_w_ex(w1, w_ex), momentum_sum(k2, k_ex), k2,
+                                           w_plus_w_ex(w2, w_ex), w2, one_half, false);
                   for (int s = 0; s < 2; ++s)
                     updateG4Atomic(G4_ptr, s, k1, k2, w1, w2, s, momentum_sum(k2, k_ex),
                                    momentum_sum(k1, k_ex), w_plus_w_ex(w2, w_ex),
-                                   w_plus_w_ex(w1, w_ex), -sign_over_2, true);
+                                   w_plus_w_ex(w1, w_ex), -one_half, true);
+                  commitG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                 }
             }
       }
@@ -425,6 +517,8 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
       // G4(k1, k2, k_ex) += 1/2  <c^+(k1 + k_ex, s1) c(k1, s1) c^+(k2, s2) c(k2 + k_ex, s2)> =
       //                  = 1/2 <G(k1, k1 + k_ex, s1) G(k2 + k_ex, k2, s2) -
       //                    (s1 == s2) G(k2 + k_ex, k1 + k_ex, s1) G(k1, k2, s1)>.
+      if (batched_spin_difference)
+        updateG4SpinDifferenceBatched(1, one_half);
       for (int w_ex_idx = 0; w_ex_idx < exchange_frq.size(); ++w_ex_idx) {
         const int w_ex = exchange_frq[w_ex_idx];
         for (int w2 = 0; w2 < WTpDmn::dmn_size(); ++w2)
@@ -433,14 +527,16 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
               const int k_ex = exchange_mom[k_ex_idx];
               for (int k2 = 0; k2 < KDmn::dmn_size(); ++k2)
                 for (int k1 = 0; k1 < KDmn::dmn_size(); ++k1) {
-                  Complex* const G4_ptr = &(*G4_)(0, 0, 0, 0, k1, k2, k_ex_idx, w1, w2, w_ex_idx);
-                  updateG4SpinDifference(G4_ptr, 1, k1, momentum_sum(k1, k_ex), w1,
-                                         w_plus_w_ex(w1, w_ex), momentum_sum(k2, k_ex), k2,
-                                         w_plus_w_ex(w2, w_ex), w2, sign_over_2, false);
+                  Complex* const G4_ptr = getG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+                  if (!batched_spin_difference)
+                    updateG4SpinDifference(G4_ptr, 1, k1, momentum_sum(k1, k_ex), w1,
+                                           w_plus_w_ex(w1, w_ex), momentum_sum(k2, k_ex), k2,
+                                           w_plus_w_ex(w2, w_ex), w2, one_half, false);
                   for (int s = 0; s < 2; ++s)
                     updateG4Atomic(G4_ptr, s, k1, k2, w1, w2, s, momentum_sum(k2, k_ex),
                                    momentum_sum(k1, k_ex), w_plus_w_ex(w2, w_ex),
-                                   w_plus_w_ex(w1, w_ex), -sign_over_2, true);
+                                   w_plus_w_ex(w1, w_ex), -one_half, true);
+                  commitG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                 }
             }
       }
@@ -459,11 +555,12 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
               const int k_ex = exchange_mom[k_ex_idx];
               for (int k2 = 0; k2 < KDmn::dmn_size(); ++k2)
                 for (int k1 = 0; k1 < KDmn::dmn_size(); ++k1) {
-                  Complex* const G4_ptr = &(*G4_)(0, 0, 0, 0, k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+                  Complex* const G4_ptr = getG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                   for (int s = 0; s < 2; ++s)
                     updateG4Atomic(G4_ptr, s, k1, k2, w1, w2, not s, momentum_sum(k2, k_ex),
                                    momentum_sum(k1, k_ex), w_plus_w_ex(w2, w_ex),
-                                   w_plus_w_ex(w1, w_ex), -sign_over_2, true);
+                                   w_plus_w_ex(w1, w_ex), -one_half, true);
+                  commitG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                 }
             }
       }
@@ -482,11 +579,12 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
               const int k_ex = exchange_mom[k_ex_idx];
               for (int k2 = 0; k2 < KDmn::dmn_size(); ++k2)
                 for (int k1 = 0; k1 < KDmn::dmn_size(); ++k1) {
-                  Complex* const G4_ptr = &(*G4_)(0, 0, 0, 0, k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+                  Complex* const G4_ptr = getG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                   for (int s = 0; s < 2; ++s)
                     updateG4Atomic(G4_ptr, s, k1, k2, w1, w2, !s, q_minus_k(k1, k_ex),
                                    q_minus_k(k2, k_ex), w_ex_minus_w(w1, w_ex),
-                                   w_ex_minus_w(w2, w_ex), sign_over_2, false);
+                                   w_ex_minus_w(w2, w_ex), one_half, false);
+                  commitG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
                 }
             }
       }
@@ -497,9 +595,83 @@ double TpAccumulator<Parameters, linalg::CPU>::updateG4() {
       throw(std::logic_error("Non supported tp mode."));
   }
 
+  flops *= n_batched_;
+  n_batched_ = 0;
+
   return 1e-9 * flops;
 }
 
+template <class Parameters>
+void TpAccumulator<Parameters, linalg::CPU>::updateG4SpinDifferenceBatched(const int sign,
+                                                                          const Real alpha) {
+  // For each exchange, G4(b1, b2, b3, b4, k1, k2, w1, w2) += \sum_m A_m(b1, b3, k1, w1) B_m(b2, b4,
+  // k2, w2), where the inner dimension m runs over the buffered measurements, and
+  // A_m = alpha sign_m (G_up + sign G_down)(k1, k1 + k_ex, w1, w1 + w_ex),
+  // B_m = (G_up + sign G_down)(k2 + k_ex, k2, w2 + w_ex, w2).
+  // The rows of A are computed and multiplied one frequency w1 at a time to bound the work space.
+  Profiler profiler("updateG4 gemm", "tp-accumulation", __LINE__, thread_id_);
+
+  const int nb = n_bands_;
+  const int nk = KDmn::dmn_size();
+  const int nw = WTpDmn::dmn_size();
+  const int n_rows_a = nb * nb * nk;
+  const int n_rows_b = nb * nb * nk * nw;
+
+  G4_a_.resizeNoCopy(std::make_pair(n_rows_a, n_batched_));
+  G4_b_.resizeNoCopy(std::make_pair(n_rows_b, n_batched_));
+  G4_ab_.resizeNoCopy(std::make_pair(n_rows_a, n_rows_b));
+
+  const auto& exchange_frq = domains::FrequencyExchangeDomain::get_elements();
+  const auto& exchange_mom = domains::MomentumExchangeDomain::get_elements();
+
+  // Stores (G_up + sign G_down)(k1, k2, w1, w2) of measurement m in the column m of 'out', starting
+  // from row 'row'.
+  auto store_spin_sum = [&](const int m, const int k1, const int k2, const int w1, const int w2,
+                            const Complex factor, Matrix& out, const int row) {
+    getGMultiband(G_[m], 0, k1, k2, w1, w2, G_a_);
+    getGMultiband(G_[m], 1, k1, k2, w1, w2, G_a_, sign);
+    for (int b2 = 0; b2 < nb; ++b2)
+      for (int b1 = 0; b1 < nb; ++b1)
+        out(row + b1 + nb * b2, m) = factor * G_a_(b1, b2);
+  };
+
+  for (int w_ex_idx = 0; w_ex_idx < exchange_frq.size(); ++w_ex_idx) {
+    const int w_ex = exchange_frq[w_ex_idx];
+    for (int k_ex_idx = 0; k_ex_idx < exchange_mom.size(); ++k_ex_idx) {
+      const int k_ex = exchange_mom[k_ex_idx];
+
+      for (int m = 0; m < n_batched_; ++m)
+        for (int w2 = 0; w2 < nw; ++w2)
+          for (int k2 = 0; k2 < nk; ++k2)
+            store_spin_sum(m, KDmn::parameter_type::add(k2, k_ex), k2, w2 + w_ex, w2, Complex(1),
+                           G4_b_, nb * nb * (k2 + nk * w2));
+
+      for (int w1 = 0; w1 < nw; ++w1) {
+        for (int m = 0; m < n_batched_; ++m)
+          for (int k1 = 0; k1 < nk; ++k1)
+            store_spin_sum(m, k1, KDmn::parameter_type::add(k1, k_ex), w1, w1 + w_ex,
+                           Complex(alpha * signs_[m]), G4_a_, nb * nb * k1);
+
+        linalg::matrixop::gemm('N', 'T', G4_a_, G4_b_, G4_ab_);
+
+        for (int w2 = 0; w2 < nw; ++w2)
+          for (int k2 = 0; k2 < nk; ++k2)
+            for (int k1 = 0; k1 < nk; ++k1) {
+              Complex* G4_ptr = getG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+              for (int b4 = 0; b4 < nb; ++b4)
+                for (int b3 = 0; b3 < nb; ++b3)
+                  for (int b2 = 0; b2 < nb; ++b2)
+                    for (int b1 = 0; b1 < nb; ++b1) {
+                      *G4_ptr += G4_ab_(b1 + nb * (b3 + nb * k1), b2 + nb * (b4 + nb * (k2 + nk * w2)));
+                      ++G4_ptr;
+                    }
+              commitG4Block(k1, k2, k_ex_idx, w1, w2, w_ex_idx);
+            }
+      }
+    }
+  }
+}
+
 template <class Parameters>
 void TpAccumulator<Parameters, linalg::CPU>::updateG4Atomic(
     Complex* G4_ptr, const int s_a, const int k1_a, const int k2_a, const int w1_a, const int w2_a,
@@ -508,32 +680,21 @@ void TpAccumulator<Parameters, linalg::CPU>::updateG4Atomic(
   // This function performs the following update for each band:
   //
   // G4(k1, k2, w1, w2) += alpha * G(s_a, k1_a, k2_a, w1_a, w2_a) * G(s_b, k1_b, k2_b, w1_b, w2_b)
+  // summed over the buffered measurements, weighted by their sign.
   // INTERNAL: would use __restrict__ pointer make sense?
   if (n_bands_ == 1) {
-    *G4_ptr += alpha * getGSingleband(s_a, k1_a, k2_a, w1_a, w2_a) *
-               getGSingleband(s_b, k1_b, k2_b, w1_b, w2_b);
-  }
-  else {
-    getGMultiband(s_a, k1_a, k2_a, w1_a, w2_a, G_a_);
-    getGMultiband(s_b, k1_b, k2_b, w1_b, w2_b, G_b_);
-
-    if (!cross_legs)
-      for (int b4 = 0; b4 < n_bands_; ++b4)
-        for (int b3 = 0; b3 < n_bands_; ++b3)
-          for (int b2 = 0; b2 < n_bands_; ++b2)
-            for (int b1 = 0; b1 < n_bands_; ++b1) {
-              *G4_ptr += alpha * G_a_(b1, b3) * G_b_(b2, b4);
-              ++G4_ptr;
-            }
-    else
-      for (int b4 = 0; b4 < n_bands_; ++b4)
-        for (int b3 = 0; b3 < n_bands_; ++b3)
-          for (int b2 = 0; b2 < n_bands_; ++b2)
-            for (int b1 = 0; b1 < n_bands_; ++b1) {
-              *G4_ptr += alpha * G_a_(b1, b4) * G_b_(b2, b3);
-              ++G4_ptr;
-            }
+    Complex contribution = 0;
+    for (int m = 0; m < n_batched_; ++m)
+      contribution += Real(signs_[m]) * getGSingleband(G_[m], s_a, k1_a, k2_a, w1_a, w2_a) *
+                      getGSingleband(G_[m], s_b, k1_b, k2_b, w1_b, w2_b);
+    *G4_ptr += alpha * contribution;
   }
+  else
+    for (int m = 0; m < n_batched_; ++m) {
+      getGMultiband(G_[m], s_a, k1_a, k2_a, w1_a, w2_a, G_a_);
+      getGMultiband(G_[m], s_b, k1_b, k2_b, w1_b, w2_b, G_b_);
+      updateG4Bands(G4_ptr, alpha * signs_[m], cross_legs);
+    }
 }
 
 template <class Parameters>
@@ -546,34 +707,96 @@ void TpAccumulator<Parameters, linalg::CPU>::updateG4SpinDifference(
   // G4(k1, k2, w1, w2) += alpha * (G(up, k1_a, k2_a, w1_a, w2_a)
   //                       + sign * G(down,k1_a, k2_a, w1_a, w2_a)) *
   //                          (G(up,k1_b,k2_b,w1_b,w2_b) + sign * G(down,k1_b,k2_b,w1_b,w2_b))
+  // summed over the buffered measurements, weighted by their sign.
   if (n_bands_ == 1) {
-      *G4_ptr += alpha * (getGSingleband(0, k1_a, k2_a, w1_a, w2_a) +
-			  Complex(sign) * getGSingleband(1, k1_a, k2_a, w1_a, w2_a)) *
-               (getGSingleband(0, k1_b, k2_b, w1_b, w2_b) +
-                Complex(sign) * getGSingleband(1, k1_b, k2_b, w1_b, w2_b));
+    Complex contribution = 0;
+    for (int m = 0; m < n_batched_; ++m)
+      contribution += Real(signs_[m]) *
+                      (getGSingleband(G_[m], 0, k1_a, k2_a, w1_a, w2_a) +
+                       Complex(sign) * getGSingleband(G_[m], 1, k1_a, k2_a, w1_a, w2_a)) *
+                      (getGSingleband(G_[m], 0, k1_b, k2_b, w1_b, w2_b) +
+                       Complex(sign) * getGSingleband(G_[m], 1, k1_b, k2_b, w1_b, w2_b));
+    *G4_ptr += alpha * contribution;
   }
-  else {
-    getGMultiband(0, k1_a, k2_a, w1_a, w2_a, G_a_);
-    getGMultiband(1, k1_a, k2_a, w1_a, w2_a, G_a_, sign);
-    getGMultiband(0, k1_b, k2_b, w1_b, w2_b, G_b_);
-    getGMultiband(1, k1_b, k2_b, w1_b, w2_b, G_b_, sign);
-
-    if (!cross_legs)
-      for (int b4 = 0; b4 < n_bands_; ++b4)
-        for (int b3 = 0; b3 < n_bands_; ++b3)
-          for (int b2 = 0; b2 < n_bands_; ++b2)
-            for (int b1 = 0; b1 < n_bands_; ++b1) {
-              *G4_ptr += alpha * G_a_(b1, b3) * G_b_(b2, b4);
-              ++G4_ptr;
-            }
-    else
-      for (int b4 = 0; b4 < n_bands_; ++b4)
-        for (int b3 = 0; b3 < n_bands_; ++b3)
-          for (int b2 = 0; b2 < n_bands_; ++b2)
-            for (int b1 = 0; b1 < n_bands_; ++b1) {
-              *G4_ptr += alpha * G_a_(b1, b4) * G_b_(b2, b3);
-              ++G4_ptr;
-            }
+  else
+    for (int m = 0; m < n_batched_; ++m) {
+      getGMultiband(G_[m], 0, k1_a, k2_a, w1_a, w2_a, G_a_);
+      getGMultiband(G_[m], 1, k1_a, k2_a, w1_a, w2_a, G_a_, sign);
+      getGMultiband(G_[m], 0, k1_b, k2_b, w1_b, w2_b, G_b_);
+      getGMultiband(G_[m], 1, k1_b, k2_b, w1_b, w2_b, G_b_, sign);
+      updateG4Bands(G4_ptr, alpha * signs_[m], cross_legs);
+    }
+}
+
+template <class Parameters>
+void TpAccumulator<Parameters, linalg::CPU>::updateG4Bands(Complex* G4_ptr, const Real alpha,
+                                                           const bool cross_legs) {
+  // G4(b1, b2, b3, b4) += alpha * G_a(b1, b3) * G_b(b2, b4), or, if cross_legs is true,
+  // G4(b1, b2, b3, b4) += alpha * G_a(b1, b4) * G_b(b2, b3).
+  if (!cross_legs)
+    for (int b4 = 0; b4 < n_bands_; ++b4)
+      for (int b3 = 0; b3 < n_bands_; ++b3)
+        for (int b2 = 0; b2 < n_bands_; ++b2)
+          for (int b1 = 0; b1 < n_bands_; ++b1) {
+            *G4_ptr += alpha * G_a_(b1, b3) * G_b_(b2, b4);
+            ++G4_ptr;
+          }
+  else
+    for (int b4 = 0; b4 < n_bands_; ++b4)
+      for (int b3 = 0; b3 < n_bands_; ++b3)
+        for (int b2 = 0; b2 < n_bands_; ++b2)
+          for (int b1 = 0; b1 < n_bands_; ++b1) {
+            *G4_ptr += alpha * G_a_(b1, b4) * G_b_(b2, b3);
+            ++G4_ptr;
+          }
+}
+
+template <class Parameters>
+typename TpAccumulator<Parameters, linalg::CPU>::Complex* TpAccumulator<
+    Parameters, linalg::CPU>::getG4Block(const int k1, const int k2, const int k_ex, const int w1,
+                                         const int w2, const int w_ex) {
+  if (!irreducible_storage_)
+    return &(*G4_)(0, 0, 0, 0, k1, k2, k_ex, w1, w2, w_ex);
+
+  std::fill(G4_block_.begin(), G4_block_.end(), Complex(0));
+  return G4_block_.data();
+}
+
+template <class Parameters>
+void TpAccumulator<Parameters, linalg::CPU>::commitG4Block(const int k1, const int k2,
+                                                           const int k_ex, const int w1,
+                                                           const int w2, const int w_ex) {
+  if (!irreducible_storage_)
+    return;
+
+  const int n_w = WTpDmn::dmn_size();
+  const int block_size = G4_block_.size();
+  const int tuple_offset = block_size * (k1 + KDmn::dmn_size() * k2);
+  Complex* const G4_ptr = G4_irreducible_.data() + orbits_->size() * (w1 + n_w * (w2 + n_w * w_ex));
+
+  for (int i = 0; i < block_size; ++i)
+    G4_ptr[orbits_->irreducibleIndex(tuple_offset + i, k_ex)] += G4_block_[i];
+}
+
+template <class Parameters>
+void TpAccumulator<Parameters, linalg::CPU>::expandG4() {
+  Profiler profiler("expandG4", "tp-accumulation", __LINE__, thread_id_);
+  if (!G4_)
+    G4_.reset(new TpGreenFunction("G4"));
+
+  const int n_tuples = std::pow(n_bands_, 4) * KDmn::dmn_size() * KDmn::dmn_size();
+  const int n_k_ex = KExchangeDmn::dmn_size();
+  const int n_frqs = WTpDmn::dmn_size() * WTpDmn::dmn_size() * WExchangeDmn::dmn_size();
+
+  // The frequency indices are the slowest in both storages.
+  for (int w = 0; w < n_frqs; ++w) {
+    const Complex* const irreducible = G4_irreducible_.data() + orbits_->size() * w;
+    Complex* const G4_ptr = G4_->values() + n_tuples * n_k_ex * w;
+    for (int k_ex = 0; k_ex < n_k_ex; ++k_ex)
+      for (int tuple = 0; tuple < n_tuples; ++tuple) {
+        const int index = orbits_->irreducibleIndex(tuple, k_ex);
+        G4_ptr[tuple + n_tuples * k_ex] = irreducible[index] / Real(orbits_->orbitSize(index));
+      }
   }
 }
 
@@ -586,8 +809,25 @@ const auto& TpAccumulator<Parameters, linalg::CPU>::get_sign_times_G4() const {
 
 template <class Parameters>
 void TpAccumulator<Parameters, linalg::CPU>::sumTo(this_type& other_one) {
+  if (n_batched_)
+    updateG4();
+
+  if (irreducible_storage_) {
+    if (G4_irreducible_.empty())
+      return;
+    if (other_one.G4_irreducible_.empty())
+      other_one.G4_irreducible_.resize(G4_irreducible_.size());
+    for (std::size_t i = 0; i < G4_irreducible_.size(); ++i)
+      other_one.G4_irreducible_[i] += G4_irreducible_[i];
+    if (!other_one.orbits_)
+      other_one.orbits_ = orbits_;
+
+    G4_irreducible_.clear();
+    return;
+  }
+
   if (!G4_)
-    throw(std::logic_error("There is no G4 stored in this class."));
+    return;
 
   if (!other_one.G4_)
     other_one.G4_.reset(new TpGreenFunction("G4"));
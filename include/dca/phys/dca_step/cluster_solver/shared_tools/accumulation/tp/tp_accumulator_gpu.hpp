@@ -187,6 +187,8 @@ TpAccumulator<Parameters, linalg::GPU>::TpAccumulator(
       streams_{queues_[0].getStream(), queues_[1].getStream()},
       ndft_objs_{NdftType(queues_[0]), NdftType(queues_[1])},
       space_trsf_objs_{DftType(n_pos_frqs_, queues_[0]), DftType(n_pos_frqs_, queues_[1])} {
+  if (pars.irreducible_storage())
+    throw(std::logic_error("The irreducible storage of G4 is not implemented on the GPU."));
   initializeG4Helpers();
 }
 
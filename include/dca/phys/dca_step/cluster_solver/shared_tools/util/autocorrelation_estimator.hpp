@@ -0,0 +1,100 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class estimates online the integrated autocorrelation time of a scalar Monte Carlo time
+// series,
+//     tau_int = 1/2 + \sum_{k >= 1} rho(k),
+// where rho(k) is the normalized autocorrelation function at lag k. The autocovariances are
+// accumulated for lags smaller than max_lag, using the last max_lag samples. The sum over the lags
+// is truncated with Sokal's automatic windowing: it stops at the first lag k >= window_factor *
+// tau_int(k).
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_UTIL_AUTOCORRELATION_ESTIMATOR_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_UTIL_AUTOCORRELATION_ESTIMATOR_HPP
+
+#include <cstdlib>  // std::size_t
+#include <stdexcept>
+#include <vector>
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace util {
+// dca::phys::solver::util::
+
+class AutocorrelationEstimator {
+public:
+  AutocorrelationEstimator(const int max_lag = 64, const double window_factor = 5.)
+      : max_lag_(max_lag), window_factor_(window_factor) {
+    if (max_lag < 1)
+      throw std::invalid_argument("The maximum lag must be positive.");
+    reset();
+  }
+
+  void addSample(const double sample) {
+    history_[count_ % max_lag_] = sample;
+    ++count_;
+    sum_ += sample;
+
+    const int n_lags = count_ < max_lag_ ? count_ : max_lag_;
+    for (int k = 0; k < n_lags; ++k)
+      products_[k] += sample * history_[(count_ - 1 - k) % max_lag_];
+  }
+
+  std::size_t count() const {
+    return count_;
+  }
+
+  // Returns the estimate of the integrated autocorrelation time in units of samples. A constant
+  // time series is uncorrelated.
+  // Precondition: addSample has been called at least twice after construction or last reset.
+  double integratedTime() const {
+    if (count_ < 2)
+      throw std::logic_error("Not enough samples to estimate the autocorrelation.");
+
+    const double mean = sum_ / count_;
+    auto autocovariance = [&](const int k) { return products_[k] / (count_ - k) - mean * mean; };
+
+    const double variance = autocovariance(0);
+    // Relative threshold for round-off errors of a constant series.
+    if (variance <= 1.e-12 * mean * mean || variance <= 0)
+      return 0.5;
+
+    double tau = 0.5;
+    const int n_lags = count_ < max_lag_ ? count_ : max_lag_;
+    for (int k = 1; k < n_lags; ++k) {
+      tau += autocovariance(k) / variance;
+      if (k >= window_factor_ * tau)
+        break;
+    }
+
+    return tau < 0.5 ? 0.5 : tau;
+  }
+
+  void reset() {
+    count_ = 0;
+    sum_ = 0;
+    history_.assign(max_lag_, 0.);
+    products_.assign(max_lag_, 0.);
+  }
+
+private:
+  const int max_lag_;
+  const double window_factor_;
+
+  std::size_t count_;
+  double sum_;
+  std::vector<double> history_;
+  std::vector<double> products_;
+};
+
+}  // util
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SHARED_TOOLS_UTIL_AUTOCORRELATION_ESTIMATOR_HPP
@@ -7,6 +7,7 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SS_CT_HYB_SS_CT_HYB_CLUSTER_SOLVER_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_SS_CT_HYB_SS_CT_HYB_CLUSTER_SOLVER_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <complex>
 #include <iostream>
@@ -162,6 +163,14 @@ SsCtHybClusterSolver<device_t, parameters_type, Data>::SsCtHybClusterSolver(
       Sigma_new("Self-Energy-n-0-iteration"),
 
       averaged_(false) {
+  if (parameters_.get_replica_exchange_expansion_parameters().size())
+    throw std::logic_error("Replica exchange is not implemented for the SS-CT-HYB solver.");
+  if (parameters_.get_four_point_measurement_interval() != 1)
+    throw std::logic_error(
+        "The four-point measurement-interval is not implemented for the SS-CT-HYB solver.");
+  if (parameters_.dynamic_measurement_distribution() && parameters_.get_measurement_batch_size() < 1)
+    throw std::logic_error("The measurement batch size must be at least 1.");
+
   if (concurrency_.id() == concurrency_.first())
     std::cout << "\n\n\t SS CT-HYB Integrator is born \n" << std::endl;
 }
@@ -204,6 +213,9 @@ void SsCtHybClusterSolver<device_t, parameters_type, Data>::initialize(int dca_i
 
   averaged_ = false;
 
+  if (parameters_.dynamic_measurement_distribution())
+    concurrency_.resetGlobalCounter();
+
   if (concurrency_.id() == concurrency_.first()) {
     std::stringstream ss;
     ss.precision(6);
@@ -331,14 +343,33 @@ void SsCtHybClusterSolver<device_t, parameters_type, Data>::measure(Walker& walk
 
   const int n_meas = dca::parallel::util::getWorkload(parameters_.get_measurements(), concurrency_);
 
-  for (int i = 0; i < n_meas; i++) {
+  auto measure_once = [&](const int meas_id) {
     walker.doSweep();
 
     accumulator_.updateFrom(walker);
 
     accumulator_.measure();
 
-    walker.updateShell(i, n_meas);
+    walker.updateShell(meas_id, n_meas);
+  };
+
+  if (parameters_.dynamic_measurement_distribution()) {
+    // Claim batches of measurements from the counter shared by all ranks, until all measurements
+    // are done. The static workload is only an estimate for the progress report.
+    const long long total_meas = parameters_.get_measurements();
+    const int batch_size = parameters_.get_measurement_batch_size();
+
+    int meas_id = 0;
+    for (long long first_meas = concurrency_.globalCounterFetchAdd(batch_size);
+         first_meas < total_meas; first_meas = concurrency_.globalCounterFetchAdd(batch_size)) {
+      const int batch_end = meas_id + std::min<long long>(batch_size, total_meas - first_meas);
+      for (; meas_id < batch_end; ++meas_id)
+        measure_once(meas_id);
+    }
+  }
+  else {
+    for (int i = 0; i < n_meas; i++)
+      measure_once(i);
   }
 
   // here we need to do a correction a la Andrey
@@ -98,6 +98,24 @@ public:
    */
   void doSweep();
 
+  // Returns the number of sweeps between two measurements. The adaptive choice based on the
+  // autocorrelation time is not implemented for this walker.
+  double get_sweeps_per_measurement() const {
+    return parameters.get_sweeps_per_measurement();
+  }
+  double get_autocorrelation_time() const {
+    return 0;
+  }
+
+  // Returns the fraction of accepted updates since the last call to initialize.
+  double get_acceptance_ratio() const {
+    return nb_updates ? static_cast<double>(nb_successfull_updates) / nb_updates : 0.;
+  }
+  // Returns the current perturbation expansion order.
+  int get_expansion_order() {
+    return configuration.size();
+  }
+
   /*!
    *  \brief Goes through an integration step. Do N insertion, removal, shift or swap steps.
    *  The insertion and removal steps include the insertion or removal of a full line, a segment or
@@ -150,6 +168,20 @@ public:
     return 0;
   }
 
+  // Replica exchange over the expansion parameter is only implemented for the CT-AUX walker.
+  void setExpansionParameter(double /*K*/) {
+    throw std::logic_error("Replica exchange is not implemented for the SS-CT-HYB walker.");
+  }
+  double get_expansion_parameter() const {
+    return 0;
+  }
+  double logWeightRatio(double /*K*/, int& /*ratio_sign*/) {
+    throw std::logic_error("Replica exchange is not implemented for the SS-CT-HYB walker.");
+  }
+  void changeExpansionParameter(double /*K*/, int /*ratio_sign*/) {
+    throw std::logic_error("Replica exchange is not implemented for the SS-CT-HYB walker.");
+  }
+
 private:
   void test_interpolation();
 
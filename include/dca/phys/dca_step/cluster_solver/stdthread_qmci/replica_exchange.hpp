@@ -0,0 +1,198 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class implements replica exchange (parallel tempering) between the walkers of one rank.
+// Each walker samples the same physical ensemble with a different value of the expansion parameter
+// K, i.e. a different rung of a ladder of expansion parameters. Every 'period' measurements the
+// walkers synchronize and the walkers on neighbouring rungs attempt to swap their expansion
+// parameters, alternating between the even and the odd pairs of rungs. A swap between the
+// configurations c_a at K_a and c_b at K_b is accepted with probability
+//   min(1, |W(c_a, K_b) W(c_b, K_a) / (W(c_a, K_a) W(c_b, K_b))|),
+// and the sign of the ratio is carried by the walkers.
+// The exchanges are performed by the last walker arriving at the synchronization point. A walker
+// that stopped measuring leaves the synchronization and keeps its rung.
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_REPLICA_EXCHANGE_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_REPLICA_EXCHANGE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace stdthreadqmci {
+// dca::phys::solver::stdthreadqmci::
+
+template <class Walker, class Rng>
+class ReplicaExchange {
+public:
+  // Walker i starts on rung i of the ladder 'expansion_parameters'.
+  ReplicaExchange(const std::vector<double>& expansion_parameters, int period, Rng&& rng);
+
+  // Resets the synchronization of the walkers. Must be called before the walkers start.
+  void reset();
+
+  // Returns the expansion parameter of the rung currently assigned to the walker.
+  double expansionParameter(const int walker_id) const {
+    return expansion_parameters_.at(rung_.at(walker_id));
+  }
+
+  // Must be called by each walker after each measurement. Every 'period' measurements of the
+  // walker, waits for all the active walkers and attempts the exchanges.
+  void afterMeasurement(int walker_id, Walker& walker);
+
+  // Must be called once by each walker when it stops measuring.
+  void leave(int walker_id);
+
+  // Returns the acceptance ratio of the exchanges between rung i and rung i + 1.
+  std::vector<double> acceptanceRatios() const;
+
+private:
+  // Attempts the exchanges between the waiting walkers and releases them.
+  // Precondition: mutex_ is locked.
+  void exchangeAndRelease();
+
+  const std::vector<double> expansion_parameters_;
+  const int period_;
+  Rng rng_;
+
+  std::vector<int> rung_;
+  std::vector<int> walker_at_rung_;
+  std::vector<long> proposed_;
+  std::vector<long> accepted_;
+  int parity_ = 0;
+
+  std::vector<int> measurements_;
+  std::vector<Walker*> waiting_;
+  int active_ = 0;
+  int arrived_ = 0;
+  long generation_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable released_;
+};
+
+template <class Walker, class Rng>
+ReplicaExchange<Walker, Rng>::ReplicaExchange(const std::vector<double>& expansion_parameters,
+                                              const int period, Rng&& rng)
+    : expansion_parameters_(expansion_parameters),
+      period_(period),
+      rng_(std::move(rng)),
+      rung_(expansion_parameters.size()),
+      walker_at_rung_(expansion_parameters.size()),
+      proposed_(expansion_parameters.size(), 0),
+      accepted_(expansion_parameters.size(), 0),
+      measurements_(expansion_parameters.size(), 0),
+      waiting_(expansion_parameters.size(), nullptr) {
+  if (expansion_parameters_.empty())
+    throw std::invalid_argument("The ladder of expansion parameters is empty.");
+  for (const double K : expansion_parameters_)
+    if (K <= 0)
+      throw std::invalid_argument("The expansion parameters must be positive.");
+  if (period_ < 1)
+    throw std::invalid_argument("The replica exchange period must be at least 1.");
+
+  std::iota(rung_.begin(), rung_.end(), 0);
+  std::iota(walker_at_rung_.begin(), walker_at_rung_.end(), 0);
+
+  reset();
+}
+
+template <class Walker, class Rng>
+void ReplicaExchange<Walker, Rng>::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::fill(measurements_.begin(), measurements_.end(), 0);
+  std::fill(waiting_.begin(), waiting_.end(), nullptr);
+  active_ = rung_.size();
+  arrived_ = 0;
+}
+
+template <class Walker, class Rng>
+void ReplicaExchange<Walker, Rng>::afterMeasurement(const int walker_id, Walker& walker) {
+  // Only the walker's own thread accesses its counter.
+  if (++measurements_[walker_id] % period_)
+    return;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  waiting_[walker_id] = &walker;
+  ++arrived_;
+
+  if (arrived_ == active_) {
+    exchangeAndRelease();
+  }
+  else {
+    const long generation = generation_;
+    released_.wait(lock, [&]() { return generation_ != generation; });
+  }
+}
+
+template <class Walker, class Rng>
+void ReplicaExchange<Walker, Rng>::leave(int /*walker_id*/) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  --active_;
+
+  if (arrived_ && arrived_ == active_)
+    exchangeAndRelease();
+}
+
+template <class Walker, class Rng>
+void ReplicaExchange<Walker, Rng>::exchangeAndRelease() {
+  for (int r = parity_; r + 1 < static_cast<int>(expansion_parameters_.size()); r += 2) {
+    Walker* const walker_a = waiting_[walker_at_rung_[r]];
+    Walker* const walker_b = waiting_[walker_at_rung_[r + 1]];
+    // One of the walkers already left.
+    if (!walker_a || !walker_b)
+      continue;
+
+    const double K_a = expansion_parameters_[r];
+    const double K_b = expansion_parameters_[r + 1];
+
+    int sign_a = 1;
+    int sign_b = 1;
+    const double log_ratio =
+        walker_a->logWeightRatio(K_b, sign_a) + walker_b->logWeightRatio(K_a, sign_b);
+
+    ++proposed_[r];
+    if (log_ratio >= 0 || rng_() < std::exp(log_ratio)) {
+      walker_a->changeExpansionParameter(K_b, sign_a);
+      walker_b->changeExpansionParameter(K_a, sign_b);
+
+      std::swap(walker_at_rung_[r], walker_at_rung_[r + 1]);
+      rung_[walker_at_rung_[r]] = r;
+      rung_[walker_at_rung_[r + 1]] = r + 1;
+      ++accepted_[r];
+    }
+  }
+  parity_ = 1 - parity_;
+
+  std::fill(waiting_.begin(), waiting_.end(), nullptr);
+  arrived_ = 0;
+  ++generation_;
+  released_.notify_all();
+}
+
+template <class Walker, class Rng>
+std::vector<double> ReplicaExchange<Walker, Rng>::acceptanceRatios() const {
+  std::vector<double> ratios(expansion_parameters_.size() - 1, 0.);
+  for (int r = 0; r < ratios.size(); ++r)
+    ratios[r] = proposed_[r] ? static_cast<double>(accepted_[r]) / proposed_[r] : 0.;
+  return ratios;
+}
+
+}  // stdthreadqmci
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_REPLICA_EXCHANGE_HPP
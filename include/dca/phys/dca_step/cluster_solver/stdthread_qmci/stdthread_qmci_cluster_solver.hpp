@@ -14,9 +14,13 @@
 #ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_STDTHREAD_QMCI_CLUSTER_SOLVER_HPP
 #define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_STDTHREAD_QMCI_CLUSTER_SOLVER_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <future>
+#include <memory>
 #include <queue>
 #include <stdexcept>
 #include <vector>
@@ -25,7 +29,9 @@
 #include "dca/io/hdf5/hdf5_writer.hpp"
 #include "dca/linalg/util/handle_functions.hpp"
 #include "dca/parallel/stdthread/thread_pool/thread_pool.hpp"
+#include "dca/phys/dca_step/cluster_solver/stdthread_qmci/replica_exchange.hpp"
 #include "dca/phys/dca_step/cluster_solver/stdthread_qmci/stdthread_qmci_accumulator.hpp"
+#include "dca/phys/dca_step/cluster_solver/stdthread_qmci/stdthread_qmci_metrics.hpp"
 #include "dca/phys/dca_step/cluster_solver/thread_task_handler.hpp"
 #include "dca/profiling/events/time.hpp"
 #include "dca/util/print_time.hpp"
@@ -73,6 +79,21 @@ private:
 
   void iterateOverLocalMeasurements(int walker_id, std::function<void(int, int, bool)>&& f);
 
+  // Claims batches of measurements for this rank from the counter shared by all ranks and makes
+  // them available to the local walkers. Executed by the main thread, as it is the only one allowed
+  // to communicate.
+  void distributeMeasurements();
+  // Returns the index of the next measurement granted to this rank, or -1 if all the measurements
+  // have been claimed.
+  int claimMeasurement();
+  // Increments the number of finished walkers and returns the new value.
+  int notifyWalkFinished();
+
+  void startMetrics();
+  // Stops the metrics stream and gathers a summary of the metrics of all ranks.
+  void stopMetrics();
+  void recordMeasurement(int walker_id, Walker& walker);
+
   void printIntegrationMetadata() const;
 
 private:
@@ -89,6 +110,8 @@ private:
   const int nr_walkers_;
   const int nr_accumulators_;
   std::vector<std::size_t> walker_fingerprints_;
+  std::vector<double> walker_sweeps_per_measurement_;
+  std::vector<double> walker_autocorrelation_times_;
   std::vector<std::size_t> accum_fingerprints_;
 
   ThreadTaskHandler thread_task_handler_;
@@ -102,6 +125,22 @@ private:
   std::condition_variable queue_insertion_;
 
   std::vector<dca::io::Buffer> config_dump_;
+
+  // Bookkeeping of the dynamic distribution of measurements across ranks.
+  std::mutex mutex_measurements_;
+  std::condition_variable measurements_update_;
+  int measurements_granted_ = 0;
+  bool measurements_exhausted_ = false;
+
+  // Metrics of the integration on this rank, if requested.
+  std::unique_ptr<stdthreadqmci::QmciMetrics> metrics_;
+  // For each rank: sweeps per second, acceptance ratio, expansion order, sign, fraction of the
+  // walker time spent waiting and number of measurements.
+  constexpr static int n_rank_metrics_ = 6;
+  std::vector<double> rank_metrics_;
+
+  // Exchanges of the expansion parameter between the walkers, if requested.
+  std::unique_ptr<stdthreadqmci::ReplicaExchange<Walker, Rng>> replica_exchange_;
 };
 
 template <class QmciSolver>
@@ -113,6 +152,8 @@ StdThreadQmciClusterSolver<QmciSolver>::StdThreadQmciClusterSolver(Parameters& p
       nr_accumulators_(parameters_.get_accumulators()),
 
       walker_fingerprints_(nr_walkers_, 0),
+      walker_sweeps_per_measurement_(nr_walkers_, 0),
+      walker_autocorrelation_times_(nr_walkers_, 0),
       accum_fingerprints_(nr_accumulators_, 0),
 
       thread_task_handler_(nr_walkers_, nr_accumulators_,
@@ -125,12 +166,21 @@ StdThreadQmciClusterSolver<QmciSolver>::StdThreadQmciClusterSolver(Parameters& p
     throw std::logic_error(
         "Both the number of walkers and the number of accumulators must be at least 1.");
   }
-
   for (int i = 0; i < nr_walkers_; ++i) {
     rng_vector_.emplace_back(concurrency_.id(), concurrency_.number_of_processors(),
                              parameters_.get_seed());
   }
 
+  const auto& expansion_parameters = parameters_.get_replica_exchange_expansion_parameters();
+  if (expansion_parameters.size()) {
+    if (expansion_parameters.size() != nr_walkers_)
+      throw std::logic_error(
+          "The number of replica exchange expansion parameters must equal the number of walkers.");
+    replica_exchange_ = std::make_unique<stdthreadqmci::ReplicaExchange<Walker, Rng>>(
+        expansion_parameters, parameters_.get_replica_exchange_period(),
+        Rng(concurrency_.id(), concurrency_.number_of_processors(), parameters_.get_seed()));
+  }
+
   readConfigurations();
 
   // Create a sufficient amount of cublas handles, cuda streams and threads.
@@ -146,6 +196,15 @@ void StdThreadQmciClusterSolver<QmciSolver>::initialize(int dca_iteration) {
 
   walk_finished_ = 0;
   measurements_done_ = 0;
+
+  // BaseClass::initialize resets the global measurement counter.
+  if (parameters_.dynamic_measurement_distribution()) {
+    measurements_granted_ = 0;
+    measurements_exhausted_ = false;
+  }
+
+  if (replica_exchange_)
+    replica_exchange_->reset();
 }
 
 template <class QmciSolver>
@@ -176,7 +235,13 @@ void StdThreadQmciClusterSolver<QmciSolver>::integrate() {
       throw std::logic_error("Thread task is undefined.");
   }
 
-  auto print_metadata = [&]() {
+  startMetrics();
+
+  if (parameters_.dynamic_measurement_distribution())
+    distributeMeasurements();
+
+  // The metrics summary requires a collective communication, which is skipped on failure.
+  auto print_metadata = [&](const bool gather_metrics) {
     assert(walk_finished_ == parameters_.get_walkers());
 
     dca::profiling::WallTime end_time;
@@ -184,6 +249,11 @@ void StdThreadQmciClusterSolver<QmciSolver>::integrate() {
     dca::profiling::Duration duration(end_time, start_time);
     total_time_ = duration.sec + 1.e-6 * duration.usec;
 
+    if (gather_metrics)
+      stopMetrics();
+    else if (metrics_)
+      metrics_->stop();
+
     printIntegrationMetadata();
   };
 
@@ -192,11 +262,11 @@ void StdThreadQmciClusterSolver<QmciSolver>::integrate() {
       future.get();
   }
   catch (std::exception& err) {
-    print_metadata();
+    print_metadata(false);
     throw;
   }
 
-  print_metadata();
+  print_metadata(true);
 
   QmciSolver::accumulator_.finalize();
 }
@@ -240,12 +310,14 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalker(int id) {
             Profiler profiler("stdthread-MC-walker updating", "stdthread-MC-walker", __LINE__, id);
             walker.doSweep();
           }
+          recordMeasurement(walker_index, walker);
           if (print)
             walker.updateShell(meas_id, tot_meas);
 
           {
             Profiler profiler("stdthread-MC-walker waiting", "stdthread-MC-walker", __LINE__, id);
             acc_ptr = nullptr;
+            const auto wait_start = std::chrono::steady_clock::now();
 
             // Wait for available accumulators.
             {
@@ -254,8 +326,16 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalker(int id) {
               acc_ptr = accumulators_queue_.front();
               accumulators_queue_.pop();
             }
+
+            if (metrics_)
+              metrics_->recordWait(walker_index, std::chrono::duration<double>(
+                                                     std::chrono::steady_clock::now() - wait_start)
+                                                     .count());
           }
           acc_ptr->updateFrom(walker);
+
+          if (replica_exchange_)
+            replica_exchange_->afterMeasurement(walker_index, walker);
         });
   }
   catch (std::bad_alloc& err) {
@@ -267,8 +347,11 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalker(int id) {
       exception_ptr = std::make_unique<std::bad_alloc>(err);
   }
 
+  if (replica_exchange_)
+    replica_exchange_->leave(walker_index);
+
   // If this is the last walker signal to all the accumulators to exit the loop.
-  if (++walk_finished_ == parameters_.get_walkers()) {
+  if (notifyWalkFinished() == parameters_.get_walkers()) {
     std::lock_guard<std::mutex> lock(mutex_queue_);
     while (!accumulators_queue_.empty()) {
       accumulators_queue_.front()->notifyDone();
@@ -283,6 +366,8 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalker(int id) {
 
   config_dump_[walker_index] = walker.dumpConfig();
   walker_fingerprints_[walker_index] = walker.deviceFingerprint();
+  walker_sweeps_per_measurement_[walker_index] = walker.get_sweeps_per_measurement();
+  walker_autocorrelation_times_[walker_index] = walker.get_autocorrelation_time();
 
   Profiler::stop_threading(id);
 
@@ -299,6 +384,9 @@ void StdThreadQmciClusterSolver<QmciSolver>::initializeAndWarmUp(Walker& walker,
   if (config_dump_[walker_id].size())
     walker.readConfig(config_dump_[walker_id]);
 
+  if (replica_exchange_)
+    walker.setExpansionParameter(replica_exchange_->expansionParameter(walker_id));
+
   walker.initialize();
 
   if (id == 0 && concurrency_.id() == concurrency_.first())
@@ -330,7 +418,13 @@ void StdThreadQmciClusterSolver<QmciSolver>::iterateOverLocalMeasurements(
                       : total_meas;
   const bool print = fix_thread_meas ? walker_id == 0 : true;
 
-  if (fix_thread_meas) {
+  if (parameters_.dynamic_measurement_distribution()) {
+    // The number of local measurements is not known in advance. Use the static workload as an
+    // estimate for the progress report.
+    for (int meas_id = claimMeasurement(); meas_id != -1; meas_id = claimMeasurement())
+      f(meas_id, total_meas, print);
+  }
+  else if (fix_thread_meas) {
     // Perform a fixed amount of loops with a private counter.
     for (int meas_id = 0; meas_id < n_local_meas; ++meas_id)
       f(meas_id, n_local_meas, print);
@@ -342,6 +436,69 @@ void StdThreadQmciClusterSolver<QmciSolver>::iterateOverLocalMeasurements(
   }
 }
 
+template <class QmciSolver>
+void StdThreadQmciClusterSolver<QmciSolver>::distributeMeasurements() {
+  Profiler profiler(__FUNCTION__, "stdthread-MC-Integration", __LINE__);
+
+  const long long total_meas = parameters_.get_measurements();
+  const int batch_size = parameters_.get_measurement_batch_size();
+
+  std::unique_lock<std::mutex> lock(mutex_measurements_);
+  while (true) {
+    // Request a new batch as soon as less than one batch of granted measurements is left.
+    measurements_update_.wait(lock, [&]() {
+      return measurements_granted_ - static_cast<int>(measurements_done_) < batch_size ||
+             walk_finished_ == nr_walkers_;
+    });
+    // All walkers terminated prematurely.
+    if (walk_finished_ == nr_walkers_)
+      break;
+
+    lock.unlock();
+    const long long first_meas = concurrency_.globalCounterFetchAdd(batch_size);
+    lock.lock();
+
+    if (first_meas >= total_meas) {
+      measurements_exhausted_ = true;
+      measurements_update_.notify_all();
+      break;
+    }
+
+    measurements_granted_ += static_cast<int>(std::min<long long>(batch_size, total_meas - first_meas));
+    measurements_update_.notify_all();
+  }
+}
+
+template <class QmciSolver>
+int StdThreadQmciClusterSolver<QmciSolver>::claimMeasurement() {
+  std::unique_lock<std::mutex> lock(mutex_measurements_);
+  measurements_update_.wait(lock, [&]() {
+    return static_cast<int>(measurements_done_) < measurements_granted_ || measurements_exhausted_;
+  });
+
+  if (static_cast<int>(measurements_done_) >= measurements_granted_)
+    return -1;
+
+  const int meas_id = measurements_done_++;
+  if (measurements_granted_ - static_cast<int>(measurements_done_) <
+      parameters_.get_measurement_batch_size())
+    measurements_update_.notify_all();
+
+  return meas_id;
+}
+
+template <class QmciSolver>
+int StdThreadQmciClusterSolver<QmciSolver>::notifyWalkFinished() {
+  int finished = 0;
+  {
+    // Lock to avoid a lost wake up of the thread distributing the measurements.
+    std::lock_guard<std::mutex> lock(mutex_measurements_);
+    finished = ++walk_finished_;
+  }
+  measurements_update_.notify_all();
+  return finished;
+}
+
 template <class QmciSolver>
 void StdThreadQmciClusterSolver<QmciSolver>::startAccumulator(int id) {
   Profiler::start_threading(id);
@@ -413,6 +570,7 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalkerAndAccumulator(int id) {
         Profiler profiler("Walker updating", "stdthread-MC", __LINE__, id);
         walker.doSweep();
       }
+      recordMeasurement(id, walker);
       {
         Profiler profiler("Accumulator measuring", "stdthread-MC", __LINE__, id);
         accumulator_obj.updateFrom(walker);
@@ -420,6 +578,9 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalkerAndAccumulator(int id) {
       }
       if (print)
         walker.updateShell(meas_id, n_meas);
+
+      if (replica_exchange_)
+        replica_exchange_->afterMeasurement(id, walker);
     });
   }
   catch (std::bad_alloc& err) {
@@ -434,13 +595,18 @@ void StdThreadQmciClusterSolver<QmciSolver>::startWalkerAndAccumulator(int id) {
       current_exception = std::make_unique<std::bad_alloc>(err);
   }
 
-  ++walk_finished_;
+  if (replica_exchange_)
+    replica_exchange_->leave(id);
+
+  notifyWalkFinished();
   {
     std::lock_guard<std::mutex> lock(mutex_merge_);
     accumulator_obj.sumTo(QmciSolver::accumulator_);
   }
   config_dump_[id] = walker.dumpConfig();
   walker_fingerprints_[id] = walker.deviceFingerprint();
+  walker_sweeps_per_measurement_[id] = walker.get_sweeps_per_measurement();
+  walker_autocorrelation_times_[id] = walker.get_autocorrelation_time();
   accum_fingerprints_[id] = accumulator_obj.deviceFingerprint();
 
   Profiler::stop_threading(id);
@@ -487,12 +653,108 @@ void StdThreadQmciClusterSolver<QmciSolver>::readConfigurations() {
   }
 }
 
+template <class QmciSolver>
+void StdThreadQmciClusterSolver<QmciSolver>::startMetrics() {
+  metrics_.reset();
+  rank_metrics_.clear();
+  if (parameters_.get_filename_qmc_metrics() == "")
+    return;
+
+  metrics_ = std::make_unique<stdthreadqmci::QmciMetrics>(nr_walkers_);
+
+  const std::string filename = parameters_.get_directory() + parameters_.get_filename_qmc_metrics() +
+                               "." + std::to_string(concurrency_.id());
+  std::function<int()> queue_depth;
+  if (!parameters_.shared_walk_and_accumulation_thread())
+    queue_depth = [this]() {
+      std::lock_guard<std::mutex> lock(mutex_queue_);
+      return static_cast<int>(accumulators_queue_.size());
+    };
+
+  try {
+    metrics_->start(filename, parameters_.get_qmc_metrics_interval(), concurrency_.id(),
+                    dca_iteration_, queue_depth);
+  }
+  catch (std::exception& err) {
+    // The metrics are still collected for the summary.
+    std::cerr << err.what() << "\nCould not write the QMC metrics.\n";
+  }
+}
+
+template <class QmciSolver>
+void StdThreadQmciClusterSolver<QmciSolver>::recordMeasurement(const int walker_id,
+                                                                Walker& walker) {
+  if (metrics_)
+    metrics_->recordMeasurement(walker_id, walker.get_sweeps_per_measurement(),
+                                walker.get_expansion_order(), walker.get_sign(),
+                                walker.get_acceptance_ratio());
+}
+
+template <class QmciSolver>
+void StdThreadQmciClusterSolver<QmciSolver>::stopMetrics() {
+  if (!metrics_)
+    return;
+
+  metrics_->stop();
+
+  // Each rank fills its own row, the sum gathers the rows of all ranks.
+  rank_metrics_.assign(n_rank_metrics_ * concurrency_.number_of_processors(), 0.);
+  double* const row = rank_metrics_.data() + n_rank_metrics_ * concurrency_.id();
+
+  int measurements = 0;
+  for (int id = 0; id < metrics_->walkers(); ++id) {
+    const auto walker_metrics = metrics_->get(id);
+    measurements += walker_metrics.measurements;
+    row[0] += walker_metrics.sweeps;
+    row[1] += walker_metrics.acceptance_ratio / metrics_->walkers();
+    row[2] += walker_metrics.expansion_order_sum;
+    row[3] += walker_metrics.sign_sum;
+    row[4] += walker_metrics.wait_time;
+  }
+  row[0] /= total_time_;
+  if (measurements) {
+    row[2] /= measurements;
+    row[3] /= measurements;
+  }
+  row[4] /= total_time_ * metrics_->walkers();
+  row[5] = measurements;
+
+  concurrency_.sum(rank_metrics_);
+}
+
 template <class QmciSolver>
 void StdThreadQmciClusterSolver<QmciSolver>::printIntegrationMetadata() const {
   if (concurrency_.id() == concurrency_.first()) {
     std::cout << "Threaded on-node integration has ended: " << dca::util::print_time()
               << "\n\nTotal number of measurements: " << parameters_.get_measurements()
               << "\nQMC-time\t" << total_time_ << "\n";
+    if (parameters_.dynamic_measurement_distribution())
+      std::cout << "Measurements performed by this rank: " << measurements_done_ << "\n";
+    if (rank_metrics_.size()) {
+      std::cout << "\nQMC metrics per rank: sweeps/s, acceptance ratio, <k>, <sign>, "
+                   "walker wait fraction, measurements\n";
+      for (int rank = 0; rank < rank_metrics_.size() / n_rank_metrics_; ++rank) {
+        std::cout << rank;
+        for (int i = 0; i < n_rank_metrics_; ++i)
+          std::cout << "\t" << rank_metrics_[n_rank_metrics_ * rank + i];
+        std::cout << "\n";
+      }
+    }
+    if (replica_exchange_) {
+      std::cout << "\nReplica exchange expansion parameters and acceptance ratios of the exchanges "
+                   "with the next one: \n";
+      const auto& expansion_parameters = parameters_.get_replica_exchange_expansion_parameters();
+      const auto acceptance_ratios = replica_exchange_->acceptanceRatios();
+      for (int i = 0; i < acceptance_ratios.size(); ++i)
+        std::cout << expansion_parameters[i] << "\t" << acceptance_ratios[i] << "\n";
+      std::cout << expansion_parameters.back() << "\n";
+    }
+    if (parameters_.adaptive_sweeps_per_measurement()) {
+      std::cout << "\nWalker autocorrelation times [sweeps] and sweeps per measurement: \n";
+      for (int i = 0; i < nr_walkers_; ++i)
+        std::cout << walker_autocorrelation_times_[i] << "\t" << walker_sweeps_per_measurement_[i]
+                  << "\n";
+    }
     if (QmciSolver::device == linalg::GPU) {
       std::cout << "\nWalker fingerprints [MB]: \n";
       for (const auto& x : walker_fingerprints_)
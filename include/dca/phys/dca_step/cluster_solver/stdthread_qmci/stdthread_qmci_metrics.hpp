@@ -0,0 +1,203 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class collects metrics of the threaded QMC integration on one rank and, while started,
+// periodically appends them as a JSON line to a file. Each line contains, for the elapsed
+// interval, the sweeps per second, mean expansion order, mean sign and waiting time of each walker,
+// together with the acceptance ratio of the walker, the depth of the accumulator queue and the
+// number of measurements done by the walkers of the rank.
+// The walker threads only update their own slot, protected by an uncontended lock.
+
+#ifndef DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_STDTHREAD_QMCI_METRICS_HPP
+#define DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_STDTHREAD_QMCI_METRICS_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dca {
+namespace phys {
+namespace solver {
+namespace stdthreadqmci {
+// dca::phys::solver::stdthreadqmci::
+
+class QmciMetrics {
+public:
+  // Cumulative metrics of one walker.
+  struct WalkerMetrics {
+    double sweeps = 0;
+    int measurements = 0;
+    double expansion_order_sum = 0;
+    double sign_sum = 0;
+    double acceptance_ratio = 0;
+    double wait_time = 0;  // [s]
+  };
+
+  QmciMetrics(int n_walkers) : slots_(n_walkers) {
+    if (n_walkers < 1)
+      throw std::invalid_argument("The number of walkers must be positive.");
+  }
+
+  ~QmciMetrics() {
+    stop();
+  }
+
+  // Adds a measurement of walker 'id', taken after 'sweeps' sweeps.
+  void recordMeasurement(const int id, const double sweeps, const int expansion_order,
+                         const double sign, const double acceptance_ratio) {
+    Slot& slot = slots_.at(id);
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    slot.metrics.sweeps += sweeps;
+    ++slot.metrics.measurements;
+    slot.metrics.expansion_order_sum += expansion_order;
+    slot.metrics.sign_sum += sign;
+    slot.metrics.acceptance_ratio = acceptance_ratio;
+  }
+
+  // Adds the time walker 'id' spent waiting for an accumulator.
+  void recordWait(const int id, const double seconds) {
+    Slot& slot = slots_.at(id);
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    slot.metrics.wait_time += seconds;
+  }
+
+  WalkerMetrics get(const int id) const {
+    const Slot& slot = slots_.at(id);
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    return slot.metrics;
+  }
+
+  int walkers() const {
+    return slots_.size();
+  }
+
+  // Starts a thread appending a record to 'filename' every 'interval' seconds, until stop is
+  // called.
+  // queue_depth (optional): returns the number of idle accumulators waiting for a walker.
+  void start(const std::string& filename, double interval, int rank, int dca_iteration,
+             std::function<int()> queue_depth = nullptr);
+
+  // Writes a last record and stops the writing thread. Does nothing if the thread is not running.
+  void stop();
+
+  // Writes a record with the metrics since the previous record.
+  void writeRecord(std::ostream& out);
+
+private:
+  struct Slot {
+    mutable std::mutex mutex;
+    WalkerMetrics metrics;
+  };
+
+  std::vector<Slot> slots_;
+
+  // State of the writing thread.
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable stop_request_;
+  bool stop_ = false;
+
+  int rank_ = 0;
+  int dca_iteration_ = 0;
+  std::function<int()> queue_depth_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point last_time_;
+  std::vector<WalkerMetrics> last_;
+};
+
+inline void QmciMetrics::start(const std::string& filename, const double interval, const int rank,
+                               const int dca_iteration, std::function<int()> queue_depth) {
+  if (thread_.joinable())
+    throw std::logic_error("The metrics are already being written.");
+  if (interval <= 0)
+    throw std::invalid_argument("The metrics interval must be positive.");
+
+  auto out = std::make_shared<std::ofstream>(filename, std::ios::app);
+  if (!*out)
+    throw std::runtime_error("Cannot open " + filename + ".");
+
+  rank_ = rank;
+  dca_iteration_ = dca_iteration;
+  queue_depth_ = std::move(queue_depth);
+  start_time_ = last_time_ = std::chrono::steady_clock::now();
+  last_.assign(slots_.size(), WalkerMetrics());
+  stop_ = false;
+
+  const auto period = std::chrono::duration<double>(interval);
+  thread_ = std::thread([this, out, period]() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_request_.wait_for(lock, period, [this]() { return stop_; }))
+      writeRecord(*out);
+    writeRecord(*out);
+  });
+}
+
+inline void QmciMetrics::stop() {
+  if (!thread_.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stop_request_.notify_one();
+  thread_.join();
+}
+
+inline void QmciMetrics::writeRecord(std::ostream& out) {
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(now - last_time_).count();
+  const double time = std::chrono::duration<double>(now - start_time_).count();
+  if (last_.size() != slots_.size())
+    last_.assign(slots_.size(), WalkerMetrics());
+
+  std::vector<WalkerMetrics> current(slots_.size());
+  int measurements_done = 0;
+  for (int id = 0; id < slots_.size(); ++id) {
+    current[id] = get(id);
+    measurements_done += current[id].measurements;
+  }
+
+  out << "{\"rank\": " << rank_ << ", \"DCA-iteration\": " << dca_iteration_
+      << ", \"time\": " << time << ", \"measurements-done\": " << measurements_done;
+  if (queue_depth_)
+    out << ", \"accumulator-queue-depth\": " << queue_depth_();
+  out << ", \"walkers\": [";
+
+  for (int id = 0; id < slots_.size(); ++id) {
+    const WalkerMetrics& last = last_[id];
+    const int measurements = current[id].measurements - last.measurements;
+
+    out << (id ? ", " : "") << "{\"id\": " << id << ", \"sweeps-per-second\": "
+        << (elapsed > 0 ? (current[id].sweeps - last.sweeps) / elapsed : 0.)
+        << ", \"measurements\": " << measurements << ", \"acceptance-ratio\": "
+        << current[id].acceptance_ratio;
+    if (measurements > 0)
+      out << ", \"expansion-order\": "
+          << (current[id].expansion_order_sum - last.expansion_order_sum) / measurements
+          << ", \"sign\": " << (current[id].sign_sum - last.sign_sum) / measurements;
+    out << ", \"wait-time\": " << current[id].wait_time - last.wait_time << "}";
+  }
+  last_ = std::move(current);
+  out << "]}" << std::endl;
+
+  last_time_ = now;
+}
+
+}  // stdthreadqmci
+}  // solver
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DCA_STEP_CLUSTER_SOLVER_STDTHREAD_QMCI_STDTHREAD_QMCI_METRICS_HPP
@@ -9,16 +9,22 @@
 //
 // This class implements the deconvolution step of the lattice mapping for single-particle
 // functions.
+// The result of the last deconvolution is kept, so that with the DCA+ parameter
+// deconvolution-warm-start the Richardson-Lucy iteration of the next DCA iteration starts from it.
 
 #ifndef DCA_PHYS_DCA_STEP_LATTICE_MAPPING_DECONVOLUTION_DECONVOLUTION_SP_HPP
 #define DCA_PHYS_DCA_STEP_LATTICE_MAPPING_DECONVOLUTION_DECONVOLUTION_SP_HPP
 
 #include <algorithm>
 #include <complex>
+#include <iostream>
+#include <utility>
+#include <vector>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/math/inference/richardson_lucy_deconvolution.hpp"
+#include "dca/parallel/util/get_bounds.hpp"
 #include "dca/phys/dca_step/lattice_mapping/deconvolution/deconvolution_routines.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
 #include "dca/phys/domains/quantum/electron_spin_domain.hpp"
@@ -34,12 +40,16 @@ class deconvolution_sp
     : public deconvolution_routines<parameters_type, source_k_dmn_t, target_k_dmn_t> {
 public:
   using concurrency_type = typename parameters_type::concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   using w = func::dmn_0<domains::frequency_domain>;
   using b = func::dmn_0<domains::electron_band_domain>;
   using s = func::dmn_0<domains::electron_spin_domain>;
   using nu = func::dmn_variadic<b, s>;  // orbital-spin index
 
+  using z = func::dmn_0<func::dmn<2, int>>;  // real and imaginary part
+  using p_dmn_t = func::dmn_variadic<z, b, b, s, w>;
+
 public:
   deconvolution_sp(parameters_type& parameters_ref);
 
@@ -58,6 +68,9 @@ private:
 private:
   parameters_type& parameters;
   concurrency_type& concurrency;
+
+  func::function<double, func::dmn_variadic<target_k_dmn_t, p_dmn_t>> target;
+  bool has_previous_target;
 };
 
 template <typename parameters_type, typename source_k_dmn_t, typename target_k_dmn_t>
@@ -66,7 +79,10 @@ deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::deconvolution
     : deconvolution_routines<parameters_type, source_k_dmn_t, target_k_dmn_t>(parameters_ref),
 
       parameters(parameters_ref),
-      concurrency(parameters.get_concurrency()) {}
+      concurrency(parameters.get_concurrency()),
+
+      target("target"),
+      has_previous_target(false) {}
 
 template <typename parameters_type, typename source_k_dmn_t, typename target_k_dmn_t>
 void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
@@ -75,21 +91,37 @@ void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
         f_source_interpolated,
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, target_k_dmn_t, w>>& f_target_convoluted,
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, target_k_dmn_t, w>>& f_target) {
-  typedef func::dmn_0<func::dmn<2, int>> z;
-  typedef func::dmn_variadic<z, b, b, s, w> p_dmn_t;
-
   math::inference::RichardsonLucyDeconvolution<source_k_dmn_t, target_k_dmn_t, p_dmn_t> RL_obj(
       this->get_T_source_symmetrized(), this->get_T_symmetrized(),
       parameters.get_deconvolution_tolerance(), parameters.get_deconvolution_iterations());
+  RL_obj.setWarmStart(parameters.deconvolution_warm_start() && has_previous_target);
+  RL_obj.setStagnationTolerance(parameters.get_deconvolution_stagnation_tolerance());
+
+  // The frequencies are independent and distributed amongst the processes. Since the frequency is
+  // the slowest index of p_dmn_t, each process deconvolutes a contiguous range of columns.
+  w w_dmn;
+  const std::pair<int, int> w_bounds = concurrency.get_bounds(w_dmn);
+  const int p_per_w = p_dmn_t::dmn_size() / w::dmn_size();
+  RL_obj.setColumnBounds(std::make_pair(w_bounds.first * p_per_w, w_bounds.second * p_per_w));
 
   func::function<double, func::dmn_variadic<source_k_dmn_t, p_dmn_t>> source("source");
   func::function<double, func::dmn_variadic<target_k_dmn_t, p_dmn_t>> source_interpolated(
       "source_interpolated");
   func::function<double, func::dmn_variadic<target_k_dmn_t, p_dmn_t>> target_convoluted(
       "target_convoluted");
-  func::function<double, func::dmn_variadic<target_k_dmn_t, p_dmn_t>> target("target");
 
-  for (int w_ind = 0; w_ind < w::dmn_size(); w_ind++) {
+  // The frequencies of this process are distributed amongst the threads.
+  const int n_threads = std::max(1, std::min(parameters.get_coarsegraining_threads(),
+                                             w_bounds.second - w_bounds.first));
+  auto for_each_w = [&](auto&& f) {
+    Threading().execute(n_threads, [&](const int id, const int n_threads) {
+      const auto bounds = parallel::util::getBounds(id, n_threads, w_bounds);
+      for (int w_ind = bounds.first; w_ind < bounds.second; w_ind++)
+        f(w_ind);
+    });
+  };
+
+  for_each_w([&](const int w_ind) {
     for (int k_ind = 0; k_ind < source_k_dmn_t::dmn_size(); k_ind++) {
       for (int j = 0; j < b::dmn_size(); j++) {
         for (int i = 0; i < b::dmn_size(); i++) {
@@ -100,9 +132,7 @@ void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
         }
       }
     }
-  }
 
-  for (int w_ind = 0; w_ind < w::dmn_size(); w_ind++) {
     for (int k_ind = 0; k_ind < target_k_dmn_t::dmn_size(); k_ind++) {
       for (int j = 0; j < b::dmn_size(); j++) {
         for (int i = 0; i < b::dmn_size(); i++) {
@@ -117,12 +147,17 @@ void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
         }
       }
     }
-  }
+  });
 
-  RL_obj.findTargetFunction(source, source_interpolated, target, target_convoluted,
-                            concurrency.id() == concurrency.first());
+  const auto iterations_error = RL_obj.findTargetFunction(source, source_interpolated, target,
+                                                          target_convoluted, false);
+  has_previous_target = true;
 
-  for (int w_ind = 0; w_ind < w::dmn_size(); w_ind++) {
+  // Each process only writes its frequencies, the spin off-diagonal elements vanish.
+  f_target_convoluted = 0.;
+  f_target = 0.;
+
+  for_each_w([&](const int w_ind) {
     for (int k_ind = 0; k_ind < target_k_dmn_t::dmn_size(); k_ind++) {
       for (int j = 0; j < b::dmn_size(); j++) {
         for (int i = 0; i < b::dmn_size(); i++) {
@@ -130,15 +165,7 @@ void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
           f_target_convoluted(i, 0, j, 0, k_ind, w_ind).imag(target_convoluted(k_ind, 1, i, j, 0, w_ind));
           f_target_convoluted(i, 1, j, 1, k_ind, w_ind).real(target_convoluted(k_ind, 0, i, j, 1, w_ind));
           f_target_convoluted(i, 1, j, 1, k_ind, w_ind).imag(target_convoluted(k_ind, 1, i, j, 1, w_ind));
-        }
-      }
-    }
-  }
 
-  for (int w_ind = 0; w_ind < w::dmn_size(); w_ind++) {
-    for (int k_ind = 0; k_ind < target_k_dmn_t::dmn_size(); k_ind++) {
-      for (int j = 0; j < b::dmn_size(); j++) {
-        for (int i = 0; i < b::dmn_size(); i++) {
           f_target(i, 0, j, 0, k_ind, w_ind).real(target(k_ind, 0, i, j, 0, w_ind));
           f_target(i, 0, j, 0, k_ind, w_ind).imag(target(k_ind, 1, i, j, 0, w_ind));
           f_target(i, 1, j, 1, k_ind, w_ind).real(target(k_ind, 0, i, j, 1, w_ind));
@@ -146,7 +173,27 @@ void deconvolution_sp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
         }
       }
     }
-  }
+  });
+
+  concurrency.sum(f_target_convoluted);
+  concurrency.sum(f_target);
+
+  // Gather the largest number of iterations and error of all processes.
+  std::vector<double> iterations(concurrency.number_of_processors(), 0.);
+  std::vector<double> errors(concurrency.number_of_processors(), 0.);
+  iterations[concurrency.id()] = iterations_error.first;
+  errors[concurrency.id()] = iterations_error.second;
+  concurrency.sum(iterations);
+  concurrency.sum(errors);
+
+  if (concurrency.id() == concurrency.first())
+    std::cout << "\n\n"
+              << "\t\t Richardson-Lucy deconvolution: iterations   = "
+              << *std::max_element(iterations.begin(), iterations.end())
+              << " (max iterations = " << parameters.get_deconvolution_iterations() << ")\n"
+              << "\t\t                                max L2-error = "
+              << *std::max_element(errors.begin(), errors.end())
+              << " (tolerance = " << parameters.get_deconvolution_tolerance() << ")" << std::endl;
 }
 
 template <typename parameters_type, typename source_k_dmn_t, typename target_k_dmn_t>
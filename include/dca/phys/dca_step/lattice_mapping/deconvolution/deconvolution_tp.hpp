@@ -32,6 +32,7 @@ template <typename parameters_type, typename source_k_dmn_t, typename target_k_d
 class deconvolution_tp
     : public deconvolution_routines<parameters_type, source_k_dmn_t, target_k_dmn_t> {
   using concurrency_type = typename parameters_type::concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   using w_VERTEX = func::dmn_0<domains::vertex_frequency_domain<domains::COMPACT>>;
   using b = func::dmn_0<domains::electron_band_domain>;
@@ -84,7 +85,8 @@ void deconvolution_tp<parameters_type, source_k_dmn_t, target_k_dmn_t>::execute(
   this->compute_T_inv_matrix(parameters.get_Gamma_deconvolution_cut_off(), phi_inv);
 
   math::transform::FunctionTransform<k_dmn_t, target_k_dmn_t>::execute_on_all(
-      Gamma_lattice_interp, Gamma_lattice_deconv, phi_inv);
+      Gamma_lattice_interp, Gamma_lattice_deconv, phi_inv, Threading(),
+      parameters.get_coarsegraining_threads());
 }
 
 }  // latticemapping
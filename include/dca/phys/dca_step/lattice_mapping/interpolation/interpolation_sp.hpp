@@ -14,9 +14,11 @@
 
 #include <complex>
 #include <iostream>
+#include <utility>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
+#include "dca/linalg/matrix.hpp"
 #include "dca/math/function_transform/function_transform.hpp"
 #include "dca/phys/dca_step/lattice_mapping/interpolation/interpolation_routines.hpp"
 #include "dca/phys/dca_step/lattice_mapping/interpolation/transform_to_alpha.hpp"
@@ -37,6 +39,7 @@ class interpolation_sp : public interpolation_routines<parameters_type, source_k
 public:
   using profiler_type = typename parameters_type::profiler_type;
   using concurrency_type = typename parameters_type::concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   using source_r_cluster_type = typename source_k_dmn::parameter_type::dual_type;
   using r_centered_dmn = func::dmn_0<domains::centered_cluster_domain<source_r_cluster_type>>;
@@ -78,9 +81,16 @@ private:
                func::function<std::complex<double>, func::dmn_variadic<nu, nu, target_k_dmn, w>>&
                    interp_self_energy);
 
+  // Computes the matrix of the transformation source_k_dmn -> r_centered_dmn -> target_k_dmn, by
+  // transforming the unit vectors of source_k_dmn, so that the interpolation is a single matrix
+  // product.
+  void initialize_T_K_to_k();
+
 private:
   parameters_type& parameters;
   concurrency_type& concurrency;
+
+  linalg::Matrix<std::complex<double>, linalg::CPU> T_K_to_k_;
 };
 
 template <typename parameters_type, typename source_k_dmn, typename target_k_dmn>
@@ -89,7 +99,9 @@ interpolation_sp<parameters_type, source_k_dmn, target_k_dmn>::interpolation_sp(
     : interpolation_routines<parameters_type, source_k_dmn, target_k_dmn>(parameters_ref),
 
       parameters(parameters_ref),
-      concurrency(parameters.get_concurrency()) {
+      concurrency(parameters.get_concurrency()),
+
+      T_K_to_k_("T_K_to_k") {
   if (concurrency.id() == concurrency.first())
     std::cout << "\n\n\t" << __FUNCTION__ << " is created " << dca::util::print_time();
 }
@@ -114,32 +126,48 @@ template <typename parameters_type, typename source_k_dmn, typename target_k_dmn
 void interpolation_sp<parameters_type, source_k_dmn, target_k_dmn>::execute(
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, source_k_dmn, w>>& cluster_function,
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, target_k_dmn, w>>& interp_function) {
-  r_centered_dmn::parameter_type::initialize();
-
-  func::function<std::complex<double>, nu_nu_r_centered_w> cluster_centered_function(
-      "cluster_centered_function");
-
-  math::transform::FunctionTransform<source_k_dmn, r_centered_dmn>::execute(
-      cluster_function, cluster_centered_function);
+  initialize_T_K_to_k();
 
-  math::transform::FunctionTransform<r_centered_dmn, target_k_dmn>::execute(
-      cluster_centered_function, interp_function);
+  math::transform::FunctionTransform<source_k_dmn, target_k_dmn>::execute(
+      cluster_function, interp_function, T_K_to_k_, Threading(),
+      parameters.get_coarsegraining_threads());
 }
 
 template <typename parameters_type, typename source_k_dmn, typename target_k_dmn>
 void interpolation_sp<parameters_type, source_k_dmn, target_k_dmn>::execute(
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, source_k_dmn>>& cluster_function,
     func::function<std::complex<double>, func::dmn_variadic<nu, nu, target_k_dmn>>& interp_function) {
+  initialize_T_K_to_k();
+
+  math::transform::FunctionTransform<source_k_dmn, target_k_dmn>::execute(
+      cluster_function, interp_function, T_K_to_k_, Threading(),
+      parameters.get_coarsegraining_threads());
+}
+
+template <typename parameters_type, typename source_k_dmn, typename target_k_dmn>
+void interpolation_sp<parameters_type, source_k_dmn, target_k_dmn>::initialize_T_K_to_k() {
+  if (T_K_to_k_.size() == std::make_pair(target_k_dmn::dmn_size(), source_k_dmn::dmn_size()))
+    return;
+
   r_centered_dmn::parameter_type::initialize();
 
-  func::function<std::complex<double>, nu_nu_r_centered> cluster_centered_function(
-      "cluster_centered_function");
+  func::function<std::complex<double>, func::dmn_variadic<source_k_dmn, source_k_dmn>> unit(
+      "unit");
+  for (int K = 0; K < source_k_dmn::dmn_size(); K++)
+    unit(K, K) = 1.;
+
+  func::function<std::complex<double>, func::dmn_variadic<r_centered_dmn, source_k_dmn>> unit_r(
+      "unit_r");
+  math::transform::FunctionTransform<source_k_dmn, r_centered_dmn>::execute(unit, unit_r);
 
-  math::transform::FunctionTransform<source_k_dmn, r_centered_dmn>::execute(
-      cluster_function, cluster_centered_function);
+  func::function<std::complex<double>, func::dmn_variadic<target_k_dmn, source_k_dmn>> T(
+      "T_K_to_k");
+  math::transform::FunctionTransform<r_centered_dmn, target_k_dmn>::execute(unit_r, T);
 
-  math::transform::FunctionTransform<r_centered_dmn, target_k_dmn>::execute(
-      cluster_centered_function, interp_function);
+  T_K_to_k_.resizeNoCopy(std::make_pair(target_k_dmn::dmn_size(), source_k_dmn::dmn_size()));
+  for (int K = 0; K < source_k_dmn::dmn_size(); K++)
+    for (int k = 0; k < target_k_dmn::dmn_size(); k++)
+      T_K_to_k_(k, K) = T(k, K);
 }
 
 }  // latticemapping
@@ -35,6 +35,7 @@ class interpolation_tp : public interpolation_routines<parameters_type, source_k
 public:
   using profiler_type = typename parameters_type::profiler_type;
   using concurrency_type = typename parameters_type::concurrency_type;
+  using Threading = typename parameters_type::ThreadingType;
 
   using source_r_cluster_type = typename source_k_dmn::parameter_type::dual_type;
   using r_centered_dmn = func::dmn_0<domains::centered_cluster_domain<source_r_cluster_type>>;
@@ -111,8 +112,8 @@ void interpolation_tp<parameters_type, source_k_dmn, target_k_dmn>::execute(
 
   initialize_T_K_to_k(T_K_to_k);
 
-  math::transform::FunctionTransform<k_DCA, k_HOST_VERTEX>::execute_on_all(Gamma_cluster,
-                                                                           Gamma_lattice, T_K_to_k);
+  math::transform::FunctionTransform<k_DCA, k_HOST_VERTEX>::execute_on_all(
+      Gamma_cluster, Gamma_lattice, T_K_to_k, Threading(), parameters.get_coarsegraining_threads());
 }
 
 }  // latticemapping
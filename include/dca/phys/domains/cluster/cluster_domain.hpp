@@ -22,6 +22,7 @@
 #include "dca/phys/domains/cluster/cluster_operations.hpp"
 #include "dca/phys/domains/cluster/cluster_specifications.hpp"
 #include "dca/phys/domains/cluster/dual_cluster.hpp"
+#include "dca/phys/domains/cluster/lattice_index.hpp"
 
 namespace dca {
 namespace phys {
@@ -82,9 +83,14 @@ public:
 
   static int origin_index();
 
+  // Return the index of the element x_i + x_j, and of the element x_j - x_i.
   static int add(int i, int j);
   static int subtract(int i, int j);
 
+  // Index of the lattice vectors modulo the superlattice, which computes add and subtract.
+  static LatticeIndex& get_lattice_index();
+
+  // Dense tables of add and subtract, computed on the first call.
   static dca::linalg::Matrix<int, dca::linalg::CPU>& get_add_matrix();
   static dca::linalg::Matrix<int, dca::linalg::CPU>& get_subtract_matrix();
 
@@ -176,28 +182,31 @@ int cluster_domain<scalar_type, D, N, R, S>::origin_index() {
 
 template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
 int cluster_domain<scalar_type, D, N, R, S>::add(int i, int j) {
-  static dca::linalg::Matrix<int, dca::linalg::CPU>& A = get_add_matrix();
-  return A(i, j);
+  static const LatticeIndex& lattice_index = get_lattice_index();
+  return lattice_index.add(i, j);
 }
 
 template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
-dca::linalg::Matrix<int, dca::linalg::CPU>& cluster_domain<scalar_type, D, N, R, S>::get_add_matrix() {
+int cluster_domain<scalar_type, D, N, R, S>::subtract(int i, int j) {
+  static const LatticeIndex& lattice_index = get_lattice_index();
+  return lattice_index.subtract(i, j);
+}
+
+template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
+LatticeIndex& cluster_domain<scalar_type, D, N, R, S>::get_lattice_index() {
   assert(SHAPE == BRILLOUIN_ZONE);
-  static dca::linalg::Matrix<int, dca::linalg::CPU> A("add", get_size());
-  return A;
+  static LatticeIndex lattice_index;
+  return lattice_index;
 }
 
 template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
-int cluster_domain<scalar_type, D, N, R, S>::subtract(int i, int j) {
-  static dca::linalg::Matrix<int, dca::linalg::CPU>& A = get_subtract_matrix();
-  return A(i, j);
+dca::linalg::Matrix<int, dca::linalg::CPU>& cluster_domain<scalar_type, D, N, R, S>::get_add_matrix() {
+  return get_lattice_index().get_add_matrix();
 }
 
 template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
 dca::linalg::Matrix<int, dca::linalg::CPU>& cluster_domain<scalar_type, D, N, R, S>::get_subtract_matrix() {
-  assert(SHAPE == BRILLOUIN_ZONE);
-  static dca::linalg::Matrix<int, dca::linalg::CPU> A("subtract", get_size());
-  return A;
+  return get_lattice_index().get_subtract_matrix();
 }
 
 template <typename scalar_type, int D, CLUSTER_NAMES N, CLUSTER_REPRESENTATION R, CLUSTER_SHAPE S>
@@ -69,11 +69,8 @@ private:
   static void initialize_elements_2D(std::vector<int> R_basis);
   static void initialize_elements_3D(std::vector<int> R_basis);
 
-  static void initialize_add(scalar_type* basis, std::vector<std::vector<scalar_type>>& elements,
-                             dca::linalg::Matrix<int, dca::linalg::CPU>& A);
-
-  static void initialize_subtract(scalar_type* basis, std::vector<std::vector<scalar_type>>& elements,
-                                  dca::linalg::Matrix<int, dca::linalg::CPU>& A);
+  // Initializes the lattice index of r_dmn and k_dmn, which provides add and subtract.
+  static void initialize_lattice_index();
 
   static void initialize_volume();
 };
@@ -144,13 +141,7 @@ void cluster_domain_initializer<func::dmn_0<cluster_domain<
   k_dmn::is_initialized() = true;
 
   if (init_add_and_subtract_matrices) {
-    initialize_add(r_dmn::get_super_basis(), r_dmn::get_elements(), r_dmn::get_add_matrix());
-    initialize_add(k_dmn::get_super_basis(), k_dmn::get_elements(), k_dmn::get_add_matrix());
-
-    initialize_subtract(r_dmn::get_super_basis(), r_dmn::get_elements(),
-                        r_dmn::get_subtract_matrix());
-    initialize_subtract(k_dmn::get_super_basis(), k_dmn::get_elements(),
-                        k_dmn::get_subtract_matrix());
+    initialize_lattice_index();
   }
 
   initialize_volume();
@@ -686,85 +677,14 @@ void cluster_domain_initializer<
 }
 
 template <typename scalar_type, int DIMENSION, CLUSTER_NAMES NAME, CLUSTER_SHAPE SHAPE>
-void cluster_domain_initializer<
-    func::dmn_0<cluster_domain<scalar_type, DIMENSION, NAME, REAL_SPACE, SHAPE>>>::
-    initialize_add(scalar_type* basis, std::vector<std::vector<scalar_type>>& elements,
-                   dca::linalg::Matrix<int, dca::linalg::CPU>& A) {
-  assert(SHAPE == BRILLOUIN_ZONE);
-
-  std::vector<std::vector<scalar_type>> basis_vecs(0);
-
-  for (int i = 0; i < DIMENSION; i++) {
-    std::vector<scalar_type> b_vec;
-    for (int j = 0; j < DIMENSION; j++)
-      b_vec.push_back(basis[j + i * DIMENSION]);
-
-    basis_vecs.push_back(b_vec);
-  }
-
-  A.resizeNoCopy(elements.size());
-
-  for (int i = 0; i < elements.size(); i++) {
-    for (int j = 0; j < elements.size(); j++) {
-      A(i, j) = -1;
-
-      std::vector<scalar_type>& x_i = elements[i];
-      std::vector<scalar_type>& x_j = elements[j];
-
-      std::vector<scalar_type> x_i_plus_x_j = x_i;
-      for (int d = 0; d < x_i_plus_x_j.size(); d++)
-        x_i_plus_x_j[d] += x_j[d];
-
-      x_i_plus_x_j = cluster_operations::translate_inside_cluster(x_i_plus_x_j, basis_vecs);
-
-      A(i, j) = cluster_operations::index(x_i_plus_x_j, elements, SHAPE);
-
-      if (A(i, j) == -1)
-        throw std::logic_error(__FUNCTION__);
-    }
-  }
-
-  // A.print();
-}
-
-template <typename scalar_type, int DIMENSION, CLUSTER_NAMES NAME, CLUSTER_SHAPE SHAPE>
-void cluster_domain_initializer<
-    func::dmn_0<cluster_domain<scalar_type, DIMENSION, NAME, REAL_SPACE, SHAPE>>>::
-    initialize_subtract(scalar_type* basis, std::vector<std::vector<scalar_type>>& elements,
-                        dca::linalg::Matrix<int, dca::linalg::CPU>& A) {
+void cluster_domain_initializer<func::dmn_0<cluster_domain<
+    scalar_type, DIMENSION, NAME, REAL_SPACE, SHAPE>>>::initialize_lattice_index() {
   assert(SHAPE == BRILLOUIN_ZONE);
 
-  std::vector<std::vector<scalar_type>> basis_vecs(0);
-
-  for (int i = 0; i < DIMENSION; i++) {
-    std::vector<scalar_type> b_vec;
-    for (int j = 0; j < DIMENSION; j++)
-      b_vec.push_back(basis[j + i * DIMENSION]);
-
-    basis_vecs.push_back(b_vec);
-  }
-
-  A.resizeNoCopy(elements.size());
-
-  for (int i = 0; i < elements.size(); i++) {
-    for (int j = 0; j < elements.size(); j++) {
-      A(i, j) = -1;
-
-      std::vector<scalar_type>& x_i = elements[i];
-      std::vector<scalar_type>& x_j = elements[j];
-
-      std::vector<scalar_type> x_j_min_x_i = x_j;
-      for (int d = 0; d < DIMENSION; d++)
-        x_j_min_x_i[d] -= x_i[d];
-
-      x_j_min_x_i = cluster_operations::translate_inside_cluster(x_j_min_x_i, basis_vecs);
-
-      A(i, j) = cluster_operations::index(x_j_min_x_i, elements, SHAPE);
-
-      if (A(i, j) == -1)
-        throw std::logic_error(__FUNCTION__);
-    }
-  }
+  r_dmn::get_lattice_index().initialize(DIMENSION, r_dmn::get_inverse_basis(),
+                                        r_dmn::get_super_basis(), r_dmn::get_elements());
+  k_dmn::get_lattice_index().initialize(DIMENSION, k_dmn::get_inverse_basis(),
+                                        k_dmn::get_super_basis(), k_dmn::get_elements());
 }
 
 template <typename scalar_type, int DIMENSION, CLUSTER_NAMES NAME, CLUSTER_SHAPE SHAPE>
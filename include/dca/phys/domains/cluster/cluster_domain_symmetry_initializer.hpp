@@ -13,6 +13,8 @@
 #define DCA_PHYS_DOMAINS_CLUSTER_CLUSTER_DOMAIN_SYMMETRY_INITIALIZER_HPP
 
 #include "dca/function/domains.hpp"
+#include "dca/io/buffer.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 #include "dca/phys/domains/cluster/cluster_symmetry.hpp"
 #include "dca/phys/domains/cluster/symmetrization_algorithms/cluster_reduction.hpp"
 
@@ -26,9 +28,25 @@ class cluster_domain_symmetry_initializer {
   typedef typename cluster_symmetry<cluster_type>::cluster_family_type cluster_family_type;
 
 public:
-  static void execute() {
+  // The symmetry matrices are computed with n_threads threads of 'threading'.
+  template <class Threading = parallel::NoThreading>
+  static void execute(Threading threading = Threading(), const int n_threads = 1) {
     cluster_reduction<cluster_family_type, point_group_type> cluster_reduction_obj;
-    cluster_reduction_obj.execute();
+    cluster_reduction_obj.execute(threading, n_threads);
+  }
+
+  // Reads the symmetry matrices from the current position of 'symmetry_tables' if they match the
+  // cluster, otherwise computes them. Returns true if they were read.
+  template <class Threading = parallel::NoThreading>
+  static bool execute(io::Buffer& symmetry_tables, Threading threading = Threading(),
+                      const int n_threads = 1) {
+    cluster_reduction<cluster_family_type, point_group_type> cluster_reduction_obj;
+    return cluster_reduction_obj.execute(symmetry_tables, threading, n_threads);
+  }
+
+  // Appends the symmetry matrices to 'symmetry_tables'.
+  static void write(io::Buffer& symmetry_tables) {
+    set_symmetry_matrices<cluster_family_type>::write(symmetry_tables);
   }
 };
 
@@ -37,9 +55,25 @@ class cluster_domain_symmetry_initializer<func::dmn_0<cluster_type>, point_group
   typedef typename cluster_symmetry<cluster_type>::cluster_family_type cluster_family_type;
 
 public:
-  static void execute() {
+  // The symmetry matrices are computed with n_threads threads of 'threading'.
+  template <class Threading = parallel::NoThreading>
+  static void execute(Threading threading = Threading(), const int n_threads = 1) {
     cluster_reduction<cluster_family_type, point_group_type> cluster_reduction_obj;
-    cluster_reduction_obj.execute();
+    cluster_reduction_obj.execute(threading, n_threads);
+  }
+
+  // Reads the symmetry matrices from the current position of 'symmetry_tables' if they match the
+  // cluster, otherwise computes them. Returns true if they were read.
+  template <class Threading = parallel::NoThreading>
+  static bool execute(io::Buffer& symmetry_tables, Threading threading = Threading(),
+                      const int n_threads = 1) {
+    cluster_reduction<cluster_family_type, point_group_type> cluster_reduction_obj;
+    return cluster_reduction_obj.execute(symmetry_tables, threading, n_threads);
+  }
+
+  // Appends the symmetry matrices to 'symmetry_tables'.
+  static void write(io::Buffer& symmetry_tables) {
+    set_symmetry_matrices<cluster_family_type>::write(symmetry_tables);
   }
 };
 
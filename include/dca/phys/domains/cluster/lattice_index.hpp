@@ -0,0 +1,317 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class maps the vectors of a lattice, modulo a superlattice, to the indices of the elements
+// of a cluster in O(1).
+// A lattice vector x has integer coordinates n = B^{-1} x with respect to the basis B. The
+// superlattice is spanned by S = B M, with M an integer matrix, and two lattice vectors are
+// equivalent iff their coordinates differ by a vector of M Z^D. The diagonalization L M R = diag(d)
+// with unimodular L and R (Smith normal form up to the divisibility of the d_i) maps the classes
+// one-to-one to the residues (L n)_i mod d_i. The residues of every element are stored, so that the
+// sum and the difference of two elements only need integer additions and a table lookup.
+
+#ifndef DCA_PHYS_DOMAINS_CLUSTER_LATTICE_INDEX_HPP
+#define DCA_PHYS_DOMAINS_CLUSTER_LATTICE_INDEX_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dca/linalg/matrix.hpp"
+
+namespace dca {
+namespace phys {
+namespace domains {
+// dca::phys::domains::
+
+class LatticeIndex {
+public:
+  LatticeIndex() = default;
+  LatticeIndex(const LatticeIndex&) = delete;
+  LatticeIndex& operator=(const LatticeIndex&) = delete;
+
+  // Initializes the index for the cluster 'elements' of dimension D. 'basis', 'inverse_basis' and
+  // 'super_basis' are D x D matrices stored in column-major order, with the basis vectors in the
+  // columns.
+  // Precondition: 'elements' contains exactly one vector of each class of lattice vectors modulo
+  //               the superlattice.
+  template <typename ScalarType>
+  void initialize(int D, const ScalarType* inverse_basis, const ScalarType* super_basis,
+                  const std::vector<std::vector<ScalarType>>& elements);
+
+  bool is_initialized() const {
+    return !element_of_code_.empty();
+  }
+
+  int size() const {
+    return element_of_code_.size();
+  }
+
+  // Returns the index of the element equivalent to the lattice vector x.
+  template <typename ScalarType>
+  int index(const std::vector<ScalarType>& x) const;
+  // Returns the index of the element equivalent to x, or -1 if x is not a lattice vector.
+  template <typename ScalarType>
+  int find(const std::vector<ScalarType>& x) const;
+
+  // Returns the index of x_i + x_j.
+  int add(int i, int j) const;
+  // Returns the index of x_j - x_i.
+  int subtract(int i, int j) const;
+
+  // Returns the dense tables A(i, j) = add(i, j) and A(i, j) = subtract(i, j), which are computed
+  // on the first call.
+  dca::linalg::Matrix<int, dca::linalg::CPU>& get_add_matrix();
+  dca::linalg::Matrix<int, dca::linalg::CPU>& get_subtract_matrix();
+
+private:
+  // Computes the integer coordinates n of x. Returns false if x is not a lattice vector.
+  template <typename ScalarType>
+  bool coordinates(const std::vector<ScalarType>& x, std::vector<long long>& n) const;
+  // Returns the code of the residues (L n)_i mod d_i of the integer coordinates n.
+  int code(const std::vector<long long>& n) const;
+
+  int dimension_ = 0;
+  std::vector<double> inverse_basis_;
+
+  // Rows of L and moduli of the components with d_i > 1.
+  std::vector<std::vector<long long>> left_transform_;
+  std::vector<int> moduli_;
+  std::vector<int> strides_;
+
+  // Residues of element i in residues_[i * moduli_.size() + c].
+  std::vector<int> residues_;
+  std::vector<int> element_of_code_;
+
+  std::mutex tables_mutex_;
+  dca::linalg::Matrix<int, dca::linalg::CPU> add_matrix_;
+  dca::linalg::Matrix<int, dca::linalg::CPU> subtract_matrix_;
+};
+
+template <typename ScalarType>
+void LatticeIndex::initialize(const int D, const ScalarType* inverse_basis,
+                              const ScalarType* super_basis,
+                              const std::vector<std::vector<ScalarType>>& elements) {
+  dimension_ = D;
+  inverse_basis_.assign(inverse_basis, inverse_basis + D * D);
+
+  // Integer matrix M = B^{-1} S of the superlattice.
+  std::vector<std::vector<long long>> A(D, std::vector<long long>(D));
+  for (int a = 0; a < D; ++a)
+    for (int c = 0; c < D; ++c) {
+      double m = 0;
+      for (int b = 0; b < D; ++b)
+        m += inverse_basis[a + b * D] * super_basis[b + c * D];
+      A[a][c] = std::llround(m);
+      if (std::abs(m - A[a][c]) > 1.e-6)
+        throw std::logic_error("The superlattice is not a sublattice of the lattice.");
+    }
+
+  std::vector<std::vector<long long>> L(D, std::vector<long long>(D, 0));
+  for (int a = 0; a < D; ++a)
+    L[a][a] = 1;
+
+  // Diagonalize M by integer row and column operations. The row operations are applied to L.
+  std::vector<long long> d(D);
+  for (int t = 0; t < D; ++t) {
+    while (true) {
+      int pi = -1, pj = -1;
+      for (int i = t; i < D; ++i)
+        for (int j = t; j < D; ++j)
+          if (A[i][j] != 0 && (pi == -1 || std::llabs(A[i][j]) < std::llabs(A[pi][pj]))) {
+            pi = i;
+            pj = j;
+          }
+      if (pi == -1)
+        throw std::logic_error("The superlattice is singular.");
+
+      std::swap(A[t], A[pi]);
+      std::swap(L[t], L[pi]);
+      for (int i = 0; i < D; ++i)
+        std::swap(A[i][t], A[i][pj]);
+
+      bool diagonal = true;
+      for (int i = t + 1; i < D; ++i) {
+        const long long q = A[i][t] / A[t][t];
+        for (int j = 0; j < D; ++j) {
+          A[i][j] -= q * A[t][j];
+          L[i][j] -= q * L[t][j];
+        }
+        diagonal = diagonal && A[i][t] == 0;
+      }
+      for (int j = t + 1; j < D; ++j) {
+        const long long q = A[t][j] / A[t][t];
+        for (int i = 0; i < D; ++i)
+          A[i][j] -= q * A[i][t];
+        diagonal = diagonal && A[t][j] == 0;
+      }
+
+      if (diagonal)
+        break;
+    }
+    d[t] = std::llabs(A[t][t]);
+  }
+
+  left_transform_.clear();
+  moduli_.clear();
+  strides_.clear();
+  long long n_classes = 1;
+  for (int t = 0; t < D; ++t) {
+    if (d[t] == 1)
+      continue;
+    left_transform_.push_back(L[t]);
+    moduli_.push_back(d[t]);
+    strides_.push_back(n_classes);
+    n_classes *= d[t];
+  }
+
+  if (n_classes != static_cast<long long>(elements.size()))
+    throw std::logic_error("The number of elements differs from the number of lattice classes.");
+
+  const int n_components = moduli_.size();
+  residues_.resize(elements.size() * n_components);
+  element_of_code_.assign(elements.size(), -1);
+
+  for (int i = 0; i < elements.size(); ++i) {
+    std::vector<long long> n;
+    if (!coordinates(elements[i], n))
+      throw std::logic_error("The element is not a lattice vector.");
+    int code = 0;
+    for (int c = 0; c < n_components; ++c) {
+      long long r = 0;
+      for (int a = 0; a < D; ++a)
+        r += left_transform_[c][a] * n[a];
+      r %= moduli_[c];
+      if (r < 0)
+        r += moduli_[c];
+
+      residues_[i * n_components + c] = r;
+      code += r * strides_[c];
+    }
+
+    if (element_of_code_[code] != -1)
+      throw std::logic_error("Two elements of the cluster are equivalent.");
+    element_of_code_[code] = i;
+  }
+
+  std::lock_guard<std::mutex> lock(tables_mutex_);
+  add_matrix_.resizeNoCopy(std::make_pair(0, 0));
+  subtract_matrix_.resizeNoCopy(std::make_pair(0, 0));
+}
+
+template <typename ScalarType>
+bool LatticeIndex::coordinates(const std::vector<ScalarType>& x, std::vector<long long>& n) const {
+  assert(x.size() == dimension_);
+
+  n.resize(dimension_);
+  for (int a = 0; a < dimension_; ++a) {
+    double n_a = 0;
+    for (int b = 0; b < dimension_; ++b)
+      n_a += inverse_basis_[a + b * dimension_] * x[b];
+    n[a] = std::llround(n_a);
+    if (std::abs(n_a - n[a]) > 1.e-6)
+      return false;
+  }
+  return true;
+}
+
+inline int LatticeIndex::code(const std::vector<long long>& n) const {
+  int code = 0;
+  for (int c = 0; c < moduli_.size(); ++c) {
+    long long r = 0;
+    for (int a = 0; a < dimension_; ++a)
+      r += left_transform_[c][a] * n[a];
+    r %= moduli_[c];
+    if (r < 0)
+      r += moduli_[c];
+    code += r * strides_[c];
+  }
+  return code;
+}
+
+template <typename ScalarType>
+int LatticeIndex::index(const std::vector<ScalarType>& x) const {
+  const int i = find(x);
+  if (i == -1)
+    throw std::logic_error("The vector is not a lattice vector.");
+  return i;
+}
+
+template <typename ScalarType>
+int LatticeIndex::find(const std::vector<ScalarType>& x) const {
+  assert(is_initialized());
+  std::vector<long long> n;
+  if (!coordinates(x, n))
+    return -1;
+  return element_of_code_[code(n)];
+}
+
+inline int LatticeIndex::add(const int i, const int j) const {
+  assert(i >= 0 && i < size() && j >= 0 && j < size());
+
+  const int n_components = moduli_.size();
+  const int* r_i = &residues_[i * n_components];
+  const int* r_j = &residues_[j * n_components];
+
+  int code = 0;
+  for (int c = 0; c < n_components; ++c) {
+    int r = r_i[c] + r_j[c];
+    if (r >= moduli_[c])
+      r -= moduli_[c];
+    code += r * strides_[c];
+  }
+  return element_of_code_[code];
+}
+
+inline int LatticeIndex::subtract(const int i, const int j) const {
+  assert(i >= 0 && i < size() && j >= 0 && j < size());
+
+  const int n_components = moduli_.size();
+  const int* r_i = &residues_[i * n_components];
+  const int* r_j = &residues_[j * n_components];
+
+  int code = 0;
+  for (int c = 0; c < n_components; ++c) {
+    int r = r_j[c] - r_i[c];
+    if (r < 0)
+      r += moduli_[c];
+    code += r * strides_[c];
+  }
+  return element_of_code_[code];
+}
+
+inline dca::linalg::Matrix<int, dca::linalg::CPU>& LatticeIndex::get_add_matrix() {
+  std::lock_guard<std::mutex> lock(tables_mutex_);
+  if (add_matrix_.size().first != size()) {
+    add_matrix_.resizeNoCopy(size());
+    for (int j = 0; j < size(); ++j)
+      for (int i = 0; i < size(); ++i)
+        add_matrix_(i, j) = add(i, j);
+  }
+  return add_matrix_;
+}
+
+inline dca::linalg::Matrix<int, dca::linalg::CPU>& LatticeIndex::get_subtract_matrix() {
+  std::lock_guard<std::mutex> lock(tables_mutex_);
+  if (subtract_matrix_.size().first != size()) {
+    subtract_matrix_.resizeNoCopy(size());
+    for (int j = 0; j < size(); ++j)
+      for (int i = 0; i < size(); ++i)
+        subtract_matrix_(i, j) = subtract(i, j);
+  }
+  return subtract_matrix_;
+}
+
+}  // domains
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DOMAINS_CLUSTER_LATTICE_INDEX_HPP
@@ -12,6 +12,8 @@
 #ifndef DCA_PHYS_DOMAINS_CLUSTER_SYMMETRIZATION_ALGORITHMS_CLUSTER_REDUCTION_HPP
 #define DCA_PHYS_DOMAINS_CLUSTER_SYMMETRIZATION_ALGORITHMS_CLUSTER_REDUCTION_HPP
 
+#include "dca/io/buffer.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 #include "dca/phys/domains/cluster/symmetrization_algorithms/search_maximal_symmetry_group.hpp"
 #include "dca/phys/domains/cluster/symmetrization_algorithms/set_symmetry_matrices.hpp"
 
@@ -25,23 +27,47 @@ class cluster_reduction {
 public:
   cluster_reduction() {}
 
-  void execute();
+  // The symmetry matrices are computed with n_threads threads of 'threading'.
+  template <class Threading = parallel::NoThreading>
+  void execute(Threading threading = Threading(), int n_threads = 1);
+  // Reads the symmetry matrices from 'symmetry_tables' instead of computing them, if they were
+  // written for the same cluster, bands and symmetry operations. Returns true if they were read.
+  template <class Threading = parallel::NoThreading>
+  bool execute(io::Buffer& symmetry_tables, Threading threading = Threading(), int n_threads = 1);
 };
 
 template <class base_cluster_type, class point_group>
-void cluster_reduction<base_cluster_type, point_group>::execute() {
+template <class Threading>
+void cluster_reduction<base_cluster_type, point_group>::execute(Threading threading,
+                                                                const int n_threads) {
   // cout << __FUNCTION__ << endl;
 
   search_maximal_symmetry_group<base_cluster_type, point_group, domains::UNIT_CELL>::execute();
 
   search_maximal_symmetry_group<base_cluster_type, point_group, domains::SUPER_CELL>::execute();
 
-  set_symmetry_matrices<base_cluster_type>::execute();
+  set_symmetry_matrices<base_cluster_type>::execute(threading, n_threads);
 
   //   set_symmetry_matrices<base_cluster_type>::print_on_shell();
   //   throw std::logic_error(__FUNCTION__);
 }
 
+template <class base_cluster_type, class point_group>
+template <class Threading>
+bool cluster_reduction<base_cluster_type, point_group>::execute(io::Buffer& symmetry_tables,
+                                                                Threading threading,
+                                                                const int n_threads) {
+  search_maximal_symmetry_group<base_cluster_type, point_group, domains::UNIT_CELL>::execute();
+
+  search_maximal_symmetry_group<base_cluster_type, point_group, domains::SUPER_CELL>::execute();
+
+  if (set_symmetry_matrices<base_cluster_type>::read(symmetry_tables))
+    return true;
+
+  set_symmetry_matrices<base_cluster_type>::execute(threading, n_threads);
+  return false;
+}
+
 }  // domains
 }  // phys
 }  // dca
@@ -7,19 +7,32 @@
 //
 // Author: Peter Staar (taa@zurich.ibm.com)
 //
-// This class sets the symmetry matrices.
+// This class sets the symmetry matrices, i.e. the image (r', b') of every site and band (r, b) of
+// the cluster under every symmetry operation of the super cell, and its momentum space analogue.
+// The image of r + a_b is found in O(1) from the integer coordinates of r + a_b - a_b' with respect
+// to the lattice (see lattice_index.hpp), and the operations are distributed over the threads.
+// The tables can be written to and read from an io::Buffer, together with the cluster, bands and
+// operations they were computed for.
 
 #ifndef DCA_PHYS_DOMAINS_CLUSTER_SYMMETRIZATION_ALGORITHMS_SET_SYMMETRY_MATRICES_HPP
 #define DCA_PHYS_DOMAINS_CLUSTER_SYMMETRIZATION_ALGORITHMS_SET_SYMMETRY_MATRICES_HPP
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
+#include "dca/io/buffer.hpp"
 #include "dca/math/util/vector_operations.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 #include "dca/phys/domains/cluster/cluster_symmetry.hpp"
 #include "dca/phys/domains/cluster/cluster_operations.hpp"
+#include "dca/phys/domains/cluster/lattice_index.hpp"
 #include "dca/phys/domains/quantum/electron_band_domain.hpp"
 #include "dca/phys/domains/quantum/point_group_symmetry_domain.hpp"
 
@@ -50,100 +63,112 @@ class set_symmetry_matrices {
   typedef func::dmn_0<sym_super_cell_t> sym_super_cell_dmn_t;
 
 public:
-  static void execute();
+  // The symmetry operations are distributed amongst n_threads threads of 'threading'.
+  template <class Threading>
+  static void execute(Threading threading, int n_threads);
+  static void execute() {
+    execute(parallel::NoThreading(), 1);
+  }
+
+  // Writes the symmetry matrices to 'buffer'.
+  static void write(io::Buffer& buffer);
+  // Reads the symmetry matrices written by write from the current position of 'buffer'.
+  // Returns false, and leaves the symmetry matrices unchanged, if the buffer does not contain
+  // matrices computed for the current cluster, bands and symmetry operations.
+  static bool read(io::Buffer& buffer);
 
   static void print_on_shell();
 
 private:
-  static void set_r_symmetry_matrix();
-  static void set_k_symmetry_matrix();
+  template <class Threading>
+  static void set_r_symmetry_matrix(Threading& threading, int n_threads);
+  template <class Threading>
+  static void set_k_symmetry_matrix(Threading& threading, int n_threads);
+
+  // Calls f(l) for each symmetry operation l, distributing the operations amongst n_threads
+  // threads of 'threading'.
+  template <class Threading, class F>
+  static void for_each_operation(Threading& threading, int n_threads, F&& f);
+
+  // Returns the data the symmetry matrices depend on.
+  static std::vector<double> fingerprint();
 
-  static int find_k_index(std::vector<double> k);
+  static void print_missing_image(int i, int j, int l);
 };
 
 template <class base_cluster_type>
-void set_symmetry_matrices<base_cluster_type>::execute() {
-  set_r_symmetry_matrix();
-  set_k_symmetry_matrix();
+template <class Threading>
+void set_symmetry_matrices<base_cluster_type>::execute(Threading threading, const int n_threads) {
+  set_r_symmetry_matrix(threading, n_threads);
+  set_k_symmetry_matrix(threading, n_threads);
+}
+
+template <class base_cluster_type>
+template <class Threading, class F>
+void set_symmetry_matrices<base_cluster_type>::for_each_operation(Threading& threading,
+                                                                  const int n_threads, F&& f) {
+  const int n_operations = sym_super_cell_dmn_t::dmn_size();
+
+  threading.execute(std::max(1, std::min(n_threads, n_operations)),
+                    [&](const int id, const int n_tasks) {
+                      for (int l = id; l < n_operations; l += n_tasks)
+                        f(l);
+                    });
 }
 
 template <class base_cluster_type>
-void set_symmetry_matrices<base_cluster_type>::set_r_symmetry_matrix() {
-  // func::function<std::pair<int,int>, func::dmn_variadic< func::dmn_variadic<r_dmn_t,b_dmn_t>,
-  // sym_super_cell_dmn_t > >&
-  // symmetry_matrix = r_cluster_type::get_symmetry_matrix();
+template <class Threading>
+void set_symmetry_matrices<base_cluster_type>::set_r_symmetry_matrix(Threading& threading,
+                                                                     const int n_threads) {
   func::function<std::pair<int, int>,
                  func::dmn_variadic<func::dmn_variadic<r_dmn_t, b_dmn_t>, sym_super_cell_dmn_t>>&
       symmetry_matrix = cluster_symmetry<r_cluster_type>::get_symmetry_matrix();
 
-  for (int i = 0; i < r_dmn_t::dmn_size(); ++i) {
-    for (int j = 0; j < b_dmn_t::dmn_size(); ++j) {
-      for (int l = 0; l < sym_super_cell_dmn_t::dmn_size(); ++l) {
-        symmetry_matrix(i, j, l) = std::pair<int, int>(-1, -1);
+  LatticeIndex lattice_index;
+  lattice_index.initialize(DIMENSION, r_cluster_type::get_inverse_basis(),
+                           r_cluster_type::get_super_basis(), r_cluster_type::get_elements());
 
-        std::vector<double> r_plus_a =
-            math::util::add(r_dmn_t::get_elements()[i], b_dmn_t::get_elements()[j].a_vec);
-        std::vector<double> trafo_r_plus_a(DIMENSION, 0);
+  const auto& bands = b_dmn_t::get_elements();
 
-        sym_super_cell_dmn_t::get_elements()[l].transform(&r_plus_a[0], &trafo_r_plus_a[0]);
-
-        // trafo_r_plus_a = r_cluster_type::back_inside_cluster(trafo_r_plus_a);
-        trafo_r_plus_a = cluster_operations::translate_inside_cluster(
-            trafo_r_plus_a, r_cluster_type::get_super_basis_vectors());
+  for_each_operation(threading, n_threads, [&](const int l) {
+    std::vector<double> trafo_r_plus_a(DIMENSION, 0);
 
-        for (int r_ind = 0; r_ind < r_dmn_t::dmn_size(); ++r_ind) {
-          for (int b_ind = 0; b_ind < b_dmn_t::dmn_size(); ++b_ind) {
-            std::vector<double> rj_plus_aj = math::util::add(r_dmn_t::get_elements()[r_ind],
-                                                             b_dmn_t::get_elements()[b_ind].a_vec);
+    for (int i = 0; i < r_dmn_t::dmn_size(); ++i) {
+      for (int j = 0; j < b_dmn_t::dmn_size(); ++j) {
+        std::vector<double> r_plus_a = math::util::add(r_dmn_t::get_elements()[i], bands[j].a_vec);
 
-            // rj_plus_aj = r_cluster_type::back_inside_cluster(rj_plus_aj);
-            rj_plus_aj = cluster_operations::translate_inside_cluster(
-                rj_plus_aj, r_cluster_type::get_super_basis_vectors());
+        sym_super_cell_dmn_t::get_elements()[l].transform(&r_plus_a[0], &trafo_r_plus_a[0]);
 
-            if (math::util::distance2(rj_plus_aj, trafo_r_plus_a) < 1.e-6 and
-                b_dmn_t::get_elements()[j].flavor == b_dmn_t::get_elements()[b_ind].flavor)
-              symmetry_matrix(i, j, l) = std::pair<int, int>(r_ind, b_ind);
-          }
+        // The image is the site r' of the band b' with the same flavor, for which
+        // T(r + a_b) - a_b' - r' is a superlattice vector. Of several images the one with the
+        // largest (r', b') is taken.
+        std::pair<int, int> image(-1, -1);
+        for (int b_ind = 0; b_ind < b_dmn_t::dmn_size(); ++b_ind) {
+          if (bands[j].flavor != bands[b_ind].flavor)
+            continue;
+
+          const int r_ind =
+              lattice_index.find(math::util::subtract(bands[b_ind].a_vec, trafo_r_plus_a));
+          if (r_ind != -1 && r_ind >= image.first)
+            image = std::pair<int, int>(r_ind, b_ind);
         }
 
-        if (symmetry_matrix(i, j, l).first == -1 or symmetry_matrix(i, j, l).second == -1) {
-          std::vector<double> r_plus_a =
-              math::util::add(r_dmn_t::get_elements()[i], b_dmn_t::get_elements()[j].a_vec);
-
-          std::vector<double> trafo_r_plus_a(DIMENSION, 0);
-          std::vector<double> trafo_r_plus_a_in_cluster(DIMENSION, 0);
-
-          sym_super_cell_dmn_t::get_elements()[l].transform(&r_plus_a[0], &trafo_r_plus_a[0]);
-
-          math::util::print(r_plus_a);
-          std::cout << "\t-->\t";
-          math::util::print(trafo_r_plus_a);
-          std::cout << "\t-->\t";
-
-          std::vector<double> r_affine =
-              math::util::coordinates(trafo_r_plus_a, r_cluster_type::get_super_basis_vectors());
-
-          math::util::print(r_affine);
-          std::cout << "\t-->\t";
-
-          trafo_r_plus_a_in_cluster = cluster_operations::translate_inside_cluster(
-              trafo_r_plus_a, r_cluster_type::get_super_basis_vectors());
-
-          math::util::print(trafo_r_plus_a_in_cluster);
-          std::cout << "\n\n";
-
-          sym_super_cell_dmn_t::get_elements()[l].to_JSON(std::cout);
-
-          // assert(false);
-          // throw std::logic_error(__FUNCTION__);
-        }
+        symmetry_matrix(i, j, l) = image;
       }
     }
-  }
+  });
+
+  for (int l = 0; l < sym_super_cell_dmn_t::dmn_size(); ++l)
+    for (int i = 0; i < r_dmn_t::dmn_size(); ++i)
+      for (int j = 0; j < b_dmn_t::dmn_size(); ++j)
+        if (symmetry_matrix(i, j, l).first == -1)
+          print_missing_image(i, j, l);
 }
 
 template <class base_cluster_type>
-void set_symmetry_matrices<base_cluster_type>::set_k_symmetry_matrix() {
+template <class Threading>
+void set_symmetry_matrices<base_cluster_type>::set_k_symmetry_matrix(Threading& threading,
+                                                                     const int n_threads) {
   func::function<std::pair<int, int>, func::dmn_variadic<func::dmn_variadic<r_dmn_t, b_dmn_t>,
                                                          sym_super_cell_dmn_t>>& r_symmetry_matrix =
       cluster_symmetry<r_cluster_type>::get_symmetry_matrix();  // r_cluster_type::get_symmetry_matrix();
@@ -151,52 +176,136 @@ void set_symmetry_matrices<base_cluster_type>::set_k_symmetry_matrix() {
                                                          sym_super_cell_dmn_t>>& k_symmetry_matrix =
       cluster_symmetry<k_cluster_type>::get_symmetry_matrix();  // k_cluster_type::get_symmetry_matrix();
 
-  //   r_symmetry_matrix.print_fingerprint();
-  //   k_symmetry_matrix.print_fingerprint();
+  LatticeIndex lattice_index;
+  lattice_index.initialize(DIMENSION, k_cluster_type::get_inverse_basis(),
+                           k_cluster_type::get_super_basis(), k_cluster_type::get_elements());
+
+  for_each_operation(threading, n_threads, [&](const int l) {
+    std::vector<double> trafo_k(DIMENSION, 0);
 
-  for (int i = 0; i < k_dmn_t::dmn_size(); ++i) {
-    for (int j = 0; j < b_dmn_t::dmn_size(); ++j) {
-      for (int l = 0; l < sym_super_cell_dmn_t::dmn_size(); ++l) {
-        std::vector<double> k = k_dmn_t::get_elements()[i];
-        std::vector<double> trafo_k(DIMENSION, 0);
+    for (int i = 0; i < k_dmn_t::dmn_size(); ++i) {
+      std::vector<double> k = k_dmn_t::get_elements()[i];
+      sym_super_cell_dmn_t::get_elements()[l].linear_transform(&k[0], &trafo_k[0]);
 
-        sym_super_cell_dmn_t::get_elements()[l].linear_transform(&k[0], &trafo_k[0]);
+      const int k_ind = lattice_index.find(trafo_k);
+      assert(k_ind > -1 and k_ind < k_cluster_type::get_elements().size());
 
-        k_symmetry_matrix(i, j, l).first = find_k_index(trafo_k);
+      for (int j = 0; j < b_dmn_t::dmn_size(); ++j) {
+        k_symmetry_matrix(i, j, l).first = k_ind;
         k_symmetry_matrix(i, j, l).second = r_symmetry_matrix(i, j, l).second;
       }
     }
+  });
+}
+
+template <class base_cluster_type>
+std::vector<double> set_symmetry_matrices<base_cluster_type>::fingerprint() {
+  std::vector<double> data{double(DIMENSION), double(r_dmn_t::dmn_size()),
+                           double(b_dmn_t::dmn_size()), double(sym_super_cell_dmn_t::dmn_size())};
+
+  for (int i = 0; i < DIMENSION * DIMENSION; ++i) {
+    data.push_back(r_cluster_type::get_basis()[i]);
+    data.push_back(r_cluster_type::get_super_basis()[i]);
+  }
+
+  for (const auto& band : b_dmn_t::get_elements()) {
+    data.push_back(band.flavor);
+    data.insert(data.end(), band.a_vec.begin(), band.a_vec.end());
+  }
+
+  for (int l = 0; l < sym_super_cell_dmn_t::dmn_size(); ++l) {
+    const auto& operation = sym_super_cell_dmn_t::get_elements()[l];
+    data.insert(data.end(), operation.O, operation.O + DIMENSION * DIMENSION);
+    data.insert(data.end(), operation.t, operation.t + DIMENSION);
+  }
+
+  return data;
+}
+
+template <class base_cluster_type>
+void set_symmetry_matrices<base_cluster_type>::write(io::Buffer& buffer) {
+  auto& r_symmetry_matrix = cluster_symmetry<r_cluster_type>::get_symmetry_matrix();
+  auto& k_symmetry_matrix = cluster_symmetry<k_cluster_type>::get_symmetry_matrix();
+
+  std::vector<int> r_images(2 * r_symmetry_matrix.size());
+  std::vector<int> k_images(2 * k_symmetry_matrix.size());
+  for (int i = 0; i < r_symmetry_matrix.size(); ++i) {
+    r_images[2 * i] = r_symmetry_matrix(i).first;
+    r_images[2 * i + 1] = r_symmetry_matrix(i).second;
+    k_images[2 * i] = k_symmetry_matrix(i).first;
+    k_images[2 * i + 1] = k_symmetry_matrix(i).second;
   }
+
+  buffer << fingerprint() << r_images << k_images;
+}
+
+template <class base_cluster_type>
+bool set_symmetry_matrices<base_cluster_type>::read(io::Buffer& buffer) {
+  std::vector<double> data;
+  std::vector<int> r_images;
+  std::vector<int> k_images;
+
+  try {
+    buffer >> data >> r_images >> k_images;
+  }
+  catch (const std::out_of_range&) {
+    return false;
+  }
+
+  const std::vector<double> expected = fingerprint();
+  if (data.size() != expected.size())
+    return false;
+  for (int i = 0; i < data.size(); ++i)
+    if (std::abs(data[i] - expected[i]) > 1.e-10)
+      return false;
+
+  auto& r_symmetry_matrix = cluster_symmetry<r_cluster_type>::get_symmetry_matrix();
+  auto& k_symmetry_matrix = cluster_symmetry<k_cluster_type>::get_symmetry_matrix();
+
+  if (r_images.size() != 2 * r_symmetry_matrix.size() ||
+      k_images.size() != 2 * k_symmetry_matrix.size())
+    return false;
+
+  for (int i = 0; i < r_symmetry_matrix.size(); ++i) {
+    r_symmetry_matrix(i) = std::pair<int, int>(r_images[2 * i], r_images[2 * i + 1]);
+    k_symmetry_matrix(i) = std::pair<int, int>(k_images[2 * i], k_images[2 * i + 1]);
+  }
+
+  return true;
 }
 
 template <class base_cluster_type>
-int set_symmetry_matrices<base_cluster_type>::find_k_index(std::vector<double> k) {
-  /*
-    assert(k_cluster_type::test_back_inside_cluster());
+void set_symmetry_matrices<base_cluster_type>::print_missing_image(const int i, const int j,
+                                                                   const int l) {
+  std::vector<double> r_plus_a =
+      math::util::add(r_dmn_t::get_elements()[i], b_dmn_t::get_elements()[j].a_vec);
 
-    int index=-1;
+  std::vector<double> trafo_r_plus_a(DIMENSION, 0);
+  std::vector<double> trafo_r_plus_a_in_cluster(DIMENSION, 0);
 
-    //k = k_cluster_type::back_inside_cluster(k);
-    k = cluster_operations::translate_inside_cluster(k, k_cluster_type::get_super_basis_new());
+  sym_super_cell_dmn_t::get_elements()[l].transform(&r_plus_a[0], &trafo_r_plus_a[0]);
 
-    for(int k_ind=0; k_ind<k_dmn_t::dmn_size(); ++k_ind)
-    if(math::util::distance2(k_dmn_t::get_elements()[k_ind], k)<1.e-6)
-    index = k_ind;
+  math::util::print(r_plus_a);
+  std::cout << "\t-->\t";
+  math::util::print(trafo_r_plus_a);
+  std::cout << "\t-->\t";
 
-    if(index<0)
-    throw std::logic_error(__FUNCTION__);
+  std::vector<double> r_affine =
+      math::util::coordinates(trafo_r_plus_a, r_cluster_type::get_super_basis_vectors());
 
-    return index;
-  */
+  math::util::print(r_affine);
+  std::cout << "\t-->\t";
 
-  k = cluster_operations::translate_inside_cluster(k, k_cluster_type::get_super_basis_vectors());
+  trafo_r_plus_a_in_cluster = cluster_operations::translate_inside_cluster(
+      trafo_r_plus_a, r_cluster_type::get_super_basis_vectors());
 
-  int index = cluster_operations::index(k, k_cluster_type::get_elements(), base_cluster_type::SHAPE);
+  math::util::print(trafo_r_plus_a_in_cluster);
+  std::cout << "\n\n";
 
-  assert(index > -1 and index < k_cluster_type::get_elements().size());
-  assert(math::util::distance2(k_dmn_t::get_elements()[index], k) < 1.e-6);
+  sym_super_cell_dmn_t::get_elements()[l].to_JSON(std::cout);
 
-  return index;
+  // assert(false);
+  // throw std::logic_error(__FUNCTION__);
 }
 
 template <class base_cluster_type>
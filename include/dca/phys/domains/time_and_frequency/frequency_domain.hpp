@@ -76,6 +76,12 @@ public:
     initialize(parameters.get_beta(), parameters.get_sp_fermionic_frequencies());
   }
 
+  // Resets the domain, so that it can be initialized again, e.g. for a different inverse
+  // temperature. The number of frequencies must not change.
+  static void reset() {
+    initialized_ = false;
+  }
+
 private:
   static bool initialized_;
   const static std::string name_;
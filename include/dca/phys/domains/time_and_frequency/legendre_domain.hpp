@@ -0,0 +1,97 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This class parametrizes the compact Legendre basis of fermionic imaginary time functions,
+//     G(tau) = \sum_l \sqrt(2l+1) / beta P_l(x(tau)) G_l,   x(tau) = 2 tau / beta - 1,
+//     G_l = \sqrt(2l+1) \int_0^beta dtau P_l(x(tau)) G(tau).
+// The number of coefficients needed to represent a Green's function grows only logarithmically
+// with beta (see L. Boehnke et al., Phys. Rev. B 84, 075145 (2011)).
+
+#ifndef DCA_PHYS_DOMAINS_TIME_AND_FREQUENCY_LEGENDRE_DOMAIN_HPP
+#define DCA_PHYS_DOMAINS_TIME_AND_FREQUENCY_LEGENDRE_DOMAIN_HPP
+
+#include <cassert>
+#include <cstdlib>  // std::size_t
+#include <string>
+#include <vector>
+
+namespace dca {
+namespace phys {
+namespace domains {
+// dca::phys::domains::
+
+class LegendreDomain {
+public:
+  using element_type = int;  // Order l of the Legendre polynomial.
+  using scalar_type = double;
+
+  static bool is_initialized() {
+    return initialized_;
+  }
+
+  static const std::string& get_name() {
+    return name_;
+  }
+
+  static std::size_t get_size() {
+    assert(initialized_);
+    return elements_.size();
+  }
+
+  static const std::vector<element_type>& get_elements() {
+    assert(initialized_);
+    return elements_;
+  }
+
+  static scalar_type get_beta() {
+    assert(initialized_);
+    return beta_;
+  }
+
+  template <typename Writer>
+  static void write(Writer& writer);
+
+  // Initializes the domain with the orders 0, 1, ..., num_coefficients - 1.
+  static void initialize(scalar_type beta, int num_coefficients);
+
+  // Calls the previous initialize method with arguments taken from the parameters object.
+  template <typename ParametersType>
+  static void initialize(const ParametersType& parameters) {
+    initialize(parameters.get_beta(), parameters.get_legendre_coefficients());
+  }
+
+  // Resets the domain, so that it can be initialized again with a different inverse temperature.
+  static void reset() {
+    initialized_ = false;
+  }
+
+  // Stores in 'values' the basis functions \sqrt(2l+1) P_l(x(tau)) for all l in the domain.
+  // Imaginary times in [-beta, 0) are mapped to [0, beta) using the antiperiodicity of fermionic
+  // functions, which introduces a minus sign.
+  // Precondition: -beta <= tau <= beta.
+  static void evaluate(scalar_type tau, std::vector<scalar_type>& values);
+
+private:
+  static bool initialized_;
+  const static std::string name_;
+  static scalar_type beta_;
+  static std::vector<element_type> elements_;
+};
+
+template <typename Writer>
+void LegendreDomain::write(Writer& writer) {
+  writer.open_group(name_);
+  writer.execute("elements", elements_);
+  writer.execute("beta", beta_);
+  writer.close_group();
+}
+
+}  // domains
+}  // phys
+}  // dca
+
+#endif  // DCA_PHYS_DOMAINS_TIME_AND_FREQUENCY_LEGENDRE_DOMAIN_HPP
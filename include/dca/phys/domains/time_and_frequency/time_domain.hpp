@@ -79,6 +79,13 @@ public:
     initialize(parameters.get_beta(), parameters.get_sp_time_intervals());
   }
 
+  // Resets the domain, so that it can be initialized again, e.g. with a different inverse
+  // temperature. Functions on the domain keep their size, i.e. the number of elements must not
+  // change.
+  static void reset() {
+    initialized_ = false;
+  }
+
   // Initializes weights and nodes for integration on the imaginary time domain.
   // The number of nodes per time slice is 2^level.
   // Precondition: The time domain is initialized, i.e. one of the initialize methods has been
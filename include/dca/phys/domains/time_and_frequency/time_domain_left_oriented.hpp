@@ -63,6 +63,12 @@ public:
     initialize();
   }
 
+  // Resets the domain, so that it can be initialized again after time_domain has been
+  // reinitialized.
+  static void reset() {
+    initialized_ = false;
+  }
+
 private:
   static bool initialized_;
   const static std::string name_;
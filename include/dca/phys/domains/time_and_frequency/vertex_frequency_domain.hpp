@@ -217,7 +217,7 @@ void vertex_frequency_domain<EXTENDED_BOSONIC>::initialize(parameters_t& paramet
 
   get_size() = 2 * parameters.get_hts_bosonic_frequencies() + 1;
 
-  get_elements().resize(get_size(), -2. * M_PI / parameters.get_beta() * int(get_size() / 2));
+  get_elements().assign(get_size(), -2. * M_PI / parameters.get_beta() * int(get_size() / 2));
 
   for (int l = 0; l < get_size(); l++) {
     get_elements()[l] += l * 2. * M_PI / parameters.get_beta();
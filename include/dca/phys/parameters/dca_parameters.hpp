@@ -32,6 +32,10 @@ public:
         self_energy_mixing_factor_(1.),
         interacting_orbitals_{0},
 
+        anderson_history_size_(0),
+        anderson_regularization_(1.e-3),
+        anderson_noise_threshold_(1.),
+
         do_finite_size_qmc_(false),
 
         k_mesh_recursion_(0),
@@ -43,6 +47,8 @@ public:
         do_dca_plus_(false),
         deconvolution_iterations_(16),
         deconvolution_tolerance_(1.e-3),
+        deconvolution_warm_start_(false),
+        deconvolution_stagnation_tolerance_(0.),
         hts_approximation_(false),
         hts_threads_(1) {}
 
@@ -75,6 +81,15 @@ public:
   const std::vector<int>& get_interacting_orbitals() const {
     return interacting_orbitals_;
   }
+  int get_anderson_history_size() const {
+    return anderson_history_size_;
+  }
+  double get_anderson_regularization() const {
+    return anderson_regularization_;
+  }
+  double get_anderson_noise_threshold() const {
+    return anderson_noise_threshold_;
+  }
   bool do_finite_size_qmc() const {
     return do_finite_size_qmc_;
   }
@@ -87,6 +102,9 @@ public:
   int get_quadrature_rule() const {
     return quadrature_rule_;
   }
+  // Number of threads of the coarse-graining. It is also used by the threaded parts of the
+  // initialization outside of the cluster solver, e.g. the construction of the cluster symmetry
+  // tables and of the free Green's function, and by the lattice mapping.
   int get_coarsegraining_threads() const {
     return coarsegraining_threads_;
   }
@@ -102,6 +120,12 @@ public:
   double get_deconvolution_tolerance() const {
     return deconvolution_tolerance_;
   }
+  bool deconvolution_warm_start() const {
+    return deconvolution_warm_start_;
+  }
+  double get_deconvolution_stagnation_tolerance() const {
+    return deconvolution_stagnation_tolerance_;
+  }
   bool hts_approximation() const {
     return hts_approximation_;
   }
@@ -116,6 +140,11 @@ private:
   double self_energy_mixing_factor_;
   std::vector<int> interacting_orbitals_;
 
+  // Anderson acceleration
+  int anderson_history_size_;
+  double anderson_regularization_;
+  double anderson_noise_threshold_;
+
   bool do_finite_size_qmc_;
 
   // coarse-graining
@@ -129,6 +158,8 @@ private:
   bool do_dca_plus_;
   int deconvolution_iterations_;
   double deconvolution_tolerance_;
+  bool deconvolution_warm_start_;
+  double deconvolution_stagnation_tolerance_;
   bool hts_approximation_;
   int hts_threads_;
 };
@@ -142,6 +173,9 @@ int DcaParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(dca_accuracy_);
   buffer_size += concurrency.get_buffer_size(self_energy_mixing_factor_);
   buffer_size += concurrency.get_buffer_size(interacting_orbitals_);
+  buffer_size += concurrency.get_buffer_size(anderson_history_size_);
+  buffer_size += concurrency.get_buffer_size(anderson_regularization_);
+  buffer_size += concurrency.get_buffer_size(anderson_noise_threshold_);
   buffer_size += concurrency.get_buffer_size(do_finite_size_qmc_);
   buffer_size += concurrency.get_buffer_size(k_mesh_recursion_);
   buffer_size += concurrency.get_buffer_size(coarsegraining_periods_);
@@ -151,6 +185,8 @@ int DcaParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(do_dca_plus_);
   buffer_size += concurrency.get_buffer_size(deconvolution_iterations_);
   buffer_size += concurrency.get_buffer_size(deconvolution_tolerance_);
+  buffer_size += concurrency.get_buffer_size(deconvolution_warm_start_);
+  buffer_size += concurrency.get_buffer_size(deconvolution_stagnation_tolerance_);
   buffer_size += concurrency.get_buffer_size(hts_approximation_);
   buffer_size += concurrency.get_buffer_size(hts_threads_);
 
@@ -165,6 +201,9 @@ void DcaParameters::pack(const Concurrency& concurrency, char* buffer, int buffe
   concurrency.pack(buffer, buffer_size, position, dca_accuracy_);
   concurrency.pack(buffer, buffer_size, position, self_energy_mixing_factor_);
   concurrency.pack(buffer, buffer_size, position, interacting_orbitals_);
+  concurrency.pack(buffer, buffer_size, position, anderson_history_size_);
+  concurrency.pack(buffer, buffer_size, position, anderson_regularization_);
+  concurrency.pack(buffer, buffer_size, position, anderson_noise_threshold_);
   concurrency.pack(buffer, buffer_size, position, do_finite_size_qmc_);
   concurrency.pack(buffer, buffer_size, position, k_mesh_recursion_);
   concurrency.pack(buffer, buffer_size, position, coarsegraining_periods_);
@@ -174,6 +213,8 @@ void DcaParameters::pack(const Concurrency& concurrency, char* buffer, int buffe
   concurrency.pack(buffer, buffer_size, position, do_dca_plus_);
   concurrency.pack(buffer, buffer_size, position, deconvolution_iterations_);
   concurrency.pack(buffer, buffer_size, position, deconvolution_tolerance_);
+  concurrency.pack(buffer, buffer_size, position, deconvolution_warm_start_);
+  concurrency.pack(buffer, buffer_size, position, deconvolution_stagnation_tolerance_);
   concurrency.pack(buffer, buffer_size, position, hts_approximation_);
   concurrency.pack(buffer, buffer_size, position, hts_threads_);
 }
@@ -186,6 +227,9 @@ void DcaParameters::unpack(const Concurrency& concurrency, char* buffer, int buf
   concurrency.unpack(buffer, buffer_size, position, dca_accuracy_);
   concurrency.unpack(buffer, buffer_size, position, self_energy_mixing_factor_);
   concurrency.unpack(buffer, buffer_size, position, interacting_orbitals_);
+  concurrency.unpack(buffer, buffer_size, position, anderson_history_size_);
+  concurrency.unpack(buffer, buffer_size, position, anderson_regularization_);
+  concurrency.unpack(buffer, buffer_size, position, anderson_noise_threshold_);
   concurrency.unpack(buffer, buffer_size, position, do_finite_size_qmc_);
   concurrency.unpack(buffer, buffer_size, position, k_mesh_recursion_);
   concurrency.unpack(buffer, buffer_size, position, coarsegraining_periods_);
@@ -195,6 +239,8 @@ void DcaParameters::unpack(const Concurrency& concurrency, char* buffer, int buf
   concurrency.unpack(buffer, buffer_size, position, do_dca_plus_);
   concurrency.unpack(buffer, buffer_size, position, deconvolution_iterations_);
   concurrency.unpack(buffer, buffer_size, position, deconvolution_tolerance_);
+  concurrency.unpack(buffer, buffer_size, position, deconvolution_warm_start_);
+  concurrency.unpack(buffer, buffer_size, position, deconvolution_stagnation_tolerance_);
   concurrency.unpack(buffer, buffer_size, position, hts_approximation_);
   concurrency.unpack(buffer, buffer_size, position, hts_threads_);
 }
@@ -220,6 +266,18 @@ void DcaParameters::readWrite(ReaderOrWriter& reader_or_writer) {
 
     try_to_read("do-finite-size-QMC", do_finite_size_qmc_);
 
+    try {
+      reader_or_writer.open_group("Anderson-acceleration");
+
+      try_to_read("history-size", anderson_history_size_);
+      try_to_read("regularization", anderson_regularization_);
+      try_to_read("noise-threshold", anderson_noise_threshold_);
+
+      reader_or_writer.close_group();
+    }
+    catch (const std::exception& r_e) {
+    }
+
     try {
       reader_or_writer.open_group("coarse-graining");
 
@@ -240,6 +298,8 @@ void DcaParameters::readWrite(ReaderOrWriter& reader_or_writer) {
       try_to_read("do-DCA+", do_dca_plus_);
       try_to_read("deconvolution-iterations", deconvolution_iterations_);
       try_to_read("deconvolution-tolerance", deconvolution_tolerance_);
+      try_to_read("deconvolution-warm-start", deconvolution_warm_start_);
+      try_to_read("deconvolution-stagnation-tolerance", deconvolution_stagnation_tolerance_);
       try_to_read("HTS-approximation", hts_approximation_);
       try_to_read("HTS-threads", hts_threads_);
 
@@ -257,6 +317,10 @@ void DcaParameters::readWrite(ReaderOrWriter& reader_or_writer) {
   if (reader_or_writer.is_reader()) {
     if (do_finite_size_qmc_ && do_dca_plus_)
       throw std::logic_error("Finite-size QMC and DCA+ are mutually exclusive options.");
+    if (anderson_history_size_ < 0 || anderson_regularization_ < 0)
+      throw std::logic_error("Invalid Anderson acceleration parameters.");
+    if (deconvolution_stagnation_tolerance_ < 0)
+      throw std::logic_error("The deconvolution stagnation tolerance must be non-negative.");
   }
 }
 
@@ -13,8 +13,9 @@
 #ifndef DCA_PHYS_PARAMETERS_DOMAINS_PARAMETERS_HPP
 #define DCA_PHYS_PARAMETERS_DOMAINS_PARAMETERS_HPP
 
-#include <vector>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace dca {
 namespace phys {
@@ -29,13 +30,15 @@ public:
         tp_host_(dimension, std::vector<int>(dimension, 0)),
         sp_time_intervals_(128),
         time_intervals_for_time_measurements_(1),
+        legendre_coefficients_(0),
         sp_fermionic_frequencies_(256),
         hts_bosonic_frequencies_(0),
         four_point_fermionic_frequencies_(1),
         min_real_frequency_(-10.),
         max_real_frequency_(10.),
         real_frequencies_(3),
-        imaginary_damping_(0.01) {
+        imaginary_damping_(0.01),
+        symmetry_tables_file_("") {
     // Set all grids to their default value, the lattice basis.
     for (int i = 0; i < dimension; ++i) {
       cluster_[i][i] = 1;
@@ -69,6 +72,9 @@ public:
   int get_time_intervals_for_time_measurements() const {
     return time_intervals_for_time_measurements_;
   }
+  int get_legendre_coefficients() const {
+    return legendre_coefficients_;
+  }
   int get_sp_fermionic_frequencies() const {
     return sp_fermionic_frequencies_;
   }
@@ -91,6 +97,12 @@ public:
     return imaginary_damping_;
   }
 
+  // File from which the symmetry matrices of the clusters are read, and to which they are written
+  // if they were computed. Empty if the symmetry matrices are always computed.
+  const std::string& get_symmetry_tables_file() const {
+    return symmetry_tables_file_;
+  }
+
 private:
   std::vector<std::vector<int>> cluster_;
   std::vector<std::vector<int>> sp_host_;
@@ -98,6 +110,7 @@ private:
 
   int sp_time_intervals_;
   int time_intervals_for_time_measurements_;
+  int legendre_coefficients_;
 
   int sp_fermionic_frequencies_;
   int hts_bosonic_frequencies_;
@@ -107,6 +120,8 @@ private:
   double max_real_frequency_;
   int real_frequencies_;
   double imaginary_damping_;
+
+  std::string symmetry_tables_file_;
 };
 
 template <typename Concurrency>
@@ -118,6 +133,7 @@ int DomainsParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(tp_host_);
   buffer_size += concurrency.get_buffer_size(sp_time_intervals_);
   buffer_size += concurrency.get_buffer_size(time_intervals_for_time_measurements_);
+  buffer_size += concurrency.get_buffer_size(legendre_coefficients_);
   buffer_size += concurrency.get_buffer_size(sp_fermionic_frequencies_);
   buffer_size += concurrency.get_buffer_size(hts_bosonic_frequencies_);
   buffer_size += concurrency.get_buffer_size(four_point_fermionic_frequencies_);
@@ -125,6 +141,7 @@ int DomainsParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(max_real_frequency_);
   buffer_size += concurrency.get_buffer_size(real_frequencies_);
   buffer_size += concurrency.get_buffer_size(imaginary_damping_);
+  buffer_size += concurrency.get_buffer_size(symmetry_tables_file_);
 
   return buffer_size;
 }
@@ -137,6 +154,7 @@ void DomainsParameters::pack(const Concurrency& concurrency, char* buffer, int b
   concurrency.pack(buffer, buffer_size, position, tp_host_);
   concurrency.pack(buffer, buffer_size, position, sp_time_intervals_);
   concurrency.pack(buffer, buffer_size, position, time_intervals_for_time_measurements_);
+  concurrency.pack(buffer, buffer_size, position, legendre_coefficients_);
   concurrency.pack(buffer, buffer_size, position, sp_fermionic_frequencies_);
   concurrency.pack(buffer, buffer_size, position, hts_bosonic_frequencies_);
   concurrency.pack(buffer, buffer_size, position, four_point_fermionic_frequencies_);
@@ -144,6 +162,7 @@ void DomainsParameters::pack(const Concurrency& concurrency, char* buffer, int b
   concurrency.pack(buffer, buffer_size, position, max_real_frequency_);
   concurrency.pack(buffer, buffer_size, position, real_frequencies_);
   concurrency.pack(buffer, buffer_size, position, imaginary_damping_);
+  concurrency.pack(buffer, buffer_size, position, symmetry_tables_file_);
 }
 
 template <typename Concurrency>
@@ -154,6 +173,7 @@ void DomainsParameters::unpack(const Concurrency& concurrency, char* buffer, int
   concurrency.unpack(buffer, buffer_size, position, tp_host_);
   concurrency.unpack(buffer, buffer_size, position, sp_time_intervals_);
   concurrency.unpack(buffer, buffer_size, position, time_intervals_for_time_measurements_);
+  concurrency.unpack(buffer, buffer_size, position, legendre_coefficients_);
   concurrency.unpack(buffer, buffer_size, position, sp_fermionic_frequencies_);
   concurrency.unpack(buffer, buffer_size, position, hts_bosonic_frequencies_);
   concurrency.unpack(buffer, buffer_size, position, four_point_fermionic_frequencies_);
@@ -161,6 +181,7 @@ void DomainsParameters::unpack(const Concurrency& concurrency, char* buffer, int
   concurrency.unpack(buffer, buffer_size, position, max_real_frequency_);
   concurrency.unpack(buffer, buffer_size, position, real_frequencies_);
   concurrency.unpack(buffer, buffer_size, position, imaginary_damping_);
+  concurrency.unpack(buffer, buffer_size, position, symmetry_tables_file_);
 }
 template <typename ReaderOrWriter>
 void DomainsParameters::readWrite(ReaderOrWriter& reader_or_writer) {
@@ -205,6 +226,11 @@ void DomainsParameters::readWrite(ReaderOrWriter& reader_or_writer) {
       }
       catch (const std::exception& r_e) {
       }
+      try {
+        reader_or_writer.execute("legendre-coefficients", legendre_coefficients_);
+      }
+      catch (const std::exception& r_e) {
+      }
 
       reader_or_writer.close_group();
     }
@@ -265,6 +291,12 @@ void DomainsParameters::readWrite(ReaderOrWriter& reader_or_writer) {
     catch (const std::exception& r_e) {
     }
 
+    try {
+      reader_or_writer.execute("symmetry-tables-file", symmetry_tables_file_);
+    }
+    catch (const std::exception& r_e) {
+    }
+
     reader_or_writer.close_group();
   }
   catch (const std::exception& r_e) {
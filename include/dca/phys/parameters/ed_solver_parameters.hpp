@@ -21,7 +21,7 @@ namespace params {
 
 class EdSolverParameters {
 public:
-  EdSolverParameters() : eigenvalue_cut_off_(1.e-6) {}
+  EdSolverParameters() : eigenvalue_cut_off_(1.e-6), ed_threads_(1) {}
 
   template <typename Concurrency>
   int getBufferSize(const Concurrency& concurrency) const;
@@ -36,15 +36,20 @@ public:
   double get_eigenvalue_cut_off() const {
     return eigenvalue_cut_off_;
   }
+  int get_ed_threads() const {
+    return ed_threads_;
+  }
 
 private:
   double eigenvalue_cut_off_;
+  int ed_threads_;
 };
 
 template <typename Concurrency>
 int EdSolverParameters::getBufferSize(const Concurrency& concurrency) const {
   int buffer_size = 0;
   buffer_size += concurrency.get_buffer_size(eigenvalue_cut_off_);
+  buffer_size += concurrency.get_buffer_size(ed_threads_);
   return buffer_size;
 }
 
@@ -52,12 +57,14 @@ template <typename Concurrency>
 void EdSolverParameters::pack(const Concurrency& concurrency, char* buffer, int buffer_size,
                               int& position) const {
   concurrency.pack(buffer, buffer_size, position, eigenvalue_cut_off_);
+  concurrency.pack(buffer, buffer_size, position, ed_threads_);
 }
 
 template <typename Concurrency>
 void EdSolverParameters::unpack(const Concurrency& concurrency, char* buffer, int buffer_size,
                                 int& position) {
   concurrency.unpack(buffer, buffer_size, position, eigenvalue_cut_off_);
+  concurrency.unpack(buffer, buffer_size, position, ed_threads_);
 }
 
 template <typename ReaderOrWriter>
@@ -70,6 +77,11 @@ void EdSolverParameters::readWrite(ReaderOrWriter& reader_or_writer) {
     }
     catch (const std::exception& r_e) {
     }
+    try {
+      reader_or_writer.execute("threads", ed_threads_);
+    }
+    catch (const std::exception& r_e) {
+    }
 
     reader_or_writer.close_group();
   }
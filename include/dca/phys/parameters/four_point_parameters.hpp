@@ -40,7 +40,10 @@ public:
       : four_point_type_(NONE),
         four_point_momentum_transfer_input_(lattice_dimension, 0.),
         four_point_frequency_transfer_(0),
-        compute_all_transfers_(false) {}
+        compute_all_transfers_(false),
+        four_point_batch_size_(1),
+        four_point_measurement_interval_(1),
+        irreducible_storage_(false) {}
 
   template <typename Concurrency>
   int getBufferSize(const Concurrency& concurrency) const;
@@ -96,6 +99,32 @@ public:
     return compute_all_transfers_;
   }
 
+  // Returns the number of measurements whose contributions are buffered and added to G4 at once.
+  int get_four_point_batch_size() const {
+    return four_point_batch_size_;
+  }
+  void set_four_point_batch_size(const int batch_size) {
+    four_point_batch_size_ = batch_size;
+  }
+
+  // Returns the number of single-particle measurements per four-point measurement. G4 is
+  // normalized by the sign of the four-point measurements only.
+  int get_four_point_measurement_interval() const {
+    return four_point_measurement_interval_;
+  }
+  void set_four_point_measurement_interval(const int interval) {
+    four_point_measurement_interval_ = interval;
+  }
+
+  // Returns true if only the entries of G4 that are irreducible under the cluster symmetries are
+  // accumulated. The G4 computed this way is symmetrized.
+  bool irreducible_storage() const {
+    return irreducible_storage_;
+  }
+  void set_irreducible_storage(const bool irreducible_storage) {
+    irreducible_storage_ = irreducible_storage;
+  }
+
 private:
   // There is no utility to communicate enumerations over mpi, so four_point_type_ is stored
   // as an int rather than a FourPointType.
@@ -103,6 +132,9 @@ private:
   std::vector<double> four_point_momentum_transfer_input_;
   int four_point_frequency_transfer_;
   bool compute_all_transfers_;
+  int four_point_batch_size_;
+  int four_point_measurement_interval_;
+  bool irreducible_storage_;
 };
 
 template <int lattice_dimension>
@@ -114,6 +146,9 @@ int FourPointParameters<lattice_dimension>::getBufferSize(const Concurrency& con
   buffer_size += concurrency.get_buffer_size(four_point_momentum_transfer_input_);
   buffer_size += concurrency.get_buffer_size(four_point_frequency_transfer_);
   buffer_size += concurrency.get_buffer_size(compute_all_transfers_);
+  buffer_size += concurrency.get_buffer_size(four_point_batch_size_);
+  buffer_size += concurrency.get_buffer_size(four_point_measurement_interval_);
+  buffer_size += concurrency.get_buffer_size(irreducible_storage_);
 
   return buffer_size;
 }
@@ -126,6 +161,9 @@ void FourPointParameters<lattice_dimension>::pack(const Concurrency& concurrency
   concurrency.pack(buffer, buffer_size, position, four_point_momentum_transfer_input_);
   concurrency.pack(buffer, buffer_size, position, four_point_frequency_transfer_);
   concurrency.pack(buffer, buffer_size, position, compute_all_transfers_);
+  concurrency.pack(buffer, buffer_size, position, four_point_batch_size_);
+  concurrency.pack(buffer, buffer_size, position, four_point_measurement_interval_);
+  concurrency.pack(buffer, buffer_size, position, irreducible_storage_);
 }
 
 template <int lattice_dimension>
@@ -136,6 +174,9 @@ void FourPointParameters<lattice_dimension>::unpack(const Concurrency& concurren
   concurrency.unpack(buffer, buffer_size, position, four_point_momentum_transfer_input_);
   concurrency.unpack(buffer, buffer_size, position, four_point_frequency_transfer_);
   concurrency.unpack(buffer, buffer_size, position, compute_all_transfers_);
+  concurrency.unpack(buffer, buffer_size, position, four_point_batch_size_);
+  concurrency.unpack(buffer, buffer_size, position, four_point_measurement_interval_);
+  concurrency.unpack(buffer, buffer_size, position, irreducible_storage_);
 }
 
 template <int lattice_dimension>
@@ -166,6 +207,21 @@ void FourPointParameters<lattice_dimension>::readWrite(ReaderOrWriter& reader_or
     }
     catch (const std::exception& r_e) {
     }
+    try {
+      reader_or_writer.execute("batch-size", four_point_batch_size_);
+    }
+    catch (const std::exception& r_e) {
+    }
+    try {
+      reader_or_writer.execute("measurement-interval", four_point_measurement_interval_);
+    }
+    catch (const std::exception& r_e) {
+    }
+    try {
+      reader_or_writer.execute("irreducible-storage", irreducible_storage_);
+    }
+    catch (const std::exception& r_e) {
+    }
 
     reader_or_writer.close_group();
   }
@@ -175,6 +231,10 @@ void FourPointParameters<lattice_dimension>::readWrite(ReaderOrWriter& reader_or
   if (compute_all_transfers_ && four_point_frequency_transfer_ < 0)
     throw(std::logic_error(
         "When compute-all-transfers is set, a greater than 0 frequency-transfer must be chosen."));
+  if (four_point_batch_size_ < 1)
+    throw(std::logic_error("The four-point batch-size must be positive."));
+  if (four_point_measurement_interval_ < 1)
+    throw(std::logic_error("The four-point measurement-interval must be positive."));
 }
 
 }  // params
@@ -18,6 +18,7 @@
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "dca/phys/error_computation_type.hpp"
 
@@ -32,12 +33,19 @@ public:
       : seed_(default_seed),
         warm_up_sweeps_(20),
         sweeps_per_measurement_(1.),
+        adaptive_sweeps_per_measurement_(false),
+        max_sweeps_per_measurement_(32.),
         measurements_(100),
+        dynamic_measurement_distribution_(false),
+        measurement_batch_size_(16),
+        hierarchical_sum_(false),
         walkers_(1),
         accumulators_(1),
         shared_walk_and_accumulation_thread_(false),
         // TODO: consider setting default do true.
         fix_meas_per_walker_(false),
+        replica_exchange_expansion_parameters_(),
+        replica_exchange_period_(1),
         adjust_self_energy_for_double_counting_(false),
         error_computation_type_(ErrorComputationType::NONE) {}
 
@@ -60,6 +68,15 @@ public:
   double get_sweeps_per_measurement() const {
     return sweeps_per_measurement_;
   }
+  // If true, the walkers estimate the integrated autocorrelation time of cheap observables during
+  // the warm-up and the first measurements, and replace get_sweeps_per_measurement() with it, up to
+  // get_max_sweeps_per_measurement().
+  bool adaptive_sweeps_per_measurement() const {
+    return adaptive_sweeps_per_measurement_;
+  }
+  double get_max_sweeps_per_measurement() const {
+    return max_sweeps_per_measurement_;
+  }
   int get_measurements() const {
     return measurements_;
   }
@@ -67,6 +84,20 @@ public:
     assert(measurements >= 0);
     measurements_ = measurements;
   }
+  // If true, the measurements are not split statically among the MPI ranks. Instead each rank
+  // claims batches of measurement_batch_size measurements from a counter shared by all ranks,
+  // until get_measurements() measurements have been performed in total.
+  bool dynamic_measurement_distribution() const {
+    return dynamic_measurement_distribution_;
+  }
+  int get_measurement_batch_size() const {
+    return measurement_batch_size_;
+  }
+  // If true, large MPI sums are first reduced within each shared memory node and only the node
+  // leaders communicate across nodes.
+  bool hierarchical_sum() const {
+    return hierarchical_sum_;
+  }
   int get_walkers() const {
     return walkers_;
   }
@@ -82,6 +113,15 @@ public:
   bool fix_meas_per_walker() const {
     return fix_meas_per_walker_;
   }
+  // If not empty, the walkers of each rank run at these values of the expansion parameter, one per
+  // walker, and every get_replica_exchange_period() measurements the walkers at neighbouring values
+  // propose to exchange them.
+  const std::vector<double>& get_replica_exchange_expansion_parameters() const {
+    return replica_exchange_expansion_parameters_;
+  }
+  int get_replica_exchange_period() const {
+    return replica_exchange_period_;
+  }
   bool adjust_self_energy_for_double_counting() const {
     return adjust_self_energy_for_double_counting_;
   }
@@ -101,11 +141,18 @@ private:
   int seed_;
   int warm_up_sweeps_;
   double sweeps_per_measurement_;
+  bool adaptive_sweeps_per_measurement_;
+  double max_sweeps_per_measurement_;
   int measurements_;
+  bool dynamic_measurement_distribution_;
+  int measurement_batch_size_;
+  bool hierarchical_sum_;
   int walkers_;
   int accumulators_;
   bool shared_walk_and_accumulation_thread_;
   bool fix_meas_per_walker_;
+  std::vector<double> replica_exchange_expansion_parameters_;
+  int replica_exchange_period_;
   bool adjust_self_energy_for_double_counting_;
   ErrorComputationType error_computation_type_;
 };
@@ -117,11 +164,18 @@ int MciParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(seed_);
   buffer_size += concurrency.get_buffer_size(warm_up_sweeps_);
   buffer_size += concurrency.get_buffer_size(sweeps_per_measurement_);
+  buffer_size += concurrency.get_buffer_size(adaptive_sweeps_per_measurement_);
+  buffer_size += concurrency.get_buffer_size(max_sweeps_per_measurement_);
   buffer_size += concurrency.get_buffer_size(measurements_);
+  buffer_size += concurrency.get_buffer_size(dynamic_measurement_distribution_);
+  buffer_size += concurrency.get_buffer_size(measurement_batch_size_);
+  buffer_size += concurrency.get_buffer_size(hierarchical_sum_);
   buffer_size += concurrency.get_buffer_size(walkers_);
   buffer_size += concurrency.get_buffer_size(accumulators_);
   buffer_size += concurrency.get_buffer_size(shared_walk_and_accumulation_thread_);
   buffer_size += concurrency.get_buffer_size(fix_meas_per_walker_);
+  buffer_size += concurrency.get_buffer_size(replica_exchange_expansion_parameters_);
+  buffer_size += concurrency.get_buffer_size(replica_exchange_period_);
   buffer_size += concurrency.get_buffer_size(adjust_self_energy_for_double_counting_);
   buffer_size += concurrency.get_buffer_size(error_computation_type_);
 
@@ -134,11 +188,18 @@ void MciParameters::pack(const Concurrency& concurrency, char* buffer, int buffe
   concurrency.pack(buffer, buffer_size, position, seed_);
   concurrency.pack(buffer, buffer_size, position, warm_up_sweeps_);
   concurrency.pack(buffer, buffer_size, position, sweeps_per_measurement_);
+  concurrency.pack(buffer, buffer_size, position, adaptive_sweeps_per_measurement_);
+  concurrency.pack(buffer, buffer_size, position, max_sweeps_per_measurement_);
   concurrency.pack(buffer, buffer_size, position, measurements_);
+  concurrency.pack(buffer, buffer_size, position, dynamic_measurement_distribution_);
+  concurrency.pack(buffer, buffer_size, position, measurement_batch_size_);
+  concurrency.pack(buffer, buffer_size, position, hierarchical_sum_);
   concurrency.pack(buffer, buffer_size, position, walkers_);
   concurrency.pack(buffer, buffer_size, position, accumulators_);
   concurrency.pack(buffer, buffer_size, position, shared_walk_and_accumulation_thread_);
   concurrency.pack(buffer, buffer_size, position, fix_meas_per_walker_);
+  concurrency.pack(buffer, buffer_size, position, replica_exchange_expansion_parameters_);
+  concurrency.pack(buffer, buffer_size, position, replica_exchange_period_);
   concurrency.pack(buffer, buffer_size, position, adjust_self_energy_for_double_counting_);
   concurrency.pack(buffer, buffer_size, position, error_computation_type_);
 }
@@ -149,11 +210,18 @@ void MciParameters::unpack(const Concurrency& concurrency, char* buffer, int buf
   concurrency.unpack(buffer, buffer_size, position, seed_);
   concurrency.unpack(buffer, buffer_size, position, warm_up_sweeps_);
   concurrency.unpack(buffer, buffer_size, position, sweeps_per_measurement_);
+  concurrency.unpack(buffer, buffer_size, position, adaptive_sweeps_per_measurement_);
+  concurrency.unpack(buffer, buffer_size, position, max_sweeps_per_measurement_);
   concurrency.unpack(buffer, buffer_size, position, measurements_);
+  concurrency.unpack(buffer, buffer_size, position, dynamic_measurement_distribution_);
+  concurrency.unpack(buffer, buffer_size, position, measurement_batch_size_);
+  concurrency.unpack(buffer, buffer_size, position, hierarchical_sum_);
   concurrency.unpack(buffer, buffer_size, position, walkers_);
   concurrency.unpack(buffer, buffer_size, position, accumulators_);
   concurrency.unpack(buffer, buffer_size, position, shared_walk_and_accumulation_thread_);
   concurrency.unpack(buffer, buffer_size, position, fix_meas_per_walker_);
+  concurrency.unpack(buffer, buffer_size, position, replica_exchange_expansion_parameters_);
+  concurrency.unpack(buffer, buffer_size, position, replica_exchange_period_);
   concurrency.unpack(buffer, buffer_size, position, adjust_self_energy_for_double_counting_);
   concurrency.unpack(buffer, buffer_size, position, error_computation_type_);
 }
@@ -207,12 +275,38 @@ void MciParameters::readWrite(ReaderOrWriter& reader_or_writer) {
     }
     catch (const std::exception& r_e) {
     }
+    try {
+      reader_or_writer.execute("adaptive-sweeps-per-measurement", adaptive_sweeps_per_measurement_);
+    }
+    catch (const std::exception& r_e) {
+    }
+    try {
+      reader_or_writer.execute("max-sweeps-per-measurement", max_sweeps_per_measurement_);
+    }
+    catch (const std::exception& r_e) {
+    }
 
     try {
       reader_or_writer.execute("measurements", measurements_);
     }
     catch (const std::exception& r_e) {
     }
+    try {
+      reader_or_writer.execute("dynamic-measurement-distribution",
+                               dynamic_measurement_distribution_);
+    }
+    catch (const std::exception& r_e) {
+    }
+    try {
+      reader_or_writer.execute("measurement-batch-size", measurement_batch_size_);
+    }
+    catch (const std::exception& r_e) {
+    }
+    try {
+      reader_or_writer.execute("hierarchical-sum", hierarchical_sum_);
+    }
+    catch (const std::exception& r_e) {
+    }
 
     // Read error computation type.
     std::string error_type = toString(error_computation_type_);
@@ -247,6 +341,17 @@ void MciParameters::readWrite(ReaderOrWriter& reader_or_writer) {
       }
       catch (const std::exception& r_e) {
       }
+      try {
+        reader_or_writer.execute("replica-exchange-expansion-parameters",
+                                 replica_exchange_expansion_parameters_);
+      }
+      catch (const std::exception& r_e) {
+      }
+      try {
+        reader_or_writer.execute("replica-exchange-period", replica_exchange_period_);
+      }
+      catch (const std::exception& r_e) {
+      }
       reader_or_writer.close_group();
     }
     catch (const std::exception& r_e) {
@@ -33,6 +33,8 @@ public:
         filename_ed_("ed.hdf5"),
         filename_qmc_("qmc.hdf5"),
         filename_profiling_("profiling.json"),
+        filename_qmc_metrics_(""),
+        qmc_metrics_interval_(10.),
         dump_lattice_self_energy_(false),
         dump_cluster_Greens_functions_(false),
         dump_Gamma_lattice_(false),
@@ -63,6 +65,9 @@ public:
   const std::string& get_filename_dca() const {
     return filename_dca_;
   }
+  void set_filename_dca(const std::string& filename) {
+    filename_dca_ = filename;
+  }
   const std::string& get_filename_analysis() const {
     return filename_analysis_;
   }
@@ -75,6 +80,14 @@ public:
   const std::string& get_filename_profiling() const {
     return filename_profiling_;
   }
+  // If not empty, each rank appends a JSON line with the QMC integration metrics to the file
+  // <directory><filename-qmc-metrics>.<rank> every qmc-metrics-interval seconds.
+  const std::string& get_filename_qmc_metrics() const {
+    return filename_qmc_metrics_;
+  }
+  double get_qmc_metrics_interval() const {
+    return qmc_metrics_interval_;
+  }
   bool dump_lattice_self_energy() const {
     return dump_lattice_self_energy_;
   }
@@ -98,6 +111,8 @@ private:
   std::string filename_ed_;
   std::string filename_qmc_;
   std::string filename_profiling_;
+  std::string filename_qmc_metrics_;
+  double qmc_metrics_interval_;
   bool dump_lattice_self_energy_;
   bool dump_cluster_Greens_functions_;
   bool dump_Gamma_lattice_;
@@ -117,6 +132,8 @@ int OutputParameters::getBufferSize(const Concurrency& concurrency) const {
   buffer_size += concurrency.get_buffer_size(filename_ed_);
   buffer_size += concurrency.get_buffer_size(filename_qmc_);
   buffer_size += concurrency.get_buffer_size(filename_profiling_);
+  buffer_size += concurrency.get_buffer_size(filename_qmc_metrics_);
+  buffer_size += concurrency.get_buffer_size(qmc_metrics_interval_);
   buffer_size += concurrency.get_buffer_size(dump_lattice_self_energy_);
   buffer_size += concurrency.get_buffer_size(dump_cluster_Greens_functions_);
   buffer_size += concurrency.get_buffer_size(dump_Gamma_lattice_);
@@ -137,6 +154,8 @@ void OutputParameters::pack(const Concurrency& concurrency, char* buffer, int bu
   concurrency.pack(buffer, buffer_size, position, filename_ed_);
   concurrency.pack(buffer, buffer_size, position, filename_qmc_);
   concurrency.pack(buffer, buffer_size, position, filename_profiling_);
+  concurrency.pack(buffer, buffer_size, position, filename_qmc_metrics_);
+  concurrency.pack(buffer, buffer_size, position, qmc_metrics_interval_);
   concurrency.pack(buffer, buffer_size, position, dump_lattice_self_energy_);
   concurrency.pack(buffer, buffer_size, position, dump_cluster_Greens_functions_);
   concurrency.pack(buffer, buffer_size, position, dump_Gamma_lattice_);
@@ -155,6 +174,8 @@ void OutputParameters::unpack(const Concurrency& concurrency, char* buffer, int
   concurrency.unpack(buffer, buffer_size, position, filename_ed_);
   concurrency.unpack(buffer, buffer_size, position, filename_qmc_);
   concurrency.unpack(buffer, buffer_size, position, filename_profiling_);
+  concurrency.unpack(buffer, buffer_size, position, filename_qmc_metrics_);
+  concurrency.unpack(buffer, buffer_size, position, qmc_metrics_interval_);
   concurrency.unpack(buffer, buffer_size, position, dump_lattice_self_energy_);
   concurrency.unpack(buffer, buffer_size, position, dump_cluster_Greens_functions_);
   concurrency.unpack(buffer, buffer_size, position, dump_Gamma_lattice_);
@@ -183,6 +204,8 @@ void OutputParameters::readWrite(ReaderOrWriter& reader_or_writer) {
     try_to_read_or_write("filename-ed", filename_ed_);
     try_to_read_or_write("filename-qmc", filename_qmc_);
     try_to_read_or_write("filename-profiling", filename_profiling_);
+    try_to_read_or_write("filename-qmc-metrics", filename_qmc_metrics_);
+    try_to_read_or_write("qmc-metrics-interval", qmc_metrics_interval_);
     try_to_read_or_write("dump-lattice-self-energy", dump_lattice_self_energy_);
     try_to_read_or_write("dump-cluster-Greens-functions", dump_cluster_Greens_functions_);
     try_to_read_or_write("dump-Gamma-lattice", dump_Gamma_lattice_);
@@ -16,12 +16,17 @@
 #ifndef DCA_PHYS_PARAMETERS_PARAMETERS_HPP
 #define DCA_PHYS_PARAMETERS_PARAMETERS_HPP
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "dca/config/accumulation_options.hpp"
 #include "dca/function/domains/dmn_0.hpp"
+#include "dca/io/buffer.hpp"
+#include "dca/math/function_transform/basis_transform/basis_transform.hpp"
 #include "dca/phys/parameters/analysis_parameters.hpp"
 #include "dca/phys/domains/cluster/cluster_domain_aliases.hpp"
 #include "dca/phys/parameters/dca_parameters.hpp"
@@ -44,6 +49,7 @@
 #include "dca/phys/domains/quantum/numerical_error_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/frequency_domain_real_axis.hpp"
+#include "dca/phys/domains/time_and_frequency/legendre_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/frequency_exchange_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/time_domain.hpp"
 #include "dca/phys/domains/time_and_frequency/time_domain_left_oriented.hpp"
@@ -114,6 +120,10 @@ public:
 
   void update_model();
   void update_domains();
+  // Initializes the time and frequency domains again with the current parameters, e.g. for a
+  // different inverse temperature, and drops the cached transformations between them. The number
+  // of time slices and frequencies must be unchanged.
+  void update_time_and_frequency_domains();
 
   int get_buffer_size(const concurrency_type& concurrency) const;
   void pack(const concurrency_type& concurrency, char* buffer, int buffer_size, int& position) const;
@@ -127,8 +137,16 @@ private:
   template <typename ReaderOrWriter>
   void readWrite(ReaderOrWriter& reader_or_writer);
 
+  void initialize_time_and_frequency_domains();
+
   std::string make_python_readable(std::string tmp);
 
+  // Returns the content of the symmetry tables file, or an empty buffer if there is none.
+  io::Buffer read_symmetry_tables() const;
+  // Writes the symmetry matrices of the DCA cluster and of the host grids to the symmetry tables
+  // file.
+  void write_symmetry_tables() const;
+
   std::string version_stamp_;
 
   std::string date_;
@@ -248,31 +266,25 @@ void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
                                             Model::get_a_vectors());
 
   // time and frequency-domains
-  domains::time_domain::initialize(*this);
-  domains::time_domain_left_oriented::initialize(*this);
-  domains::frequency_domain::initialize(*this);
+  initialize_time_and_frequency_domains();
   domains::frequency_domain_real_axis::initialize(*this);
 
-  domains::vertex_time_domain<domains::SP_TIME_DOMAIN>::initialize(*this);
-  domains::vertex_time_domain<domains::TP_TIME_DOMAIN>::initialize(*this);
-  domains::vertex_time_domain<domains::SP_TIME_DOMAIN_POSITIVE>::initialize(*this);
-  domains::vertex_time_domain<domains::TP_TIME_DOMAIN_POSITIVE>::initialize(*this);
-
-  domains::vertex_frequency_domain<domains::COMPACT>::initialize(*this);
-  domains::vertex_frequency_domain<domains::EXTENDED>::initialize(*this);
-
-  domains::vertex_frequency_domain<domains::COMPACT_POSITIVE>::initialize(*this);
-  domains::vertex_frequency_domain<domains::EXTENDED_POSITIVE>::initialize(*this);
-
-  domains::vertex_frequency_domain<domains::EXTENDED_BOSONIC>::initialize(*this);
-
   domains::FrequencyExchangeDomain::initialize(*this);
 
+  // The symmetry matrices of the clusters are read from the symmetry tables of a previous run, if
+  // they were computed for the same clusters.
+  // Otherwise they are computed with the coarse-graining threads.
+  io::Buffer symmetry_tables = read_symmetry_tables();
+  bool symmetry_tables_read = true;
+  const int n_threads = DcaParameters::get_coarsegraining_threads();
+  using DcaPointGroup = typename Model::lattice_type::DCA_point_group;
+
   // DCA cluster
   domains::cluster_domain_initializer<RClusterDmn>::execute(Model::get_r_DCA_basis(),
                                                             DomainsParameters::get_cluster());
-  domains::cluster_domain_symmetry_initializer<
-      RClusterDmn, typename Model::lattice_type::DCA_point_group>::execute();
+  symmetry_tables_read &=
+      domains::cluster_domain_symmetry_initializer<RClusterDmn, DcaPointGroup>::execute(
+          symmetry_tables, Threading(), n_threads);
 
   if (concurrency_.id() == concurrency_.first())
     KClusterDmn::parameter_type::print(std::cout);
@@ -280,8 +292,9 @@ void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
   // Host grid for single-particle functions ((sp-)lattice)
   domains::cluster_domain_initializer<RSpHostDmn>::execute(Model::get_r_DCA_basis(),
                                                            DomainsParameters::get_sp_host());
-  domains::cluster_domain_symmetry_initializer<
-      RSpHostDmn, typename Model::lattice_type::DCA_point_group>::execute();
+  symmetry_tables_read &=
+      domains::cluster_domain_symmetry_initializer<RSpHostDmn, DcaPointGroup>::execute(
+          symmetry_tables, Threading(), n_threads);
 
   domains::MomentumExchangeDomain::initialize(*this);
 
@@ -299,11 +312,97 @@ void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
     domains::cluster_domain_initializer<RTpHostDmn>::execute(Model::get_r_DCA_basis(),
                                                              DomainsParameters::get_cluster());
   }
-  domains::cluster_domain_symmetry_initializer<
-      RTpHostDmn, typename Model::lattice_type::DCA_point_group>::execute();
+  symmetry_tables_read &=
+      domains::cluster_domain_symmetry_initializer<RTpHostDmn, DcaPointGroup>::execute(
+          symmetry_tables, Threading(), n_threads);
 
   if (concurrency_.id() == concurrency_.first())
     KTpHostDmn::parameter_type::print(std::cout);
+
+  if (!symmetry_tables_read)
+    write_symmetry_tables();
+}
+
+template <typename Concurrency, typename Threading, typename Profiler, typename Model,
+          typename RandomNumberGenerator, solver::ClusterSolverName solver_name>
+void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
+                solver_name>::update_time_and_frequency_domains() {
+  domains::time_domain::reset();
+  domains::time_domain_left_oriented::reset();
+  domains::frequency_domain::reset();
+  domains::LegendreDomain::reset();
+
+  initialize_time_and_frequency_domains();
+
+  math::transform::basis_transform<WDmn, TDmn>::is_initialized() = false;
+  math::transform::basis_transform<TDmn, WDmn>::is_initialized() = false;
+}
+
+template <typename Concurrency, typename Threading, typename Profiler, typename Model,
+          typename RandomNumberGenerator, solver::ClusterSolverName solver_name>
+void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
+                solver_name>::initialize_time_and_frequency_domains() {
+  domains::time_domain::initialize(*this);
+  domains::time_domain_left_oriented::initialize(*this);
+  domains::frequency_domain::initialize(*this);
+  if (DomainsParameters::get_legendre_coefficients() > 0)
+    domains::LegendreDomain::initialize(*this);
+
+  domains::vertex_time_domain<domains::SP_TIME_DOMAIN>::initialize(*this);
+  domains::vertex_time_domain<domains::TP_TIME_DOMAIN>::initialize(*this);
+  domains::vertex_time_domain<domains::SP_TIME_DOMAIN_POSITIVE>::initialize(*this);
+  domains::vertex_time_domain<domains::TP_TIME_DOMAIN_POSITIVE>::initialize(*this);
+
+  domains::vertex_frequency_domain<domains::COMPACT>::initialize(*this);
+  domains::vertex_frequency_domain<domains::EXTENDED>::initialize(*this);
+
+  domains::vertex_frequency_domain<domains::COMPACT_POSITIVE>::initialize(*this);
+  domains::vertex_frequency_domain<domains::EXTENDED_POSITIVE>::initialize(*this);
+
+  domains::vertex_frequency_domain<domains::EXTENDED_BOSONIC>::initialize(*this);
+}
+
+template <typename Concurrency, typename Threading, typename Profiler, typename Model,
+          typename RandomNumberGenerator, solver::ClusterSolverName solver_name>
+io::Buffer Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
+                      solver_name>::read_symmetry_tables() const {
+  io::Buffer symmetry_tables;
+  if (get_symmetry_tables_file() == "")
+    return symmetry_tables;
+
+  std::ifstream file(get_symmetry_tables_file(), std::ios::binary);
+  if (file)
+    symmetry_tables.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  return symmetry_tables;
+}
+
+template <typename Concurrency, typename Threading, typename Profiler, typename Model,
+          typename RandomNumberGenerator, solver::ClusterSolverName solver_name>
+void Parameters<Concurrency, Threading, Profiler, Model, RandomNumberGenerator,
+                solver_name>::write_symmetry_tables() const {
+  if (get_symmetry_tables_file() == "" || concurrency_.id() != concurrency_.first())
+    return;
+
+  io::Buffer symmetry_tables;
+  domains::cluster_domain_symmetry_initializer<
+      RClusterDmn, typename Model::lattice_type::DCA_point_group>::write(symmetry_tables);
+  domains::cluster_domain_symmetry_initializer<
+      RSpHostDmn, typename Model::lattice_type::DCA_point_group>::write(symmetry_tables);
+  domains::cluster_domain_symmetry_initializer<
+      RTpHostDmn, typename Model::lattice_type::DCA_point_group>::write(symmetry_tables);
+
+  // Write to a temporary file first, so that the other processes never read a partial file.
+  const std::string tmp_name = get_symmetry_tables_file() + ".tmp";
+  {
+    std::ofstream file(tmp_name, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(symmetry_tables.data()), symmetry_tables.size());
+    if (!file) {
+      std::cerr << "Could not write the symmetry tables to " << tmp_name << ".\n";
+      return;
+    }
+  }
+  std::rename(tmp_name.c_str(), get_symmetry_tables_file().c_str());
 }
 
 template <typename Concurrency, typename Threading, typename Profiler, typename Model,
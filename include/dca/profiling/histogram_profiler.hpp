@@ -0,0 +1,288 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// Histogram profiler.
+// Records the distribution of the wall time of every call to a profiled region in log-binned
+// histograms, in addition to the number of calls and the total time. Each thread fills its own
+// table, so no lock is taken while profiling. The tables of all threads and ranks are merged when
+// the profiler is stopped, and the number of calls, the total, mean, median, 90th and 99th
+// percentile and maximum time, together with the non-empty bins, are written to a JSON file.
+// The percentiles are given by the upper edge of the bin they fall in, i.e. with a relative
+// resolution of 2^(1/4) - 1 ~ 19%.
+// The tables are keyed by the address of the region name, so that recording a call does not
+// allocate. Names must therefore stay valid until the profiler is stopped, e.g. string literals
+// or __FUNCTION__.
+// Regions with equal names at different addresses are merged by name.
+
+#ifndef DCA_PROFILING_HISTOGRAM_PROFILER_HPP
+#define DCA_PROFILING_HISTOGRAM_PROFILER_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dca {
+namespace profiling {
+// dca::profiling::
+
+class HistogramProfiler {
+public:
+  // Bin 0 collects the times below min_time, the last bin the times above the range.
+  constexpr static int bins_per_octave = 4;
+  constexpr static int n_bins = 2 + 40 * bins_per_octave;
+  constexpr static double min_time = 1.e-7;  // [s]
+
+  // Merged statistics of one profiled region. Times are in seconds.
+  struct Statistics {
+    std::string category;
+    double calls = 0;
+    double total = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    std::vector<double> counts;
+  };
+
+  HistogramProfiler(const char* function_name, const char* category_name, int /*line*/)
+      : name_(function_name), category_(category_name), start_(Clock::now()) {}
+  HistogramProfiler(const char* function_name, const char* category_name, int /*line*/,
+                    int /*thread_id*/)
+      : name_(function_name), category_(category_name), start_(Clock::now()) {}
+
+  ~HistogramProfiler() {
+    record(name_, category_, std::chrono::duration<double>(Clock::now() - start_).count());
+  }
+
+  // Adds a call of 'time' seconds to the histogram of 'name' of the calling thread.
+  static void record(const char* name, const char* category, double time);
+
+  // Clears the tables of all threads.
+  static void start();
+  // Merges the tables of all threads and writes the statistics to 'file_name'.
+  static void stop(const std::string& file_name);
+  // Merges the tables of all threads and ranks and writes the statistics to 'file_name' on the
+  // first rank.
+  // Precondition: all ranks profiled the same regions.
+  template <typename Concurrency>
+  static void stop(const Concurrency& concurrency, const std::string& file_name);
+
+  static void start_threading(int /*id*/) {}
+  static void stop_threading(int /*id*/) {}
+
+  // Returns the statistics merged by the last call to stop.
+  static const std::map<std::string, Statistics>& get_statistics() {
+    return statistics();
+  }
+
+  // Returns the index of the bin of 'time', and the upper edge of the bin 'bin'.
+  static int bin(double time);
+  static double binUpperEdge(int bin);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Histogram {
+    const char* category = nullptr;
+    double calls = 0;
+    double total = 0;
+    double max = 0;
+    std::array<double, n_bins> counts{};
+  };
+  using Table = std::unordered_map<const char*, Histogram>;
+
+  // Returns the table of the calling thread, which is registered on the first call.
+  static Table& threadTable();
+
+  static std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  // The tables are shared with the registry to survive the termination of their thread.
+  static std::vector<std::shared_ptr<Table>>& registry() {
+    static std::vector<std::shared_ptr<Table>> tables;
+    return tables;
+  }
+  static std::map<std::string, Statistics>& statistics() {
+    static std::map<std::string, Statistics> stats;
+    return stats;
+  }
+
+  // Merges the tables of all threads into one vector per region, containing the number of calls,
+  // the total time, the counts of the bins and the maximum time in slot 'rank_id' of 'n_ranks'.
+  static std::map<std::string, std::vector<double>> mergeThreads(
+      int rank_id, int n_ranks, std::map<std::string, std::string>& categories);
+  static void computeStatistics(const std::map<std::string, std::vector<double>>& merged,
+                                const std::map<std::string, std::string>& categories);
+  static void toJSON(const std::string& file_name);
+
+  const char* const name_;
+  const char* const category_;
+  const Clock::time_point start_;
+};
+
+inline int HistogramProfiler::bin(const double time) {
+  if (!(time >= min_time))
+    return 0;
+  const int b = 1 + static_cast<int>(std::floor(bins_per_octave * std::log2(time / min_time)));
+  return std::min(b, n_bins - 1);
+}
+
+inline double HistogramProfiler::binUpperEdge(const int bin) {
+  return min_time * std::exp2(static_cast<double>(bin) / bins_per_octave);
+}
+
+inline HistogramProfiler::Table& HistogramProfiler::threadTable() {
+  thread_local std::shared_ptr<Table> table;
+  if (!table) {
+    table = std::make_shared<Table>();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(table);
+  }
+  return *table;
+}
+
+inline void HistogramProfiler::record(const char* name, const char* category, const double time) {
+  Histogram& histogram = threadTable()[name];
+  histogram.category = category;
+  ++histogram.calls;
+  histogram.total += time;
+  histogram.max = std::max(histogram.max, time);
+  ++histogram.counts[bin(time)];
+}
+
+inline void HistogramProfiler::start() {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for (auto& table : registry())
+    table->clear();
+  statistics().clear();
+}
+
+inline std::map<std::string, std::vector<double>> HistogramProfiler::mergeThreads(
+    const int rank_id, const int n_ranks, std::map<std::string, std::string>& categories) {
+  std::map<std::string, std::vector<double>> merged;
+
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for (const auto& table : registry()) {
+    for (const auto& entry : *table) {
+      const Histogram& histogram = entry.second;
+      const std::string name(entry.first);
+      std::vector<double>& values = merged[name];
+      if (values.empty())
+        values.resize(2 + n_bins + n_ranks, 0.);
+
+      values[0] += histogram.calls;
+      values[1] += histogram.total;
+      for (int b = 0; b < n_bins; ++b)
+        values[2 + b] += histogram.counts[b];
+      double& max = values[2 + n_bins + rank_id];
+      max = std::max(max, histogram.max);
+
+      categories[name] = histogram.category;
+    }
+  }
+
+  return merged;
+}
+
+inline void HistogramProfiler::computeStatistics(
+    const std::map<std::string, std::vector<double>>& merged,
+    const std::map<std::string, std::string>& categories) {
+  statistics().clear();
+
+  for (const auto& entry : merged) {
+    const std::vector<double>& values = entry.second;
+    Statistics& stats = statistics()[entry.first];
+
+    stats.category = categories.at(entry.first);
+    stats.calls = values[0];
+    stats.total = values[1];
+    stats.counts.assign(values.begin() + 2, values.begin() + 2 + n_bins);
+    stats.max = *std::max_element(values.begin() + 2 + n_bins, values.end());
+
+    // The percentile p is the upper edge of the first bin whose cumulative count reaches p * calls.
+    auto percentile = [&](const double p) {
+      double cumulative = 0;
+      for (int b = 0; b < n_bins; ++b) {
+        cumulative += stats.counts[b];
+        if (cumulative >= p * stats.calls)
+          return std::min(binUpperEdge(b), stats.max);
+      }
+      return stats.max;
+    };
+    stats.p50 = percentile(0.5);
+    stats.p90 = percentile(0.9);
+    stats.p99 = percentile(0.99);
+  }
+}
+
+inline void HistogramProfiler::stop(const std::string& file_name) {
+  std::map<std::string, std::string> categories;
+  computeStatistics(mergeThreads(0, 1, categories), categories);
+  toJSON(file_name);
+}
+
+template <typename Concurrency>
+void HistogramProfiler::stop(const Concurrency& concurrency, const std::string& file_name) {
+  std::map<std::string, std::string> categories;
+  auto merged = mergeThreads(concurrency.id(), concurrency.number_of_processors(), categories);
+
+  concurrency.sum(merged);
+
+  computeStatistics(merged, categories);
+  if (concurrency.id() == concurrency.first())
+    toJSON(file_name);
+}
+
+inline void HistogramProfiler::toJSON(const std::string& file_name) {
+  std::ofstream file(file_name);
+  file.precision(6);
+
+  file << "{";
+  int index = 0;
+  for (const auto& entry : statistics()) {
+    const Statistics& stats = entry.second;
+
+    file << (index ? ",\n" : "\n") << "\"" << index << "\" : {\n"
+         << "\"name\"      : \"" << entry.first << "\",\n"
+         << "\"category\"  : \"" << stats.category << "\",\n"
+         << "\"calls\"     : " << stats.calls << ",\n"
+         << "\"total [s]\" : " << stats.total << ",\n"
+         << "\"mean [s]\"  : " << (stats.calls ? stats.total / stats.calls : 0.) << ",\n"
+         << "\"p50 [s]\"   : " << stats.p50 << ",\n"
+         << "\"p90 [s]\"   : " << stats.p90 << ",\n"
+         << "\"p99 [s]\"   : " << stats.p99 << ",\n"
+         << "\"max [s]\"   : " << stats.max << ",\n";
+
+    // Pairs of upper bin edge and count of the non-empty bins.
+    file << "\"histogram\" : [";
+    bool first = true;
+    for (int b = 0; b < n_bins; ++b) {
+      if (!stats.counts[b])
+        continue;
+      file << (first ? "" : ", ") << "[" << binUpperEdge(b) << ", " << stats.counts[b] << "]";
+      first = false;
+    }
+    file << "]\n}";
+
+    ++index;
+  }
+  file << "\n}\n";
+}
+
+}  // profiling
+}  // dca
+
+#endif  // DCA_PROFILING_HISTOGRAM_PROFILER_HPP
@@ -0,0 +1,54 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file implements mpi_global_counter.hpp.
+
+#include "dca/parallel/mpi_concurrency/mpi_global_counter.hpp"
+
+namespace dca {
+namespace parallel {
+// dca::parallel::
+
+MPIGlobalCounter::MPIGlobalCounter() {
+  const MPI_Aint window_size = get_id() == root_ ? sizeof(long long) : 0;
+
+  MPI_Win_allocate(window_size, sizeof(long long), MPI_INFO_NULL, MPIProcessorGrouping::get(),
+                   &counter_, &window_);
+
+  resetGlobalCounter();
+}
+
+MPIGlobalCounter::~MPIGlobalCounter() {
+  if (window_ != MPI_WIN_NULL)
+    MPI_Win_free(&window_);
+}
+
+void MPIGlobalCounter::resetGlobalCounter() const {
+  // Make sure that all the pending increments have completed before resetting.
+  MPI_Barrier(MPIProcessorGrouping::get());
+
+  if (get_id() == root_) {
+    MPI_Win_lock(MPI_LOCK_EXCLUSIVE, root_, 0, window_);
+    *counter_ = 0;
+    MPI_Win_unlock(root_, window_);
+  }
+
+  MPI_Barrier(MPIProcessorGrouping::get());
+}
+
+long long MPIGlobalCounter::globalCounterFetchAdd(const long long increment) const {
+  long long previous = 0;
+
+  MPI_Win_lock(MPI_LOCK_SHARED, root_, 0, window_);
+  MPI_Fetch_and_op(&increment, &previous, MPI_LONG_LONG, root_, 0, MPI_SUM, window_);
+  MPI_Win_unlock(root_, window_);
+
+  return previous;
+}
+
+}  // parallel
+}  // dca
@@ -0,0 +1,72 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file implements mpi_node_grouping.hpp.
+
+#include "dca/parallel/mpi_concurrency/mpi_node_grouping.hpp"
+
+namespace dca {
+namespace parallel {
+// dca::parallel::
+
+MPINodeGrouping::~MPINodeGrouping() {
+  finalizeNodeGrouping();
+}
+
+void MPINodeGrouping::initializeNodeGrouping(const std::size_t buffer_size, const int max_node_size) {
+  finalizeNodeGrouping();
+
+  MPI_Comm_split_type(MPIProcessorGrouping::get(), MPI_COMM_TYPE_SHARED, get_id(), MPI_INFO_NULL,
+                      &node_comm_);
+  MPI_Comm_rank(node_comm_, &node_id_);
+
+  if (max_node_size > 0) {
+    MPI_Comm shared_comm = node_comm_;
+    MPI_Comm_split(shared_comm, node_id_ / max_node_size, node_id_, &node_comm_);
+    MPI_Comm_free(&shared_comm);
+    MPI_Comm_rank(node_comm_, &node_id_);
+  }
+
+  MPI_Comm_size(node_comm_, &node_size_);
+  MPI_Allreduce(&node_size_, &max_node_size_, 1, MPI_INT, MPI_MAX, MPIProcessorGrouping::get());
+
+  MPI_Comm_split(MPIProcessorGrouping::get(), node_id_ == 0 ? 0 : MPI_UNDEFINED, get_id(),
+                 &leaders_comm_);
+  if (node_id_ == 0)
+    MPI_Comm_size(leaders_comm_, &number_of_nodes_);
+  MPI_Bcast(&number_of_nodes_, 1, MPI_INT, 0, node_comm_);
+
+  // The whole buffer is allocated by the leader and accessed directly by the other processes.
+  buffer_size_ = buffer_size;
+  MPI_Win_allocate_shared(node_id_ == 0 ? buffer_size_ : 0, 1, MPI_INFO_NULL, node_comm_,
+                          &shared_buffer_, &window_);
+  MPI_Aint size;
+  int disp_unit;
+  MPI_Win_shared_query(window_, 0, &size, &disp_unit, &shared_buffer_);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+}
+
+void MPINodeGrouping::finalizeNodeGrouping() {
+  if (window_ != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(window_);
+    MPI_Win_free(&window_);
+    shared_buffer_ = nullptr;
+  }
+  if (leaders_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&leaders_comm_);
+  if (node_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&node_comm_);
+}
+
+void MPINodeGrouping::nodeBarrier() const {
+  MPI_Win_sync(window_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(window_);
+}
+
+}  // parallel
+}  // dca
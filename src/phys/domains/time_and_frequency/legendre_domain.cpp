@@ -0,0 +1,68 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file implements legendre_domain.hpp.
+
+#include "dca/phys/domains/time_and_frequency/legendre_domain.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace dca {
+namespace phys {
+namespace domains {
+// dca::phys::domains::
+
+bool LegendreDomain::initialized_ = false;
+const std::string LegendreDomain::name_ = "Legendre-domain";
+LegendreDomain::scalar_type LegendreDomain::beta_ = -1.;
+std::vector<LegendreDomain::element_type> LegendreDomain::elements_;
+
+void LegendreDomain::initialize(const scalar_type beta, const int num_coefficients) {
+  if (initialized_)
+    throw std::logic_error("LegendreDomain has already been initialized.");
+  if (num_coefficients <= 0)
+    throw std::invalid_argument("The number of Legendre coefficients must be positive.");
+
+  beta_ = beta;
+
+  elements_.resize(num_coefficients);
+  for (int l = 0; l < num_coefficients; ++l)
+    elements_[l] = l;
+
+  initialized_ = true;
+}
+
+void LegendreDomain::evaluate(scalar_type tau, std::vector<scalar_type>& values) {
+  assert(initialized_);
+  assert(tau >= -beta_ && tau <= beta_);
+
+  scalar_type sign = 1.;
+  if (tau < 0) {
+    tau += beta_;
+    sign = -1.;
+  }
+
+  const scalar_type x = 2. * tau / beta_ - 1.;
+  const int size = elements_.size();
+  values.resize(size);
+
+  // Upward recurrence (l + 1) P_{l+1} = (2l + 1) x P_l - l P_{l-1}.
+  scalar_type p_prev = 0.;
+  scalar_type p = 1.;
+  for (int l = 0; l < size; ++l) {
+    values[l] = sign * std::sqrt(2. * l + 1.) * p;
+
+    const scalar_type p_next = ((2 * l + 1) * x * p - l * p_prev) / (l + 1);
+    p_prev = p;
+    p = p_next;
+  }
+}
+
+}  // domains
+}  // phys
+}  // dca
@@ -10,9 +10,12 @@
 // No-change test for the stdthread solver wrapper. The base solver is CT-AUX and the model is
 // a square lattice with nearest neighbours hopping. Two and single particles Green's function are
 // tested.
+// It also checks that G4 measured with a four-point measurement interval > 1 agrees with the one
+// measured at every measurement within the statistical errors.
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -53,16 +56,8 @@ using Data = dca::phys::DcaData<Parameters>;
 using BaseSolver = dca::phys::solver::CtauxClusterSolver<dca::linalg::CPU, Parameters, Data>;
 using QmcSolver = dca::phys::solver::StdThreadQmciClusterSolver<BaseSolver>;
 
-void performTest(const std::string& input, const std::string& baseline) {
-  Concurrency concurrency(0, nullptr);
-  if (concurrency.id() == concurrency.first()) {
-    dca::util::GitVersion::print();
-    dca::util::Modules::print();
-  }
-
-  Parameters parameters(dca::util::GitVersion::string(), concurrency);
-  parameters.read_input_and_broadcast<dca::io::JSONReader>(input_dir + input);
-
+// The domains can only be initialized once per process.
+void initializeDomains(Parameters& parameters) {
   static bool update_model = true;
   if (update_model) {
     parameters.update_model();
@@ -75,6 +70,18 @@ void performTest(const std::string& input, const std::string& baseline) {
     dca::phys::domains::MomentumExchangeDomain::initialize(parameters);
   }
   update_model = false;
+}
+
+void performTest(const std::string& input, const std::string& baseline) {
+  Concurrency concurrency(0, nullptr);
+  if (concurrency.id() == concurrency.first()) {
+    dca::util::GitVersion::print();
+    dca::util::Modules::print();
+  }
+
+  Parameters parameters(dca::util::GitVersion::string(), concurrency);
+  parameters.read_input_and_broadcast<dca::io::JSONReader>(input_dir + input);
+  initializeDomains(parameters);
 
   // Initialize data with G0 computation.
   Data data(parameters);
@@ -131,3 +138,43 @@ TEST(StdhreadCtauxTest, NonShared) {
   performTest("stdthread_ctaux_tp_test_nonshared_input.json",
               "stdthread_ctaux_tp_test_nonshared_baseline.hdf5");
 }
+
+// Returns G4 of one integration step with the four-point measurement interval 'interval'. The
+// inputs in 'inputs' are read in order, i.e. later ones overwrite parameters of earlier ones.
+Data::TpGreensFunction computeG4(const std::vector<std::string>& inputs, const int interval) {
+  Concurrency concurrency(0, nullptr);
+
+  Parameters parameters(dca::util::GitVersion::string(), concurrency);
+  for (const auto& input : inputs)
+    parameters.read_input_and_broadcast<dca::io::JSONReader>(input_dir + input);
+  parameters.set_four_point_measurement_interval(interval);
+  parameters.set_measurements(2000);
+  initializeDomains(parameters);
+
+  Data data(parameters);
+  data.initialize();
+
+  QmcSolver qmc_solver(parameters, data);
+  qmc_solver.initialize(0);
+  qmc_solver.integrate();
+  dca::phys::DcaLoopData<Parameters> loop_data;
+  qmc_solver.finalize(loop_data);
+
+  return data.get_G4();
+}
+
+TEST(StdhreadCtauxTest, MeasurementInterval) {
+  const std::string input = "stdthread_ctaux_tp_test_shared_input.json";
+
+  const auto G4 = computeG4({input}, 1);
+  const auto G4_interval = computeG4({input}, 3);
+  // Independent estimate of G4 with a different seed.
+  const auto G4_reseeded = computeG4({input, "stdthread_ctaux_tp_test_seed_input.json"}, 1);
+
+  // The difference between two independent estimates sets the scale of the statistical error. With
+  // a wrong normalization, e.g. by the sign of all measurements, G4_interval would be off by a
+  // factor of 3.
+  const double noise = dca::func::util::difference(G4, G4_reseeded).l2;
+  EXPECT_GT(0.2, noise);
+  EXPECT_GT(2 * noise, dca::func::util::difference(G4, G4_interval).l2);
+}
@@ -20,6 +20,7 @@
 #include "dca/io/json/json_reader.hpp"
 #include "dca/linalg/matrix.hpp"
 #include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/fock_space.hpp"
 #include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/options.hpp"
 #include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
@@ -50,8 +51,9 @@ Matrix referenceHamiltonian(const double t, const double U, const double mu) {
 TEST(HamiltonianTest, ConstructHamiltonian) {
   using Lattice = phys::models::square_lattice<phys::domains::D4>;
   using Model = phys::models::TightBindingModel<Lattice>;
-  using Parameters = phys::params::Parameters<parallel::NoConcurrency, void, void, Model, void,
-                                              phys::solver::CT_AUX>;  // CT_AUX is a placeholder.
+  using Parameters =
+      phys::params::Parameters<parallel::NoConcurrency, parallel::NoThreading, void, Model, void,
+                               phys::solver::CT_AUX>;  // CT_AUX is a placeholder.
   using EdOptions = phys::solver::ed::Options<Parameters>;
 
   using OrbitalSpinDmn = func::dmn_variadic<func::dmn_0<phys::domains::electron_band_domain>,
@@ -0,0 +1,82 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// Tests that the Anderson acceleration of a concurrent (using MPI) DCA calculation with the CT-AUX
+// cluster solver weights the self-energy residuals with the error bars of every accelerated
+// iteration, and not only with the ones of the last iteration.
+
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "dca/io/json/json_reader.hpp"
+#include "dca/math/random/std_random_wrapper.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
+#include "dca/phys/dca_data/dca_data.hpp"
+#include "dca/phys/dca_loop/dca_loop.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/ctaux_cluster_solver.hpp"
+#include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
+#include "dca/phys/models/analytic_hamiltonians/square_lattice.hpp"
+#include "dca/phys/models/tight_binding_model.hpp"
+#include "dca/phys/parameters/parameters.hpp"
+#include "dca/profiling/null_profiler.hpp"
+#include "dca/testing/dca_mpi_test_environment.hpp"
+#include "dca/testing/minimalist_printer.hpp"
+#include "dca/util/git_version.hpp"
+
+dca::testing::DcaMpiTestEnvironment* dca_test_env;
+
+TEST(DcaAndersonMpiTest, WeightedAcceleration) {
+  using RngType = dca::math::random::StdRandomWrapper<std::mt19937_64>;
+  using LatticeType = dca::phys::models::square_lattice<dca::phys::domains::D4>;
+  using ModelType = dca::phys::models::TightBindingModel<LatticeType>;
+  using ParametersType =
+      dca::phys::params::Parameters<dca::testing::DcaMpiTestEnvironment::ConcurrencyType,
+                                    dca::parallel::NoThreading, dca::profiling::NullProfiler,
+                                    ModelType, RngType, dca::phys::solver::CT_AUX>;
+  using DcaDataType = dca::phys::DcaData<ParametersType>;
+  using ClusterSolverType =
+      dca::phys::solver::CtauxClusterSolver<dca::linalg::CPU, ParametersType, DcaDataType>;
+  using DcaLoopType = dca::phys::DcaLoop<ParametersType, DcaDataType, ClusterSolverType>;
+
+  ParametersType parameters(dca::util::GitVersion::string(), dca_test_env->concurrency);
+  parameters.read_input_and_broadcast<dca::io::JSONReader>(dca_test_env->input_file_name);
+  parameters.update_model();
+  parameters.update_domains();
+
+  DcaDataType dca_data(parameters);
+  dca_data.initialize();
+
+  // The first two of the three iterations are accelerated, the last one is not.
+  DcaLoopType dca_loop(parameters, dca_data, dca_test_env->concurrency);
+  dca_loop.initialize();
+  dca_loop.execute();
+
+  EXPECT_TRUE(dca_loop.get_anderson_mixing().is_weighted());
+}
+
+int main(int argc, char** argv) {
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  dca_test_env = new dca::testing::DcaMpiTestEnvironment(
+      argc, argv, DCA_SOURCE_DIR "/test/system-level/dca/input.dca_anderson_mpi_test.json");
+  ::testing::AddGlobalTestEnvironment(dca_test_env);
+
+  ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+
+  if (dca_test_env->concurrency.id() != 0) {
+    delete listeners.Release(listeners.default_result_printer());
+    listeners.Append(new dca::testing::MinimalistPrinter);
+  }
+
+  result = RUN_ALL_TESTS();
+
+  return result;
+}
@@ -0,0 +1,124 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// Runs a sweep of two DCA calculations with the threaded CT-AUX cluster solver, where the second
+// point changes the density and the inverse temperature. Checks that the second point starts from
+// the self-energy and the chemical potential of the first one, that the additional time
+// measurements use the inverse temperature of the current point and that each point writes its own
+// output file.
+
+#include "dca/phys/dca_loop/dca_sweep.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/math/random/std_random_wrapper.hpp"
+#include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
+#include "dca/phys/dca_data/dca_data.hpp"
+#include "dca/phys/dca_loop/dca_loop.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/ctaux_cluster_solver.hpp"
+#include "dca/phys/dca_step/cluster_solver/stdthread_qmci/stdthread_qmci_cluster_solver.hpp"
+#include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
+#include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/time_domain.hpp"
+#include "dca/phys/models/analytic_hamiltonians/square_lattice.hpp"
+#include "dca/phys/models/tight_binding_model.hpp"
+#include "dca/phys/parameters/parameters.hpp"
+#include "dca/profiling/null_profiler.hpp"
+
+TEST(DcaSweepTest, SelfEnergyCarriesOver) {
+  using RngType = dca::math::random::StdRandomWrapper<std::mt19937_64>;
+  using LatticeType = dca::phys::models::square_lattice<dca::phys::domains::D4>;
+  using ModelType = dca::phys::models::TightBindingModel<LatticeType>;
+  using Concurrency = dca::parallel::NoConcurrency;
+  using ParametersType =
+      dca::phys::params::Parameters<Concurrency, dca::parallel::stdthread, dca::profiling::NullProfiler,
+                                    ModelType, RngType, dca::phys::solver::CT_AUX>;
+  using DcaDataType = dca::phys::DcaData<ParametersType>;
+  using ClusterSolverType = dca::phys::solver::StdThreadQmciClusterSolver<
+      dca::phys::solver::CtauxClusterSolver<dca::linalg::CPU, ParametersType, DcaDataType>>;
+  using DcaLoopType = dca::phys::DcaLoop<ParametersType, DcaDataType, ClusterSolverType>;
+
+  using WDmn = dca::func::dmn_0<dca::phys::domains::frequency_domain>;
+  using TDmn = dca::func::dmn_0<dca::phys::domains::time_domain>;
+  using RDmn = typename ParametersType::RClusterDmn;
+
+  const std::string input_dir = DCA_SOURCE_DIR "/test/system-level/dca/";
+  const std::vector<std::string> input_files{input_dir + "input.dca_sweep_test_point_1.json",
+                                             input_dir + "input.dca_sweep_test_point_2.json"};
+
+  // The G(r, tau) measured by the equal-time accumulator of the CT-AUX solver on the time domain of
+  // the current point jumps by -1 at tau = 0: G(0^+) + G(beta^-) = -1.
+  auto check_G_r_t_jump = [](const auto& G_r_t) {
+    const int r_0 = RDmn::parameter_type::origin_index();
+    const int t_0_plus = TDmn::dmn_size() / 2;
+    const int t_beta_minus = TDmn::dmn_size() - 1;
+    for (int s = 0; s < 2; ++s)
+      EXPECT_NEAR(-1., G_r_t(0, s, 0, s, r_0, t_0_plus) + G_r_t(0, s, 0, s, r_0, t_beta_minus),
+                  1.e-2);
+  };
+
+  Concurrency concurrency(0, nullptr);
+
+  dca::phys::DcaSweep<ParametersType, DcaDataType, DcaLoopType> sweep(input_files, concurrency);
+  auto& parameters = sweep.get_parameters();
+  auto& dca_data = sweep.get_dca_data();
+
+  ASSERT_EQ(2, sweep.size());
+
+  // First point.
+  sweep.readPoint(0);
+  const std::string output_1 = sweep.get_output_file();
+  EXPECT_EQ("./data.dca_sweep_test.hdf5", output_1);
+  std::remove(output_1.c_str());
+
+  sweep.runPoint();
+
+  const auto Sigma_1 = dca_data.Sigma;
+  const double mu_1 = parameters.get_chemical_potential();
+  double Sigma_1_norm = 0.;
+  for (int i = 0; i < Sigma_1.size(); ++i)
+    Sigma_1_norm += std::norm(Sigma_1(i));
+  EXPECT_GT(Sigma_1_norm, 0.);
+  check_G_r_t_jump(dca_data.G_r_t);
+
+  // Second point: the input only changes the density and the inverse temperature. The name of the
+  // output file is inherited from the first point and therefore gets the index of the point.
+  sweep.readPoint(1);
+  const std::string output_2 = sweep.get_output_file();
+  EXPECT_EQ("./data.dca_sweep_test_point2.hdf5", output_2);
+  std::remove(output_2.c_str());
+
+  EXPECT_EQ(2., parameters.get_beta());
+  EXPECT_EQ(0.95, parameters.get_density());
+  EXPECT_EQ(mu_1, parameters.get_chemical_potential());
+
+  // The time and frequency domains are reinitialized with the new inverse temperature.
+  EXPECT_NEAR(M_PI / 2., WDmn::get_elements()[WDmn::dmn_size() / 2], 1.e-14);
+
+  // The self-energy is not reset.
+  for (int i = 0; i < Sigma_1.size(); ++i)
+    EXPECT_EQ(Sigma_1(i), dca_data.Sigma(i));
+
+  sweep.runPoint();
+
+  EXPECT_FALSE(Sigma_1 == dca_data.Sigma);
+  check_G_r_t_jump(dca_data.G_r_t);
+
+  // Each point wrote its own output file.
+  EXPECT_TRUE(std::ifstream(output_1).good());
+  EXPECT_TRUE(std::ifstream(output_2).good());
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the transformation of all the domains of a given type with a matrix, performed by
+// FunctionTransform::execute_on_all, against a direct summation.
+
+#include "dca/math/function_transform/function_transform.hpp"
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/linalg/matrix.hpp"
+#include "dca/math/function_transform/domain_specifications.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
+
+template <int size>
+struct TestDomain {
+  using element_type = double;
+  using dmn_specifications_type =
+      dca::math::transform::domain_specifications<double, double, dca::math::transform::DISCRETE,
+                                                  dca::math::transform::KRONECKER_DELTA,
+                                                  dca::math::transform::PERIODIC,
+                                                  dca::math::transform::EQUIDISTANT>;
+
+  static int get_size() {
+    return size;
+  }
+  static std::vector<double>& get_elements() {
+    static std::vector<double> elements(size);
+    return elements;
+  }
+  static std::string get_name() {
+    return "TestDomain<" + std::to_string(size) + ">";
+  }
+};
+
+using InDmn = dca::func::dmn_0<TestDomain<3>>;
+using OutDmn = dca::func::dmn_0<TestDomain<5>>;
+using OtherDmn = dca::func::dmn_0<TestDomain<4>>;
+
+using InputDmn = dca::func::dmn_variadic<dca::func::dmn_variadic<OtherDmn, InDmn>,
+                                         dca::func::dmn_variadic<OtherDmn, InDmn>>;
+using OutputDmn = dca::func::dmn_variadic<dca::func::dmn_variadic<OtherDmn, OutDmn>,
+                                          dca::func::dmn_variadic<OtherDmn, OutDmn>>;
+
+using Complex = std::complex<double>;
+using Transform = dca::math::transform::FunctionTransform<InDmn, OutDmn>;
+
+class DomainwiseFunctionTransformTest : public ::testing::Test {
+protected:
+  DomainwiseFunctionTransformTest()
+      : T_("T", std::make_pair(OutDmn::dmn_size(), InDmn::dmn_size())) {
+    for (int i = 0; i < f_in_.size(); ++i)
+      f_in_(i) = Complex(0.1 * i - 1., 0.03 * i * i);
+    for (int j = 0; j < T_.nrCols(); ++j)
+      for (int i = 0; i < T_.nrRows(); ++i)
+        T_(i, j) = Complex(i - 2. * j, 0.5 * i * j - 1.);
+
+    // f_out(o1, j1, o2, j2) = \sum_{i1, i2} T(j1, i1) T(j2, i2) f_in(o1, i1, o2, i2).
+    for (int o1 = 0; o1 < OtherDmn::dmn_size(); ++o1)
+      for (int j1 = 0; j1 < OutDmn::dmn_size(); ++j1)
+        for (int o2 = 0; o2 < OtherDmn::dmn_size(); ++o2)
+          for (int j2 = 0; j2 < OutDmn::dmn_size(); ++j2) {
+            Complex val = 0;
+            for (int i1 = 0; i1 < InDmn::dmn_size(); ++i1)
+              for (int i2 = 0; i2 < InDmn::dmn_size(); ++i2)
+                val += T_(j1, i1) * T_(j2, i2) * f_in_(o1, i1, o2, i2);
+            expected_(o1, j1, o2, j2) = val;
+          }
+  }
+
+  void check(const dca::func::function<Complex, OutputDmn>& f_out) const {
+    for (int i = 0; i < f_out.size(); ++i) {
+      EXPECT_NEAR(expected_(i).real(), f_out(i).real(), 1.e-10 * std::abs(expected_(i)) + 1.e-12);
+      EXPECT_NEAR(expected_(i).imag(), f_out(i).imag(), 1.e-10 * std::abs(expected_(i)) + 1.e-12);
+    }
+  }
+
+  dca::func::function<Complex, InputDmn> f_in_;
+  dca::func::function<Complex, OutputDmn> expected_;
+  dca::linalg::Matrix<Complex, dca::linalg::CPU> T_;
+};
+
+TEST_F(DomainwiseFunctionTransformTest, Serial) {
+  dca::func::function<Complex, OutputDmn> f_out;
+  Transform::execute_on_all(f_in_, f_out, T_);
+  check(f_out);
+}
+
+TEST_F(DomainwiseFunctionTransformTest, Threaded) {
+  for (const int n_threads : {1, 3, 64}) {
+    dca::func::function<Complex, OutputDmn> f_out;
+    Transform::execute_on_all(f_in_, f_out, T_, dca::parallel::stdthread(), n_threads);
+    check(f_out);
+  }
+}
@@ -0,0 +1,121 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests legendre_transform.hpp on the Green's function of a single level,
+//     G(i w) = 1 / (i w - eps),   G(tau) = -e^{-eps tau} / (1 + e^{-beta eps}),   0 < tau < beta.
+
+#include "dca/math/function_transform/legendre_transform.hpp"
+
+#include <cmath>
+#include <complex>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/legendre_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/time_domain.hpp"
+
+using LDmn = dca::func::dmn_0<dca::phys::domains::LegendreDomain>;
+using WDmn = dca::func::dmn_0<dca::phys::domains::frequency_domain>;
+using TDmn = dca::func::dmn_0<dca::phys::domains::time_domain>;
+using OtherDmn = dca::func::dmn_0<dca::func::dmn<2, int>>;
+using Transform = dca::math::transform::LegendreTransform<LDmn, WDmn>;
+
+const double beta = 20.;
+const double eps[2] = {0.3, -1.1};
+
+class LegendreTransformTest : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+    dca::phys::domains::LegendreDomain::initialize(beta, 40);
+    dca::phys::domains::frequency_domain::initialize(beta, 512);
+    dca::phys::domains::time_domain::initialize(beta, 64);
+  }
+
+  static std::complex<double> gW(int i, double w) {
+    return 1. / (std::complex<double>(0., w) - eps[i]);
+  }
+  static double gT(int i, double tau) {
+    const double sign = tau < 0 ? -1. : 1.;
+    if (tau < 0)
+      tau += beta;
+    return -sign * std::exp(-eps[i] * tau) / (1. + std::exp(-beta * eps[i]));
+  }
+};
+
+TEST_F(LegendreTransformTest, SphericalBessel) {
+  std::vector<double> j;
+  for (const double z : {0.3, 2.5, 17., 151.}) {
+    Transform::sphericalBessel(30, z, j);
+    EXPECT_NEAR(std::sin(z) / z, j[0], 1.e-14);
+    EXPECT_NEAR(std::sin(z) / (z * z) - std::cos(z) / z, j[1], 1.e-14);
+    for (int l = 1; l < 30; ++l)
+      EXPECT_NEAR(j[l - 1] + j[l + 1], (2 * l + 1) / z * j[l], 1.e-12 * std::abs(j[l] / z) + 1.e-15);
+  }
+
+  Transform::sphericalBessel(3, -2.5, j);
+  std::vector<double> j_positive;
+  Transform::sphericalBessel(3, 2.5, j_positive);
+  EXPECT_DOUBLE_EQ(j_positive[2], j[2]);
+  EXPECT_DOUBLE_EQ(-j_positive[3], j[3]);
+}
+
+TEST_F(LegendreTransformTest, RoundTrip) {
+  dca::func::function<std::complex<double>, dca::func::dmn_variadic<OtherDmn, WDmn>> g_w;
+  for (int i = 0; i < 2; ++i)
+    for (int w = 0; w < WDmn::dmn_size(); ++w)
+      g_w(i, w) = gW(i, WDmn::get_elements()[w]);
+
+  dca::func::function<std::complex<double>, dca::func::dmn_variadic<OtherDmn, LDmn>> g_l;
+  Transform::matsubaraToLegendre(g_w, g_l);
+
+  // The coefficients of a real G(tau) are real and decay exponentially.
+  for (int i = 0; i < 2; ++i) {
+    for (int l = 0; l < LDmn::dmn_size(); ++l)
+      EXPECT_NEAR(0., g_l(i, l).imag(), 1.e-8);
+    EXPECT_LT(std::abs(g_l(i, LDmn::dmn_size() - 1)), 1.e-5);
+  }
+
+  // Matsubara frequencies.
+  dca::func::function<std::complex<double>, dca::func::dmn_variadic<OtherDmn, WDmn>> g_w_back;
+  Transform::legendreToMatsubara(g_l, g_w_back);
+  for (int i = 0; i < g_w.size(); ++i)
+    EXPECT_NEAR(0., std::abs(g_w(i) - g_w_back(i)), 1.e-6);
+
+  // Imaginary time.
+  dca::func::function<std::complex<double>, dca::func::dmn_variadic<OtherDmn, TDmn>> g_t;
+  Transform::legendreToTime<TDmn>(g_l, g_t);
+  for (int i = 0; i < 2; ++i)
+    for (int t = 1; t < TDmn::dmn_size() - 1; ++t)
+      EXPECT_NEAR(gT(i, TDmn::get_elements()[t]), g_t(i, t).real(), 1.e-6);
+}
+
+TEST_F(LegendreTransformTest, Projection) {
+  // Coefficients from the definition G_l = \sqrt(2l+1) \int_0^beta dtau P_l(x(tau)) G(tau).
+  const int n_l = LDmn::dmn_size();
+  dca::func::function<double, dca::func::dmn_variadic<OtherDmn, LDmn>> g_l;
+
+  const int n_points = 20000;
+  const double dtau = beta / n_points;
+  std::vector<double> values;
+  for (int p = 0; p < n_points; ++p) {
+    const double tau = (p + 0.5) * dtau;
+    dca::phys::domains::LegendreDomain::evaluate(tau, values);
+    for (int i = 0; i < 2; ++i)
+      for (int l = 0; l < n_l; ++l)
+        g_l(i, l) += values[l] * gT(i, tau) * dtau;
+  }
+
+  dca::func::function<std::complex<double>, dca::func::dmn_variadic<OtherDmn, WDmn>> g_w;
+  Transform::legendreToMatsubara(g_l, g_w);
+
+  for (int i = 0; i < 2; ++i)
+    for (int w = 0; w < WDmn::dmn_size(); ++w)
+      EXPECT_NEAR(0., std::abs(gW(i, WDmn::get_elements()[w]) - g_w(i, w)), 1.e-5);
+}
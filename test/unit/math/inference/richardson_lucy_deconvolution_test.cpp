@@ -186,3 +186,123 @@ TEST_F(RichardsonLucyDeconvolutionTest, FindShift) {
   deconvolution.findShift(source_interpolated_, shift);
   EXPECT_EQ(-4 * DeconvolutionType::min_distance_to_zero_, shift(0));
 }
+
+TEST(RichardsonLucyDeconvolutionColumnsTest, ColumnBounds) {
+  using ClusterDmn = dca::func::dmn_0<dca::func::dmn<2, int>>;
+  using HostDmn = dca::func::dmn_0<dca::func::dmn<4, int>>;
+  using OtherDmn = dca::func::dmn_0<dca::func::dmn<5, int>>;
+  using DeconvolutionType =
+      dca::math::inference::RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>;
+
+  // Averaging projection operators.
+  dca::linalg::Matrix<double, dca::linalg::CPU> p_cluster(
+      std::make_pair(ClusterDmn::dmn_size(), HostDmn::dmn_size()));
+  dca::linalg::Matrix<double, dca::linalg::CPU> p_host(HostDmn::dmn_size());
+  for (int j = 0; j < HostDmn::dmn_size(); ++j) {
+    p_cluster(j / 2, j) = 0.5;
+    for (int i = 0; i < HostDmn::dmn_size(); ++i)
+      p_host(i, j) = i == j ? 0.7 : 0.1;
+  }
+
+  dca::func::function<double, dca::func::dmn_variadic<ClusterDmn, OtherDmn>> source;
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> source_interpolated;
+  for (int j = 0; j < OtherDmn::dmn_size(); ++j) {
+    for (int i = 0; i < HostDmn::dmn_size(); ++i)
+      source_interpolated(i, j) = 1. + 0.3 * i - 0.5 * j;
+    for (int i = 0; i < ClusterDmn::dmn_size(); ++i)
+      source(i, j) = 0.5 * (source_interpolated(2 * i, j) + source_interpolated(2 * i + 1, j));
+  }
+
+  const double tolerance = 1.e-8;
+  const int max_iterations = 50;
+
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> target_all;
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> convoluted_all;
+  DeconvolutionType deconvolution(p_cluster, p_host, tolerance, max_iterations);
+  deconvolution.findTargetFunction(source, source_interpolated, target_all, convoluted_all);
+
+  // The columns are independent: deconvoluting disjoint column ranges gives the same result.
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> target;
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> convoluted;
+  for (const auto& bounds : {std::make_pair(0, 2), std::make_pair(2, 2), std::make_pair(2, 5)}) {
+    DeconvolutionType deconvolution_part(p_cluster, p_host, tolerance, max_iterations);
+    deconvolution_part.setColumnBounds(bounds);
+    deconvolution_part.findTargetFunction(source, source_interpolated, target, convoluted);
+  }
+
+  for (int i = 0; i < target.size(); ++i) {
+    EXPECT_DOUBLE_EQ(target_all(i), target(i));
+    EXPECT_DOUBLE_EQ(convoluted_all(i), convoluted(i));
+  }
+}
+
+TEST(RichardsonLucyDeconvolutionColumnsTest, WarmStartAndStagnation) {
+  using ClusterDmn = dca::func::dmn_0<dca::func::dmn<2, int>>;
+  using HostDmn = dca::func::dmn_0<dca::func::dmn<4, int>>;
+  using OtherDmn = dca::func::dmn_0<dca::func::dmn<3, int>>;
+  using DeconvolutionType =
+      dca::math::inference::RichardsonLucyDeconvolution<ClusterDmn, HostDmn, OtherDmn>;
+
+  dca::linalg::Matrix<double, dca::linalg::CPU> p_cluster(
+      std::make_pair(ClusterDmn::dmn_size(), HostDmn::dmn_size()));
+  dca::linalg::Matrix<double, dca::linalg::CPU> p_host(HostDmn::dmn_size());
+  for (int j = 0; j < HostDmn::dmn_size(); ++j) {
+    p_cluster(j / 2, j) = 0.5;
+    for (int i = 0; i < HostDmn::dmn_size(); ++i)
+      p_host(i, j) = i == j ? 0.7 : 0.1;
+  }
+
+  // Source functions of an exact solution, so that the deconvolution converges.
+  dca::func::function<double, dca::func::dmn_variadic<ClusterDmn, OtherDmn>> source;
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> source_interpolated;
+  for (int j = 0; j < OtherDmn::dmn_size(); ++j)
+    for (int k = 0; k < HostDmn::dmn_size(); ++k) {
+      const double exact = 2. + 0.3 * k + 0.5 * j;
+      for (int i = 0; i < HostDmn::dmn_size(); ++i)
+        source_interpolated(i, j) += p_host(i, k) * exact;
+      for (int i = 0; i < ClusterDmn::dmn_size(); ++i)
+        source(i, j) += p_cluster(i, k) * exact;
+    }
+
+  const double tolerance = 1.e-6;
+  const int max_iterations = 200;
+
+  DeconvolutionType deconvolution(p_cluster, p_host, tolerance, max_iterations);
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> target;
+  const auto cold = deconvolution.findTargetFunction(source, source_interpolated, target);
+  ASSERT_LT(cold.second, tolerance);
+  ASSERT_GT(cold.first, 1);
+
+  // Starting from the converged result does not need any iteration.
+  const auto expected = target;
+  deconvolution.setWarmStart(true);
+  const auto warm = deconvolution.findTargetFunction(source, source_interpolated, target);
+  EXPECT_EQ(0, warm.first);
+  EXPECT_LT(warm.second, tolerance);
+  for (int i = 0; i < target.size(); ++i)
+    EXPECT_DOUBLE_EQ(expected(i), target(i));
+
+  // A slightly changed source converges faster from the previous result.
+  for (int i = 0; i < source.size(); ++i)
+    source(i) *= 1.01;
+  for (int i = 0; i < source_interpolated.size(); ++i)
+    source_interpolated(i) *= 1.01;
+
+  dca::func::function<double, dca::func::dmn_variadic<HostDmn, OtherDmn>> target_cold;
+  deconvolution.setWarmStart(false);
+  const auto changed_cold =
+      deconvolution.findTargetFunction(source, source_interpolated, target_cold);
+  deconvolution.setWarmStart(true);
+  const auto changed_warm = deconvolution.findTargetFunction(source, source_interpolated, target);
+  EXPECT_LT(changed_warm.second, tolerance);
+  EXPECT_LT(changed_warm.first, changed_cold.first);
+
+  // With an unreachable tolerance the iteration stops when the error stagnates.
+  DeconvolutionType exact(p_cluster, p_host, 0., max_iterations);
+  EXPECT_EQ(max_iterations, exact.findTargetFunction(source, source_interpolated, target).first);
+
+  exact.setStagnationTolerance(1.e-2);
+  const auto stagnated = exact.findTargetFunction(source, source_interpolated, target);
+  EXPECT_LT(stagnated.first, max_iterations);
+  EXPECT_LT(stagnated.second, 1.e-2);
+}
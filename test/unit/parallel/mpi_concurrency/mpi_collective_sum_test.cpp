@@ -67,6 +67,33 @@ TEST_F(MPICollectiveSumTest, SumFunction) {
     EXPECT_EQ(function_expected(i), function_test(i));
 }
 
+TEST_F(MPICollectiveSumTest, HierarchicalSum) {
+  // Split the processes in groups of at most three, and use a small buffer such that the sums are
+  // performed over several chunks.
+  sum_interface_.setHierarchicalSum(true, 0, 1024, 3);
+  EXPECT_TRUE(sum_interface_.hierarchicalSumEnabled());
+  EXPECT_EQ(3, sum_interface_.get_number_of_nodes());
+
+  using TestDomain = dca::func::dmn_0<dca::func::dmn<1000, int>>;
+  dca::func::function<std::complex<double>, TestDomain> f;
+  std::vector<int> v(f.size());
+  for (int i = 0; i < f.size(); ++i) {
+    f(i) = std::complex<double>(i * rank_, -rank_);
+    v[i] = i + rank_;
+  }
+
+  sum_interface_.sum(f);
+  sum_interface_.sum(v);
+
+  for (int i = 0; i < f.size(); ++i) {
+    EXPECT_EQ(std::complex<double>(i * size_ * (size_ - 1) / 2, -size_ * (size_ - 1) / 2), f(i));
+    EXPECT_EQ(i * size_ + size_ * (size_ - 1) / 2, v[i]);
+  }
+
+  sum_interface_.setHierarchicalSum(false);
+  EXPECT_FALSE(sum_interface_.hierarchicalSumEnabled());
+}
+
 TEST_F(MPICollectiveSumTest, LeaveOneOutAvgAndSum) {
   std::vector<double> values(size_);
   double sum = 0.;
@@ -309,6 +336,42 @@ TEST_F(MPICollectiveSumTest, ComputeCovarianceComplex) {
   }
 }
 
+TEST_F(MPICollectiveSumTest, StreamingChunks) {
+  using TestDomain = dca::func::dmn_0<dca::func::dmn<101, int>>;
+  using FunctionType = dca::func::function<std::complex<double>, TestDomain>;
+
+  FunctionType f;
+  for (int i = 0; i < f.size(); ++i)
+    f(i) = std::complex<double>(i + rank_, i * rank_);
+
+  // Reference results computed with a single chunk.
+  FunctionType f_avg_ref(f), f_stddev_ref, f_loo_ref(f);
+  sum_interface_.average_and_compute_stddev(f_avg_ref, f_stddev_ref);
+  sum_interface_.leaveOneOutSum(f_loo_ref);
+  FunctionType f_jack_ref(f);
+  const FunctionType err_ref = sum_interface_.jackknifeError(f_jack_ref, true);
+
+  // Use chunks of 3 elements, the last one being incomplete.
+  sum_interface_.setStreamingChunkSize(3 * sizeof(std::complex<double>));
+
+  FunctionType f_avg(f), f_stddev, f_loo(f), f_jack(f);
+  sum_interface_.average_and_compute_stddev(f_avg, f_stddev);
+  sum_interface_.leaveOneOutSum(f_loo);
+  const FunctionType err = sum_interface_.jackknifeError(f_jack, true);
+
+  for (int i = 0; i < f.size(); ++i) {
+    EXPECT_EQ(f_avg_ref(i), f_avg(i));
+    EXPECT_EQ(f_stddev_ref(i), f_stddev(i));
+    EXPECT_EQ(f_loo_ref(i), f_loo(i));
+    EXPECT_EQ(f_jack_ref(i), f_jack(i));
+    EXPECT_EQ(err_ref(i), err(i));
+
+    const double sum_real = i * size_ + size_ * (size_ - 1) / 2;
+    EXPECT_DOUBLE_EQ(sum_real - (i + rank_), f_loo(i).real());
+    EXPECT_DOUBLE_EQ(sum_real / size_, f_avg(i).real());
+  }
+}
+
 TEST_F(MPICollectiveSumTest, AvgNormalizedMomenta) {
   using FunctionDomain = dca::func::dmn_0<dca::func::dmn<2, int>>;
   const std::vector<int> orders{3, 4};
@@ -0,0 +1,89 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests mpi_global_counter.hpp.
+// It is run with 4 MPI processes.
+
+#include "dca/parallel/mpi_concurrency/mpi_global_counter.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "dca/testing/minimalist_printer.hpp"
+
+class MPIGlobalCounterTest : public ::testing::Test {
+protected:
+  MPIGlobalCounterTest() {
+    rank_ = counter_.get_id();
+    size_ = counter_.get_size();
+  }
+
+  dca::parallel::MPIGlobalCounter counter_;
+
+  int rank_;
+  int size_;
+};
+
+TEST_F(MPIGlobalCounterTest, FetchAdd) {
+  // Each rank claims batches until the total work is exhausted.
+  const long long total = 1000;
+  const int batch = 7;
+
+  std::vector<int> claimed(total, 0);
+  int local_work = 0;
+  for (long long start = counter_.globalCounterFetchAdd(batch); start < total;
+       start = counter_.globalCounterFetchAdd(batch)) {
+    for (long long i = start; i < std::min(total, start + batch); ++i) {
+      ++claimed[i];
+      ++local_work;
+    }
+  }
+
+  // Every unit of work is claimed by exactly one rank.
+  MPI_Allreduce(MPI_IN_PLACE, claimed.data(), total, MPI_INT, MPI_SUM, counter_.get());
+  for (const int c : claimed)
+    EXPECT_EQ(1, c);
+
+  MPI_Allreduce(MPI_IN_PLACE, &local_work, 1, MPI_INT, MPI_SUM, counter_.get());
+  EXPECT_EQ(total, local_work);
+}
+
+TEST_F(MPIGlobalCounterTest, Reset) {
+  counter_.globalCounterFetchAdd(rank_ + 1);
+  counter_.resetGlobalCounter();
+
+  // After the reset the increments of all ranks start again from zero.
+  const long long previous = counter_.globalCounterFetchAdd(1);
+  EXPECT_LT(previous, size_);
+
+  long long max_previous = previous;
+  MPI_Allreduce(MPI_IN_PLACE, &max_previous, 1, MPI_LONG_LONG, MPI_MAX, counter_.get());
+  EXPECT_EQ(size_ - 1, max_previous);
+}
+
+int main(int argc, char** argv) {
+  int result = 0;
+
+  MPI_Init(&argc, &argv);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (rank != 0) {
+    delete listeners.Release(listeners.default_result_printer());
+    listeners.Append(new dca::testing::MinimalistPrinter);
+  }
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -53,3 +53,11 @@ TEST_F(NoConcurrencyTest, GetBounds) {
   EXPECT_EQ(0, bounds.first);
   EXPECT_EQ(3, bounds.second);
 }
+
+TEST_F(NoConcurrencyTest, GlobalCounter) {
+  EXPECT_EQ(0, concurrency_.globalCounterFetchAdd(4));
+  EXPECT_EQ(4, concurrency_.globalCounterFetchAdd(2));
+
+  concurrency_.resetGlobalCounter();
+  EXPECT_EQ(0, concurrency_.globalCounterFetchAdd(1));
+}
@@ -0,0 +1,82 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the error handling of the distributed compute_G0_k_t in
+// compute_free_greens_function.hpp.
+// It is run with 2 MPI processes.
+
+#include "dca/phys/dca_algorithms/compute_free_greens_function.hpp"
+
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/parallel/mpi_concurrency/mpi_concurrency.hpp"
+#include "dca/parallel/no_threading/no_threading.hpp"
+#include "dca/testing/minimalist_printer.hpp"
+
+dca::parallel::MPIConcurrency* concurrency_ptr;
+
+using OrbitalSpinDmn = dca::func::dmn_0<dca::func::dmn<4, int>>;
+using KDmn = dca::func::dmn_0<dca::func::dmn<4, int>>;
+using ImagTimeDmn = dca::func::dmn<1, double>;
+
+// Only the process owning the last k-point finds a complex G_0(k, tau). All processes must throw
+// instead of the others waiting for it in the sum of G_0.
+TEST(ComputeFreeGreensFunctionMpiTest, ErrorOnOneProcess) {
+  ASSERT_EQ(2, concurrency_ptr->number_of_processors());
+
+  const double beta = 1.;
+  ImagTimeDmn::set_elements(std::vector<double>{beta / 4});
+
+  // A complex hopping between the two orbitals at the last k-point.
+  dca::func::function<std::complex<double>,
+                      dca::func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn>>
+      H0_k;
+  const int k = KDmn::dmn_size() - 1;
+  H0_k(0, 1, k) = std::complex<double>(0, 1);
+  H0_k(1, 0, k) = std::complex<double>(0, -1);
+
+  dca::func::function<double, dca::func::dmn_variadic<OrbitalSpinDmn, OrbitalSpinDmn, KDmn,
+                                                      dca::func::dmn_0<ImagTimeDmn>>>
+      G0_k_t;
+
+  EXPECT_THROW(dca::phys::compute_G0_k_t(H0_k, 0., beta, *concurrency_ptr, G0_k_t,
+                                         dca::parallel::NoThreading(), 1),
+               std::logic_error);
+
+  // Without the complex hopping the processes compute G_0 together.
+  H0_k = 0.;
+  EXPECT_NO_THROW(dca::phys::compute_G0_k_t(H0_k, 0., beta, *concurrency_ptr, G0_k_t,
+                                            dca::parallel::NoThreading(), 1));
+  EXPECT_DOUBLE_EQ(-0.5, G0_k_t(0, 0, 0, 0));
+  EXPECT_DOUBLE_EQ(-0.5, G0_k_t(1, 1, k, 0));
+}
+
+int main(int argc, char** argv) {
+  int result = 0;
+
+  concurrency_ptr = new dca::parallel::MPIConcurrency(argc, argv);
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (concurrency_ptr->id() != 0) {
+    delete listeners.Release(listeners.default_result_printer());
+    listeners.Append(new dca::testing::MinimalistPrinter);
+  }
+
+  result = RUN_ALL_TESTS();
+
+  delete concurrency_ptr;
+
+  return result;
+}
@@ -20,6 +20,7 @@
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
 #include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
 #include "dca/phys/models/analytic_hamiltonians/bilayer_lattice.hpp"
 #include "dca/phys/models/analytic_hamiltonians/square_lattice.hpp"
@@ -321,4 +322,18 @@ TEST_F(ComputeFreeGreensFunctionTest, BilayerLattice) {
 
   EXPECT_DOUBLE_EQ(-0.081476455730596378, G0_k_t(0, 0, 1, 0, 0, 1));
   EXPECT_DOUBLE_EQ(-0.19743535655797104, G0_k_t(0, 0, 1, 0, 0, 4));
+
+  // Threaded computation, also with more threads than (k, w) and (k, t) points.
+  for (const int n_threads : {2, 8}) {
+    auto G0_k_w_threaded = G0_k_w;
+    auto G0_k_t_threaded = G0_k_t;
+    phys::compute_G0_k_w(H_0, mu, concurrency_, G0_k_w_threaded, parallel::stdthread(), n_threads);
+    phys::compute_G0_k_t(H_0, mu, beta, concurrency_, G0_k_t_threaded, parallel::stdthread(),
+                         n_threads);
+
+    for (int i = 0; i < G0_k_w.size(); ++i)
+      EXPECT_EQ(G0_k_w(i), G0_k_w_threaded(i));
+    for (int i = 0; i < G0_k_t.size(); ++i)
+      EXPECT_EQ(G0_k_t(i), G0_k_t_threaded(i));
+  }
 }
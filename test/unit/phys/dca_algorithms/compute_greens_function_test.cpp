@@ -20,6 +20,7 @@
 #include "dca/function/domains.hpp"
 #include "dca/function/function.hpp"
 #include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
 #include "dca/phys/dca_algorithms/compute_free_greens_function.hpp"
 #include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
 #include "dca/phys/models/analytic_hamiltonians/bilayer_lattice.hpp"
@@ -181,4 +182,14 @@ TEST_F(ComputeGreensFunctionTest, BilayerLattice) {
     EXPECT_NEAR(G_k_w_check(i).real(), G_k_w(i).real(), tol);
     EXPECT_NEAR(G_k_w_check(i).imag(), G_k_w(i).imag(), tol);
   }
+
+  // Threaded computation, also with more threads than (k, w) points.
+  for (const int n_threads : {2, 8}) {
+    phys::compute_G_k_w(H0_k, S_k_w, mu, concurrency_, G_k_w, parallel::stdthread(), n_threads);
+
+    for (int i = 0; i < G_k_w.size(); ++i) {
+      EXPECT_NEAR(G_k_w_check(i).real(), G_k_w(i).real(), tol);
+      EXPECT_NEAR(G_k_w_check(i).imag(), G_k_w(i).imag(), tol);
+    }
+  }
 }
@@ -0,0 +1,114 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests compute_gamma_cluster.hpp against the dense computation of
+// (c G_II_0)^{-1} - (c G_II)^{-1}.
+
+#include "dca/phys/dca_analysis/bse_solver/compute_gamma_cluster.hpp"
+
+#include <complex>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/linalg/matrix.hpp"
+#include "dca/linalg/matrixop.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
+
+class ComputeGammaClusterTest : public ::testing::Test {
+protected:
+  static constexpr int block_size = 4;
+  static constexpr int n_blocks = 3;
+  static constexpr int N = block_size * n_blocks;
+
+  using VectorDmn = dca::func::dmn_0<dca::func::dmn<N, int>>;
+  using MatrixDmn = dca::func::dmn_variadic<VectorDmn, VectorDmn>;
+  using Function = dca::func::function<std::complex<double>, MatrixDmn>;
+
+  ComputeGammaClusterTest() : rng_(0), distro_(-1., 1.) {}
+
+  // Fills the elements (i, j) of f for which include(i, j) is true with random values. A large
+  // diagonal keeps f well conditioned.
+  template <class Include>
+  void fillRandom(Function& f, Include&& include) {
+    f = 0.;
+    for (int j = 0; j < N; ++j)
+      for (int i = 0; i < N; ++i)
+        if (include(i, j))
+          f(i, j) = std::complex<double>(distro_(rng_), distro_(rng_));
+    for (int i = 0; i < N; ++i)
+      f(i, i) += 2. * N;
+  }
+
+  // Returns the dense (renorm G_II_0)^{-1} - (renorm G_II)^{-1}.
+  dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> denseGamma(const Function& G_II,
+                                                                         const Function& G_II_0) {
+    dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> G_II_inv(N);
+    dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU> G_II_0_inv(N);
+    for (int j = 0; j < N; ++j)
+      for (int i = 0; i < N; ++i) {
+        G_II_inv(i, j) = renorm_ * G_II(i, j);
+        G_II_0_inv(i, j) = renorm_ * G_II_0(i, j);
+      }
+
+    dca::linalg::matrixop::inverse(G_II_inv);
+    dca::linalg::matrixop::inverse(G_II_0_inv);
+
+    for (int j = 0; j < N; ++j)
+      for (int i = 0; i < N; ++i)
+        G_II_0_inv(i, j) -= G_II_inv(i, j);
+    return G_II_0_inv;
+  }
+
+  void expectNear(const dca::linalg::Matrix<std::complex<double>, dca::linalg::CPU>& expected,
+                  const Function& Gamma) {
+    for (int j = 0; j < N; ++j)
+      for (int i = 0; i < N; ++i) {
+        EXPECT_NEAR(expected(i, j).real(), Gamma(i, j).real(), 1.e-10);
+        EXPECT_NEAR(expected(i, j).imag(), Gamma(i, j).imag(), 1.e-10);
+      }
+  }
+
+  const double renorm_ = 0.25;
+  std::mt19937_64 rng_;
+  std::uniform_real_distribution<double> distro_;
+};
+
+TEST_F(ComputeGammaClusterTest, BlockDiagonal) {
+  Function G_II;
+  Function G_II_0;
+  fillRandom(G_II, [](int, int) { return true; });
+  fillRandom(G_II_0, [](int i, int j) { return i / block_size == j / block_size; });
+
+  const auto expected = denseGamma(G_II, G_II_0);
+
+  for (const int n_threads : {1, 2, 8}) {
+    Function G_II_0_copy(G_II_0);
+    Function Gamma;
+    dca::phys::analysis::computeGammaCluster(G_II, G_II_0_copy, renorm_, block_size, Gamma,
+                                             dca::parallel::stdthread(), n_threads);
+    expectNear(expected, Gamma);
+  }
+}
+
+TEST_F(ComputeGammaClusterTest, NotBlockDiagonal) {
+  Function G_II;
+  Function G_II_0;
+  fillRandom(G_II, [](int, int) { return true; });
+  // A single element outside of the blocks.
+  fillRandom(G_II_0, [](int i, int j) { return i / block_size == j / block_size; });
+  G_II_0(0, N - 1) = std::complex<double>(0.5, -0.5);
+
+  const auto expected = denseGamma(G_II, G_II_0);
+
+  Function Gamma;
+  dca::phys::analysis::computeGammaCluster(G_II, G_II_0, renorm_, block_size, Gamma,
+                                           dca::parallel::stdthread(), 2);
+  expectNear(expected, Gamma);
+}
@@ -0,0 +1,82 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests anderson_mixing.hpp.
+
+#include "dca/phys/dca_loop/anderson_mixing.hpp"
+
+#include <cmath>
+#include <complex>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+
+using Function = dca::func::function<std::complex<double>, dca::func::dmn_0<dca::func::dmn<16, int>>>;
+
+// Linear contraction g(x) = A x + b with a slowly converging direction.
+void applyMap(const Function& x, Function& g) {
+  for (int i = 0; i < x.size(); ++i) {
+    const double a = 0.5 + 0.45 * i / (x.size() - 1);
+    g(i) = a * x(i) + std::complex<double>(1., 0.1 * i);
+  }
+}
+
+double distance(const Function& a, const Function& b) {
+  double result = 0;
+  for (int i = 0; i < a.size(); ++i)
+    result = std::max(result, std::abs(a(i) - b(i)));
+  return result;
+}
+
+int iterationsToConvergence(const int history_size) {
+  dca::phys::AndersonMixing<Function> mixing(history_size, 1.e-10);
+  Function x, g;
+
+  for (int iteration = 1; iteration < 1000; ++iteration) {
+    applyMap(x, g);
+    if (distance(x, g) < 1.e-8)
+      return iteration;
+    mixing.execute(x, g);
+    x = g;
+  }
+  return 1000;
+}
+
+TEST(AndersonMixingTest, Convergence) {
+  const int plain_iterations = iterationsToConvergence(0);
+  const int anderson_iterations = iterationsToConvergence(6);
+
+  EXPECT_GT(plain_iterations, 300);
+  EXPECT_LT(anderson_iterations, 50);
+}
+
+TEST(AndersonMixingTest, NoiseThreshold) {
+  dca::phys::AndersonMixing<Function> mixing(4, 1.e-3, 1.);
+  Function x, g, error;
+
+  for (int i = 0; i < error.size(); ++i)
+    error(i) = std::complex<double>(10., 10.);
+
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    applyMap(x, g);
+    const Function g_plain(g);
+
+    // The residual is well within the error bars: the output is not modified.
+    EXPECT_FALSE(mixing.execute(x, g, &error));
+    EXPECT_EQ(0., distance(g, g_plain));
+    x = g;
+  }
+
+  // With small error bars the history is used.
+  for (int i = 0; i < error.size(); ++i)
+    error(i) = std::complex<double>(1.e-3, 1.e-3);
+  applyMap(x, g);
+  EXPECT_TRUE(mixing.execute(x, g, &error));
+  EXPECT_EQ(3, mixing.get_coefficients().size());
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the replica exchange methods of the CT-AUX walker: the weight ratio between two
+// expansion parameters and the change of the expansion parameter of a walker.
+
+#include "dca/phys/dca_step/cluster_solver/ctaux/ctaux_walker.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/io/buffer.hpp"
+#include "dca/linalg/matrix.hpp"
+#include "test/unit/phys/dca_step/cluster_solver/test_setup.hpp"
+
+constexpr char input_name[] =
+    DCA_SOURCE_DIR "/test/unit/phys/dca_step/cluster_solver/ctaux/structs/input.json";
+
+using CtauxWalkerTest =
+    dca::testing::G0Setup<dca::testing::LatticeBilayer, dca::phys::solver::CT_AUX, input_name>;
+
+using Walker = dca::phys::solver::ctaux::CtauxWalker<dca::linalg::CPU, CtauxWalkerTest::Parameters,
+                                                     CtauxWalkerTest::Data>;
+using WalkerData = dca::phys::solver::ctaux::CtauxWalkerData<dca::linalg::CPU,
+                                                             CtauxWalkerTest::Parameters>;
+
+void expectNear(const dca::linalg::Matrix<double, dca::linalg::CPU>& expected,
+                const dca::linalg::Matrix<double, dca::linalg::CPU>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (int j = 0; j < expected.nrCols(); ++j)
+    for (int i = 0; i < expected.nrRows(); ++i)
+      EXPECT_NEAR(expected(i, j), actual(i, j), 1.e-10);
+}
+
+// Returns log|det(A)| and stores the sign of the determinant in 'sign'.
+double logDeterminant(dca::linalg::Matrix<double, dca::linalg::CPU> A, int& sign) {
+  const int n = A.nrRows();
+  std::vector<int> ipiv(n);
+  dca::linalg::lapack::getrf(n, n, A.ptr(), A.leadingDimension(), ipiv.data());
+
+  double log_det = 0.;
+  sign = 1;
+  for (int i = 0; i < n; ++i) {
+    log_det += std::log(std::abs(A(i, i)));
+    if ((A(i, i) < 0) != (ipiv[i] != i + 1))
+      sign *= -1;
+  }
+  return log_det;
+}
+
+TEST_F(CtauxWalkerTest, ExchangeExpansionParameter) {
+  std::vector<double> random(1000);
+  for (auto& x : random)
+    x = static_cast<double>(std::rand()) / RAND_MAX;
+  Parameters::random_number_generator rng(random);
+
+  const double K = parameters_.get_expansion_parameter_K();
+  const double K_new = 2.5 * K;
+
+  Walker walker(parameters_, *data_, rng, 0);
+  walker.initialize();
+  ASSERT_LT(0, walker.get_expansion_order());
+
+  // The weight ratio at the current expansion parameter is one.
+  int sign = 0;
+  EXPECT_NEAR(0., walker.logWeightRatio(K, sign), 1.e-10);
+  EXPECT_EQ(1, sign);
+
+  int forward_sign = 0;
+  const double forward = walker.logWeightRatio(K_new, forward_sign);
+  EXPECT_NE(0., forward);
+
+  // W(c, K) is proportional to K^k / (det(N_up) det(N_dn)).
+  const WalkerData& data = walker;
+  const auto N_up = data.N_up;
+  const auto N_dn = data.N_dn;
+
+  const int walker_sign = walker.get_sign();
+  walker.changeExpansionParameter(K_new, forward_sign);
+  EXPECT_EQ(K_new, walker.get_expansion_parameter());
+  EXPECT_EQ(walker_sign * forward_sign, walker.get_sign());
+
+  int signs[4];
+  const double expected_forward = walker.get_expansion_order() * std::log(K_new / K) +
+                                  logDeterminant(N_up, signs[0]) + logDeterminant(N_dn, signs[1]) -
+                                  logDeterminant(data.N_up, signs[2]) -
+                                  logDeterminant(data.N_dn, signs[3]);
+  EXPECT_NEAR(expected_forward, forward, 1.e-8);
+  EXPECT_EQ(signs[0] * signs[1] * signs[2] * signs[3], forward_sign);
+
+  // The matrices after the change equal the ones built from scratch for the same configuration at
+  // the new expansion parameter.
+  Walker walker_expected(parameters_, *data_, rng, 1);
+  auto buffer = walker.dumpConfig();
+  walker_expected.readConfig(buffer);
+  walker_expected.setExpansionParameter(K_new);
+  walker_expected.initialize();
+
+  const WalkerData& data_expected = walker_expected;
+  expectNear(data_expected.N_up, data.N_up);
+  expectNear(data_expected.N_dn, data.N_dn);
+  expectNear(data_expected.G_up, data.G_up);
+  expectNear(data_expected.G_dn, data.G_dn);
+
+  // The reverse ratio is the inverse of the forward one.
+  int backward_sign = 0;
+  EXPECT_NEAR(-forward, walker.logWeightRatio(K, backward_sign), 1.e-10);
+  EXPECT_EQ(forward_sign, backward_sign);
+}
@@ -0,0 +1,154 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests vertex_arrays.hpp, the vertex arrays kept by CT_AUX_HS_configuration and the
+// kernels reading them against the kernels reading the vertex singletons one by one.
+
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/vertex_arrays.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/linalg/matrix.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/ctaux_walker.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/ct_aux_hs_configuration.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/structs/cv.hpp"
+#include "dca/phys/dca_step/cluster_solver/ctaux/walker/tools/g0_interpolation/g0_interpolation.hpp"
+#include "test/unit/phys/dca_step/cluster_solver/test_setup.hpp"
+
+using namespace dca::phys;
+using namespace dca::phys::solver::ctaux;
+
+constexpr char input_name[] =
+    DCA_SOURCE_DIR "/test/unit/phys/dca_step/cluster_solver/ctaux/structs/input.json";
+
+using VertexArraysTest =
+    dca::testing::G0Setup<dca::testing::LatticeBilayer, dca::phys::solver::CT_AUX, input_name>;
+
+TEST(VertexArraysMutationTest, FollowsVector) {
+  std::vector<vertex_singleton> vertices;
+  vertices.emplace_back(0, e_UP, 1, 3, 2, 5, 0.25, HS_UP, HS_FIELD_DN, 0);
+  vertices.emplace_back(1, e_UP, 3, 1, 4, 6, 1.5, HS_ZERO, HS_FIELD_UP, 0);
+  vertices.emplace_back(1, e_UP, 3, 2, 7, 0, 0.75, HS_DN, HS_FIELD_UP, 2);
+
+  VertexArrays arrays;
+  for (const auto& v : vertices)
+    arrays.push_back(v);
+
+  ASSERT_EQ(3, arrays.size());
+  EXPECT_TRUE(arrays.isConsistent(vertices));
+  for (int i = 0; i < arrays.size(); ++i) {
+    const vertex_singleton& v = vertices[i];
+    EXPECT_EQ(v.get_tau(), arrays.tau()[i]);
+    EXPECT_EQ(v.get_band(), arrays.band()[i]);
+    EXPECT_EQ(v.get_r_site(), arrays.r_site()[i]);
+    EXPECT_EQ(v.get_delta_r(), arrays.delta_r()[i]);
+    EXPECT_EQ(v.get_spin_orbital(), arrays.spin_orbital()[i]);
+    EXPECT_EQ(v.get_paired_spin_orbital(), arrays.paired_spin_orbital()[i]);
+    EXPECT_EQ(v.get_HS_spin(), arrays.HS_spin()[i]);
+    EXPECT_EQ(v.get_HS_field(), arrays.HS_field()[i]);
+    EXPECT_EQ(v.get_configuration_index(), arrays.configuration_index()[i]);
+  }
+
+  vertices[1].get_HS_spin() = HS_DN;
+  EXPECT_FALSE(arrays.isConsistent(vertices));
+  arrays.setHSSpin(1, HS_DN);
+  EXPECT_TRUE(arrays.isConsistent(vertices));
+
+  std::swap(vertices[0], vertices[2]);
+  arrays.swap(0, 2);
+  EXPECT_TRUE(arrays.isConsistent(vertices));
+
+  vertices.erase(vertices.begin() + 1);
+  arrays.erase(1);
+  EXPECT_TRUE(arrays.isConsistent(vertices));
+
+  // Remove the vertex pair 1 from the configuration.
+  vertices[0].get_configuration_index() -= 1;
+  arrays.removeConfigurationIndex(1);
+  EXPECT_TRUE(arrays.isConsistent(vertices));
+  EXPECT_EQ(1, arrays.configuration_index()[0]);
+  EXPECT_EQ(0, arrays.configuration_index()[1]);
+
+  arrays.clear();
+  EXPECT_EQ(0, arrays.size());
+}
+
+TEST_F(VertexArraysTest, FollowConfigurationUpdates) {
+  std::vector<double> random(1000);
+  for (auto& x : random)
+    x = static_cast<double>(std::rand()) / RAND_MAX;
+  Parameters::random_number_generator rng(random);
+
+  // The sweeps insert, flip, swap and erase vertices.
+  CtauxWalker<dca::linalg::CPU, Parameters, Data> walker(parameters_, *data_, rng, 0);
+  walker.initialize();
+
+  auto& configuration = walker.get_configuration();
+  for (int sweep = 0; sweep < 10; ++sweep) {
+    walker.doSweep();
+
+    for (const e_spin_states_type e_spin : {e_UP, e_DN})
+      EXPECT_TRUE(configuration.get_vertex_arrays(e_spin).isConsistent(configuration.get(e_spin)));
+  }
+  EXPECT_TRUE(configuration.assert_consistency());
+}
+
+TEST_F(VertexArraysTest, KernelsMatchPerVertexPaths) {
+  std::vector<double> random(100);
+  for (auto& x : random)
+    x = static_cast<double>(std::rand()) / RAND_MAX;
+  Parameters::random_number_generator stub_rng(random);
+
+  // Any G0 serves to compare the interpolations.
+  for (int i = 0; i < data_->G0_r_t_cluster_excluded.size(); ++i)
+    data_->G0_r_t_cluster_excluded(i) = std::sin(0.1 * i);
+
+  CV<Parameters> cv(parameters_);
+  cv.initialize(*data_);
+
+  G0_INTERPOLATION<dca::linalg::CPU, Parameters> g0_interpolation(0, parameters_);
+  g0_interpolation.initialize(*data_);
+
+  CT_AUX_HS_configuration<Parameters> configuration(parameters_, stub_rng);
+  configuration.initialize();
+  ASSERT_LT(0, configuration.size());
+
+  for (const e_spin_states_type e_spin : {e_UP, e_DN}) {
+    std::vector<vertex_singleton>& vertices = configuration.get(e_spin);
+    const VertexArrays& arrays = configuration.get_vertex_arrays(e_spin);
+    const int n = vertices.size();
+    ASSERT_TRUE(arrays.isConsistent(vertices));
+
+    // exp(V)
+    std::vector<double> exp_V(n);
+    cv.exp_V(arrays, n, exp_V.data());
+
+    for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(cv.exp_V(vertices[i]), exp_V[i]);
+
+    // G0 matrix
+    dca::linalg::Matrix<double, dca::linalg::CPU> G0_expected;
+    dca::linalg::Matrix<double, dca::linalg::CPU> G0;
+    g0_interpolation.build_G0_matrix(vertices, G0_expected);
+    g0_interpolation.build_G0_matrix(configuration, G0, e_spin);
+
+    ASSERT_EQ(G0_expected.size(), G0.size());
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+        EXPECT_DOUBLE_EQ(G0_expected(i, j), G0(i, j));
+
+    // The update of an unchanged configuration reproduces the matrix.
+    g0_interpolation.update_G0_matrix(configuration, G0, e_spin);
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+        EXPECT_DOUBLE_EQ(G0_expected(i, j), G0(i, j));
+  }
+}
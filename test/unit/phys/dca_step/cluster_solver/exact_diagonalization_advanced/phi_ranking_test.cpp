@@ -0,0 +1,74 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests phi_ranking.hpp.
+
+#include "dca/phys/dca_step/cluster_solver/exact_diagonalization_advanced/basis_states/phi_ranking.hpp"
+
+#include <bitset>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+struct MockOptions {
+  using phi_type = std::bitset<64>;
+};
+}  // namespace
+
+using PhiRanking = dca::phys::solver::ed::PhiRanking<MockOptions>;
+
+TEST(PhiRankingTest, Binomial) {
+  const PhiRanking ranking(1, 3);
+  EXPECT_EQ(6, ranking.get_num_orbitals());
+  EXPECT_EQ(1, ranking.binomial(6, 0));
+  EXPECT_EQ(20, ranking.binomial(6, 3));
+  EXPECT_EQ(6, ranking.binomial(6, 5));
+  EXPECT_EQ(0, ranking.binomial(2, 3));
+}
+
+// The ranks of the states with n electrons are a permutation of [0, C(N, n)).
+TEST(PhiRankingTest, Bijection) {
+  for (const int num_bands : {1, 2, 3}) {
+    const int num_sites = num_bands == 3 ? 1 : 2;
+    const PhiRanking ranking(num_bands, num_sites);
+    const int N = ranking.get_num_orbitals();
+
+    std::vector<std::vector<int>> count(N + 1);
+    for (int n = 0; n <= N; ++n)
+      count[n].assign(ranking.binomial(N, n), 0);
+
+    for (unsigned long state = 0; state < (1ul << N); ++state) {
+      const std::bitset<64> phi(state);
+      const int n = phi.count();
+      const long long rank = ranking.rank(phi);
+
+      ASSERT_GE(rank, 0);
+      ASSERT_LT(rank, ranking.binomial(N, n));
+      ++count[n][rank];
+    }
+
+    for (int n = 0; n <= N; ++n)
+      for (const int c : count[n])
+        EXPECT_EQ(1, c);
+  }
+}
+
+// The states are ordered by the number of spin up electrons first.
+TEST(PhiRankingTest, SpinOrdering) {
+  // Two bands on one site: orbitals 0, 1 have spin up and 2, 3 spin down.
+  const PhiRanking ranking(2, 1);
+
+  const std::bitset<64> down_down("1100");
+  const std::bitset<64> up_down("0101");
+  const std::bitset<64> up_up("0011");
+
+  EXPECT_EQ(0, ranking.rank(down_down));
+  EXPECT_LT(ranking.rank(down_down), ranking.rank(up_down));
+  EXPECT_LT(ranking.rank(up_down), ranking.rank(up_up));
+  EXPECT_EQ(5, ranking.rank(up_up));
+}
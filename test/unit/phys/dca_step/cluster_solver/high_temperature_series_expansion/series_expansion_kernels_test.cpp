@@ -0,0 +1,144 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the threaded kernels of the high temperature series expansion against the serial
+// momentum space kernels.
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains.hpp"
+#include "dca/function/function.hpp"
+#include "dca/parallel/no_concurrency/no_concurrency.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
+#include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/compute_bubble.hpp"
+#include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/compute_interaction.hpp"
+#include "dca/phys/dca_step/cluster_solver/high_temperature_series_expansion/sigma_perturbation.hpp"
+#include "dca/phys/domains/cluster/cluster_domain.hpp"
+#include "dca/phys/domains/cluster/cluster_domain_initializer.hpp"
+#include "dca/phys/domains/quantum/electron_band_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/frequency_domain.hpp"
+#include "dca/phys/domains/time_and_frequency/vertex_frequency_domain.hpp"
+#include "dca/profiling/null_profiler.hpp"
+
+using namespace dca::phys;
+
+namespace {
+class MockParameters {
+public:
+  using concurrency_type = dca::parallel::NoConcurrency;
+  using ThreadingType = dca::parallel::stdthread;
+  using profiler_type = dca::profiling::NullProfiler;
+
+  MockParameters() : concurrency_(0, nullptr) {}
+
+  concurrency_type& get_concurrency() {
+    return concurrency_;
+  }
+  double get_beta() const {
+    return 2.;
+  }
+  int get_hts_threads() const {
+    return 3;
+  }
+  int get_hts_bosonic_frequencies() const {
+    return 4;
+  }
+
+private:
+  concurrency_type concurrency_;
+};
+
+using RDmn = dca::func::dmn_0<
+    domains::cluster_domain<double, 2, domains::LATTICE_SP, domains::REAL_SPACE, domains::BRILLOUIN_ZONE>>;
+using KDmn = dca::func::dmn_0<domains::cluster_domain<double, 2, domains::LATTICE_SP,
+                                                      domains::MOMENTUM_SPACE, domains::BRILLOUIN_ZONE>>;
+using WDmn = dca::func::dmn_0<domains::frequency_domain>;
+using NuDmn = dca::func::dmn_variadic<dca::func::dmn_0<domains::electron_band_domain>,
+                                      dca::func::dmn_0<domains::electron_spin_domain>>;
+
+using PhBubble = solver::htseries::compute_bubble<solver::htseries::ph, MockParameters, KDmn, WDmn>;
+using PpBubble = solver::htseries::compute_bubble<solver::htseries::pp, MockParameters, KDmn, WDmn>;
+using GFunction = PhBubble::G_function_type;
+
+class SeriesExpansionKernelsTest : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+    int dummy_parameters = 0;
+    domains::electron_band_domain::initialize(dummy_parameters, 2, std::vector<int>{0, 1},
+                                              std::vector<std::vector<double>>{{0., 0.}, {0., 0.}});
+
+    double r_basis[4] = {1., 0., 0., 1.};
+    domains::cluster_domain_initializer<RDmn>::execute(r_basis,
+                                                       std::vector<std::vector<int>>{{2, 2}, {3, -1}});
+
+    domains::frequency_domain::initialize(parameters_.get_beta(), 8);
+    domains::vertex_frequency_domain<domains::EXTENDED_BOSONIC>::initialize(parameters_);
+  }
+
+  SeriesExpansionKernelsTest() {
+    // Arbitrary Green's function without symmetries.
+    for (int l = 0; l < G_.size(); ++l)
+      G_(l) = std::complex<double>(std::sin(0.7 * l), std::cos(1.3 * l + 0.2));
+  }
+
+  template <class Function>
+  static void expectNear(const Function& expected, const Function& f) {
+    for (int l = 0; l < f.size(); ++l) {
+      EXPECT_NEAR(expected(l).real(), f(l).real(), 1.e-10 * (1. + std::abs(expected(l))));
+      EXPECT_NEAR(expected(l).imag(), f(l).imag(), 1.e-10 * (1. + std::abs(expected(l))));
+    }
+  }
+
+  static MockParameters parameters_;
+  GFunction G_;
+};
+
+MockParameters SeriesExpansionKernelsTest::parameters_;
+}  // namespace
+
+TEST_F(SeriesExpansionKernelsTest, Bubbles) {
+  PhBubble ph_bubble(parameters_);
+  ph_bubble.execute_on_cluster(G_);
+  const auto ph_expected = ph_bubble.get_function();
+
+  // The bubble does not depend on the previous result.
+  for (int i = 0; i < 2; ++i) {
+    ph_bubble.threaded_execute_on_cluster(G_);
+    expectNear(ph_expected, ph_bubble.get_function());
+  }
+
+  PpBubble pp_bubble(parameters_);
+  pp_bubble.execute_on_cluster(G_);
+  const auto pp_expected = pp_bubble.get_function();
+
+  pp_bubble.threaded_execute_on_cluster(G_);
+  expectNear(pp_expected, pp_bubble.get_function());
+}
+
+TEST_F(SeriesExpansionKernelsTest, SecondOrderSigma) {
+  solver::htseries::compute_interaction interaction;
+  interaction.get_function()(0, 0, 0, 1) = 1.5;
+
+  PhBubble ph_bubble(parameters_);
+  PpBubble pp_bubble(parameters_);
+  ph_bubble.threaded_execute_on_cluster(G_);
+
+  solver::htseries::sigma_perturbation<2, MockParameters, KDmn> sigma_2(parameters_, interaction,
+                                                                        ph_bubble, pp_bubble);
+
+  sigma_2.execute_on_cluster(G_);
+  const auto expected = sigma_2.get_function();
+
+  for (int i = 0; i < 2; ++i) {
+    sigma_2.threaded_execute_on_cluster(G_);
+    expectNear(expected, sigma_2.get_function());
+  }
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the Legendre single-particle accumulator against the NFFT accumulator.
+
+#include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/sp/sp_legendre_accumulator.hpp"
+
+#include <array>
+#include <cmath>
+#include "gtest/gtest.h"
+
+#include "dca/function/util/difference.hpp"
+#include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/sp/sp_accumulator.hpp"
+#include "test/unit/phys/dca_step/cluster_solver/shared_tools/accumulation/accumulation_test.hpp"
+
+class SpLegendreAccumulatorTest : public dca::testing::AccumulationTest<double, 2, 3, 64> {
+protected:
+  static void SetUpTestCase() {
+    dca::testing::AccumulationTest<double, 2, 3, 64>::SetUpTestCase();
+    dca::phys::domains::LegendreDomain::initialize(get_beta(), 60);
+  }
+};
+
+using MatrixPair = SpLegendreAccumulatorTest::Sample;
+using Configuration = SpLegendreAccumulatorTest::Configuration;
+using Parameters = SpLegendreAccumulatorTest::Parameters;
+using LegendreAccumulator = dca::phys::solver::accumulator::SpLegendreAccumulator<Parameters>;
+
+TEST_F(SpLegendreAccumulatorTest, Accumulate) {
+  const std::array<int, 2> n{31, 28};
+  MatrixPair M;
+  Configuration config;
+  prepareConfiguration(config, M, n);
+
+  dca::phys::solver::accumulator::SpAccumulator<Parameters, dca::linalg::CPU> nfft_accumulator(
+      parameters_, true);
+  LegendreAccumulator legendre_accumulator(parameters_, true);
+
+  const int sign = -1;
+  nfft_accumulator.resetAccumulation();
+  nfft_accumulator.accumulate(M, config, sign);
+  nfft_accumulator.finalize();
+
+  legendre_accumulator.resetAccumulation();
+  legendre_accumulator.accumulate(M, config, sign);
+  legendre_accumulator.finalize();
+
+  // The resolved frequencies agree with the NFFT.
+  const int n_resolved = LegendreAccumulator::get_resolved_frequencies();
+  EXPECT_LT(10, n_resolved);
+  EXPECT_GT(64, n_resolved);
+
+  const int n_w = FreqDmn::dmn_size();
+  auto check = [&](const auto& expected, const auto& result) {
+    double max_val = 0, max_diff = 0;
+    for (int w = n_w / 2 - n_resolved; w < n_w / 2 + n_resolved; ++w)
+      for (int r = 0; r < RDmn::dmn_size(); ++r)
+        for (int s = 0; s < 2; ++s)
+          for (int b1 = 0; b1 < BDmn::dmn_size(); ++b1)
+            for (int b2 = 0; b2 < BDmn::dmn_size(); ++b2) {
+              max_val = std::max(max_val, std::abs(expected(b1, s, b2, s, r, w)));
+              max_diff = std::max(
+                  max_diff, std::abs(expected(b1, s, b2, s, r, w) - result(b1, s, b2, s, r, w)));
+            }
+    EXPECT_LT(max_diff, 1.e-6 * max_val);
+  };
+
+  check(nfft_accumulator.get_sign_times_M_r_w(), legendre_accumulator.get_sign_times_M_r_w());
+  check(nfft_accumulator.get_sign_times_M_r_w_sqr(),
+        legendre_accumulator.get_sign_times_M_r_w_sqr());
+}
+
+TEST_F(SpLegendreAccumulatorTest, SumTo) {
+  LegendreAccumulator accumulator1(parameters_);
+  LegendreAccumulator accumulator2(parameters_);
+  LegendreAccumulator accumulator_sum(parameters_);
+  LegendreAccumulator accumulator3(parameters_);
+
+  const std::array<int, 2> n{3, 4};
+  const int sign = -1;
+  MatrixPair M1, M2;
+  Configuration config1, config2;
+  prepareConfiguration(config1, M1, n);
+  prepareConfiguration(config2, M2, n);
+
+  accumulator1.resetAccumulation();
+  accumulator2.resetAccumulation();
+  accumulator3.resetAccumulation();
+
+  accumulator1.accumulate(M1, config1, sign);
+  accumulator2.accumulate(M2, config2, sign);
+  accumulator1.sumTo(accumulator_sum);
+  accumulator2.sumTo(accumulator_sum);
+  accumulator_sum.finalize();
+
+  accumulator3.accumulate(M1, config1, sign);
+  accumulator3.accumulate(M2, config2, sign);
+  accumulator3.finalize();
+
+  const auto diff = dca::func::util::difference(accumulator3.get_sign_times_M_r_w(),
+                                                accumulator_sum.get_sign_times_M_r_w());
+  EXPECT_GT(1e-12, diff.l_inf);
+}
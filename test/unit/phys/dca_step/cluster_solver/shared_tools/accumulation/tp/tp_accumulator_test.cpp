@@ -12,12 +12,14 @@
 #include "dca/phys/dca_step/cluster_solver/shared_tools/accumulation/tp/tp_accumulator.hpp"
 
 #include <array>
+#include <cmath>
 #include <map>
 #include <string>
 #include "gtest/gtest.h"
 
 #include "dca/function/util/difference.hpp"
 #include "dca/math/random/std_random_wrapper.hpp"
+#include "dca/phys/dca_step/symmetrization/symmetrize.hpp"
 #include "dca/phys/four_point_type.hpp"
 #include "test/unit/phys/dca_step/cluster_solver/shared_tools/accumulation/accumulation_test.hpp"
 #include "test/unit/phys/dca_step/cluster_solver/test_setup.hpp"
@@ -93,3 +95,164 @@ TEST_F(TpAccumulatorTest, Accumulate) {
   else
     reader.close_file();
 }
+
+TEST_F(TpAccumulatorTest, BatchedAccumulate) {
+  // Accumulating a batch of measurements at once must give the same G4 as accumulating them one
+  // at a time.
+  constexpr int n_samples = 3;
+  std::array<Sample, n_samples> M;
+  std::array<Configuration, n_samples> configs;
+  const std::array<int, n_samples> signs{1, -1, 1};
+  const std::array<std::array<int, 2>, n_samples> sizes{{{18, 22}, {9, 14}, {12, 12}}};
+
+  for (int i = 0; i < n_samples; ++i)
+    ConfigGenerator::prepareConfiguration(configs[i], M[i], TpAccumulatorTest::BDmn::dmn_size(),
+                                          TpAccumulatorTest::RDmn::dmn_size(),
+                                          parameters_.get_beta(), sizes[i]);
+
+  for (const dca::phys::FourPointType type :
+       {dca::phys::PARTICLE_HOLE_TRANSVERSE, dca::phys::PARTICLE_HOLE_MAGNETIC,
+        dca::phys::PARTICLE_HOLE_CHARGE, dca::phys::PARTICLE_PARTICLE_UP_DOWN}) {
+    parameters_.set_four_point_type(type);
+
+    parameters_.set_four_point_batch_size(1);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+
+    // The last batch is incomplete.
+    parameters_.set_four_point_batch_size(2);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> batched_accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+
+    for (int i = 0; i < n_samples; ++i) {
+      accumulator.accumulate(M[i], configs[i], signs[i]);
+      batched_accumulator.accumulate(M[i], configs[i], signs[i]);
+    }
+    accumulator.finalize();
+    batched_accumulator.finalize();
+
+    const auto diff =
+        dca::func::util::difference(accumulator.get_sign_times_G4(),
+                                    batched_accumulator.get_sign_times_G4());
+    EXPECT_GT(1e-8, diff.l_inf);
+  }
+
+  parameters_.set_four_point_batch_size(1);
+}
+
+TEST_F(TpAccumulatorTest, IrreducibleStorage) {
+  // Accumulating only the irreducible entries must give the symmetrized G4.
+  using WTpDmn =
+      dca::func::dmn_0<dca::phys::domains::vertex_frequency_domain<dca::phys::domains::COMPACT>>;
+  using G4SliceDmn = dca::func::dmn_variadic<BDmn, BDmn, BDmn, BDmn, KDmn, KDmn, WTpDmn, WTpDmn>;
+
+  const std::array<int, 2> n{18, 22};
+  Sample M;
+  Configuration config;
+  ConfigGenerator::prepareConfiguration(config, M, TpAccumulatorTest::BDmn::dmn_size(),
+                                        TpAccumulatorTest::RDmn::dmn_size(), parameters_.get_beta(),
+                                        n);
+
+  const auto& exchange_mom = dca::phys::domains::MomentumExchangeDomain::get_elements();
+  const int n_exchange_frq = dca::phys::domains::FrequencyExchangeDomain::get_size();
+
+  for (const dca::phys::FourPointType type : {dca::phys::PARTICLE_HOLE_MAGNETIC}) {
+    parameters_.set_four_point_type(type);
+
+    parameters_.set_irreducible_storage(false);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+    parameters_.set_irreducible_storage(true);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> irreducible_accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+
+    accumulator.accumulate(M, config, 1);
+    accumulator.finalize();
+    irreducible_accumulator.accumulate(M, config, 1);
+    irreducible_accumulator.finalize();
+
+    const auto& G4 = accumulator.get_sign_times_G4();
+    const auto& G4_irreducible = irreducible_accumulator.get_sign_times_G4();
+
+    const int nb = BDmn::dmn_size();
+    const int nk = KDmn::dmn_size();
+    const int nw = WTpDmn::dmn_size();
+
+    dca::func::function<std::complex<double>, G4SliceDmn> slice;
+    for (int w_ex = 0; w_ex < n_exchange_frq; ++w_ex)
+      for (int k_ex = 0; k_ex < exchange_mom.size(); ++k_ex) {
+        auto for_each_element = [&](auto&& f) {
+          for (int w2 = 0; w2 < nw; ++w2)
+            for (int w1 = 0; w1 < nw; ++w1)
+              for (int k2 = 0; k2 < nk; ++k2)
+                for (int k1 = 0; k1 < nk; ++k1)
+                  for (int b4 = 0; b4 < nb; ++b4)
+                    for (int b3 = 0; b3 < nb; ++b3)
+                      for (int b2 = 0; b2 < nb; ++b2)
+                        for (int b1 = 0; b1 < nb; ++b1)
+                          f(slice(b1, b2, b3, b4, k1, k2, w1, w2),
+                            G4(b1, b2, b3, b4, k1, k2, k_ex, w1, w2, w_ex),
+                            G4_irreducible(b1, b2, b3, b4, k1, k2, k_ex, w1, w2, w_ex));
+        };
+
+        for_each_element([](auto& slice_val, const auto& val, const auto&) { slice_val = val; });
+        dca::phys::symmetrize::execute(slice,
+                                       KDmn::parameter_type::get_elements()[exchange_mom[k_ex]]);
+        for_each_element([](const auto& slice_val, const auto&, const auto& irreducible_val) {
+          EXPECT_NEAR(slice_val.real(), irreducible_val.real(), 1e-6);
+          EXPECT_NEAR(slice_val.imag(), irreducible_val.imag(), 1e-6);
+        });
+      }
+  }
+
+  parameters_.set_irreducible_storage(false);
+}
+
+TEST_F(TpAccumulatorTest, SumEmptyAccumulator) {
+  // An accumulator without measurements, e.g. of a thread that did not measure G4, must not change
+  // the accumulator it is summed to.
+  const std::array<int, 2> n{18, 22};
+  Sample M;
+  Configuration config;
+  ConfigGenerator::prepareConfiguration(config, M, TpAccumulatorTest::BDmn::dmn_size(),
+                                        TpAccumulatorTest::RDmn::dmn_size(), parameters_.get_beta(),
+                                        n);
+
+  parameters_.set_four_point_type(dca::phys::PARTICLE_HOLE_MAGNETIC);
+
+  for (const bool irreducible_storage : {false, true}) {
+    parameters_.set_irreducible_storage(irreducible_storage);
+
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> sum_accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> empty_accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+    accumulator.resetAccumulation();
+    sum_accumulator.resetAccumulation();
+    empty_accumulator.resetAccumulation();
+
+    accumulator.accumulate(M, config, 1);
+    sum_accumulator.accumulate(M, config, 1);
+    accumulator.finalize();
+
+    EXPECT_NO_THROW(empty_accumulator.sumTo(sum_accumulator));
+    sum_accumulator.finalize();
+
+    const auto diff = dca::func::util::difference(accumulator.get_sign_times_G4(),
+                                                  sum_accumulator.get_sign_times_G4());
+    EXPECT_GT(1e-8, diff.l_inf);
+
+    // The G4 of an accumulator without measurements vanishes.
+    dca::phys::solver::accumulator::TpAccumulator<Parameters> unused_accumulator(
+        data_->G0_k_w_cluster_excluded, parameters_);
+    unused_accumulator.resetAccumulation();
+    unused_accumulator.finalize();
+    const auto& G4_unused = unused_accumulator.get_sign_times_G4();
+    for (int i = 0; i < G4_unused.size(); ++i)
+      ASSERT_EQ(0., std::abs(G4_unused(i)));
+  }
+
+  parameters_.set_irreducible_storage(false);
+}
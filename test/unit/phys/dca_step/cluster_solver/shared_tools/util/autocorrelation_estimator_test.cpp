@@ -0,0 +1,58 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests autocorrelation_estimator.hpp.
+
+#include "dca/phys/dca_step/cluster_solver/shared_tools/util/autocorrelation_estimator.hpp"
+
+#include <random>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+TEST(AutocorrelationEstimatorTest, ConstantSeries) {
+  dca::phys::solver::util::AutocorrelationEstimator estimator;
+  EXPECT_THROW(estimator.integratedTime(), std::logic_error);
+
+  for (int i = 0; i < 100; ++i)
+    estimator.addSample(1.);
+
+  EXPECT_EQ(100, estimator.count());
+  EXPECT_EQ(0.5, estimator.integratedTime());
+
+  estimator.reset();
+  EXPECT_EQ(0, estimator.count());
+}
+
+TEST(AutocorrelationEstimatorTest, UncorrelatedSeries) {
+  dca::phys::solver::util::AutocorrelationEstimator estimator;
+  std::mt19937_64 rng(42);
+  std::normal_distribution<double> distro(1., 1.);
+
+  for (int i = 0; i < 100000; ++i)
+    estimator.addSample(distro(rng));
+
+  EXPECT_NEAR(0.5, estimator.integratedTime(), 0.05);
+}
+
+TEST(AutocorrelationEstimatorTest, AutoregressiveSeries) {
+  // x_{n+1} = phi x_n + noise has tau_int = (1 + phi) / (2 (1 - phi)).
+  const double phi = 0.8;
+  const double tau_exact = (1. + phi) / (2. * (1. - phi));
+
+  dca::phys::solver::util::AutocorrelationEstimator estimator;
+  std::mt19937_64 rng(42);
+  std::normal_distribution<double> distro(0., 1.);
+
+  double x = 0;
+  for (int i = 0; i < 100000; ++i) {
+    x = phi * x + distro(rng);
+    estimator.addSample(x + 10.);
+  }
+
+  EXPECT_NEAR(tau_exact, estimator.integratedTime(), 0.1 * tau_exact);
+}
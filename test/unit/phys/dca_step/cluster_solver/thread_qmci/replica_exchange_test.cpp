@@ -0,0 +1,158 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests replica_exchange.hpp.
+
+#include "dca/phys/dca_step/cluster_solver/stdthread_qmci/replica_exchange.hpp"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+// Walker whose configuration has weight exp(-(K - K_pref)^2) and negative sign for K > 3.
+class MockWalker {
+public:
+  MockWalker(double K, double K_pref) : K_(K), K_pref_(K_pref) {}
+
+  double logWeightRatio(const double K, int& ratio_sign) {
+    ratio_sign = (K > 3) == (K_ > 3) ? 1 : -1;
+    return logWeight(K) - logWeight(K_);
+  }
+  void changeExpansionParameter(const double K, const int ratio_sign) {
+    K_ = K;
+    sign_ *= ratio_sign;
+  }
+
+  double K_;
+  int sign_ = 1;
+
+private:
+  double logWeight(const double K) const {
+    return -(K - K_pref_) * (K - K_pref_);
+  }
+
+  const double K_pref_;
+};
+
+class MockRng {
+public:
+  double operator()() {
+    return 0.5;
+  }
+};
+
+using ReplicaExchange = dca::phys::solver::stdthreadqmci::ReplicaExchange<MockWalker, MockRng>;
+}  // namespace
+
+TEST(ReplicaExchangeTest, Exchange) {
+  const std::vector<double> ladder{1., 2., 4.};
+  ReplicaExchange exchange(ladder, 2, MockRng());
+
+  // Each walker prefers the rung of its neighbour.
+  std::vector<MockWalker> walkers{MockWalker(1., 2.), MockWalker(2., 1.), MockWalker(4., 4.)};
+  for (int i = 0; i < walkers.size(); ++i)
+    EXPECT_EQ(ladder[i], exchange.expansionParameter(i));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < walkers.size(); ++i)
+    threads.emplace_back([&, i]() {
+      for (int meas = 0; meas < 2; ++meas)
+        exchange.afterMeasurement(i, walkers[i]);
+      exchange.leave(i);
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  // Only the even pair (0, 1) was proposed.
+  EXPECT_EQ(2., exchange.expansionParameter(0));
+  EXPECT_EQ(1., exchange.expansionParameter(1));
+  EXPECT_EQ(4., exchange.expansionParameter(2));
+  EXPECT_EQ(2., walkers[0].K_);
+  EXPECT_EQ(1., walkers[1].K_);
+  EXPECT_EQ(4., walkers[2].K_);
+
+  const auto ratios = exchange.acceptanceRatios();
+  ASSERT_EQ(2, ratios.size());
+  EXPECT_EQ(1., ratios[0]);
+  EXPECT_EQ(0., ratios[1]);
+
+  // The odd pair (1, 2) is proposed next: walker 0 at K = 2 and walker 2 at K = 4.
+  // log ratio = -(4 - 2)^2 - (2 - 4)^2 = -8. The exchange is rejected.
+  exchange.reset();
+  threads.clear();
+  for (int i = 0; i < walkers.size(); ++i)
+    threads.emplace_back([&, i]() {
+      for (int meas = 0; meas < 2; ++meas)
+        exchange.afterMeasurement(i, walkers[i]);
+      exchange.leave(i);
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(2., walkers[0].K_);
+  EXPECT_EQ(4., walkers[2].K_);
+  EXPECT_EQ(1, walkers[2].sign_);
+  EXPECT_EQ(0., exchange.acceptanceRatios()[1]);
+}
+
+TEST(ReplicaExchangeTest, Sign) {
+  ReplicaExchange exchange(std::vector<double>{2., 4.}, 1, MockRng());
+  std::vector<MockWalker> walkers{MockWalker(2., 4.), MockWalker(4., 2.)};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < walkers.size(); ++i)
+    threads.emplace_back([&, i]() {
+      exchange.afterMeasurement(i, walkers[i]);
+      exchange.leave(i);
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(4., walkers[0].K_);
+  EXPECT_EQ(-1, walkers[0].sign_);
+  EXPECT_EQ(2., walkers[1].K_);
+  EXPECT_EQ(-1, walkers[1].sign_);
+}
+
+TEST(ReplicaExchangeTest, UnequalMeasurements) {
+  const std::vector<double> ladder{1., 1.5, 2., 2.5};
+  ReplicaExchange exchange(ladder, 1, MockRng());
+
+  std::vector<MockWalker> walkers;
+  for (int i = 0; i < ladder.size(); ++i)
+    walkers.emplace_back(ladder[i], 1.75);
+
+  // The walkers leave after different numbers of measurements. No walker must be blocked.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < walkers.size(); ++i)
+    threads.emplace_back([&, i]() {
+      for (int meas = 0; meas < 10 * (i + 1); ++meas)
+        exchange.afterMeasurement(i, walkers[i]);
+      exchange.leave(i);
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  // The walkers still occupy distinct rungs, consistent with their expansion parameter.
+  std::vector<int> occupied(ladder.size(), 0);
+  for (int i = 0; i < walkers.size(); ++i) {
+    EXPECT_EQ(walkers[i].K_, exchange.expansionParameter(i));
+    for (int r = 0; r < ladder.size(); ++r)
+      occupied[r] += ladder[r] == walkers[i].K_;
+  }
+  for (const int count : occupied)
+    EXPECT_EQ(1, count);
+}
+
+TEST(ReplicaExchangeTest, InvalidInput) {
+  EXPECT_THROW(ReplicaExchange(std::vector<double>{}, 1, MockRng()), std::invalid_argument);
+  EXPECT_THROW(ReplicaExchange(std::vector<double>{1., -1.}, 1, MockRng()), std::invalid_argument);
+  EXPECT_THROW(ReplicaExchange(std::vector<double>{1., 2.}, 0, MockRng()), std::invalid_argument);
+}
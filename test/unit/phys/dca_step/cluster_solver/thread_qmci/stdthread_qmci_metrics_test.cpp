@@ -0,0 +1,84 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests stdthread_qmci_metrics.hpp.
+
+#include "dca/phys/dca_step/cluster_solver/stdthread_qmci/stdthread_qmci_metrics.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using dca::phys::solver::stdthreadqmci::QmciMetrics;
+
+TEST(StdThreadQmciMetricsTest, Record) {
+  QmciMetrics metrics(2);
+
+  metrics.recordMeasurement(0, 2., 10, 1, 0.5);
+  metrics.recordMeasurement(0, 2., 20, -1, 0.25);
+  metrics.recordWait(1, 0.5);
+
+  const auto walker_0 = metrics.get(0);
+  EXPECT_EQ(4., walker_0.sweeps);
+  EXPECT_EQ(2, walker_0.measurements);
+  EXPECT_EQ(30., walker_0.expansion_order_sum);
+  EXPECT_EQ(0., walker_0.sign_sum);
+  EXPECT_EQ(0.25, walker_0.acceptance_ratio);
+  EXPECT_EQ(0.5, metrics.get(1).wait_time);
+
+  std::ostringstream out;
+  metrics.writeRecord(out);
+  const std::string record = out.str();
+  EXPECT_NE(std::string::npos, record.find("\"measurements-done\": 2"));
+  EXPECT_NE(std::string::npos, record.find("\"expansion-order\": 15"));
+  EXPECT_NE(std::string::npos, record.find("\"wait-time\": 0.5"));
+
+  // The next record only contains the new measurements.
+  metrics.recordMeasurement(0, 1., 40, 1, 0.3);
+  std::ostringstream out2;
+  metrics.writeRecord(out2);
+  EXPECT_NE(std::string::npos, out2.str().find("\"expansion-order\": 40"));
+  EXPECT_NE(std::string::npos, out2.str().find("\"wait-time\": 0}"));
+
+  EXPECT_THROW(metrics.recordMeasurement(2, 1., 1, 1, 1.), std::out_of_range);
+}
+
+TEST(StdThreadQmciMetricsTest, Stream) {
+  const std::string filename = "stdthread_qmci_metrics_test.jsonl";
+  std::remove(filename.c_str());
+
+  {
+    QmciMetrics metrics(1);
+    metrics.start(filename, 0.01, 3, 1, []() { return 2; });
+    EXPECT_THROW(metrics.start(filename, 0.01, 3, 1), std::logic_error);
+
+    for (int i = 0; i < 5; ++i) {
+      metrics.recordMeasurement(0, 1., 5, 1, 0.5);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    metrics.stop();
+  }
+
+  std::ifstream in(filename);
+  std::string line, last_line;
+  int lines = 0;
+  while (std::getline(in, line)) {
+    ++lines;
+    EXPECT_EQ(0, line.find("{\"rank\": 3, \"DCA-iteration\": 1"));
+    EXPECT_NE(std::string::npos, line.find("\"accumulator-queue-depth\": 2"));
+    last_line = line;
+  }
+  // At least the final record is written.
+  EXPECT_GE(lines, 1);
+  EXPECT_NE(std::string::npos, last_line.find("\"measurements-done\": 5"));
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests lattice_index.hpp through the add and subtract functions of the cluster domains.
+
+#include "dca/phys/domains/cluster/lattice_index.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains/dmn_0.hpp"
+#include "dca/math/util/vector_operations.hpp"
+#include "dca/phys/domains/cluster/cluster_domain.hpp"
+#include "dca/phys/domains/cluster/cluster_domain_initializer.hpp"
+#include "dca/phys/domains/cluster/cluster_operations.hpp"
+
+using namespace dca::phys::domains;
+
+namespace {
+// Compares add, subtract and the dense tables of the cluster domain 'Cluster' with the translation
+// of the sum and difference of the elements inside the cluster.
+template <class Cluster>
+void checkCluster() {
+  const auto& elements = Cluster::get_elements();
+  const auto& super_basis = Cluster::get_super_basis_vectors();
+  const int n = elements.size();
+
+  ASSERT_EQ(n, Cluster::get_lattice_index().size());
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(i, Cluster::get_lattice_index().index(elements[i]));
+
+    for (int j = 0; j < n; ++j) {
+      const auto sum = cluster_operations::translate_inside_cluster(
+          dca::math::util::add(elements[i], elements[j]), super_basis);
+      const auto difference = cluster_operations::translate_inside_cluster(
+          dca::math::util::subtract(elements[i], elements[j]), super_basis);
+
+      EXPECT_EQ(cluster_operations::index(sum, elements, BRILLOUIN_ZONE), Cluster::add(i, j));
+      EXPECT_EQ(cluster_operations::index(difference, elements, BRILLOUIN_ZONE),
+                Cluster::subtract(i, j));
+      EXPECT_EQ(Cluster::add(i, j), Cluster::get_add_matrix()(i, j));
+      EXPECT_EQ(Cluster::subtract(i, j), Cluster::get_subtract_matrix()(i, j));
+    }
+  }
+
+  // Lattice vectors outside of the cluster are mapped to their equivalent element.
+  for (int i = 0; i < n; ++i) {
+    // x = x_i - sum of the superlattice basis vectors.
+    auto x = elements[i];
+    for (const auto& b : super_basis)
+      x = dca::math::util::subtract(b, x);
+    EXPECT_EQ(i, Cluster::get_lattice_index().index(x));
+  }
+}
+}  // namespace
+
+TEST(LatticeIndexTest, Tilted2D) {
+  using RDmn = cluster_domain<double, 2, CLUSTER, REAL_SPACE, BRILLOUIN_ZONE>;
+  using KDmn = cluster_domain<double, 2, CLUSTER, MOMENTUM_SPACE, BRILLOUIN_ZONE>;
+
+  double r_basis[4] = {1., 0., 0., 1.};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{2, 2}, {2, -2}});
+
+  EXPECT_EQ(8, RDmn::get_size());
+  checkCluster<RDmn>();
+  checkCluster<KDmn>();
+}
+
+TEST(LatticeIndexTest, Triangular2D) {
+  using RDmn = cluster_domain<double, 2, LATTICE_SP, REAL_SPACE, BRILLOUIN_ZONE>;
+  using KDmn = cluster_domain<double, 2, LATTICE_SP, MOMENTUM_SPACE, BRILLOUIN_ZONE>;
+
+  double r_basis[4] = {1., 0., 0.5, 0.8660254037844386};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{6, 0}, {-3, 6}});
+
+  EXPECT_EQ(36, RDmn::get_size());
+  checkCluster<RDmn>();
+  checkCluster<KDmn>();
+}
+
+TEST(LatticeIndexTest, Cluster3D) {
+  using RDmn = cluster_domain<double, 3, LATTICE_TP, REAL_SPACE, BRILLOUIN_ZONE>;
+  using KDmn = cluster_domain<double, 3, LATTICE_TP, MOMENTUM_SPACE, BRILLOUIN_ZONE>;
+
+  double r_basis[9] = {1., 0., 0., 0., 1., 0., 0., 0., 1.};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{2, 1, 0}, {0, 2, 1}, {1, 0, 2}});
+
+  EXPECT_EQ(9, RDmn::get_size());
+  checkCluster<RDmn>();
+  checkCluster<KDmn>();
+}
+
+TEST(LatticeIndexTest, InvalidElements) {
+  LatticeIndex index;
+  const double inverse_basis[4] = {1., 0., 0., 1.};
+  const double super_basis[4] = {2., 0., 0., 2.};
+
+  // (0, 0) and (2, 0) are equivalent.
+  EXPECT_THROW(index.initialize(2, inverse_basis, super_basis,
+                                std::vector<std::vector<double>>{{0, 0}, {2, 0}, {0, 1}, {1, 1}}),
+               std::logic_error);
+  // Wrong number of elements.
+  EXPECT_THROW(index.initialize(2, inverse_basis, super_basis,
+                                std::vector<std::vector<double>>{{0, 0}, {1, 0}}),
+               std::logic_error);
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests set_symmetry_matrices.hpp.
+
+#include "dca/phys/domains/cluster/symmetrization_algorithms/set_symmetry_matrices.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/function/domains/dmn_0.hpp"
+#include "dca/io/buffer.hpp"
+#include "dca/math/util/vector_operations.hpp"
+#include "dca/parallel/stdthread/stdthread.hpp"
+#include "dca/phys/domains/cluster/cluster_domain.hpp"
+#include "dca/phys/domains/cluster/cluster_domain_initializer.hpp"
+#include "dca/phys/domains/cluster/cluster_domain_symmetry_initializer.hpp"
+#include "dca/phys/domains/cluster/cluster_operations.hpp"
+#include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_hexagonal.hpp"
+#include "dca/phys/domains/cluster/symmetries/point_groups/2d/2d_square.hpp"
+#include "dca/phys/domains/quantum/electron_band_domain.hpp"
+
+using namespace dca::phys::domains;
+
+namespace {
+// Compares the symmetry matrices of the cluster family of 'RCluster' with a search over all the
+// sites and bands.
+template <class RCluster>
+void checkSymmetryMatrices() {
+  using KCluster = typename cluster_symmetry<RCluster>::dual_type;
+  using SymDmn = typename cluster_symmetry<RCluster>::sym_super_cell_dmn_t;
+  const int D = RCluster::DIMENSION;
+
+  const auto& r_matrix = cluster_symmetry<RCluster>::get_symmetry_matrix();
+  const auto& k_matrix = cluster_symmetry<KCluster>::get_symmetry_matrix();
+  const auto& r_elements = RCluster::get_elements();
+  const auto& k_elements = KCluster::get_elements();
+  const auto& bands = electron_band_domain::get_elements();
+
+  ASSERT_GT(SymDmn::dmn_size(), 1);
+
+  for (int l = 0; l < SymDmn::dmn_size(); ++l) {
+    auto& operation = SymDmn::get_elements()[l];
+
+    for (int i = 0; i < r_elements.size(); ++i) {
+      for (int j = 0; j < bands.size(); ++j) {
+        std::vector<double> r_plus_a = dca::math::util::add(r_elements[i], bands[j].a_vec);
+        std::vector<double> trafo(D);
+        operation.transform(&r_plus_a[0], &trafo[0]);
+        trafo = cluster_operations::translate_inside_cluster(trafo,
+                                                              RCluster::get_super_basis_vectors());
+
+        std::pair<int, int> expected(-1, -1);
+        for (int r_ind = 0; r_ind < r_elements.size(); ++r_ind)
+          for (int b_ind = 0; b_ind < bands.size(); ++b_ind) {
+            const auto rj_plus_aj = cluster_operations::translate_inside_cluster(
+                dca::math::util::add(r_elements[r_ind], bands[b_ind].a_vec),
+                RCluster::get_super_basis_vectors());
+            if (dca::math::util::distance2(rj_plus_aj, trafo) < 1.e-6 &&
+                bands[j].flavor == bands[b_ind].flavor)
+              expected = std::make_pair(r_ind, b_ind);
+          }
+
+        EXPECT_NE(-1, expected.first);
+        EXPECT_EQ(expected, r_matrix(i, j, l));
+      }
+    }
+
+    for (int i = 0; i < k_elements.size(); ++i) {
+      std::vector<double> k = k_elements[i];
+      std::vector<double> trafo_k(D);
+      operation.linear_transform(&k[0], &trafo_k[0]);
+      trafo_k = cluster_operations::translate_inside_cluster(trafo_k,
+                                                             KCluster::get_super_basis_vectors());
+      const int expected = cluster_operations::index(trafo_k, k_elements, BRILLOUIN_ZONE);
+
+      for (int j = 0; j < bands.size(); ++j) {
+        EXPECT_EQ(expected, k_matrix(i, j, l).first);
+        EXPECT_EQ(r_matrix(i, j, l).second, k_matrix(i, j, l).second);
+      }
+    }
+  }
+}
+
+// The band domain can only be initialized once. The second band is displaced by a lattice vector,
+// so that its images are not the images of the sites.
+void initializeBands() {
+  int dummy_parameters = 0;
+  electron_band_domain::initialize(dummy_parameters, 2, std::vector<int>{0, 1},
+                                   std::vector<std::vector<double>>{{0., 0.}, {1., 0.}});
+}
+}  // namespace
+
+TEST(SetSymmetryMatricesTest, SquareLattice) {
+  using RDmn = cluster_domain<double, 2, CLUSTER, REAL_SPACE, BRILLOUIN_ZONE>;
+
+  initializeBands();
+
+  double r_basis[4] = {1., 0., 0., 1.};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{2, 2}, {2, -2}});
+  cluster_domain_symmetry_initializer<dca::func::dmn_0<RDmn>, D4>::execute();
+
+  checkSymmetryMatrices<RDmn>();
+}
+
+TEST(SetSymmetryMatricesTest, TriangularLattice) {
+  using RDmn = cluster_domain<double, 2, LATTICE_SP, REAL_SPACE, BRILLOUIN_ZONE>;
+
+  initializeBands();
+
+  double r_basis[4] = {1., 0., 0.5, 0.8660254037844386};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{4, -2}, {2, 2}});
+  // The symmetry operations are distributed amongst the threads.
+  cluster_domain_symmetry_initializer<dca::func::dmn_0<RDmn>, D6>::execute(
+      dca::parallel::stdthread(), 3);
+
+  checkSymmetryMatrices<RDmn>();
+}
+
+TEST(SetSymmetryMatricesTest, ReadWrite) {
+  using RDmn = cluster_domain<double, 2, LATTICE_TP, REAL_SPACE, BRILLOUIN_ZONE>;
+  using OtherRDmn = cluster_domain<double, 2, TMP_CLUSTER, REAL_SPACE, BRILLOUIN_ZONE>;
+  using Initializer = cluster_domain_symmetry_initializer<dca::func::dmn_0<RDmn>, D4>;
+  using OtherInitializer = cluster_domain_symmetry_initializer<dca::func::dmn_0<OtherRDmn>, D4>;
+
+  initializeBands();
+
+  double r_basis[4] = {1., 0., 0., 1.};
+  cluster_domain_initializer<dca::func::dmn_0<RDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{4, 0}, {0, 4}});
+  cluster_domain_initializer<dca::func::dmn_0<OtherRDmn>>::execute(
+      r_basis, std::vector<std::vector<int>>{{2, 2}, {2, -2}});
+
+  // Nothing to read: the matrices are computed.
+  dca::io::Buffer empty;
+  EXPECT_FALSE(Initializer::execute(empty));
+  EXPECT_FALSE(OtherInitializer::execute(empty));
+
+  auto& r_matrix = cluster_symmetry<RDmn>::get_symmetry_matrix();
+  const auto expected = r_matrix;
+
+  dca::io::Buffer tables;
+  OtherInitializer::write(tables);
+  Initializer::write(tables);
+
+  // The tables of the other cluster are skipped, the matching ones are read.
+  EXPECT_FALSE(Initializer::execute(tables));
+  for (int i = 0; i < r_matrix.size(); ++i)
+    r_matrix(i) = std::make_pair(-1, -1);
+  EXPECT_TRUE(Initializer::execute(tables));
+  for (int i = 0; i < r_matrix.size(); ++i)
+    EXPECT_EQ(expected(i), r_matrix(i));
+
+  checkSymmetryMatrices<RDmn>();
+}
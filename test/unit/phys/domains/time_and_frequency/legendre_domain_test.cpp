@@ -0,0 +1,54 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests legendre_domain.hpp.
+
+#include "dca/phys/domains/time_and_frequency/legendre_domain.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using dca::phys::domains::LegendreDomain;
+
+TEST(LegendreDomainTest, Full) {
+  const double beta = 4.;
+  const int num_coefficients = 4;
+
+  EXPECT_FALSE(LegendreDomain::is_initialized());
+  EXPECT_EQ("Legendre-domain", LegendreDomain::get_name());
+  EXPECT_DEBUG_DEATH(LegendreDomain::get_size(), "initialized_");
+
+  EXPECT_THROW(LegendreDomain::initialize(beta, 0), std::invalid_argument);
+  LegendreDomain::initialize(beta, num_coefficients);
+
+  EXPECT_TRUE(LegendreDomain::is_initialized());
+  EXPECT_EQ(num_coefficients, LegendreDomain::get_size());
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), LegendreDomain::get_elements());
+  EXPECT_EQ(beta, LegendreDomain::get_beta());
+
+  // tau = 3 corresponds to x = 0.5.
+  const double x = 0.5;
+  const std::vector<double> expected{1., std::sqrt(3.) * x, std::sqrt(5.) * (3 * x * x - 1) / 2,
+                                     std::sqrt(7.) * (5 * x * x * x - 3 * x) / 2};
+  std::vector<double> values;
+
+  LegendreDomain::evaluate(3., values);
+  ASSERT_EQ(num_coefficients, values.size());
+  for (int l = 0; l < num_coefficients; ++l)
+    EXPECT_NEAR(expected[l], values[l], 1.e-14);
+
+  // Antiperiodicity.
+  LegendreDomain::evaluate(3. - beta, values);
+  for (int l = 0; l < num_coefficients; ++l)
+    EXPECT_NEAR(-expected[l], values[l], 1.e-14);
+
+  // The domain can only be initialized once.
+  EXPECT_THROW(LegendreDomain::initialize(1., 10), std::logic_error);
+}
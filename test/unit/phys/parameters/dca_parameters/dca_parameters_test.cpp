@@ -27,6 +27,9 @@ TEST_F(DcaParametersTest, DefaultValues) {
   EXPECT_EQ(0., pars_.get_dca_accuracy());
   EXPECT_EQ(1., pars_.get_self_energy_mixing_factor());
   EXPECT_EQ(std::vector<int>{0}, pars_.get_interacting_orbitals());
+  EXPECT_EQ(0, pars_.get_anderson_history_size());
+  EXPECT_EQ(1.e-3, pars_.get_anderson_regularization());
+  EXPECT_EQ(1., pars_.get_anderson_noise_threshold());
   EXPECT_FALSE(pars_.do_finite_size_qmc());
   EXPECT_EQ(0, pars_.get_k_mesh_recursion());
   EXPECT_EQ(0, pars_.get_coarsegraining_periods());
@@ -36,6 +39,8 @@ TEST_F(DcaParametersTest, DefaultValues) {
   EXPECT_FALSE(pars_.do_dca_plus());
   EXPECT_EQ(16, pars_.get_deconvolution_iterations());
   EXPECT_EQ(1.e-3, pars_.get_deconvolution_tolerance());
+  EXPECT_FALSE(pars_.deconvolution_warm_start());
+  EXPECT_EQ(0., pars_.get_deconvolution_stagnation_tolerance());
   EXPECT_FALSE(pars_.hts_approximation());
   EXPECT_EQ(1, pars_.get_hts_threads());
 }
@@ -52,6 +57,9 @@ TEST_F(DcaParametersTest, ReadAll) {
   EXPECT_EQ(1.e-3, pars_.get_dca_accuracy());
   EXPECT_EQ(0.5, pars_.get_self_energy_mixing_factor());
   EXPECT_EQ(interacting_orbitals_check, pars_.get_interacting_orbitals());
+  EXPECT_EQ(3, pars_.get_anderson_history_size());
+  EXPECT_EQ(1.e-2, pars_.get_anderson_regularization());
+  EXPECT_EQ(2., pars_.get_anderson_noise_threshold());
   EXPECT_FALSE(pars_.do_finite_size_qmc());
   EXPECT_EQ(3, pars_.get_k_mesh_recursion());
   EXPECT_EQ(2, pars_.get_coarsegraining_periods());
@@ -61,6 +69,8 @@ TEST_F(DcaParametersTest, ReadAll) {
   EXPECT_TRUE(pars_.do_dca_plus());
   EXPECT_EQ(32, pars_.get_deconvolution_iterations());
   EXPECT_EQ(1.e-4, pars_.get_deconvolution_tolerance());
+  EXPECT_TRUE(pars_.deconvolution_warm_start());
+  EXPECT_EQ(1.e-2, pars_.get_deconvolution_stagnation_tolerance());
   EXPECT_TRUE(pars_.hts_approximation());
   EXPECT_EQ(8, pars_.get_hts_threads());
 }
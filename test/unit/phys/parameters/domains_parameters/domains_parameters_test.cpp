@@ -28,6 +28,7 @@ TEST(DomainsParametersTest, DefaultValues) {
   EXPECT_EQ(tp_host_check, pars.get_tp_host());
   EXPECT_EQ(128, pars.get_sp_time_intervals());
   EXPECT_EQ(1, pars.get_time_intervals_for_time_measurements());
+  EXPECT_EQ(0, pars.get_legendre_coefficients());
   EXPECT_EQ(256, pars.get_sp_fermionic_frequencies());
   EXPECT_EQ(0, pars.get_hts_bosonic_frequencies());
   EXPECT_EQ(1, pars.get_four_point_fermionic_frequencies());
@@ -35,6 +36,7 @@ TEST(DomainsParametersTest, DefaultValues) {
   EXPECT_EQ(10., pars.get_max_real_frequency());
   EXPECT_EQ(3, pars.get_real_frequencies());
   EXPECT_EQ(0.01, pars.get_imaginary_damping());
+  EXPECT_EQ("", pars.get_symmetry_tables_file());
 }
 
 TEST(DomainsParametersTest, ReadAll) {
@@ -56,6 +58,7 @@ TEST(DomainsParametersTest, ReadAll) {
   EXPECT_EQ(tp_host_check, pars.get_tp_host());
   EXPECT_EQ(64, pars.get_sp_time_intervals());
   EXPECT_EQ(128, pars.get_time_intervals_for_time_measurements());
+  EXPECT_EQ(40, pars.get_legendre_coefficients());
   EXPECT_EQ(512, pars.get_sp_fermionic_frequencies());
   EXPECT_EQ(32, pars.get_hts_bosonic_frequencies());
   EXPECT_EQ(16, pars.get_four_point_fermionic_frequencies());
@@ -63,4 +66,5 @@ TEST(DomainsParametersTest, ReadAll) {
   EXPECT_EQ(8., pars.get_max_real_frequency());
   EXPECT_EQ(128, pars.get_real_frequencies());
   EXPECT_EQ(0.001, pars.get_imaginary_damping());
+  EXPECT_EQ("symmetry_tables.bin", pars.get_symmetry_tables_file());
 }
@@ -25,6 +25,9 @@ TEST(FourPointParametersTest, DefaultValues) {
   EXPECT_EQ(momentum_transfer_input_check, pars.get_four_point_momentum_transfer_input());
   EXPECT_EQ(0, pars.get_four_point_frequency_transfer());
   EXPECT_EQ(false, pars.compute_all_transfers());
+  EXPECT_EQ(1, pars.get_four_point_batch_size());
+  EXPECT_EQ(1, pars.get_four_point_measurement_interval());
+  EXPECT_EQ(false, pars.irreducible_storage());
 }
 
 TEST(FourPointParametersTest, ReadAll) {
@@ -42,6 +45,9 @@ TEST(FourPointParametersTest, ReadAll) {
   EXPECT_EQ(momentum_transfer_input_check, pars.get_four_point_momentum_transfer_input());
   EXPECT_EQ(1, pars.get_four_point_frequency_transfer());
   EXPECT_EQ(true, pars.compute_all_transfers());
+  EXPECT_EQ(8, pars.get_four_point_batch_size());
+  EXPECT_EQ(4, pars.get_four_point_measurement_interval());
+  EXPECT_EQ(true, pars.irreducible_storage());
 
   pars.set_four_point_type(dca::phys::PARTICLE_HOLE_MAGNETIC);
   EXPECT_EQ(dca::phys::PARTICLE_HOLE_MAGNETIC, pars.get_four_point_type());
@@ -29,11 +29,18 @@ TEST(MciParametersTest, DefaultValues) {
   EXPECT_EQ(985456376, pars.get_seed());
   EXPECT_EQ(20, pars.get_warm_up_sweeps());
   EXPECT_EQ(1., pars.get_sweeps_per_measurement());
+  EXPECT_FALSE(pars.adaptive_sweeps_per_measurement());
+  EXPECT_EQ(32., pars.get_max_sweeps_per_measurement());
   EXPECT_EQ(100, pars.get_measurements());
+  EXPECT_FALSE(pars.dynamic_measurement_distribution());
+  EXPECT_EQ(16, pars.get_measurement_batch_size());
+  EXPECT_FALSE(pars.hierarchical_sum());
   EXPECT_EQ(dca::phys::ErrorComputationType::NONE, pars.get_error_computation_type());
   EXPECT_EQ(1, pars.get_walkers());
   EXPECT_EQ(1, pars.get_accumulators());
   EXPECT_EQ(false, pars.shared_walk_and_accumulation_thread());
+  EXPECT_TRUE(pars.get_replica_exchange_expansion_parameters().empty());
+  EXPECT_EQ(1, pars.get_replica_exchange_period());
   EXPECT_FALSE(pars.adjust_self_energy_for_double_counting());
 }
 
@@ -48,11 +55,18 @@ TEST(MciParametersTest, ReadAll) {
   EXPECT_EQ(42, pars.get_seed());
   EXPECT_EQ(40, pars.get_warm_up_sweeps());
   EXPECT_EQ(4., pars.get_sweeps_per_measurement());
+  EXPECT_TRUE(pars.adaptive_sweeps_per_measurement());
+  EXPECT_EQ(10., pars.get_max_sweeps_per_measurement());
   EXPECT_EQ(200, pars.get_measurements());
+  EXPECT_TRUE(pars.dynamic_measurement_distribution());
+  EXPECT_EQ(4, pars.get_measurement_batch_size());
+  EXPECT_TRUE(pars.hierarchical_sum());
   EXPECT_EQ(dca::phys::ErrorComputationType::JACK_KNIFE, pars.get_error_computation_type());
   EXPECT_EQ(3, pars.get_walkers());
   EXPECT_EQ(5, pars.get_accumulators());
   EXPECT_EQ(true, pars.shared_walk_and_accumulation_thread());
+  EXPECT_EQ(std::vector<double>({1., 2., 4.}), pars.get_replica_exchange_expansion_parameters());
+  EXPECT_EQ(10, pars.get_replica_exchange_period());
 }
 
 TEST(MciParametersTest, ReadPositiveIntegerSeed) {
@@ -27,6 +27,8 @@ TEST(OutputParametersTest, DefaultValues) {
   EXPECT_EQ("ed.hdf5", pars.get_filename_ed());
   EXPECT_EQ("qmc.hdf5", pars.get_filename_qmc());
   EXPECT_EQ("profiling.json", pars.get_filename_profiling());
+  EXPECT_EQ("", pars.get_filename_qmc_metrics());
+  EXPECT_EQ(10., pars.get_qmc_metrics_interval());
   EXPECT_FALSE(pars.dump_lattice_self_energy());
   EXPECT_FALSE(pars.dump_cluster_Greens_functions());
   EXPECT_FALSE(pars.dump_Gamma_lattice());
@@ -53,6 +55,8 @@ TEST(OutputParametersTest, ReadAll) {
   EXPECT_EQ("ed.json", pars.get_filename_ed());
   EXPECT_EQ("qmc.json", pars.get_filename_qmc());
   EXPECT_EQ("profiling_run1.json", pars.get_filename_profiling());
+  EXPECT_EQ("metrics.jsonl", pars.get_filename_qmc_metrics());
+  EXPECT_EQ(2.5, pars.get_qmc_metrics_interval());
   EXPECT_TRUE(pars.dump_lattice_self_energy());
   EXPECT_TRUE(pars.dump_cluster_Greens_functions());
   EXPECT_TRUE(pars.dump_Gamma_lattice());
@@ -0,0 +1,102 @@
+// Copyright (C) 2018 ETH Zurich
+// Copyright (C) 2018 UT-Battelle, LLC
+// All rights reserved.
+//
+// See LICENSE for terms of usage.
+// See CITATION.md for citation guidelines, if DCA++ is used for scientific publications.
+//
+// This file tests the HistogramProfiler class.
+
+#include "dca/profiling/histogram_profiler.hpp"
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dca/io/json/json_reader.hpp"
+#include "dca/parallel/no_concurrency/no_concurrency.hpp"
+
+using Profiler = dca::profiling::HistogramProfiler;
+
+TEST(HistogramProfilerTest, Bins) {
+  EXPECT_EQ(0, Profiler::bin(0.));
+  EXPECT_EQ(0, Profiler::bin(0.5 * Profiler::min_time));
+  EXPECT_EQ(Profiler::n_bins - 1, Profiler::bin(1e10));
+
+  for (const double time : {1e-6, 3.3e-5, 1e-3, 0.7, 12.}) {
+    const int b = Profiler::bin(time);
+    EXPECT_LT(time, Profiler::binUpperEdge(b));
+    EXPECT_GE(time, Profiler::binUpperEdge(b - 1));
+  }
+}
+
+TEST(HistogramProfilerTest, Parallel) {
+  Profiler::start();
+  constexpr int n_threads = 4;
+
+  // Each thread records 98 calls of 1 ms, one call of 10 ms and one call of 100 ms * (id + 1).
+  {
+    std::vector<std::future<void>> futures;
+    for (int id = 0; id < n_threads; ++id)
+      futures.emplace_back(std::async(std::launch::async, [id]() {
+        for (int i = 0; i < 98; ++i)
+          Profiler::record("step", "HistogramProfilerTest", 1e-3);
+        Profiler::record("step", "HistogramProfilerTest", 1e-2);
+        Profiler::record("step", "HistogramProfilerTest", 0.1 * (id + 1));
+
+        Profiler prof("scope", "HistogramProfilerTest", __LINE__, id);
+      }));
+  }
+
+  dca::parallel::NoConcurrency concurrency(0, nullptr);
+  Profiler::stop(concurrency, "histogram_profile.json");
+
+  const auto& statistics = Profiler::get_statistics();
+  ASSERT_EQ(2, statistics.size());
+  EXPECT_EQ(n_threads, statistics.at("scope").calls);
+
+  const auto& step = statistics.at("step");
+  EXPECT_EQ("HistogramProfilerTest", step.category);
+  EXPECT_EQ(100 * n_threads, step.calls);
+  EXPECT_NEAR(n_threads * (98e-3 + 1e-2) + 1., step.total, 1e-10);
+  EXPECT_EQ(0.4, step.max);
+  EXPECT_EQ(Profiler::binUpperEdge(Profiler::bin(1e-3)), step.p50);
+  EXPECT_EQ(Profiler::binUpperEdge(Profiler::bin(1e-3)), step.p90);
+  EXPECT_EQ(Profiler::binUpperEdge(Profiler::bin(1e-2)), step.p99);
+  EXPECT_EQ(98 * n_threads, step.counts[Profiler::bin(1e-3)]);
+
+  // Read the output.
+  dca::io::JSONReader reader;
+  reader.open_file("histogram_profile.json");
+  reader.open_group("1");
+
+  std::string name;
+  int calls;
+  double max;
+  reader.execute("name", name);
+  reader.execute("calls", calls);
+  reader.execute("max [s]", max);
+
+  EXPECT_EQ("step", name);
+  EXPECT_EQ(100 * n_threads, calls);
+  EXPECT_DOUBLE_EQ(0.4, max);
+}
+
+TEST(HistogramProfilerTest, EqualNamesAtDifferentAddresses) {
+  Profiler::start();
+
+  static const char name_1[] = "region";
+  static const char name_2[] = "region";
+  ASSERT_NE(static_cast<const void*>(name_1), static_cast<const void*>(name_2));
+
+  Profiler::record(name_1, "HistogramProfilerTest", 1e-3);
+  Profiler::record(name_2, "HistogramProfilerTest", 2e-3);
+  Profiler::stop("histogram_profile.json");
+
+  const auto& statistics = Profiler::get_statistics();
+  ASSERT_EQ(1, statistics.size());
+  EXPECT_EQ(2, statistics.at("region").calls);
+  EXPECT_DOUBLE_EQ(3e-3, statistics.at("region").total);
+}